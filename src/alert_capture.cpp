@@ -0,0 +1,279 @@
+/*!
+ * \file alert_capture.cpp
+ * \brief Implementation of the alert-triggered capture of the raw datagrams.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "alert_capture.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+void DatagramRing::setCapacity(size_t bytes)
+{
+    if (bytes != m_capacity)
+    {
+        // Not value-initialised, the pages are only touched as the ring fills.
+        m_storage.reset(bytes > 0 ? new char[bytes] : nullptr);
+        m_capacity = bytes;
+    }
+    clear();
+}
+
+void DatagramRing::clear()
+{
+    m_begin = 0;
+    m_end = 0;
+    m_wrapAt = 0;
+    m_wrapped = false;
+    m_count = 0;
+}
+
+/*!
+ Stores a copy of the \a size bytes of \a data, after dropping the records older than the maximum
+ age and as many of the oldest others as needed to make room for it.
+ */
+bool DatagramRing::push(quint64 sequence, quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size)
+{
+    const size_t length = recordSize(size);
+    if (size < 0 || length > m_capacity)
+    {
+        return false;
+    }
+
+    while (m_count > 0 && m_maxAgeUs > 0 && header(m_begin).timestampUs < timestamp_us - m_maxAgeUs)
+    {
+        popOldest();
+    }
+    for (;;)
+    {
+        if (m_count == 0)
+        {
+            clear();
+        }
+        if (!m_wrapped)
+        {
+            if (m_end + length <= m_capacity)
+            {
+                break;
+            }
+            if (length <= m_begin)
+            {
+                // Continue at the start, the tail of the buffer is left unused until the next wrap.
+                m_wrapAt = m_end;
+                m_end = 0;
+                m_wrapped = true;
+                break;
+            }
+        }
+        else if (m_end + length <= m_begin)
+        {
+            break;
+        }
+        popOldest();
+    }
+
+    Header h;
+    h.timestampUs = timestamp_us;
+    h.sequence = sequence;
+    h.size = static_cast<quint32>(size);
+    h.streamId = stream_id;
+    h.reserved = 0;
+    std::memcpy(m_storage.get() + m_end, &h, sizeof(h));
+    std::memcpy(m_storage.get() + m_end + sizeof(h), data, static_cast<size_t>(size));
+    m_end += length;
+    m_count++;
+    return true;
+}
+
+/*!
+ Returns the timestamp of the oldest datagram, or 0 if the ring is empty.
+ */
+qint64 DatagramRing::oldestUs() const
+{
+    return m_count > 0 ? header(m_begin).timestampUs : 0;
+}
+
+DatagramRing::Header DatagramRing::header(size_t offset) const
+{
+    Header h;
+    std::memcpy(&h, m_storage.get() + offset, sizeof(h));
+    return h;
+}
+
+void DatagramRing::popOldest()
+{
+    m_begin += recordSize(header(m_begin).size);
+    m_count--;
+    if (m_wrapped && m_begin == m_wrapAt)
+    {
+        m_begin = 0;
+        m_wrapped = false;
+    }
+}
+
+AlertCapture::AlertCapture(QObject *parent) : QObject(parent), m_directory(defaultDirectory())
+{
+    // Not on the monitor clock: the datagrams are stamped with the wall clock.
+    m_stopTimer.setSingleShot(true);
+    connect(&m_stopTimer, &ClockTimer::timeout, this, &AlertCapture::stop);
+}
+
+/*!
+ Closes the capture in progress without signalling it, its receivers may be gone already.
+ */
+AlertCapture::~AlertCapture()
+{
+    m_recorder.close();
+}
+
+/*!
+ Keeps the datagrams of the last \a seconds_before in a ring of at most \a buffer_mb megabytes,
+ and records each capture until \a seconds_after past its last trigger.
+ */
+void AlertCapture::configure(int seconds_before, int seconds_after, int buffer_mb)
+{
+    m_beforeUs = std::max(0, seconds_before) * qint64(1000000);
+    m_afterUs = std::max(0, seconds_after) * qint64(1000000);
+    m_ring.setMaxAgeUs(m_beforeUs);
+    m_ring.setCapacity(m_beforeUs > 0 ? static_cast<size_t>(std::max(1, buffer_mb)) << 20 : 0);
+}
+
+/*!
+ Returns the directory where the captures are written, "captures" in the application data directory.
+ */
+QString AlertCapture::defaultDirectory()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("captures");
+}
+
+void AlertCapture::push(quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size)
+{
+    m_sequence++;
+    if (m_beforeUs > 0)
+    {
+        m_ring.push(m_sequence, stream_id, timestamp_us, data, size);
+    }
+    if (!isCapturing())
+    {
+        return;
+    }
+
+    if (timestamp_us > m_deadlineUs)
+    {
+        stop();
+        return;
+    }
+    write(m_sequence, stream_id, timestamp_us, data, size);
+}
+
+/*!
+ Opens a capture with the datagrams of the ring received in the last seconds before \a now_us and
+ not written yet, and keeps it open until the seconds after. During a capture, moves its end instead.
+ */
+bool AlertCapture::trigger(qint64 now_us)
+{
+    if (!isEnabled())
+    {
+        return true;
+    }
+    if (isCapturing())
+    {
+        scheduleStop(now_us);
+        return true;
+    }
+
+    // UTC to the millisecond, and never an existing capture, which open() would truncate.
+    const QDir directory(m_directory);
+    const QString name = "alert-" + QDateTime::fromMSecsSinceEpoch(now_us / 1000, Qt::UTC).toString("yyyyMMdd-hhmmss-zzz");
+    QString path = directory.filePath(name + ".gsdr");
+    for (int n = 1; QFileInfo::exists(path); n++)
+    {
+        path = directory.filePath(QString("%1-%2.gsdr").arg(name).arg(n));
+    }
+    if (!QDir().mkpath(m_directory) || !m_recorder.open(path))
+    {
+        m_errorString = QString("Cannot write the alert capture %1: %2").arg(path, m_recorder.errorString());
+        return false;
+    }
+
+    m_datagrams = 0;
+    m_deadlineUs = 0;
+    const qint64 from_us = now_us - m_beforeUs;
+    qint64 first_us = now_us;
+    m_ring.forEach([this, from_us, &first_us](const DatagramRing::Datagram &datagram) {
+        if (datagram.timestampUs >= from_us && datagram.sequence > m_lastWritten)
+        {
+            first_us = std::min(first_us, datagram.timestampUs);
+            write(datagram.sequence, datagram.streamId, datagram.timestampUs, datagram.data, datagram.size);
+        }
+    });
+    scheduleStop(now_us);
+
+    emit captureStarted(path, (now_us - first_us) / 1e6);
+    return true;
+}
+
+/*!
+ Ends the capture in progress, if any.
+ */
+void AlertCapture::stop()
+{
+    m_stopTimer.stop();
+    if (!isCapturing())
+    {
+        return;
+    }
+
+    const QString path = m_recorder.fileName();
+    m_recorder.close();
+    emit captureFinished(path, m_datagrams);
+}
+
+void AlertCapture::write(quint64 sequence, quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size)
+{
+    m_recorder.record(stream_id, timestamp_us, data, size);
+    m_lastWritten = sequence;
+    m_datagrams++;
+}
+
+/*!
+ Moves the end of the capture to the seconds after \a now_us, if later. The timer ends it when no
+ datagram arrives past the end.
+ */
+void AlertCapture::scheduleStop(qint64 now_us)
+{
+    m_deadlineUs = std::max(m_deadlineUs, now_us + m_afterUs);
+    const qint64 remaining_ms = (m_deadlineUs - now_us) / 1000 + 1;
+    m_stopTimer.start(static_cast<int>(std::min<qint64>(remaining_ms, std::numeric_limits<int>::max())));
+}
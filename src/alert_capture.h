@@ -0,0 +1,196 @@
+/*!
+ * \file alert_capture.h
+ * \brief Interface of the alert-triggered capture of the raw datagrams.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_ALERT_CAPTURE_H_
+#define GNSS_SDR_MONITOR_ALERT_CAPTURE_H_
+
+#include "monitor_clock.h"
+#include "session_recorder.h"
+#include <QObject>
+#include <QString>
+#include <cstddef>
+#include <memory>
+
+/*!
+ Ring of the last datagrams received, in a byte buffer allocated once.
+
+ Each datagram is stored with its header in one contiguous record, so that
+ adding one is a memcpy. The oldest records are dropped when they are older
+ than the maximum age or to make room for a new one.
+ */
+class DatagramRing
+{
+public:
+    struct Datagram
+    {
+        quint64 sequence;
+        qint64 timestampUs;
+        quint16 streamId;
+        const char *data;
+        qint64 size;
+    };
+
+    // Allocates the buffer, and drops what it held, if \a bytes differs from the capacity.
+    void setCapacity(size_t bytes);
+    size_t capacity() const { return m_capacity; }
+    void setMaxAgeUs(qint64 age_us) { m_maxAgeUs = age_us; }
+    void clear();
+
+    // Returns false if the datagram is larger than the whole buffer.
+    bool push(quint64 sequence, quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size);
+
+    size_t count() const { return m_count; }
+    qint64 oldestUs() const;
+
+    // Calls \a f with every Datagram, oldest first.
+    template <typename F>
+    void forEach(F f) const
+    {
+        if (m_count == 0)
+        {
+            return;
+        }
+        if (m_wrapped)
+        {
+            forEachIn(m_begin, m_wrapAt, f);
+            forEachIn(0, m_end, f);
+        }
+        else
+        {
+            forEachIn(m_begin, m_end, f);
+        }
+    }
+
+private:
+    struct Header
+    {
+        qint64 timestampUs;
+        quint64 sequence;
+        quint32 size;
+        quint16 streamId;
+        quint16 reserved;
+    };
+
+    static size_t recordSize(qint64 size) { return (sizeof(Header) + static_cast<size_t>(size) + 7) & ~size_t(7); }
+    Header header(size_t offset) const;
+    void popOldest();
+
+    template <typename F>
+    void forEachIn(size_t offset, size_t end, F &f) const
+    {
+        while (offset < end)
+        {
+            const Header h = header(offset);
+            f(Datagram{h.sequence, h.timestampUs, h.streamId, m_storage.get() + offset + sizeof(Header), h.size});
+            offset += recordSize(h.size);
+        }
+    }
+
+    std::unique_ptr<char[]> m_storage;
+    size_t m_capacity = 0;
+    qint64 m_maxAgeUs = 0;
+
+    // The records are in [m_begin, m_end), or in [m_begin, m_wrapAt) then [0, m_end) once wrapped.
+    size_t m_begin = 0;
+    size_t m_end = 0;
+    size_t m_wrapAt = 0;
+    bool m_wrapped = false;
+    size_t m_count = 0;
+};
+
+/*!
+ Records the raw datagrams around the alerts, for units that cannot afford
+ to record all the time.
+
+ The datagrams of the last seconds before are always kept in a DatagramRing.
+ trigger() opens a recording in the capture directory, writes the part of
+ the ring within that window and then every datagram received until the
+ seconds after have elapsed. An alert during a capture extends it instead
+ of opening another file, and a capture never repeats the datagrams already
+ written by the previous one, so overlapping alerts do not duplicate data.
+
+ The ring holds the seconds before as long as they fit in its byte budget.
+ Once configured, keeping it costs no allocation per datagram.
+ */
+class AlertCapture : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_SECONDS = 60;
+    static constexpr int DEFAULT_BUFFER_MB = 32;
+
+    explicit AlertCapture(QObject *parent = nullptr);
+    ~AlertCapture();
+
+    // Zero seconds before and after turn the capture off and free the ring.
+    void configure(int seconds_before, int seconds_after, int buffer_mb);
+    bool isEnabled() const { return m_beforeUs > 0 || m_afterUs > 0; }
+    bool isCapturing() const { return m_recorder.isRecording(); }
+
+    static QString defaultDirectory();
+    void setDirectory(const QString &directory) { m_directory = directory; }
+    QString errorString() const { return m_errorString; }
+
+    // Every datagram received, before it is parsed, with its wall clock timestamp.
+    void push(quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size);
+
+    // Starts a capture at \a now_us, or extends the one in progress. Returns false on error.
+    bool trigger(qint64 now_us);
+
+public slots:
+    void stop();
+
+signals:
+    // \a buffered_seconds is how far back the ring went, less than asked if it ran out of memory.
+    void captureStarted(const QString &path, double buffered_seconds);
+    void captureFinished(const QString &path, quint64 datagrams);
+
+private:
+    void write(quint64 sequence, quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size);
+    void scheduleStop(qint64 now_us);
+
+    DatagramRing m_ring;
+    SessionRecorder m_recorder;
+    ClockTimer m_stopTimer;
+    QString m_directory;
+    QString m_errorString;
+
+    qint64 m_beforeUs = 0;
+    qint64 m_afterUs = 0;
+    qint64 m_deadlineUs = 0;
+    quint64 m_sequence = 0;     // Of the last datagram pushed.
+    quint64 m_lastWritten = 0;  // Sequence of the last datagram written to a capture.
+    quint64 m_datagrams = 0;    // Written to the capture in progress.
+};
+
+#endif  // GNSS_SDR_MONITOR_ALERT_CAPTURE_H_
@@ -0,0 +1,52 @@
+/*!
+ * \file allocation_counter.h
+ * \brief Counter of heap allocations, compiled in on demand for the replay
+ * benchmark.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_ALLOCATION_COUNTER_H_
+#define GNSS_SDR_MONITOR_ALLOCATION_COUNTER_H_
+
+#include <QtGlobal>
+
+/*!
+ Number of calls to the global operator new since the program started.
+
+ The replacement operators are only built when the project is configured
+ with -DENABLE_ALLOCATION_COUNTER=ON, so normal builds pay nothing for it;
+ otherwise isEnabled() is false and count() is always 0.
+ */
+namespace AllocationCounter
+{
+bool isEnabled();
+quint64 count();
+}  // namespace AllocationCounter
+
+#endif  // GNSS_SDR_MONITOR_ALLOCATION_COUNTER_H_
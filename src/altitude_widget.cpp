@@ -32,22 +32,26 @@
 
 
 #include "altitude_widget.h"
+#include <QActionGroup>
 #include <QChart>
+#include <QContextMenuEvent>
 #include <QGraphicsLayout>
 #include <QLayout>
+#include <QMenu>
+#include <cmath>
 
 /*!
  Constructs an altitude widget.
  */
 AltitudeWidget::AltitudeWidget(QWidget *parent) : QWidget(parent)
 {
-    // Default buffer size.
-    m_bufferSize = 100;
-
-    m_altitudeBuffer.resize(m_bufferSize);
-    m_altitudeBuffer.clear();
+    m_altitudeBuffer.setCapacity(m_window.capacity());
+    m_orthometricBuffer.setCapacity(m_window.capacity());
 
     m_series = new QtCharts::QLineSeries();
+    m_series->setName("Ellipsoidal");
+    m_orthometricSeries = new QtCharts::QLineSeries();
+    m_orthometricSeries->setName("Orthometric");
     m_chartView = new QtCharts::QChartView(this);
 
     QVBoxLayout *layout = new QVBoxLayout(this);
@@ -57,11 +61,12 @@ AltitudeWidget::AltitudeWidget(QWidget *parent) : QWidget(parent)
     QtCharts::QChart *chart = m_chartView->chart();
 
     chart->addSeries(m_series);
+    chart->addSeries(m_orthometricSeries);
     chart->setTitle("Altitude vs Time");
     chart->legend()->hide();
     chart->createDefaultAxes();
     chart->axes(Qt::Horizontal).back()->setTitleText("TOW [s]");
-    chart->axes(Qt::Vertical).back()->setTitleText("Altitude [m]");
+    applyHeightMode();
     chart->layout()->setContentsMargins(0, 0, 0, 0);
     chart->setContentsMargins(-18, -18, -14, -16);
 
@@ -76,11 +81,71 @@ AltitudeWidget::AltitudeWidget(QWidget *parent) : QWidget(parent)
 }
 
 /*!
- Adds the \a alitude and associated \a tow to the widget's internal data structures.
+ Shows the ellipsoidal height, the orthometric height or both. Without a geoid model only the
+ ellipsoidal height can be shown.
+ */
+void AltitudeWidget::setHeightMode(HeightMode mode)
+{
+    m_heightMode = mode;
+    applyHeightMode();
+}
+
+/*!
+ Sets the name of the geoid model that gives the orthometric heights, or an empty string if there is none.
+ */
+void AltitudeWidget::setGeoidName(const QString &name)
+{
+    m_geoidName = name;
+    applyHeightMode();
+}
+
+void AltitudeWidget::applyHeightMode()
+{
+    const bool orthometric = m_heightMode != HeightMode::Ellipsoidal && !m_geoidName.isEmpty();
+    const bool ellipsoidal = m_heightMode != HeightMode::Orthometric || !orthometric;
+
+    m_series->setVisible(ellipsoidal);
+    m_orthometricSeries->setVisible(orthometric);
+    m_orthometricSeries->setName("Orthometric (" + m_geoidName + ")");
+
+    QtCharts::QChart *chart = m_chartView->chart();
+    chart->legend()->setVisible(ellipsoidal && orthometric);
+    if (ellipsoidal && orthometric)
+    {
+        chart->axes(Qt::Vertical).back()->setTitleText("Height [m]");
+    }
+    else if (orthometric)
+    {
+        chart->axes(Qt::Vertical).back()->setTitleText("Height above the geoid [m]");
+    }
+    else
+    {
+        chart->axes(Qt::Vertical).back()->setTitleText("Height above the ellipsoid [m]");
+    }
+
+    // Refill and rescale to the series now shown. The generations of the buffers are never 0 again
+    // after their capacity is set.
+    m_drawnGeneration = 0;
+    m_drawnOrthometricGeneration = 0;
+    redraw();
+}
+
+/*!
+ Adds the ellipsoidal \a altitude, the \a orthometric height, NaN if unknown, and the associated \a tow
+ to the widget's internal data structures.
  */
-void AltitudeWidget::addData(qreal tow, qreal altitude)
+void AltitudeWidget::addData(qreal tow, qreal altitude, qreal orthometric)
 {
+    if (m_window.observe(tow))
+    {
+        m_altitudeBuffer.setCapacity(m_window.capacity());
+        m_orthometricBuffer.setCapacity(m_window.capacity());
+    }
     m_altitudeBuffer.push_back(QPointF(tow, altitude));
+    if (!std::isnan(orthometric))
+    {
+        m_orthometricBuffer.push_back(QPointF(tow, orthometric));
+    }
 }
 
 /*!
@@ -88,34 +153,82 @@ void AltitudeWidget::addData(qreal tow, qreal altitude)
  */
 void AltitudeWidget::redraw()
 {
-    if (!m_altitudeBuffer.empty())
+    // Nothing was added since the last redraw.
+    if (m_altitudeBuffer.generation() == m_drawnGeneration &&
+        m_orthometricBuffer.generation() == m_drawnOrthometricGeneration)
     {
-        double min_x = std::numeric_limits<double>::max();
-        double max_x = -std::numeric_limits<double>::max();
-
-        double min_y = std::numeric_limits<double>::max();
-        double max_y = -std::numeric_limits<double>::max();
-
-        QtCharts::QChart *chart = m_chartView->chart();
-        QPointF p;
-        QVector<QPointF> vec;
+        return;
+    }
+    m_drawnGeneration = m_altitudeBuffer.generation();
+    m_drawnOrthometricGeneration = m_orthometricBuffer.generation();
 
-        for (size_t i = 0; i < m_altitudeBuffer.size(); i++)
+    RingRange x_range;
+    RingRange y_range;
+    QVector<QPointF> vec;
+    for (auto *series : {m_series, m_orthometricSeries})
+    {
+        const RingBuffer<QPointF> &buffer = series == m_series ? m_altitudeBuffer : m_orthometricBuffer;
+        if (!series->isVisible() || buffer.empty())
         {
-            p = m_altitudeBuffer.at(i);
-            vec << p;
+            continue;
+        }
 
-            min_x = std::min(min_x, p.x());
-            min_y = std::min(min_y, p.y());
+        // Only the points within the history window, like every other chart.
+        const size_t first = ringLowerBound(buffer, buffer.back().x() - m_window.seconds(),
+            [](const QPointF &point) { return point.x(); });
+        vec.clear();
+        vec.reserve(static_cast<int>(buffer.size() - first));
+        buffer.forEach(first, buffer.size() - first, [&vec](const QPointF &point) { vec.push_back(point); });
+        series->replace(vec);
 
-            max_x = std::max(max_x, p.x());
-            max_y = std::max(max_y, p.y());
-        }
+        std::pair<RingRange, RingRange> range = ringMinMaxXY(buffer, first, buffer.size() - first);
+        x_range.merge(range.first);
+        y_range.merge(range.second);
+    }
+
+    if (x_range.valid())
+    {
+        QtCharts::QChart *chart = m_chartView->chart();
+        chart->axes(Qt::Horizontal).back()->setRange(x_range.max - m_window.seconds(), x_range.max);
+        chart->axes(Qt::Vertical).back()->setRange(y_range.min, y_range.max);
+    }
+}
 
-        m_series->replace(vec);
+void AltitudeWidget::contextMenuEvent(QContextMenuEvent *event)
+{
+    QMenu menu(this);
+    QActionGroup group(&menu);
+    QAction *ellipsoidal = menu.addAction("Ellipsoidal Height");
+    QAction *orthometric = menu.addAction("Orthometric Height");
+    QAction *both = menu.addAction("Both Heights");
+    for (QAction *action : {ellipsoidal, orthometric, both})
+    {
+        action->setCheckable(true);
+        group.addAction(action);
+    }
+    ellipsoidal->setChecked(m_heightMode == HeightMode::Ellipsoidal);
+    orthometric->setChecked(m_heightMode == HeightMode::Orthometric);
+    both->setChecked(m_heightMode == HeightMode::Both);
+    if (m_geoidName.isEmpty())
+    {
+        orthometric->setEnabled(false);
+        both->setEnabled(false);
+        menu.addSeparator();
+        menu.addAction("Set a geoid grid in the preferences")->setEnabled(false);
+    }
 
-        chart->axes(Qt::Horizontal).back()->setRange(min_x, max_x);
-        chart->axes(Qt::Vertical).back()->setRange(min_y, max_y);
+    QAction *chosen = menu.exec(event->globalPos());
+    if (chosen == ellipsoidal)
+    {
+        setHeightMode(HeightMode::Ellipsoidal);
+    }
+    else if (chosen == orthometric)
+    {
+        setHeightMode(HeightMode::Orthometric);
+    }
+    else if (chosen == both)
+    {
+        setHeightMode(HeightMode::Both);
     }
 }
 
@@ -125,14 +238,21 @@ void AltitudeWidget::redraw()
 void AltitudeWidget::clear()
 {
     m_altitudeBuffer.clear();
+    m_orthometricBuffer.clear();
+    m_window.reset();
     m_series->clear();
+    m_orthometricSeries->clear();
 }
 
 /*!
- Sets the size of the internal circular buffer that stores the widget's data.
+ Shows the heights of the last \a seconds. The circular buffers are sized from the rate of the PVT.
  */
-void AltitudeWidget::setBufferSize(size_t size)
+void AltitudeWidget::setHistoryWindow(double seconds)
 {
-    m_bufferSize = size;
-    m_altitudeBuffer.resize(m_bufferSize);
+    m_window.setSeconds(seconds);
+    m_altitudeBuffer.setCapacity(m_window.capacity());
+    m_orthometricBuffer.setCapacity(m_window.capacity());
+    m_drawnGeneration = 0;
+    m_drawnOrthometricGeneration = 0;
+    redraw();
 }
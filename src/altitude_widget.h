@@ -34,7 +34,8 @@
 #ifndef GNSS_SDR_MONITOR_ALTITUDE_WIDGET_H_
 #define GNSS_SDR_MONITOR_ALTITUDE_WIDGET_H_
 
-#include <boost/circular_buffer.hpp>
+#include "history_window.h"
+#include "ring_buffer.h"
 #include <QChartView>
 #include <QLineSeries>
 #include <QWidget>
@@ -44,19 +45,41 @@ class AltitudeWidget : public QWidget
     Q_OBJECT
 
 public:
+    enum class HeightMode
+    {
+        Ellipsoidal,  // Above the WGS 84 ellipsoid, as computed by the receiver
+        Orthometric,  // Above the geoid, close to mean sea level
+        Both
+    };
+
     explicit AltitudeWidget(QWidget *parent = nullptr);
 
+    void setHeightMode(HeightMode mode);
+    HeightMode heightMode() const { return m_heightMode; }
+    void setGeoidName(const QString &name);
+
 public slots:
-    void addData(qreal tow, qreal altitude);
+    void addData(qreal tow, qreal altitude, qreal orthometric);
     void redraw();
     void clear();
-    void setBufferSize(size_t size);
+    void setHistoryWindow(double seconds);
+
+protected:
+    void contextMenuEvent(QContextMenuEvent *event) override;
 
 private:
-    size_t m_bufferSize;
-    boost::circular_buffer<QPointF> m_altitudeBuffer;
+    void applyHeightMode();
+
+    HistoryWindow m_window;
+    RingBuffer<QPointF> m_altitudeBuffer;
+    RingBuffer<QPointF> m_orthometricBuffer;
+    uint64_t m_drawnGeneration = 0;
+    uint64_t m_drawnOrthometricGeneration = 0;
+    HeightMode m_heightMode = HeightMode::Ellipsoidal;
+    QString m_geoidName;  // Empty without a geoid model
     QtCharts::QChartView *m_chartView = nullptr;
     QtCharts::QLineSeries *m_series = nullptr;
+    QtCharts::QLineSeries *m_orthometricSeries = nullptr;
 
     double min_x;
     double min_y;
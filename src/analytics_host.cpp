@@ -0,0 +1,305 @@
+/*!
+ * \file analytics_host.cpp
+ * \brief Implementation of the host that runs the analytics modules on worker threads.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "analytics_host.h"
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QThread>
+#include <algorithm>
+#include <functional>
+#if defined(Q_OS_UNIX)
+#include <time.h>
+#endif
+
+namespace
+{
+// Weight of the newest sample in the running means of the costs and of the epoch interval.
+constexpr double SMOOTHING = 1.0 / 16.0;
+
+// A module gets back to twice its rate only if its load would then stay under this share of its budget.
+constexpr double RECOVERY = 0.8;
+
+/*!
+ Returns the CPU time used by the calling thread in nanoseconds, or -1 where it is not available.
+ */
+qint64 threadCpuNs()
+{
+#if defined(Q_OS_UNIX)
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0)
+    {
+        return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+#endif
+    return -1;
+}
+
+/*!
+ Runs one module on one epoch and reports its cost back to the host, on the thread of the host.
+ */
+class ModuleRunner : public QRunnable
+{
+public:
+    ModuleRunner(AnalyticsModule *module, std::shared_ptr<const AnalyticsEpoch> epoch,
+        std::function<void(double)> done)
+        : m_module(module), m_epoch(std::move(epoch)), m_done(std::move(done))
+    {
+    }
+
+    void run() override
+    {
+        QElapsedTimer wall;
+        wall.start();
+        const qint64 cpu = threadCpuNs();
+
+        m_module->process(*m_epoch);
+
+        // Without a thread CPU clock the wall time is an upper bound of the CPU time.
+        const qint64 cpu_end = cpu >= 0 ? threadCpuNs() : -1;
+        const double cost_us = (cpu_end >= 0 ? cpu_end - cpu : wall.nsecsElapsed()) / 1000.0;
+        m_done(cost_us);
+    }
+
+private:
+    AnalyticsModule *m_module;
+    std::shared_ptr<const AnalyticsEpoch> m_epoch;
+    std::function<void(double)> m_done;
+};
+}  // namespace
+
+/*!
+ Constructs a host without modules. One core is left to the ingest and the views.
+ */
+AnalyticsHost::AnalyticsHost(QObject *parent) : QObject(parent)
+{
+    m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+}
+
+AnalyticsHost::~AnalyticsHost()
+{
+    m_pool.waitForDone();
+}
+
+int AnalyticsHost::addModule(std::unique_ptr<AnalyticsModule> module, double budget_percent)
+{
+    Module entry;
+    entry.stats.name = module->name();
+    entry.stats.budgetPercent = budget_percent;
+    entry.module = std::move(module);
+    m_modules.push_back(std::move(entry));
+
+    const int index = static_cast<int>(m_modules.size()) - 1;
+    emit moduleAdded(index);
+    return index;
+}
+
+/*!
+ Returns the index of the module called \a name, or -1.
+ */
+int AnalyticsHost::findModule(const QString &name) const
+{
+    for (size_t i = 0; i < m_modules.size(); i++)
+    {
+        if (m_modules[i].stats.name == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void AnalyticsHost::setEnabled(int index, bool enabled)
+{
+    if (m_modules[index].stats.enabled == enabled)
+    {
+        return;
+    }
+    m_modules[index].stats.enabled = enabled;
+    emit enabledChanged(index, enabled);
+}
+
+/*!
+ Sets the share of one core, in percent, that module \a index may take on average.
+ Its rate is adjusted from the next epoch on.
+ */
+void AnalyticsHost::setBudget(int index, double percent)
+{
+    m_modules[index].stats.budgetPercent = percent;
+}
+
+AnalyticsHost::ModuleStats AnalyticsHost::stats(int index) const
+{
+    return m_modules[index].stats;
+}
+
+/*!
+ Hands the epoch made of \a observables and of the latest \a pvt, if any, to the modules that are
+ due and not busy. Returns at once; the modules run on the worker threads. On a virtual clock,
+ returns once the modules are done and their results published.
+ */
+void AnalyticsHost::submit(const gnss_sdr::Observables &observables, const PvtSnapshot *pvt)
+{
+    const qint64 now_ms = clockNowMs(m_clock);
+    if (m_lastEpochMs >= 0 && now_ms >= m_lastEpochMs)
+    {
+        const double interval_us = (now_ms - m_lastEpochMs) * 1000.0;
+        m_epochIntervalUs = m_epochIntervalUs > 0.0 ? m_epochIntervalUs + SMOOTHING * (interval_us - m_epochIntervalUs)
+                                                    : interval_us;
+    }
+    m_lastEpochMs = now_ms;
+
+    const bool synchronous = isSynchronous();
+    if (synchronous)
+    {
+        // Runs started before the clock turned virtual.
+        m_pool.waitForDone();
+    }
+    std::vector<double> costs(synchronous ? m_modules.size() : 0, -1.0);
+
+    // Copied once, and only if some module takes it.
+    std::shared_ptr<const AnalyticsEpoch> epoch;
+    for (size_t i = 0; i < m_modules.size(); i++)
+    {
+        Module &module = m_modules[i];
+        if (!module.stats.enabled || module.epochs++ % module.stats.stride != 0)
+        {
+            continue;
+        }
+        if (module.busy && !synchronous)
+        {
+            module.stats.skipped++;
+            continue;
+        }
+
+        if (!epoch)
+        {
+            auto next = std::make_shared<AnalyticsEpoch>();
+            next->timeMs = now_ms;
+            next->observables = observables;
+            if (pvt)
+            {
+                next->hasPvt = true;
+                next->pvt = *pvt;
+            }
+            epoch = std::move(next);
+        }
+
+        module.busy = true;
+        const int index = static_cast<int>(i);
+        const quint64 generation = m_generation;
+        if (synchronous)
+        {
+            double *cost = &costs[i];
+            m_pool.start(new ModuleRunner(module.module.get(), epoch, [cost](double cost_us) { *cost = cost_us; }));
+            continue;
+        }
+        m_pool.start(new ModuleRunner(module.module.get(), epoch, [this, index, generation](double cost_us) {
+            QMetaObject::invokeMethod(this, [this, index, generation, cost_us] { finished(index, generation, cost_us); },
+                Qt::QueuedConnection);
+        }));
+    }
+
+    if (synchronous && epoch)
+    {
+        m_pool.waitForDone();
+        for (size_t i = 0; i < costs.size(); i++)
+        {
+            if (costs[i] >= 0.0)
+            {
+                finished(static_cast<int>(i), m_generation, costs[i]);
+            }
+        }
+    }
+}
+
+/*!
+ Publishes the results of module \a index, accounts for the \a cost_us it took and adjusts its stride.
+ */
+void AnalyticsHost::finished(int index, quint64 generation, double cost_us)
+{
+    Module &module = m_modules[index];
+    module.busy = false;
+    if (generation != m_generation)
+    {
+        // Computed on data cleared since.
+        return;
+    }
+
+    module.module->publish();
+
+    ModuleStats &stats = module.stats;
+    stats.costUs = stats.processed > 0 ? stats.costUs + SMOOTHING * (cost_us - stats.costUs) : cost_us;
+    stats.processed++;
+    if (m_epochIntervalUs <= 0.0)
+    {
+        return;
+    }
+
+    stats.loadPercent = 100.0 * stats.costUs / (m_epochIntervalUs * stats.stride);
+    if (isSynchronous())
+    {
+        // The CPU time does not scale with the replay speed, the stride must not either.
+        return;
+    }
+    if (stats.loadPercent > stats.budgetPercent && stats.stride < MAX_STRIDE)
+    {
+        stats.stride *= 2;
+        stats.loadPercent /= 2.0;
+    }
+    else if (stats.stride > 1 && 2.0 * stats.loadPercent < RECOVERY * stats.budgetPercent)
+    {
+        stats.stride /= 2;
+        stats.loadPercent *= 2.0;
+    }
+}
+
+/*!
+ Waits for the modules at work and resets all of them, for when the data is cleared. The strides
+ start again from one, so that a replay always processes the same epochs.
+ */
+void AnalyticsHost::reset()
+{
+    m_pool.waitForDone();
+    m_generation++;
+    for (Module &module : m_modules)
+    {
+        module.module->reset();
+        module.busy = false;
+        module.epochs = 0;
+        module.stats.stride = 1;
+        module.stats.loadPercent = 0.0;
+        module.stats.processed = 0;
+        module.stats.skipped = 0;
+    }
+    m_lastEpochMs = -1;
+    m_epochIntervalUs = 0.0;
+}
@@ -0,0 +1,158 @@
+/*!
+ * \file analytics_host.h
+ * \brief Interface of the host that runs the analytics modules on worker threads.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_ANALYTICS_HOST_H_
+#define GNSS_SDR_MONITOR_ANALYTICS_HOST_H_
+
+#include "gnss_synchro.pb.h"
+#include "monitor_clock.h"
+#include "pvt_snapshot.h"
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <memory>
+#include <vector>
+
+/*!
+ What the analytics modules see of one observables epoch. Shared read-only by all the modules
+ that process the epoch.
+ */
+struct AnalyticsEpoch
+{
+    qint64 timeMs = 0;  // Monitor clock, virtual during replay [ms since the Unix epoch]
+    gnss_sdr::Observables observables;
+    bool hasPvt = false;
+    PvtSnapshot pvt;  // Latest PVT when the epoch arrived.
+};
+
+/*!
+ A computation on the stream of epochs that is too costly to run inline on the ingest.
+
+ process() runs on a worker thread of the host, never concurrently with itself or with the other
+ calls. publish() runs on the GUI thread after each process(), before the next one starts, so
+ that a module can hand its results to the views and the event log without locks.
+ */
+class AnalyticsModule
+{
+public:
+    virtual ~AnalyticsModule() = default;
+
+    virtual QString name() const = 0;
+    virtual void process(const AnalyticsEpoch &epoch) = 0;
+    virtual void publish() {}
+    virtual void reset() {}
+};
+
+/*!
+ Runs the analytics modules on a pool of worker threads, one epoch at a time
+ per module, and keeps each of them within its CPU budget.
+
+ The CPU time of every process() is measured on the thread that runs it. The
+ budget of a module is the share of one core it may take on average; the
+ load is its mean cost per epoch over the monitor clock time between the
+ epochs it is given. A module over budget is given one epoch in two, then
+ one in four and so on, and gets back to a higher rate once its load would
+ stay well under the budget. Epochs that arrive while a module is still busy
+ are skipped.
+
+ On a virtual clock the results must not depend on the replay speed: submit()
+ waits for the modules it starts, none is ever skipped, and the strides are
+ frozen.
+ */
+class AnalyticsHost : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct ModuleStats
+    {
+        QString name;
+        bool enabled = true;
+        double budgetPercent = 0.0;  // Of one core.
+        double costUs = 0.0;         // Mean CPU time per processed epoch.
+        double loadPercent = 0.0;    // Of one core, at the current stride.
+        int stride = 1;              // One epoch in stride is processed.
+        quint64 processed = 0;
+        quint64 skipped = 0;
+    };
+
+    static constexpr double DEFAULT_BUDGET_PERCENT = 5.0;
+    static constexpr int MAX_STRIDE = 64;
+
+    explicit AnalyticsHost(QObject *parent = nullptr);
+    ~AnalyticsHost();
+
+    void setClock(MonitorClock *clock) { m_clock = clock; }
+
+    // Takes ownership of \a module. Returns its index.
+    int addModule(std::unique_ptr<AnalyticsModule> module, double budget_percent = DEFAULT_BUDGET_PERCENT);
+    int moduleCount() const { return static_cast<int>(m_modules.size()); }
+    AnalyticsModule *module(int index) const { return m_modules[index].module.get(); }
+    int findModule(const QString &name) const;
+
+    void setEnabled(int index, bool enabled);
+    bool isEnabled(int index) const { return m_modules[index].stats.enabled; }
+    void setBudget(int index, double percent);
+    ModuleStats stats(int index) const;
+
+    void submit(const gnss_sdr::Observables &observables, const PvtSnapshot *pvt);
+
+public slots:
+    void reset();
+
+signals:
+    void moduleAdded(int index);
+    void enabledChanged(int index, bool enabled);
+
+private:
+    struct Module
+    {
+        std::unique_ptr<AnalyticsModule> module;
+        ModuleStats stats;
+        bool busy = false;
+        quint64 epochs = 0;  // Epochs seen while enabled, to apply the stride.
+    };
+
+    void finished(int index, quint64 generation, double cost_us);
+    bool isSynchronous() const { return m_clock && m_clock->isVirtual(); }
+
+    std::vector<Module> m_modules;
+    MonitorClock *m_clock = nullptr;
+    QThreadPool m_pool;
+    quint64 m_generation = 0;
+
+    // Monitor clock time between epochs, the same for every module.
+    qint64 m_lastEpochMs = -1;
+    double m_epochIntervalUs = 0.0;
+};
+
+#endif  // GNSS_SDR_MONITOR_ANALYTICS_HOST_H_
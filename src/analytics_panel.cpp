@@ -0,0 +1,175 @@
+/*!
+ * \file analytics_panel.cpp
+ * \brief Implementation of a widget that shows the cost of the analytics modules.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "analytics_panel.h"
+#include <QDoubleSpinBox>
+#include <QHeaderView>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+namespace
+{
+enum Column
+{
+    Name,
+    Budget,
+    Cost,
+    Load,
+    Rate,
+    Processed,
+    Skipped,
+    COLUMN_COUNT
+};
+}  // namespace
+
+/*!
+ Constructs an empty AnalyticsPanel. The modules are listed once a host is set.
+ */
+AnalyticsPanel::AnalyticsPanel(QWidget *parent) : QWidget(parent)
+{
+    m_table = new QTableWidget(0, COLUMN_COUNT, this);
+    m_table->setHorizontalHeaderLabels({"Module", "Budget", "CPU per epoch", "Load", "Rate", "Processed", "Skipped"});
+    m_table->horizontalHeaderItem(Budget)->setToolTip("Share of one core the module may take on average");
+    m_table->horizontalHeaderItem(Load)->setToolTip("Share of one core the module takes at its current rate");
+    m_table->horizontalHeaderItem(Rate)->setToolTip("Epochs processed, lowered while the module is over budget");
+    m_table->horizontalHeaderItem(Skipped)->setToolTip("Epochs that arrived while the module was still busy");
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    m_table->verticalHeader()->hide();
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+
+    auto *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(5, 5, 5, 5);
+    layout->addWidget(m_table);
+
+    // Ticking the name of a module turns it on or off.
+    connect(m_table, &QTableWidget::itemChanged, this, [this](QTableWidgetItem *item) {
+        if (m_host && item->column() == Name && item->row() < m_host->moduleCount())
+        {
+            m_host->setEnabled(item->row(), item->checkState() == Qt::Checked);
+        }
+    });
+}
+
+/*!
+ Shows the modules of \a host and follows the ones added later. The panel does not take ownership of \a host.
+ */
+void AnalyticsPanel::setHost(AnalyticsHost *host)
+{
+    if (m_host)
+    {
+        disconnect(m_host, nullptr, this, nullptr);
+    }
+    m_host = host;
+    m_table->setRowCount(0);
+    if (m_host)
+    {
+        connect(m_host, &AnalyticsHost::moduleAdded, this, &AnalyticsPanel::addModule);
+        for (int i = 0; i < m_host->moduleCount(); i++)
+        {
+            addModule(i);
+        }
+    }
+}
+
+void AnalyticsPanel::addModule(int index)
+{
+    const AnalyticsHost::ModuleStats stats = m_host->stats(index);
+    m_table->setRowCount(index + 1);
+
+    QSignalBlocker blocker(m_table);
+    auto *name = new QTableWidgetItem(stats.name);
+    name->setFlags(Qt::ItemIsEnabled | Qt::ItemIsUserCheckable);
+    name->setCheckState(stats.enabled ? Qt::Checked : Qt::Unchecked);
+    m_table->setItem(index, Name, name);
+    for (int column = Cost; column < COLUMN_COUNT; column++)
+    {
+        auto *item = new QTableWidgetItem();
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        m_table->setItem(index, column, item);
+    }
+
+    auto *budget = new QDoubleSpinBox(m_table);
+    budget->setRange(0.1, 100.0);
+    budget->setDecimals(1);
+    budget->setSuffix(" %");
+    budget->setValue(stats.budgetPercent);
+    m_table->setCellWidget(index, Budget, budget);
+    connect(budget, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this, index](double percent) {
+        if (m_host)
+        {
+            m_host->setBudget(index, percent);
+        }
+    });
+
+    redraw();
+}
+
+/*!
+ Refreshes the figures of every module. The enabled state and budgets are refreshed too, in case
+ they were changed elsewhere, such as when the settings are loaded.
+ */
+void AnalyticsPanel::redraw()
+{
+    if (!m_host)
+    {
+        return;
+    }
+
+    QSignalBlocker blocker(m_table);
+    for (int row = 0; row < m_host->moduleCount() && row < m_table->rowCount(); row++)
+    {
+        const AnalyticsHost::ModuleStats stats = m_host->stats(row);
+        m_table->item(row, Name)->setCheckState(stats.enabled ? Qt::Checked : Qt::Unchecked);
+        if (auto *budget = qobject_cast<QDoubleSpinBox *>(m_table->cellWidget(row, Budget)))
+        {
+            if (!budget->hasFocus())
+            {
+                QSignalBlocker budget_blocker(budget);
+                budget->setValue(stats.budgetPercent);
+            }
+        }
+
+        m_table->item(row, Cost)->setText(stats.processed > 0 ? QString("%1 µs").arg(stats.costUs, 0, 'f', 1) : QString("-"));
+        m_table->item(row, Load)->setText(stats.processed > 0 ? QString("%1 %").arg(stats.loadPercent, 0, 'f', 2) : QString("-"));
+        m_table->item(row, Rate)->setText(stats.stride == 1 ? QString("every epoch") : QString("1 in %1").arg(stats.stride));
+        m_table->item(row, Processed)->setText(QString::number(stats.processed));
+        m_table->item(row, Skipped)->setText(QString::number(stats.skipped));
+
+        // Modules cut down to a lower rate are over their budget.
+        const QColor background = stats.enabled && stats.stride > 1 ? QColor(255, 225, 170) : QColor();
+        for (int column = Cost; column < COLUMN_COUNT; column++)
+        {
+            m_table->item(row, column)->setBackground(background.isValid() ? QBrush(background) : QBrush());
+        }
+    }
+}
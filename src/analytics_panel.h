@@ -0,0 +1,65 @@
+/*!
+ * \file analytics_panel.h
+ * \brief Interface of a widget that shows the cost of the analytics modules.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_ANALYTICS_PANEL_H_
+#define GNSS_SDR_MONITOR_ANALYTICS_PANEL_H_
+
+#include "analytics_host.h"
+#include <QWidget>
+
+class QTableWidget;
+
+/*!
+ Lists the analytics modules with their CPU cost, load and rate, and lets
+ the user turn them on and off and set their budgets.
+ */
+class AnalyticsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit AnalyticsPanel(QWidget *parent = nullptr);
+
+    void setHost(AnalyticsHost *host);
+
+public slots:
+    void redraw();
+
+private slots:
+    void addModule(int index);
+
+private:
+    AnalyticsHost *m_host = nullptr;
+    QTableWidget *m_table;
+};
+
+#endif  // GNSS_SDR_MONITOR_ANALYTICS_PANEL_H_
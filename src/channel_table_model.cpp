@@ -35,9 +35,28 @@
 #include <QDebug>
 #include <QList>
 #include <QtGui>
+#include <algorithm>
+#include <cmath>
 #include <string.h>
 
-#define DEFAULT_BUFFER_SIZE 1000
+namespace
+{
+// Lists the flags that make satellite \a prn unusable. Only built when a tooltip is shown.
+QString healthToolTip(const SatelliteHealth &health, int prn)
+{
+    QStringList lines;
+    const SatelliteHealth::Flags flags = health.flags(prn);
+    for (int i = 0; i < SatelliteHealth::FLAG_COUNT; i++)
+    {
+        auto flag = static_cast<SatelliteHealth::Flag>(i);
+        if (flags[flag] && SatelliteHealth::severity(flag) == SatelliteHealth::Severity::Fault)
+        {
+            lines << SatelliteHealth::flagDescription(flag);
+        }
+    }
+    return lines.join('\n');
+}
+}  // namespace
 
 /*!
  Constructs an instance of a table model.
@@ -52,8 +71,23 @@ ChannelTableModel::ChannelTableModel()
     m_mapSignalPrettyName["5X"] = "E5a";
     m_mapSignalPrettyName["L5"] = "L5";
 
-    m_columns = 11;
-    m_bufferSize = DEFAULT_BUFFER_SIZE;
+    m_columns = 14;
+    m_historySeconds = HistoryWindow::DEFAULT_SECONDS;
+
+    // The identity and acquisition columns only change with the satellite in the channel.
+    // The tracking values change every epoch, and the sparklines are the dearest to paint.
+    m_columnPolicy.resize(m_columns);
+    for (int column : {8, 9, 10, 11, 12})
+    {
+        m_columnPolicy[column] = {false, SCALAR_INTERVAL_MS};
+    }
+    for (int column : {5, 6, 7, 13})
+    {
+        m_columnPolicy[column] = {false, SPARKLINE_INTERVAL_MS};
+    }
+    m_columnVisible.assign(m_columns, true);
+    m_columnDirty.assign(m_columns, false);
+    m_columnRefreshMs.assign(m_columns, 0);
 }
 
 /*!
@@ -63,6 +97,134 @@ void ChannelTableModel::update()
 {
     beginResetModel();
     endResetModel();
+    m_rowsChanged = false;
+    std::fill(m_columnDirty.begin(), m_columnDirty.end(), false);
+}
+
+/*!
+ Sends to the views the columns due at \a now_ms according to their policy, with one dataChanged()
+ per run of adjacent columns, or resets the model if channels came or went. Hidden columns are
+ skipped, as the views query them again when they are shown. Returns true if some visible column
+ still has changes to send, so that the caller calls again later.
+ */
+bool ChannelTableModel::refresh(qint64 now_ms)
+{
+    if (m_rowsChanged)
+    {
+        update();
+        std::fill(m_columnRefreshMs.begin(), m_columnRefreshMs.end(), now_ms);
+        return false;
+    }
+
+    const int rows = static_cast<int>(m_channelsId.size());
+    bool pending = false;
+    int first = -1;
+    for (int column = 0; column <= m_columns; column++)
+    {
+        if (column < m_columns && isDue(column, now_ms))
+        {
+            m_columnDirty[column] = false;
+            m_columnRefreshMs[column] = now_ms;
+            if (first < 0)
+            {
+                first = column;
+            }
+            continue;
+        }
+
+        if (column < m_columns && m_columnVisible[column] && m_columnDirty[column])
+        {
+            pending = true;
+        }
+        if (first >= 0 && rows > 0)
+        {
+            emit dataChanged(index(0, first), index(rows - 1, column - 1));
+        }
+        first = -1;
+    }
+    return pending;
+}
+
+bool ChannelTableModel::isDue(int column, qint64 now_ms) const
+{
+    const ColumnPolicy &policy = m_columnPolicy[column];
+    return m_columnVisible[column] && m_columnDirty[column] &&
+           (policy.onChange || now_ms - m_columnRefreshMs[column] >= policy.intervalMs);
+}
+
+/*!
+ Sets when \a column is sent to the views.
+ */
+void ChannelTableModel::setColumnPolicy(int column, ColumnPolicy policy)
+{
+    if (column >= 0 && column < m_columns)
+    {
+        m_columnPolicy[column] = policy;
+    }
+}
+
+ChannelTableModel::ColumnPolicy ChannelTableModel::columnPolicy(int column) const
+{
+    return column >= 0 && column < m_columns ? m_columnPolicy[column] : ColumnPolicy();
+}
+
+/*!
+ Tells whether \a column is shown and on screen. Changes to columns that are not are never sent, so
+ a column that comes into view is marked as changed to catch up with the next refresh().
+ */
+void ChannelTableModel::setColumnVisible(int column, bool visible)
+{
+    if (column >= 0 && column < m_columns && m_columnVisible[column] != visible)
+    {
+        m_columnVisible[column] = visible;
+        m_columnDirty[column] = visible && !m_channelsId.empty();
+    }
+}
+
+bool ChannelTableModel::hasDirtyColumns() const
+{
+    return std::find(m_columnDirty.begin(), m_columnDirty.end(), true) != m_columnDirty.end();
+}
+
+/*!
+ Marks \a column as changed by something other than the channel data, such as the satellite health.
+ */
+void ChannelTableModel::markChanged(int column)
+{
+    if (column >= 0 && column < m_columns && m_columnVisible[column])
+    {
+        m_columnDirty[column] = true;
+    }
+}
+
+/*!
+ Marks the columns whose values differ between \a old_channel and \a channel.
+ */
+void ChannelTableModel::markChannelChanged(const gnss_sdr::GnssSynchro &old_channel, const gnss_sdr::GnssSynchro &channel)
+{
+    const bool changed[] = {
+        false,
+        old_channel.system() != channel.system() || old_channel.signal() != channel.signal(),
+        old_channel.prn() != channel.prn(),
+        old_channel.acq_doppler_hz() != channel.acq_doppler_hz(),
+        old_channel.acq_delay_samples() != channel.acq_delay_samples(),
+        true,  // Sparklines get a new sample every epoch.
+        true,
+        true,
+        old_channel.tow_at_current_symbol_ms() != channel.tow_at_current_symbol_ms(),
+        old_channel.flag_valid_word() != channel.flag_valid_word(),
+        old_channel.pseudorange_m() != channel.pseudorange_m(),
+        true,  // The C/N0 model learns from every epoch.
+        true,  // So does the C/N0 estimated from the prompt I/Q.
+        false,  // The Doppler residuals come from addDopplerResidual().
+    };
+    for (int column = 0; column < m_columns && column < static_cast<int>(sizeof(changed) / sizeof(changed[0])); column++)
+    {
+        if (changed[column])
+        {
+            markChanged(column);
+        }
+    }
 }
 
 int ChannelTableModel::rowCount(const QModelIndex &parent) const
@@ -77,38 +239,66 @@ int ChannelTableModel::columnCount(const QModelIndex &parent) const
 
 QVariant ChannelTableModel::data(const QModelIndex &index, int role) const
 {
-    if (role == Qt::DisplayRole || role == Qt::ToolTipRole || role == Qt::DecorationRole)
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole || role == Qt::DecorationRole || role == SparklineRangeRole)
     {
         try
         {
             int channel_id = m_channelsId.at(index.row());
 
-            gnss_sdr::GnssSynchro channel = m_channels.at(channel_id);
+            const gnss_sdr::GnssSynchro &channel = m_channels.at(channel_id);
 
-            QString channel_signal = m_channelsSignal.at(channel_id);
+            const QString &channel_signal = m_channelsSignal.at(channel_id);
 
-            boost::circular_buffer<double> channel_time_cbuf =
-                m_channelsTime.at(channel_id);
-            boost::circular_buffer<double> channel_prompt_i_cbuf =
-                m_channelsPromptI.at(channel_id);
-            boost::circular_buffer<double> channel_prompt_q_cbuf =
-                m_channelsPromptQ.at(channel_id);
-            boost::circular_buffer<double> channel_cn0_cbuf =
-                m_channelsCn0.at(channel_id);
-            boost::circular_buffer<double> channel_doppler_cbuf =
-                m_channelsDoppler.at(channel_id);
+            const ChannelHistory &history = m_channelsHistory.at(channel_id);
 
-            QList<QVariant> channel_prompt_iq;
-            QList<QVariant> channel_cn0;
-            QList<QVariant> channel_doppler;
+            if (role == Qt::ToolTipRole && m_staleChannels.count(channel_id))
+            {
+                return "Restored from the previous session, not updated since";
+            }
 
-            for (int i = 0; i < channel_cn0_cbuf.size(); i++)
+            // Builds the list of points for the sparkline columns. Only the requested column is
+            // materialised, straight from the ring storage, and only within the history window.
+            auto windowStart = [](const History &series) {
+                return series.time.empty() ? 0 : ringLowerBound(series.time, series.time.back() - series.window.seconds());
+            };
+            auto makePoints = [&windowStart](const History &series, const RingBuffer<double> &xs, const RingBuffer<double> &ys) {
+                QList<QVariant> list;
+                size_t n = std::min(xs.size(), ys.size());
+                size_t first = windowStart(series);
+                list.reserve(static_cast<int>(n > first ? n - first : 0));
+                for (size_t i = first; i < n; i++)
+                {
+                    list << QPointF(xs[i], ys[i]);
+                }
+                return list;
+            };
+
+            // The range of the same points: the time is in order, the values are reduced on the ring storage.
+            auto makeRange = [&windowStart](const History &series) -> QVariant {
+                size_t n = std::min(series.time.size(), series.values[0].size());
+                size_t first = windowStart(series);
+                if (first >= n)
+                {
+                    return QVariant::Invalid;
+                }
+                const RingRange values = ringMinMax(series.values[0], first, n - first);
+                return QRectF(QPointF(series.time[first], values.min), QPointF(series.time[n - 1], values.max));
+            };
+
+            if (role == SparklineRangeRole)
             {
-                channel_prompt_iq << QPointF(channel_prompt_i_cbuf.at(i),
-                    channel_prompt_q_cbuf.at(i));
-                channel_cn0 << QPointF(channel_time_cbuf.at(i), channel_cn0_cbuf.at(i));
-                channel_doppler << QPointF(channel_time_cbuf.at(i),
-                    channel_doppler_cbuf.at(i));
+                switch (index.column())
+                {
+                case 6:
+                    return makeRange(history[Cn0]);
+
+                case 7:
+                    return makeRange(history[Doppler]);
+
+                case 13:
+                    return makeRange(history[DopplerResidual]);
+                }
+                return QVariant::Invalid;
             }
 
             if (role == Qt::DisplayRole)
@@ -131,13 +321,13 @@ QVariant ChannelTableModel::data(const QModelIndex &index, int role) const
                     return channel.acq_delay_samples();
 
                 case 5:
-                    return channel_prompt_iq;
+                    return makePoints(history[Constellation], history[Constellation].values[0], history[Constellation].values[1]);
 
                 case 6:
-                    return channel_cn0;
+                    return makePoints(history[Cn0], history[Cn0].time, history[Cn0].values[0]);
 
                 case 7:
-                    return channel_doppler;
+                    return makePoints(history[Doppler], history[Doppler].time, history[Doppler].values[0]);
 
                 case 8:
                     return channel.tow_at_current_symbol_ms();
@@ -147,6 +337,29 @@ QVariant ChannelTableModel::data(const QModelIndex &index, int role) const
 
                 case 10:
                     return channel.pseudorange_m();
+
+                case 11:
+                {
+                    Cn0ElevationModel::Deviation deviation;
+                    if (m_cn0Model && m_cn0Model->deviation(channel_id, deviation))
+                    {
+                        return std::round(deviation.deviation * 10.0) / 10.0;
+                    }
+                    return QVariant::Invalid;
+                }
+
+                case 12:
+                {
+                    Cn0EstimatorModule::Estimate estimate;
+                    if (m_cn0Estimates && m_cn0Estimates->estimate(channel_id, estimate) && estimate.hasM2m4)
+                    {
+                        return std::round(estimate.m2m4 * 10.0) / 10.0;
+                    }
+                    return QVariant::Invalid;
+                }
+
+                case 13:
+                    return makePoints(history[DopplerResidual], history[DopplerResidual].time, history[DopplerResidual].values[0]);
                 }
             }
             else if (role == Qt::ToolTipRole)
@@ -160,6 +373,10 @@ QVariant ChannelTableModel::data(const QModelIndex &index, int role) const
                     return QVariant::Invalid;
 
                 case 2:
+                    if (m_satelliteHealth && m_satelliteHealth->isUnhealthy(channel.system(), channel.prn()))
+                    {
+                        return healthToolTip(*m_satelliteHealth, channel.prn());
+                    }
                     return QVariant::Invalid;
 
                 case 3:
@@ -172,10 +389,10 @@ QVariant ChannelTableModel::data(const QModelIndex &index, int role) const
                     return QVariant::Invalid;
 
                 case 6:
-                    return channel_cn0_cbuf.back();
+                    return channel.cn0_db_hz();
 
                 case 7:
-                    return channel_doppler_cbuf.back();
+                    return channel.carrier_doppler_hz();
 
                 case 8:
                     return QVariant::Invalid;
@@ -185,6 +402,41 @@ QVariant ChannelTableModel::data(const QModelIndex &index, int role) const
 
                 case 10:
                     return QVariant::Invalid;
+
+                case 11:
+                {
+                    Cn0ElevationModel::Deviation deviation;
+                    if (m_cn0Model && m_cn0Model->deviation(channel_id, deviation))
+                    {
+                        return QString("Expected %1 dB-Hz at %2° elevation")
+                            .arg(deviation.expected, 0, 'f', 1)
+                            .arg(deviation.elevation, 0, 'f', 1);
+                    }
+                    return "The expected C/N0 is learned from the satellites seen at this elevation";
+                }
+
+                case 12:
+                {
+                    Cn0EstimatorModule::Estimate estimate;
+                    if (m_cn0Estimates && m_cn0Estimates->estimate(channel_id, estimate) && estimate.hasM2m4)
+                    {
+                        QString text = QString("M2M4 %1 dB-Hz").arg(estimate.m2m4, 0, 'f', 1);
+                        if (estimate.hasNwpr)
+                        {
+                            text += QString(", NWPR %1 dB-Hz").arg(estimate.nwpr, 0, 'f', 1);
+                        }
+                        return text + QString("\nReported by the receiver %1 dB-Hz").arg(estimate.reported, 0, 'f', 1);
+                    }
+                    return "Estimated from the prompt I/Q once enough samples are in";
+                }
+
+                case 13:
+                    if (history[DopplerResidual].values[0].empty())
+                    {
+                        return "Needs a PVT fix, the ephemeris of the satellite and at least three channels";
+                    }
+                    return QString("%1 Hz after the receiver clock drift")
+                        .arg(history[DopplerResidual].values[0].back(), 0, 'f', 1);
                 }
             }
             else if (index.column() == 1 && role == Qt::DecorationRole)
@@ -213,6 +465,64 @@ QVariant ChannelTableModel::data(const QModelIndex &index, int role) const
             return QVariant::Invalid;
         }
     }
+    else if ((role == Qt::BackgroundRole || role == Qt::ForegroundRole) && !m_staleChannels.empty() &&
+             index.row() < static_cast<int>(m_channelsId.size()) && m_staleChannels.count(m_channelsId[index.row()]))
+    {
+        // Hatches the whole row of the channels restored from the previous session, sparklines included.
+        if (role == Qt::BackgroundRole)
+        {
+            return QBrush(QColor(200, 200, 200), Qt::BDiagPattern);
+        }
+        return QColor(Qt::gray);
+    }
+    else if (role == Qt::BackgroundRole && index.column() == 2 && m_satelliteHealth)
+    {
+        // Flags the tracked satellites whose ephemeris says they should not be used.
+        if (index.row() < static_cast<int>(m_channelsId.size()))
+        {
+            auto channel = m_channels.find(m_channelsId[index.row()]);
+            if (channel != m_channels.end() &&
+                m_satelliteHealth->isUnhealthy(channel->second.system(), channel->second.prn()))
+            {
+                return QColor(255, 190, 190);
+            }
+        }
+    }
+    else if (role == Qt::BackgroundRole && index.column() == 12 && m_cn0Estimates)
+    {
+        // Flags the channels whose reported C/N0 cannot be trusted.
+        Cn0EstimatorModule::Estimate estimate;
+        if (index.row() < static_cast<int>(m_channelsId.size()) &&
+            m_cn0Estimates->estimate(m_channelsId[index.row()], estimate) && estimate.diverging)
+        {
+            return QColor(255, 190, 190);
+        }
+    }
+    else if (role == Qt::BackgroundRole && index.column() == 13 && !m_dopplerOutliers.empty())
+    {
+        // Flags the channels whose Doppler the geometry and the clock drift do not explain.
+        if (index.row() < static_cast<int>(m_channelsId.size()) && m_dopplerOutliers.count(m_channelsId[index.row()]))
+        {
+            return QColor(255, 225, 170);
+        }
+    }
+    else if (role == Qt::BackgroundRole && index.column() == 11 && m_cn0Model)
+    {
+        // Flags the channels well below the C/N0 expected at their elevation.
+        Cn0ElevationModel::Deviation deviation;
+        if (index.row() < static_cast<int>(m_channelsId.size()) &&
+            m_cn0Model->deviation(m_channelsId[index.row()], deviation))
+        {
+            if (deviation.deviation <= -6.0)
+            {
+                return QColor(255, 190, 190);
+            }
+            if (deviation.deviation <= -3.0)
+            {
+                return QColor(255, 225, 170);
+            }
+        }
+    }
     else if (role == Qt::TextAlignmentRole)
     {
         return Qt::AlignCenter;
@@ -262,6 +572,15 @@ QVariant ChannelTableModel::headerData(int section,
 
             case 10:
                 return "Pseudorange [m]";
+
+            case 11:
+                return "C/N0 vs Expected [dB]";
+
+            case 12:
+                return "C/N0 from I/Q [dB-Hz]";
+
+            case 13:
+                return "Doppler Residual [Hz]";
             }
         }
     }
@@ -302,63 +621,38 @@ void ChannelTableModel::populateChannel(const gnss_sdr::GnssSynchro *ch)
         // Check the size of the map of GnssSynchro objects before adding new data.
         size_t map_size = m_channels.size();
 
-        // Add the new GnssSynchro object to the map.
-        m_channels[ch->channel_id()] = *ch;
-
-        // Time.
-        // Check if channel exists in the map of time data.
-        if (m_channelsTime.find(ch->channel_id()) == m_channelsTime.end())
+        auto existing = m_channels.find(ch->channel_id());
+        if (existing != m_channels.end())
         {
-            // Channel does not exist so make room for it.
-            m_channelsTime[ch->channel_id()].resize(m_bufferSize);
-            m_channelsTime[ch->channel_id()].clear();
+            markChannelChanged(existing->second, *ch);
         }
-        // Populate map with new time data.
-        m_channelsTime[ch->channel_id()].push_back(ch->rx_time());
 
-        // In-phase prompt component.
-        // Check if channel exists in the map of in-phase component data.
-        if (m_channelsPromptI.find(ch->channel_id()) == m_channelsPromptI.end())
-        {
-            // Channel does not exist so make room for it.
-            m_channelsPromptI[ch->channel_id()].resize(m_bufferSize);
-            m_channelsPromptI[ch->channel_id()].clear();
-        }
-        // Populate map with new in-phase component data.
-        m_channelsPromptI[ch->channel_id()].push_back(ch->prompt_i());
+        // Add the new GnssSynchro object to the map.
+        m_channels[ch->channel_id()] = *ch;
 
-        // Quadrature prompt component.
-        // Check if channel exists in the map of quadrature component data.
-        if (m_channelsPromptQ.find(ch->channel_id()) == m_channelsPromptQ.end())
+        // A restored channel is live again, repaint its whole row.
+        if (m_staleChannels.erase(ch->channel_id()))
         {
-            // Channel does not exist so make room for it.
-            m_channelsPromptQ[ch->channel_id()].resize(m_bufferSize);
-            m_channelsPromptQ[ch->channel_id()].clear();
+            m_rowsChanged = true;
         }
-        // Populate map with new quadrature component data.
-        m_channelsPromptQ[ch->channel_id()].push_back(ch->prompt_q());
 
-        // CN0.
-        // Check if channel exists in the map of CN0 data.
-        if (m_channelsCn0.find(ch->channel_id()) == m_channelsCn0.end())
+        // History.
+        // Check if channel exists in the map of histories.
+        if (m_channelsHistory.find(ch->channel_id()) == m_channelsHistory.end())
         {
             // Channel does not exist so make room for it.
-            m_channelsCn0[ch->channel_id()].resize(m_bufferSize);
-            m_channelsCn0[ch->channel_id()].clear();
+            addHistory(ch->channel_id());
         }
-        // Populate map with new CN0 data.
-        m_channelsCn0[ch->channel_id()].push_back(ch->cn0_db_hz());
-
-        // Doppler.
-        // Check if channel exists in the map of Doppler data.
-        if (m_channelsDoppler.find(ch->channel_id()) == m_channelsDoppler.end())
+        // Populate the histories with the new data, unwrapped across week rollovers.
+        double rx_time = ch->rx_time();
+        if (m_gnssTime && rx_time > 0.0)
         {
-            // Channel does not exist so make room for it.
-            m_channelsDoppler[ch->channel_id()].resize(m_bufferSize);
-            m_channelsDoppler[ch->channel_id()].clear();
+            rx_time = m_gnssTime->continuousTime(rx_time);
         }
-        // Populate map with new Doppler data.
-        m_channelsDoppler[ch->channel_id()].push_back(ch->carrier_doppler_hz());
+        ChannelHistory &history = m_channelsHistory[ch->channel_id()];
+        record(history[Constellation], rx_time, ch->prompt_i(), ch->prompt_q());
+        record(history[Cn0], rx_time, ch->cn0_db_hz());
+        record(history[Doppler], rx_time, ch->carrier_doppler_hz());
 
         // Signal name.
         // Populate map with new signal name.
@@ -369,10 +663,161 @@ void ChannelTableModel::populateChannel(const gnss_sdr::GnssSynchro *ch)
         {
             // Map size has changed so record the new channel number in the vector of channel IDs.
             m_channelsId.push_back(ch->channel_id());
+            m_rowsChanged = true;
         }
     }
 }
 
+/*!
+ Copies into \a snapshot the list of channels, or the history of the channels and fields selected by \a request.
+ */
+void ChannelTableModel::fillSnapshot(const SeriesRequest &request, SeriesSnapshot &snapshot) const
+{
+    if (request.kind == SeriesRequest::Kind::Pvt)
+    {
+        return;
+    }
+
+    for (int channel_id : m_channelsId)
+    {
+        const gnss_sdr::GnssSynchro &channel = m_channels.at(channel_id);
+        const QString satellite = QString::fromStdString(channel.system()) + QString::number(channel.prn());
+
+        if (request.kind == SeriesRequest::Kind::Channels)
+        {
+            SeriesSnapshot::Channel info;
+            info.channelId = channel_id;
+            info.satellite = satellite;
+            info.signal = m_channelsSignal.at(channel_id);
+            info.samples = m_channelsHistory.at(channel_id)[Cn0].time.size();
+            snapshot.channels.push_back(info);
+            continue;
+        }
+
+        if ((request.channelId >= 0 && channel_id != request.channelId) ||
+            (!request.satellite.isEmpty() && satellite != request.satellite) ||
+            (!request.signal.isEmpty() && request.signal != QString::fromStdString(channel.signal())))
+        {
+            continue;
+        }
+
+        for (const QString &field : request.fields)
+        {
+            const ChannelHistory &channel_history = m_channelsHistory.at(channel_id);
+            const History *history = &channel_history[Cn0];
+            int component = 0;
+            if (field == "doppler")
+            {
+                history = &channel_history[Doppler];
+            }
+            else if (field == "doppler_residual")
+            {
+                history = &channel_history[DopplerResidual];
+            }
+            else if (field == "prompt_i" || field == "prompt_q")
+            {
+                history = &channel_history[Constellation];
+                component = field == "prompt_q" ? 1 : 0;
+            }
+
+            SeriesSnapshot::Series series;
+            series.field = field;
+            series.channelId = channel_id;
+            series.satellite = satellite;
+            series.signal = m_channelsSignal.at(channel_id);
+            history->time.copyTo(series.time);
+            history->values[component].copyTo(series.values);
+            snapshot.series.push_back(std::move(series));
+        }
+    }
+}
+
+/*!
+ Copies into \a channels the last data and the history of every channel, in the order of the rows.
+ */
+void ChannelTableModel::saveState(std::vector<ChannelState> &channels) const
+{
+    channels.reserve(channels.size() + m_channelsId.size());
+    for (int channel_id : m_channelsId)
+    {
+        ChannelState state;
+        state.channel = m_channels.at(channel_id);
+        const ChannelHistory &history = m_channelsHistory.at(channel_id);
+        for (int series = 0; series < SERIES_COUNT; series++)
+        {
+            history[series].time.copyTo(state.series[series].time);
+            history[series].values[0].copyTo(state.series[series].values[0]);
+            history[series].values[1].copyTo(state.series[series].values[1]);
+        }
+        channels.push_back(std::move(state));
+    }
+}
+
+/*!
+ Replaces the channels with \a channels, as saved by saveState() in an earlier session. They are
+ shown as stale until the receiver sends data for them again. The histories are stored as they
+ are, without going through the decimators again, and cut to the current history window.
+ */
+void ChannelTableModel::restoreState(const std::vector<ChannelState> &channels)
+{
+    clearChannels();
+    for (const ChannelState &state : channels)
+    {
+        const int channel_id = state.channel.channel_id();
+        if (m_channels.count(channel_id))
+        {
+            continue;
+        }
+        m_channels[channel_id] = state.channel;
+        m_channelsSignal[channel_id] = getSignalPrettyName(&state.channel);
+        m_channelsId.push_back(channel_id);
+        m_staleChannels.insert(channel_id);
+
+        ChannelHistory &history = addHistory(channel_id);
+        for (int series = 0; series < SERIES_COUNT; series++)
+        {
+            const ChannelState::SeriesState &saved = state.series[series];
+            History &target = history[series];
+            const bool paired = target.values[1].capacity() > 0;
+            const size_t n = std::min(saved.time.size(), saved.values[0].size());
+            if (paired && saved.values[1].size() < n)
+            {
+                continue;
+            }
+
+            // Learn the rate of the series first, so that the rings hold its whole window.
+            for (size_t i = 0; i < n; i++)
+            {
+                target.window.observe(saved.time[i]);
+            }
+            target.time.setCapacity(target.window.capacity());
+            target.values[0].setCapacity(target.window.capacity());
+            if (paired)
+            {
+                target.values[1].setCapacity(target.window.capacity());
+            }
+            for (size_t i = 0; i < n; i++)
+            {
+                target.time.push_back(saved.time[i]);
+                target.values[0].push_back(saved.values[0][i]);
+                if (paired)
+                {
+                    target.values[1].push_back(saved.values[1][i]);
+                }
+            }
+        }
+    }
+    m_rowsChanged = true;
+}
+
+/*!
+ Tells whether channel \a channel_id was restored from the previous session and has not been updated since.
+ */
+bool ChannelTableModel::isStale(int channel_id) const
+{
+    return m_staleChannels.count(channel_id) != 0;
+}
+
 /*!
  Clears the data of a single channel specified by \a ch_id from the table model.
  */
@@ -382,11 +827,10 @@ void ChannelTableModel::clearChannel(int ch_id)
         m_channelsId.end());
     m_channels.erase(ch_id);
     m_channelsSignal.erase(ch_id);
-    m_channelsTime.erase(ch_id);
-    m_channelsPromptI.erase(ch_id);
-    m_channelsPromptQ.erase(ch_id);
-    m_channelsCn0.erase(ch_id);
-    m_channelsDoppler.erase(ch_id);
+    m_channelsHistory.erase(ch_id);
+    m_staleChannels.erase(ch_id);
+    m_dopplerOutliers.erase(ch_id);
+    m_rowsChanged = true;
 }
 
 /*!
@@ -397,11 +841,41 @@ void ChannelTableModel::clearChannels()
     m_channelsId.clear();
     m_channels.clear();
     m_channelsSignal.clear();
-    m_channelsTime.clear();
-    m_channelsPromptI.clear();
-    m_channelsPromptQ.clear();
-    m_channelsCn0.clear();
-    m_channelsDoppler.clear();
+    m_channelsHistory.clear();
+    m_staleChannels.clear();
+    m_dopplerOutliers.clear();
+    m_rowsChanged = true;
+}
+
+/*!
+ Adds \a residual to the Doppler residual history of its channel, unless the channel has been
+ cleared or given to another satellite since the epoch it was computed from.
+ */
+void ChannelTableModel::addDopplerResidual(const DopplerResidualModule::Residual &residual)
+{
+    auto channel = m_channels.find(residual.channelId);
+    if (channel == m_channels.end() || channel->second.prn() != residual.prn ||
+        channel->second.system() != residual.system)
+    {
+        return;
+    }
+
+    double rx_time = residual.rxTime;
+    if (m_gnssTime && rx_time > 0.0)
+    {
+        rx_time = m_gnssTime->continuousTime(rx_time);
+    }
+    record(m_channelsHistory[residual.channelId][DopplerResidual], rx_time, residual.hz);
+
+    if (residual.outlier)
+    {
+        m_dopplerOutliers.insert(residual.channelId);
+    }
+    else
+    {
+        m_dopplerOutliers.erase(residual.channelId);
+    }
+    markChanged(13);
 }
 
 /*!
@@ -434,14 +908,12 @@ QString ChannelTableModel::getSignalPrettyName(const gnss_sdr::GnssSynchro *ch)
 /*!
  Gets a list from a circular buffer \a cbuf.
  */
-QList<QVariant> ChannelTableModel::getListFromCbuf(boost::circular_buffer<double> cbuf)
+QList<QVariant> ChannelTableModel::getListFromCbuf(const RingBuffer<double> &cbuf)
 {
     QList<QVariant> list;
+    list.reserve(static_cast<int>(cbuf.size()));
 
-    for (size_t i = 0; i < cbuf.size(); i++)
-    {
-        list << cbuf.at(i);
-    }
+    cbuf.forEach([&list](double value) { list << value; });
 
     return list;
 }
@@ -455,16 +927,29 @@ int ChannelTableModel::getColumns()
 }
 
 /*!
- Sets the size of the internal circular buffers that store the data of the table model.
+ Reads from the preferences the history window and the decimation of each series, and clears the channels.
  */
-void ChannelTableModel::setBufferSize()
+void ChannelTableModel::loadPreferences()
 {
     QSettings settings;
     settings.beginGroup("Preferences_Dialog");
-    int size = settings.value("buffer_size", DEFAULT_BUFFER_SIZE).toInt();
+    double seconds = settings.value("history_window", HistoryWindow::DEFAULT_SECONDS).toDouble();
+    for (int series = 0; series < SERIES_COUNT; series++)
+    {
+        const QString key = seriesDescriptor(static_cast<Series>(series)).settingsKey;
+        SeriesDecimator::Config config;
+        const int policy = settings.value(key + "_policy", 0).toInt();
+        if (policy > 0 && policy <= static_cast<int>(SeriesDecimator::Policy::Last))
+        {
+            config.policy = static_cast<SeriesDecimator::Policy>(policy);
+        }
+        config.every = settings.value(key + "_every", config.every).toInt();
+        config.bucketMs = settings.value(key + "_bucket_ms", config.bucketMs).toInt();
+        m_decimation[series] = config;
+    }
     settings.endGroup();
 
-    m_bufferSize = size;
+    m_historySeconds = seconds;
     clearChannels();
 }
 
@@ -475,3 +960,105 @@ int ChannelTableModel::getChannelId(int row)
 {
     return m_channelsId.at(row);
 }
+
+/*!
+ Sets the model that gives the deviation of each channel from the C/N0 expected at its elevation.
+ */
+void ChannelTableModel::setCn0Model(const Cn0ElevationModel *model)
+{
+    m_cn0Model = model;
+}
+
+/*!
+ Sets the module that estimates the C/N0 of each channel from its prompt I/Q.
+ */
+void ChannelTableModel::setCn0Estimates(const Cn0EstimatorModule *estimates)
+{
+    m_cn0Estimates = estimates;
+}
+
+/*!
+ Sets the health flags used to mark the PRN of the satellites that should not be used.
+ */
+void ChannelTableModel::setSatelliteHealth(const SatelliteHealth *health)
+{
+    m_satelliteHealth = health;
+}
+
+/*!
+ Sets how the samples of \a series are reduced before they enter the history of each channel.
+ Takes effect on the channels that appear after the call.
+ */
+void ChannelTableModel::setDecimation(Series series, const SeriesDecimator::Config &config)
+{
+    m_decimation[series] = config;
+}
+
+/*!
+ Gets the settings key and the label of the decimation of \a series.
+ */
+const ChannelTableModel::SeriesDescriptor &ChannelTableModel::seriesDescriptor(Series series)
+{
+    static const SeriesDescriptor descriptors[SERIES_COUNT] = {
+        {"decimation_constellation", "Constellation history:"},
+        {"decimation_cn0", "C/N0 history:"},
+        {"decimation_doppler", "Doppler history:"},
+        {"decimation_doppler_residual", "Doppler residual history:"},
+    };
+    return descriptors[series];
+}
+
+/*!
+ Creates the empty history of channel \a channel_id, with the decimation and window of each series.
+ */
+ChannelTableModel::ChannelHistory &ChannelTableModel::addHistory(int channel_id)
+{
+    ChannelHistory &history = m_channelsHistory[channel_id];
+    for (int series = 0; series < SERIES_COUNT; series++)
+    {
+        history[series].decimator = SeriesDecimator(series == Constellation ? 2 : 1);
+        history[series].decimator.setConfig(m_decimation[series]);
+        history[series].window.setSeconds(m_historySeconds);
+        history[series].time.setCapacity(history[series].window.capacity());
+        history[series].values[0].setCapacity(history[series].window.capacity());
+    }
+    history[Constellation].values[1].setCapacity(history[Constellation].window.capacity());
+    return history;
+}
+
+/*!
+ Feeds a sample to the decimator of \a history and stores what comes out of it.
+ */
+void ChannelTableModel::record(History &history, double time, double value, double value_q)
+{
+    SeriesDecimator::Sample out[SeriesDecimator::MAX_OUTPUT];
+    const int count = history.decimator.push({time, {value, value_q}}, out);
+    for (int i = 0; i < count; i++)
+    {
+        // Resize before storing, so that the ring already holds the window at the new rate.
+        const bool paired = history.values[1].capacity() > 0;
+        if (history.window.observe(out[i].time))
+        {
+            history.time.setCapacity(history.window.capacity());
+            history.values[0].setCapacity(history.window.capacity());
+            if (paired)
+            {
+                history.values[1].setCapacity(history.window.capacity());
+            }
+        }
+        history.time.push_back(out[i].time);
+        history.values[0].push_back(out[i].value[0]);
+        if (paired)
+        {
+            history.values[1].push_back(out[i].value[1]);
+        }
+    }
+}
+
+/*!
+ Sets the time service used to place the samples on the continuous time axis shared by all views.
+ */
+void ChannelTableModel::setTimeService(GnssTime *gnss_time)
+{
+    m_gnssTime = gnss_time;
+}
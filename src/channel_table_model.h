@@ -34,26 +34,97 @@
 #ifndef GNSS_SDR_MONITOR_CHANNEL_TABLE_MODEL_H_
 #define GNSS_SDR_MONITOR_CHANNEL_TABLE_MODEL_H_
 
+#include "cn0_elevation_model.h"
+#include "cn0_estimator.h"
+#include "doppler_residuals.h"
 #include "gnss_synchro.pb.h"
-#include <boost/circular_buffer.hpp>
+#include "gnss_time.h"
+#include "history_window.h"
+#include "ring_buffer.h"
+#include "satellite_health.h"
+#include "series_decimator.h"
+#include "series_query.h"
 #include <QAbstractTableModel>
+#include <array>
+#include <set>
+#include <vector>
 
 class ChannelTableModel : public QAbstractTableModel
 {
 public:
     ChannelTableModel();
 
+    // When a column is sent to the views: as soon as one of its values changes, or at most
+    // once every intervalMs while its values keep changing.
+    struct ColumnPolicy
+    {
+        bool onChange = true;
+        int intervalMs = 0;
+    };
+
+    static constexpr int SCALAR_INTERVAL_MS = 100;
+    static constexpr int SPARKLINE_INTERVAL_MS = 500;
+
+    // Role of the sparkline columns giving, as a QRectF, the time and value ranges of the points
+    // of the DisplayRole, so that the delegates do not scan the points for them.
+    static constexpr int SparklineRangeRole = Qt::UserRole;
+
+    // Series kept in the history of each channel, each with its own decimation.
+    enum Series
+    {
+        Constellation,  // Prompt I and Q.
+        Cn0,
+        Doppler,
+        DopplerResidual,
+        SERIES_COUNT
+    };
+
+    struct SeriesDescriptor
+    {
+        const char *settingsKey;
+        const char *label;
+    };
+    static const SeriesDescriptor &seriesDescriptor(Series series);
+
+    // Last data and history of a channel, as kept across sessions.
+    struct ChannelState
+    {
+        gnss_sdr::GnssSynchro channel;
+        struct SeriesState
+        {
+            std::vector<double> time;
+            std::vector<double> values[2];
+        };
+        std::array<SeriesState, SERIES_COUNT> series;
+    };
+
     void update();
+    bool refresh(qint64 now_ms);
+    void setColumnPolicy(int column, ColumnPolicy policy);
+    ColumnPolicy columnPolicy(int column) const;
+    void setColumnVisible(int column, bool visible);
+    bool hasDirtyColumns() const;
+    void markChanged(int column);
 
     void populateChannels(const gnss_sdr::Observables *m_stocks);
     void populateChannel(const gnss_sdr::GnssSynchro *ch);
     void clearChannel(int ch_id);
     void clearChannels();
+    void addDopplerResidual(const DopplerResidualModule::Residual &residual);
     QString getSignalPrettyName(const gnss_sdr::GnssSynchro *ch);
-    QList<QVariant> getListFromCbuf(boost::circular_buffer<double> cbuf);
+    QList<QVariant> getListFromCbuf(const RingBuffer<double> &cbuf);
     int getColumns();
-    void setBufferSize();
+    void loadPreferences();
     int getChannelId(int row);
+    void setTimeService(GnssTime *gnss_time);
+    void setCn0Model(const Cn0ElevationModel *model);
+    void setCn0Estimates(const Cn0EstimatorModule *estimates);
+    void setSatelliteHealth(const SatelliteHealth *health);
+    void setDecimation(Series series, const SeriesDecimator::Config &config);
+    void fillSnapshot(const SeriesRequest &request, SeriesSnapshot &snapshot) const;
+    void saveState(std::vector<ChannelState> &channels) const;
+    void restoreState(const std::vector<ChannelState> &channels);
+    bool isStale(int channel_id) const;
 
     // List of virtual functions that must be implemented in a read-only table model.
     int rowCount(const QModelIndex &parent) const;
@@ -66,20 +137,45 @@ public slots:
 
 protected:
     int m_columns;
-    int m_bufferSize;
+    double m_historySeconds;
+    GnssTime *m_gnssTime = nullptr;
+    const Cn0ElevationModel *m_cn0Model = nullptr;
+    const Cn0EstimatorModule *m_cn0Estimates = nullptr;
+    const SatelliteHealth *m_satelliteHealth = nullptr;
     gnss_sdr::Observables m_stocks;
 
     std::vector<int> m_channelsId;
     std::map<int, gnss_sdr::GnssSynchro> m_channels;
     std::map<int, QString> m_channelsSignal;
-    std::map<int, boost::circular_buffer<double>> m_channelsTime;
-    std::map<int, boost::circular_buffer<double>> m_channelsPromptI;
-    std::map<int, boost::circular_buffer<double>> m_channelsPromptQ;
-    std::map<int, boost::circular_buffer<double>> m_channelsCn0;
-    std::map<int, boost::circular_buffer<double>> m_channelsDoppler;
+    std::set<int> m_staleChannels;  // Restored from the previous session and not updated since.
+    std::set<int> m_dopplerOutliers;  // Last Doppler residual above DopplerResidualModule::OUTLIER_HZ.
+
+    // Samples of one series of a channel as they come out of its decimator.
+    struct History
+    {
+        SeriesDecimator decimator;
+        HistoryWindow window;
+        RingBuffer<double> time;
+        RingBuffer<double> values[2];  // The constellation uses both, the other series the first.
+    };
+    using ChannelHistory = std::array<History, SERIES_COUNT>;
+    std::map<int, ChannelHistory> m_channelsHistory;
+    std::array<SeriesDecimator::Config, SERIES_COUNT> m_decimation;
 
 private:
+    ChannelHistory &addHistory(int channel_id);
+    bool isDue(int column, qint64 now_ms) const;
+    static void record(History &history, double time, double value, double value_q = 0.0);
+    void markChannelChanged(const gnss_sdr::GnssSynchro &old_channel, const gnss_sdr::GnssSynchro &channel);
+
     std::map<std::string, QString> m_mapSignalPrettyName;
+
+    // Per column, indexed like the columns of the table.
+    std::vector<ColumnPolicy> m_columnPolicy;
+    std::vector<bool> m_columnVisible;
+    std::vector<bool> m_columnDirty;
+    std::vector<qint64> m_columnRefreshMs;
+    bool m_rowsChanged = false;
 };
 
 #endif  // GNSS_SDR_MONITOR_CHANNEL_TABLE_MODEL_H_
@@ -32,18 +32,15 @@
 
 
 #include "cn0_delegate.h"
+#include "channel_table_model.h"
 #include <QApplication>
 #include <QDebug>
 #include <QPainter>
-#include <limits>
 
 #define SPARKLINE_MIN_EM_WIDTH 10
 
 Cn0Delegate::Cn0Delegate(QWidget *parent) : QStyledItemDelegate(parent)
 {
-    // Default buffer size.
-    m_bufferSize = 100;
-
     // Default CN0 range.
     m_minCn0 = 20;
     m_maxCn0 = 50;
@@ -56,14 +53,6 @@ Cn0Delegate::~Cn0Delegate()
 {
 }
 
-/*!
- Sets the size of the internal vector that stores the sparkline data.
- */
-void Cn0Delegate::setBufferSize(size_t size)
-{
-    m_bufferSize = size;
-}
-
 /*!
  Sets the manual limits of the vertical axis for rendering the sparkline.
  */
@@ -99,16 +88,18 @@ void Cn0Delegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
         y_data << var.at(i).toPointF().y();
     }
 
-    double min_x = std::numeric_limits<double>::max();
-    double max_x = -std::numeric_limits<double>::max();
+    // Ranges of the time (horizontal axis) and of the CN0 (vertical axis, if auto range is enabled).
+    const QRectF range = index.data(ChannelTableModel::SparklineRangeRole).toRectF();
+    double min_x = range.left();
+    double max_x = range.right();
 
     double min_y = m_minCn0;
     double max_y = m_maxCn0;
 
     if (m_autoRangeEnabled)
     {
-        min_y = std::numeric_limits<double>::max();
-        max_y = -std::numeric_limits<double>::max();
+        min_y = range.top();
+        max_y = range.bottom();
     }
 
     int em_w = option.fontMetrics.height();
@@ -144,45 +135,11 @@ void Cn0Delegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
     QVector<QPointF> fpoints;
     QStyledItemDelegate::paint(painter, option, index);
 
-    if (points.isEmpty() || m_bufferSize < 1.0 || contentHeight <= 0)
+    if (points.isEmpty() || contentHeight <= 0)
     {
         return;
     }
 
-    // Remove first points until the number of elements is within the designated buffer size.
-    while (points.length() > m_bufferSize)
-    {
-        points.removeFirst();
-    }
-
-    foreach (val, points)
-    {
-        // Find the min and max values of the time data (horizontal axis).
-        if (val.x() < min_x)
-        {
-            min_x = val.x();
-        }
-
-        if (val.x() > max_x)
-        {
-            max_x = val.x();
-        }
-
-        // Find the min and max values of the CN0 data (vertical axis) if auto range is enabled.
-        if (m_autoRangeEnabled)
-        {
-            if (val.y() < min_y)
-            {
-                min_y = val.y();
-            }
-
-            if (val.y() > max_y)
-            {
-                max_y = val.y();
-            }
-        }
-    }
-
     // Map the real CN0 data to the sparkline coordinate system.
     foreach (val, points)
     {
@@ -43,7 +43,6 @@ public:
     ~Cn0Delegate();
 
 public slots:
-    void setBufferSize(size_t size);
     void setCn0Range(double min, double max);
     void setAutoRangeEnabled(bool enabled);
 
@@ -56,7 +55,6 @@ protected:
 
 private:
     void drawGuides(QPainter *painter, QRect cellRect, QRect sparklineRect, QRect textRect) const;
-    size_t m_bufferSize;
     double m_minCn0;
     double m_maxCn0;
     bool m_autoRangeEnabled;
@@ -0,0 +1,212 @@
+/*!
+ * \file cn0_elevation_model.cpp
+ * \brief Implementation of a model of the expected CN0 as a function of elevation.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "cn0_elevation_model.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr quint32 SAVE_MAGIC = 0x434E3045;  // "CN0E"
+constexpr quint32 SAVE_VERSION = 1;
+}  // namespace
+
+/*!
+ Packs the system letter and the two character signal code, e.g. "G" and "1C", into a map key
+ without building a string for every observation.
+ */
+uint32_t Cn0ElevationModel::key(const std::string &system, const std::string &signal)
+{
+    uint32_t k = system.empty() ? 0 : static_cast<unsigned char>(system[0]);
+    for (size_t i = 0; i < 2; i++)
+    {
+        k = (k << 8) | (i < signal.size() ? static_cast<unsigned char>(signal[i]) : 0);
+    }
+    return k;
+}
+
+bool Cn0ElevationModel::Curve::expected(double elevation, double &cn0) const
+{
+    // Bins below and above the elevation, by their centres.
+    const double position = elevation / BIN_DEGREES - 0.5;
+    const int below = std::max(0, std::min(BINS - 1, static_cast<int>(std::floor(position))));
+    const int above = std::min(BINS - 1, below + 1);
+    const bool has_below = bins[below].weight >= MIN_WEIGHT;
+    const bool has_above = bins[above].weight >= MIN_WEIGHT;
+
+    if (has_below && has_above)
+    {
+        const double f = std::max(0.0, std::min(1.0, position - below));
+        cn0 = bins[below].mean + f * (bins[above].mean - bins[below].mean);
+        return true;
+    }
+
+    // Only one side learned: use it if the elevation falls in that bin.
+    const int own = std::max(0, std::min(BINS - 1, static_cast<int>(elevation / BIN_DEGREES)));
+    if (bins[own].weight >= MIN_WEIGHT)
+    {
+        cn0 = bins[own].mean;
+        return true;
+    }
+    return false;
+}
+
+bool Cn0ElevationModel::observe(int channel_id, const std::string &system, const std::string &signal,
+    double elevation, double cn0)
+{
+    if (elevation < 0.0 || elevation > 90.0 || !(cn0 > 0.0))
+    {
+        clearChannel(channel_id);
+        return false;
+    }
+
+    Curve &curve = m_curves[key(system, signal)];
+
+    Deviation d;
+    const bool known = curve.expected(elevation, d.expected);
+    if (known)
+    {
+        d.deviation = cn0 - d.expected;
+        d.elevation = elevation;
+        m_channels[channel_id] = d;
+    }
+    else
+    {
+        m_channels.erase(channel_id);
+    }
+
+    Bin &bin = curve.bins[std::min(BINS - 1, static_cast<int>(elevation / BIN_DEGREES))];
+    if (bin.weight < MAX_WEIGHT)
+    {
+        bin.weight += 1.0;
+    }
+    bin.mean += (cn0 - bin.mean) / bin.weight;
+    return known;
+}
+
+bool Cn0ElevationModel::expected(const std::string &system, const std::string &signal, double elevation,
+    double &cn0) const
+{
+    auto it = m_curves.find(key(system, signal));
+    return it != m_curves.end() && it->second.expected(elevation, cn0);
+}
+
+/*!
+ Gets the deviation of channel \a channel_id at its latest observation. Returns false if it has none.
+ */
+bool Cn0ElevationModel::deviation(int channel_id, Deviation &deviation) const
+{
+    auto it = m_channels.find(channel_id);
+    if (it == m_channels.end())
+    {
+        return false;
+    }
+    deviation = it->second;
+    return true;
+}
+
+void Cn0ElevationModel::clearChannel(int channel_id)
+{
+    m_channels.erase(channel_id);
+}
+
+void Cn0ElevationModel::clearChannels()
+{
+    m_channels.clear();
+}
+
+/*!
+ Forgets the learned curves, for example after moving the antenna.
+ */
+void Cn0ElevationModel::clear()
+{
+    m_curves.clear();
+    m_channels.clear();
+}
+
+/*!
+ Serializes the learned curves.
+ */
+QByteArray Cn0ElevationModel::save() const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << SAVE_MAGIC << SAVE_VERSION << static_cast<quint32>(BINS) << static_cast<quint32>(m_curves.size());
+    for (const auto &curve : m_curves)
+    {
+        out << static_cast<quint32>(curve.first);
+        for (const Bin &bin : curve.second.bins)
+        {
+            out << bin.mean << bin.weight;
+        }
+    }
+    return data;
+}
+
+/*!
+ Restores the curves serialized by save(). Returns false, leaving the model empty, if \a data is not valid.
+ */
+bool Cn0ElevationModel::restore(const QByteArray &data)
+{
+    clear();
+
+    QDataStream in(data);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 bins = 0;
+    quint32 count = 0;
+    in >> magic >> version >> bins >> count;
+    if (in.status() != QDataStream::Ok || magic != SAVE_MAGIC || version != SAVE_VERSION || bins != BINS)
+    {
+        return false;
+    }
+
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        quint32 k = 0;
+        in >> k;
+        Curve &curve = m_curves[k];
+        for (Bin &bin : curve.bins)
+        {
+            in >> bin.mean >> bin.weight;
+        }
+    }
+
+    if (in.status() != QDataStream::Ok)
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,103 @@
+/*!
+ * \file cn0_elevation_model.h
+ * \brief Interface of a model of the expected CN0 as a function of elevation.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_CN0_ELEVATION_MODEL_H_
+#define GNSS_SDR_MONITOR_CN0_ELEVATION_MODEL_H_
+
+#include <QByteArray>
+#include <cstdint>
+#include <map>
+#include <string>
+
+/*!
+ Learns the C/N0 that each signal of each system is expected to have at a
+ given elevation, so that the channels can be judged by their deviation from
+ it rather than by their raw C/N0, which mostly reflects the elevation.
+
+ The model keeps one curve per system and signal with a running mean of the
+ C/N0 in 5 degree elevation bins. Each observation updates one bin in
+ constant time; once a bin holds MAX_WEIGHT samples it becomes an exponential
+ moving average, so the curve follows slow changes of the antenna
+ environment. The expected value is interpolated between the centres of the
+ bins around the elevation. The curves can be saved and restored, so they
+ are not learned again at every start.
+ */
+class Cn0ElevationModel
+{
+public:
+    static constexpr int BIN_DEGREES = 5;
+    static constexpr int BINS = 90 / BIN_DEGREES;
+    static constexpr double MIN_WEIGHT = 30.0;   // Samples before a bin is trusted.
+    static constexpr double MAX_WEIGHT = 5000.0;
+
+    struct Deviation
+    {
+        double deviation = 0.0;  // C/N0 - expected, in dB.
+        double expected = 0.0;   // dB-Hz.
+        double elevation = 0.0;  // Degrees.
+    };
+
+    // Updates the curve of the signal with \a cn0 at \a elevation, and stores the deviation of
+    // channel \a channel_id from the curve as it was before the update. Returns false if the
+    // curve cannot predict that elevation yet.
+    bool observe(int channel_id, const std::string &system, const std::string &signal, double elevation, double cn0);
+
+    bool expected(const std::string &system, const std::string &signal, double elevation, double &cn0) const;
+    bool deviation(int channel_id, Deviation &deviation) const;
+
+    void clearChannel(int channel_id);
+    void clearChannels();
+    void clear();
+
+    QByteArray save() const;
+    bool restore(const QByteArray &data);
+
+private:
+    struct Bin
+    {
+        double mean = 0.0;
+        double weight = 0.0;
+    };
+
+    struct Curve
+    {
+        Bin bins[BINS];
+        bool expected(double elevation, double &cn0) const;
+    };
+
+    static uint32_t key(const std::string &system, const std::string &signal);
+
+    std::map<uint32_t, Curve> m_curves;
+    std::map<int, Deviation> m_channels;
+};
+
+#endif  // GNSS_SDR_MONITOR_CN0_ELEVATION_MODEL_H_
@@ -0,0 +1,297 @@
+/*!
+ * \file cn0_estimator.cpp
+ * \brief Implementation of the C/N0 estimators computed from the prompt correlator outputs.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "cn0_estimator.h"
+#include <QString>
+#include <algorithm>
+#include <cmath>
+
+void SlidingSum::setLength(int length)
+{
+    m_values.assign(static_cast<size_t>(std::max(1, length)), 0.0);
+    reset();
+}
+
+/*!
+ Adds \a value to the window, dropping the oldest one once it is full.
+ */
+void SlidingSum::push(double value)
+{
+    const int length = static_cast<int>(m_values.size());
+    if (m_count == length)
+    {
+        m_sum -= m_values[m_head];
+    }
+    else
+    {
+        m_count++;
+    }
+    m_values[m_head] = value;
+    m_sum += value;
+    m_head = (m_head + 1) % length;
+
+    if (++m_pushesSinceSum >= length)
+    {
+        m_pushesSinceSum = 0;
+        m_sum = 0.0;
+        for (int i = 0; i < m_count; i++)
+        {
+            m_sum += m_values[i];
+        }
+    }
+}
+
+void SlidingSum::reset()
+{
+    std::fill(m_values.begin(), m_values.end(), 0.0);
+    m_head = 0;
+    m_count = 0;
+    m_pushesSinceSum = 0;
+    m_sum = 0.0;
+}
+
+
+Cn0Estimator::Cn0Estimator(int window, int block, int blocks)
+    : m_power(window), m_power2(window), m_nwpr(blocks), m_block(std::max(2, block))
+{
+}
+
+/*!
+ Adds the prompt correlator output \a prompt_i, \a prompt_q of one integration period.
+ */
+void Cn0Estimator::push(double prompt_i, double prompt_q)
+{
+    const double power = prompt_i * prompt_i + prompt_q * prompt_q;
+    m_power.push(power);
+    m_power2.push(power * power);
+
+    // Wipe off the data bit with the sign of the sample against the coherent sum of the block so far, which
+    // follows the bit whatever the carrier phase. The first sample of a block sets its orientation.
+    const double sign = m_blockI * prompt_i + m_blockQ * prompt_q < 0.0 ? -1.0 : 1.0;
+    m_blockI += sign * prompt_i;
+    m_blockQ += sign * prompt_q;
+    m_blockPower += power;
+    if (++m_blockCount == m_block)
+    {
+        if (m_blockPower > 0.0)
+        {
+            m_nwpr.push((m_blockI * m_blockI + m_blockQ * m_blockQ) / m_blockPower);
+        }
+        m_blockCount = 0;
+        m_blockI = 0.0;
+        m_blockQ = 0.0;
+        m_blockPower = 0.0;
+    }
+}
+
+void Cn0Estimator::reset()
+{
+    m_power.reset();
+    m_power2.reset();
+    m_nwpr.reset();
+    m_blockCount = 0;
+    m_blockI = 0.0;
+    m_blockQ = 0.0;
+    m_blockPower = 0.0;
+}
+
+/*!
+ Estimates the C/N0 from the moments of the power of the last samples, each integrated over
+ \a integration_s. With M2 and M4 the mean power and mean squared power, the signal power is
+ sqrt(2 M2² - M4) and the noise power the rest of M2.
+ */
+bool Cn0Estimator::m2m4(double integration_s, double &cn0_db_hz) const
+{
+    if (!m_power.full() || integration_s <= 0.0)
+    {
+        return false;
+    }
+
+    const double m2 = m_power.mean();
+    const double m4 = m_power2.mean();
+    const double signal2 = 2.0 * m2 * m2 - m4;
+    if (signal2 <= 0.0)
+    {
+        return false;
+    }
+    const double signal = std::sqrt(signal2);
+    const double noise = m2 - signal;
+    if (noise <= 0.0)
+    {
+        return false;
+    }
+
+    cn0_db_hz = 10.0 * std::log10(signal / (noise * integration_s));
+    return true;
+}
+
+/*!
+ Estimates the C/N0 from the mean ratio mu of the narrowband to the wideband power of the last
+ blocks of M samples, each integrated over \a integration_s: the SNR of a sample is (mu - 1) / (M - mu).
+ Returns false below NWPR_MIN_DB_HZ, where the bit decisions bias the estimate upwards.
+ */
+bool Cn0Estimator::nwpr(double integration_s, double &cn0_db_hz) const
+{
+    if (!m_nwpr.full() || integration_s <= 0.0)
+    {
+        return false;
+    }
+
+    const double mu = m_nwpr.mean();
+    if (mu <= 1.0 || mu >= m_block)
+    {
+        return false;
+    }
+
+    const double estimate = 10.0 * std::log10((mu - 1.0) / ((m_block - mu) * integration_s));
+    if (estimate < NWPR_MIN_DB_HZ)
+    {
+        return false;
+    }
+    cn0_db_hz = estimate;
+    return true;
+}
+
+
+/*!
+ Updates the estimates of the channels tracked in \a epoch and checks them against the reported C/N0.
+ */
+void Cn0EstimatorModule::process(const AnalyticsEpoch &epoch)
+{
+    for (int i = 0; i < epoch.observables.observable_size(); i++)
+    {
+        const gnss_sdr::GnssSynchro &observable = epoch.observables.observable(i);
+        if (observable.fs() == 0)
+        {
+            continue;
+        }
+
+        Channel &channel = m_channels[observable.channel_id()];
+        Estimate &estimate = channel.estimate;
+        if (estimate.prn != observable.prn() || estimate.system != observable.system())
+        {
+            // Another satellite in the channel.
+            channel = Channel();
+            estimate.system = observable.system();
+            estimate.prn = observable.prn();
+        }
+        if (!observable.flag_valid_symbol_output())
+        {
+            continue;
+        }
+
+        const int length_ms = observable.correlation_length_ms() > 0 ? observable.correlation_length_ms() : 1;
+        channel.estimator.push(observable.prompt_i(), observable.prompt_q());
+        estimate.reported = observable.cn0_db_hz();
+        estimate.hasM2m4 = channel.estimator.m2m4(length_ms / 1000.0, estimate.m2m4);
+        estimate.hasNwpr = channel.estimator.nwpr(length_ms / 1000.0, estimate.nwpr);
+
+        // Half the threshold to end a divergence, so that it does not flap around the threshold.
+        const double limit = estimate.diverging ? DIVERGENCE_DB / 2.0 : DIVERGENCE_DB;
+        // Only formatted for the events, not for every channel of every epoch.
+        auto satellite = [&estimate, &observable] {
+            return QString("%1%2 (channel %3)")
+                .arg(QString::fromStdString(estimate.system))
+                .arg(estimate.prn, 2, 10, QChar('0'))
+                .arg(observable.channel_id());
+        };
+        if (!estimate.hasM2m4 || std::abs(estimate.divergence()) <= limit)
+        {
+            if (estimate.diverging && estimate.hasM2m4)
+            {
+                MonitorEvent event;
+                event.severity = MonitorEvent::Severity::Info;
+                event.message = QString("%1: reported C/N0 agrees again with the prompt I/Q").arg(satellite());
+                event.value = estimate.divergence();
+                m_pendingEvents.push_back(event);
+            }
+            estimate.diverging = false;
+            channel.divergingSinceMs = -1;
+            continue;
+        }
+
+        if (channel.divergingSinceMs < 0)
+        {
+            channel.divergingSinceMs = epoch.timeMs;
+        }
+        if (!estimate.diverging && epoch.timeMs - channel.divergingSinceMs >= DIVERGENCE_HOLD_MS)
+        {
+            estimate.diverging = true;
+            MonitorEvent event;
+            event.severity = MonitorEvent::Severity::Alert;
+            event.message = QString("%1: reported C/N0 %2 dB-Hz, %3 dB-Hz from the prompt I/Q")
+                                .arg(satellite())
+                                .arg(estimate.reported, 0, 'f', 1)
+                                .arg(estimate.m2m4, 0, 'f', 1);
+            event.value = estimate.divergence();
+            m_pendingEvents.push_back(event);
+        }
+    }
+}
+
+/*!
+ Makes the estimates of the last epoch available to estimate() and logs the divergences found in it.
+ */
+void Cn0EstimatorModule::publish()
+{
+    for (const auto &channel : m_channels)
+    {
+        m_published[channel.first] = channel.second.estimate;
+    }
+
+    for (const MonitorEvent &event : m_pendingEvents)
+    {
+        if (m_log)
+        {
+            m_log->add(event.severity, "C/N0 check", event.message, event.value);
+        }
+    }
+    m_pendingEvents.clear();
+}
+
+void Cn0EstimatorModule::reset()
+{
+    m_channels.clear();
+    m_pendingEvents.clear();
+    m_published.clear();
+}
+
+bool Cn0EstimatorModule::estimate(int channel_id, Estimate &estimate) const
+{
+    auto it = m_published.find(channel_id);
+    if (it == m_published.end())
+    {
+        return false;
+    }
+    estimate = it->second;
+    return true;
+}
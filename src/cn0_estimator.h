@@ -0,0 +1,172 @@
+/*!
+ * \file cn0_estimator.h
+ * \brief Interface of the C/N0 estimators computed from the prompt correlator outputs.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_CN0_ESTIMATOR_H_
+#define GNSS_SDR_MONITOR_CN0_ESTIMATOR_H_
+
+#include "analytics_host.h"
+#include "event_log.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ Sum of the last values pushed, updated in constant time. The sum is
+ recomputed from the stored values once per window length, so that the
+ rounding of the running updates does not accumulate.
+ */
+class SlidingSum
+{
+public:
+    explicit SlidingSum(int length = 1) { setLength(length); }
+
+    void setLength(int length);
+    void push(double value);
+    void reset();
+
+    bool full() const { return m_count == static_cast<int>(m_values.size()); }
+    int count() const { return m_count; }
+    double sum() const { return m_sum; }
+    double mean() const { return m_count > 0 ? m_sum / m_count : 0.0; }
+
+private:
+    std::vector<double> m_values;
+    int m_head = 0;
+    int m_count = 0;
+    int m_pushesSinceSum = 0;
+    double m_sum = 0.0;
+};
+
+/*!
+ Carrier-to-noise density of one channel estimated from its prompt I/Q
+ samples alone, with two estimators over sliding windows:
+
+ - M2M4, from the second and fourth moments of the sample power. It does
+   not depend on the carrier phase or the data bits.
+ - NWPR, from the ratio of the narrowband to the wideband power over
+   blocks of samples, averaged over the last blocks. The data bits are
+   wiped off against the coherent sum of each block, so the carrier phase
+   does not matter. Wrong bit decisions make the narrowband power grow with
+   the noise, so that the estimate levels off at about 27 dB-Hz with the
+   default blocks of 1 ms samples; it is not reported below NWPR_MIN_DB_HZ.
+
+ Both take the coherent integration time of each sample to scale the
+ per-sample SNR to a density.
+ */
+class Cn0Estimator
+{
+public:
+    static constexpr int DEFAULT_WINDOW = 100;  // Samples of M2M4.
+    static constexpr int DEFAULT_BLOCK = 10;    // Samples per NWPR block.
+    static constexpr int DEFAULT_BLOCKS = 10;   // NWPR blocks averaged.
+
+    // Lowest NWPR estimate reported. Above it, the bias of the bit decisions is under 0.3 dB.
+    static constexpr double NWPR_MIN_DB_HZ = 32.0;
+
+    explicit Cn0Estimator(int window = DEFAULT_WINDOW, int block = DEFAULT_BLOCK, int blocks = DEFAULT_BLOCKS);
+
+    void push(double prompt_i, double prompt_q);
+    void reset();
+
+    // False until the window is full or if the samples look like noise only.
+    bool m2m4(double integration_s, double &cn0_db_hz) const;
+    bool nwpr(double integration_s, double &cn0_db_hz) const;
+
+private:
+    SlidingSum m_power;    // I² + Q²
+    SlidingSum m_power2;   // (I² + Q²)²
+    SlidingSum m_nwpr;     // Narrowband over wideband power of each block.
+    int m_block;
+    int m_blockCount = 0;
+    double m_blockI = 0.0;
+    double m_blockQ = 0.0;
+    double m_blockPower = 0.0;
+};
+
+/*!
+ Analytics module that estimates the C/N0 of every tracked channel from its
+ prompt I/Q and compares it with the C/N0 reported by the receiver.
+
+ A channel whose reported C/N0 stays more than DIVERGENCE_DB away from the
+ M2M4 estimate for DIVERGENCE_HOLD_MS raises an alert, as the reported value
+ is not to be trusted then, e.g. under interference. It is logged again once
+ both agree. The NWPR estimate is only shown, it never raises alerts.
+ */
+class Cn0EstimatorModule : public AnalyticsModule
+{
+public:
+    static constexpr double DIVERGENCE_DB = 3.0;
+    static constexpr qint64 DIVERGENCE_HOLD_MS = 5000;
+
+    struct Estimate
+    {
+        std::string system;
+        unsigned int prn = 0;
+        double reported = 0.0;  // [dB-Hz]
+        bool hasM2m4 = false;
+        double m2m4 = 0.0;      // [dB-Hz]
+        bool hasNwpr = false;
+        double nwpr = 0.0;      // [dB-Hz]
+        bool diverging = false;
+
+        // Reported minus M2M4 [dB]
+        double divergence() const { return reported - m2m4; }
+    };
+
+    explicit Cn0EstimatorModule(EventLog *log = nullptr) : m_log(log) {}
+
+    QString name() const override { return "C/N0 from prompt I/Q"; }
+    void process(const AnalyticsEpoch &epoch) override;
+    void publish() override;
+    void reset() override;
+
+    // Latest estimate of channel \a channel_id, on the GUI thread.
+    bool estimate(int channel_id, Estimate &estimate) const;
+
+private:
+    struct Channel
+    {
+        Cn0Estimator estimator;
+        Estimate estimate;
+        qint64 divergingSinceMs = -1;
+    };
+
+    // Written by process() only.
+    std::map<int, Channel> m_channels;
+    std::vector<MonitorEvent> m_pendingEvents;
+
+    // Read on the GUI thread, filled by publish().
+    std::map<int, Estimate> m_published;
+    EventLog *m_log;
+};
+
+#endif  // GNSS_SDR_MONITOR_CN0_ESTIMATOR_H_
@@ -0,0 +1,127 @@
+/*!
+ * \file crc32c.cpp
+ * \brief CRC-32C checksum of the recording blocks.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "crc32c.h"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define GNSS_SDR_MONITOR_CRC32C_SSE42
+#endif
+
+namespace
+{
+constexpr uint32_t POLYNOMIAL = 0x82F63B78;  // Castagnoli, bit-reversed.
+
+// Slicing-by-8 tables: table[k][b] is the CRC of byte b followed by k zero bytes.
+struct Tables
+{
+    uint32_t table[8][256];
+
+    Tables()
+    {
+        for (uint32_t b = 0; b < 256; b++)
+        {
+            uint32_t crc = b;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+            }
+            table[0][b] = crc;
+        }
+        for (int k = 1; k < 8; k++)
+        {
+            for (uint32_t b = 0; b < 256; b++)
+            {
+                table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+            }
+        }
+    }
+};
+
+uint32_t crc32cSoftware(const unsigned char *p, size_t size, uint32_t crc)
+{
+    static const Tables tables;
+    const uint32_t(&t)[8][256] = tables.table;
+
+    for (; size >= 8; p += 8, size -= 8)
+    {
+        crc ^= static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+               static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+        crc = t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF] ^ t[5][(crc >> 16) & 0xFF] ^ t[4][crc >> 24] ^
+              t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    }
+    for (; size > 0; p++, size--)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+    }
+    return crc;
+}
+
+#ifdef GNSS_SDR_MONITOR_CRC32C_SSE42
+__attribute__((target("sse4.2"))) uint32_t crc32cHardware(const unsigned char *p, size_t size, uint32_t crc)
+{
+    uint64_t crc64 = crc;
+    for (; size >= 8; p += 8, size -= 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+
+    crc = static_cast<uint32_t>(crc64);
+    for (; size > 0; p++, size--)
+    {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+    return crc;
+}
+
+bool hasSse42()
+{
+    static const bool has = __builtin_cpu_supports("sse4.2");
+    return has;
+}
+#endif
+}  // namespace
+
+uint32_t crc32c(const char *data, size_t size, uint32_t crc)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+#ifdef GNSS_SDR_MONITOR_CRC32C_SSE42
+    if (hasSse42())
+    {
+        return ~crc32cHardware(p, size, ~crc);
+    }
+#endif
+    return ~crc32cSoftware(p, size, ~crc);
+}
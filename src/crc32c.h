@@ -0,0 +1,43 @@
+/*!
+ * \file crc32c.h
+ * \brief CRC-32C checksum of the recording blocks.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_CRC32C_H_
+#define GNSS_SDR_MONITOR_CRC32C_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32C (Castagnoli) of \a size bytes at \a data, continuing from the checksum \a crc of the bytes
+// before them. Uses the SSE4.2 crc32 instruction when the CPU has it.
+uint32_t crc32c(const char *data, size_t size, uint32_t crc = 0);
+
+#endif  // GNSS_SDR_MONITOR_CRC32C_H_
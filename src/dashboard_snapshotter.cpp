@@ -0,0 +1,244 @@
+/*!
+ * \file dashboard_snapshotter.cpp
+ * \brief Implementation of a class that periodically renders views of the
+ * monitor to image files for dashboards.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "dashboard_snapshotter.h"
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QImage>
+#include <QImageWriter>
+#include <QRunnable>
+#include <QSaveFile>
+#include <algorithm>
+
+namespace
+{
+/*!
+ Encodes the images of one snapshot and replaces their files, off the GUI thread.
+ */
+class SnapshotWriter : public QRunnable
+{
+public:
+    SnapshotWriter(std::vector<std::pair<QString, QImage>> images, const QByteArray &format,
+        std::atomic<bool> &busy, std::atomic<quint64> &written)
+        : m_images(std::move(images)), m_format(format), m_busy(busy), m_written(written)
+    {
+    }
+
+    void run() override
+    {
+        for (const auto &image : m_images)
+        {
+            // QSaveFile writes to a temporary file and renames it over the old one on commit.
+            QSaveFile file(image.first);
+            if (!file.open(QIODevice::WriteOnly))
+            {
+                qDebug() << "Cannot write snapshot" << image.first << file.errorString();
+                continue;
+            }
+
+            QImageWriter writer(&file, m_format);
+            if (!writer.write(image.second))
+            {
+                qDebug() << "Cannot encode snapshot" << image.first << writer.errorString();
+                file.cancelWriting();
+            }
+
+            if (file.commit())
+            {
+                m_written++;
+            }
+        }
+        m_busy = false;
+    }
+
+private:
+    std::vector<std::pair<QString, QImage>> m_images;
+    QByteArray m_format;
+    std::atomic<bool> &m_busy;
+    std::atomic<quint64> &m_written;
+};
+}  // namespace
+
+/*!
+ Adds the command line options of the snapshots to \a parser.
+ */
+void DashboardSnapshotter::addOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"headless", "Run without showing the main window. Use with --snapshot-dir, "
+                                  "and -platform offscreen without a display."});
+    parser.addOption({"snapshot-dir", "Render the views to image files in this directory.", "dir"});
+    parser.addOption({"snapshot-interval", "Time between snapshots.", "seconds", "1"});
+    parser.addOption({"snapshot-format", "Image format of the snapshots, png or webp.", "format", "png"});
+    parser.addOption({"snapshot-views", "Views to render.", "list", "channels,skyplot,dop,altitude"});
+}
+
+DashboardSnapshotter::DashboardSnapshotter(QObject *parent)
+    : QObject(parent), m_format("png"), m_busy(false), m_written(0), m_skipped(0)
+{
+    // A single worker keeps the snapshots in order and bounds the work in flight to one.
+    m_pool.setMaxThreadCount(1);
+
+    m_timer.setInterval(1000);
+    m_timer.setSingleShot(false);
+    connect(&m_timer, &ClockTimer::timeout, this, &DashboardSnapshotter::capture);
+}
+
+DashboardSnapshotter::~DashboardSnapshotter()
+{
+    m_timer.stop();
+    m_pool.waitForDone();
+}
+
+/*!
+ Sets up the snapshots from the options in \a parser, picking the requested views among \a available.
+ Returns false and sets the error string if an option is invalid.
+ */
+bool DashboardSnapshotter::configure(const QCommandLineParser &parser, const Views &available)
+{
+    if (!setDirectory(parser.value("snapshot-dir")) || !setFormat(parser.value("snapshot-format").toLatin1()))
+    {
+        return false;
+    }
+
+    const double seconds = parser.value("snapshot-interval").toDouble();
+    if (seconds <= 0.0)
+    {
+        m_error = "invalid snapshot interval " + parser.value("snapshot-interval");
+        return false;
+    }
+    setInterval(static_cast<int>(seconds * 1000.0));
+
+    Views views;
+    for (const QString &name : parser.value("snapshot-views").split(',', QString::SkipEmptyParts))
+    {
+        auto it = std::find_if(available.begin(), available.end(),
+            [&name](const std::pair<QString, QWidget *> &view) { return view.first == name.trimmed(); });
+        if (it == available.end())
+        {
+            m_error = "unknown view " + name;
+            return false;
+        }
+        views.push_back(*it);
+    }
+    setViews(views);
+    return true;
+}
+
+void DashboardSnapshotter::setViews(const Views &views)
+{
+    m_views.clear();
+    for (const auto &view : views)
+    {
+        m_views.emplace_back(view.first, view.second);
+    }
+}
+
+bool DashboardSnapshotter::setDirectory(const QString &directory)
+{
+    if (directory.isEmpty() || !QDir().mkpath(directory))
+    {
+        m_error = "cannot create the snapshot directory " + directory;
+        return false;
+    }
+    m_directory = directory;
+    return true;
+}
+
+/*!
+ Sets the image format of the snapshots. WebP needs the Qt image formats plugin.
+ */
+bool DashboardSnapshotter::setFormat(const QByteArray &format)
+{
+    if (!QImageWriter::supportedImageFormats().contains(format.toLower()))
+    {
+        m_error = "unsupported snapshot format " + QString::fromLatin1(format);
+        return false;
+    }
+    m_format = format.toLower();
+    return true;
+}
+
+void DashboardSnapshotter::start()
+{
+    m_timer.start();
+}
+
+void DashboardSnapshotter::stop()
+{
+    m_timer.stop();
+}
+
+/*!
+ Renders every view into an image and hands them to the worker thread to be written.
+ Skipped if the previous snapshot is still being written.
+ */
+void DashboardSnapshotter::capture()
+{
+    if (m_views.empty() || m_directory.isEmpty())
+    {
+        return;
+    }
+
+    if (m_busy.exchange(true))
+    {
+        m_skipped++;
+        return;
+    }
+
+    const QDir directory(m_directory);
+    std::vector<std::pair<QString, QImage>> images;
+    images.reserve(m_views.size());
+
+    for (const auto &view : m_views)
+    {
+        QWidget *widget = view.second;
+        if (!widget || widget->size().isEmpty())
+        {
+            continue;
+        }
+
+        QImage image(widget->size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(widget->palette().color(QPalette::Window));
+        widget->render(&image);
+        images.emplace_back(directory.filePath(view.first + "." + QString::fromLatin1(m_format)), std::move(image));
+    }
+
+    if (images.empty())
+    {
+        m_busy = false;
+        return;
+    }
+
+    m_pool.start(new SnapshotWriter(std::move(images), m_format, m_busy, m_written));
+}
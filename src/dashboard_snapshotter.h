@@ -0,0 +1,106 @@
+/*!
+ * \file dashboard_snapshotter.h
+ * \brief Interface of a class that periodically renders views of the monitor
+ * to image files for dashboards.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_DASHBOARD_SNAPSHOTTER_H_
+#define GNSS_SDR_MONITOR_DASHBOARD_SNAPSHOTTER_H_
+
+#include "monitor_clock.h"
+#include <QByteArray>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QThreadPool>
+#include <QWidget>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+class QCommandLineParser;
+
+/*!
+ Renders views of the monitor into images every interval and writes them to
+ a directory, one file per view (e.g. skyplot.png), for a wall display or a
+ web portal to pick up.
+
+ The views paint themselves with QPainter on a QImage through
+ QWidget::render(), the same code path as on screen, so their cached layers
+ and decimated series are reused and no window is needed. That part has to
+ run on the GUI thread; encoding and writing, which take most of the time,
+ run on a worker thread. Each file is replaced atomically, so readers never
+ see a partial image. When the worker is still busy with the previous
+ snapshot the next one is skipped instead of queued.
+ */
+class DashboardSnapshotter : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Views = std::vector<std::pair<QString, QWidget *>>;
+
+    static void addOptions(QCommandLineParser &parser);
+
+    explicit DashboardSnapshotter(QObject *parent = nullptr);
+    ~DashboardSnapshotter();
+
+    // Reads the directory, interval, format and views from a parser that has processed the command line.
+    bool configure(const QCommandLineParser &parser, const Views &available);
+
+    void setClock(MonitorClock *clock) { m_timer.setClock(clock); }
+    void setViews(const Views &views);
+    bool setDirectory(const QString &directory);
+    bool setFormat(const QByteArray &format);
+    void setInterval(int milliseconds) { m_timer.setInterval(milliseconds); }
+
+    QString errorString() const { return m_error; }
+    quint64 written() const { return m_written; }
+    quint64 skipped() const { return m_skipped; }
+
+public slots:
+    void start();
+    void stop();
+    void capture();
+
+private:
+    std::vector<std::pair<QString, QPointer<QWidget>>> m_views;
+    QString m_directory;
+    QByteArray m_format;
+    QString m_error;
+
+    ClockTimer m_timer;
+    QThreadPool m_pool;
+    std::atomic<bool> m_busy;
+    std::atomic<quint64> m_written;
+    quint64 m_skipped;
+};
+
+#endif  // GNSS_SDR_MONITOR_DASHBOARD_SNAPSHOTTER_H_
@@ -41,20 +41,13 @@
  */
 DOPWidget::DOPWidget(QWidget *parent) : QWidget(parent)
 {
-    // Default buffer size.
-    m_bufferSize = 100;
+    m_gdopBuffer.setCapacity(m_window.capacity());
 
-    m_gdopBuffer.resize(m_bufferSize);
-    m_gdopBuffer.clear();
+    m_pdopBuffer.setCapacity(m_window.capacity());
 
-    m_pdopBuffer.resize(m_bufferSize);
-    m_pdopBuffer.clear();
+    m_hdopBuffer.setCapacity(m_window.capacity());
 
-    m_hdopBuffer.resize(m_bufferSize);
-    m_hdopBuffer.clear();
-
-    m_vdopBuffer.resize(m_bufferSize);
-    m_vdopBuffer.clear();
+    m_vdopBuffer.setCapacity(m_window.capacity());
 
     m_gdopSeries = new QtCharts::QLineSeries();
     m_gdopSeries->setName("GDOP");
@@ -101,6 +94,13 @@ DOPWidget::DOPWidget(QWidget *parent) : QWidget(parent)
  */
 void DOPWidget::addData(qreal tow, qreal gdop, qreal pdop, qreal hdop, qreal vdop)
 {
+    if (m_window.observe(tow))
+    {
+        m_gdopBuffer.setCapacity(m_window.capacity());
+        m_pdopBuffer.setCapacity(m_window.capacity());
+        m_hdopBuffer.setCapacity(m_window.capacity());
+        m_vdopBuffer.setCapacity(m_window.capacity());
+    }
     m_gdopBuffer.push_back(QPointF(tow, gdop));
     m_pdopBuffer.push_back(QPointF(tow, pdop));
     m_hdopBuffer.push_back(QPointF(tow, hdop));
@@ -112,6 +112,13 @@ void DOPWidget::addData(qreal tow, qreal gdop, qreal pdop, qreal hdop, qreal vdo
  */
 void DOPWidget::redraw()
 {
+    // All four buffers are fed together, so one generation tracks them all.
+    if (m_gdopBuffer.generation() == m_drawnGeneration)
+    {
+        return;
+    }
+    m_drawnGeneration = m_gdopBuffer.generation();
+
     populateSeries(m_gdopBuffer, m_gdopSeries);
     populateSeries(m_pdopBuffer, m_pdopSeries);
     populateSeries(m_hdopBuffer, m_hdopSeries);
@@ -127,6 +134,7 @@ void DOPWidget::clear()
     m_pdopBuffer.clear();
     m_hdopBuffer.clear();
     m_vdopBuffer.clear();
+    m_window.reset();
 
     m_gdopSeries->clear();
     m_pdopSeries->clear();
@@ -135,52 +143,43 @@ void DOPWidget::clear()
 }
 
 /*!
- Sets the size of the internal circular buffers that store the widget's data.
+ Shows the DOP of the last \a seconds. The circular buffers are sized from the rate of the PVT.
  */
-void DOPWidget::setBufferSize(size_t size)
+void DOPWidget::setHistoryWindow(double seconds)
 {
-    m_bufferSize = size;
-
-    m_gdopBuffer.resize(m_bufferSize);
-    m_pdopBuffer.resize(m_bufferSize);
-    m_hdopBuffer.resize(m_bufferSize);
-    m_vdopBuffer.resize(m_bufferSize);
+    m_window.setSeconds(seconds);
+
+    m_gdopBuffer.setCapacity(m_window.capacity());
+    m_pdopBuffer.setCapacity(m_window.capacity());
+    m_hdopBuffer.setCapacity(m_window.capacity());
+    m_vdopBuffer.setCapacity(m_window.capacity());
+    m_drawnGeneration = 0;
+    redraw();
 }
 
 /*!
  Replaces the old data in the \a series object with the new data from the \a buffer, casuing the chart to repaint.
  */
-void DOPWidget::populateSeries(boost::circular_buffer<QPointF> buffer, QtCharts::QLineSeries *series)
+void DOPWidget::populateSeries(const RingBuffer<QPointF> &buffer, QtCharts::QLineSeries *series)
 {
     if (!buffer.empty())
     {
-        double min_x = std::numeric_limits<double>::max();
-        double max_x = -std::numeric_limits<double>::max();
-
-        /*
-        double min_y = std::numeric_limits<double>::max();
-        double max_y = -std::numeric_limits<double>::max();
-        */
-
         QtCharts::QChart *chart = m_chartView->chart();
-        QPointF p;
+        // Only the points within the history window, like every other chart.
+        const size_t first = ringLowerBound(buffer, buffer.back().x() - m_window.seconds(),
+            [](const QPointF &point) { return point.x(); });
         QVector<QPointF> vec;
+        vec.reserve(static_cast<int>(buffer.size() - first));
+        buffer.forEach(first, buffer.size() - first, [&vec](const QPointF &point) { vec.push_back(point); });
 
-        for (size_t i = 0; i < buffer.size(); i++)
-        {
-            p = buffer.at(i);
-            vec << p;
-
-            min_x = std::min(min_x, p.x());
-            min_y = std::min(min_y, p.y());
+        std::pair<RingRange, RingRange> range = ringMinMaxXY(buffer, first, buffer.size() - first);
 
-            max_x = std::max(max_x, p.x());
-            max_y = std::max(max_y, p.y());
-        }
+        min_y = std::min(min_y, range.second.min);
+        max_y = std::max(max_y, range.second.max);
 
         series->replace(vec);
 
-        chart->axes(Qt::Horizontal).back()->setRange(min_x, max_x);
+        chart->axes(Qt::Horizontal).back()->setRange(range.first.max - m_window.seconds(), range.first.max);
         chart->axes(Qt::Vertical).back()->setRange(min_y, max_y);
     }
 }
@@ -34,7 +34,8 @@
 #ifndef GNSS_SDR_MONITOR_DOP_WIDGET_H_
 #define GNSS_SDR_MONITOR_DOP_WIDGET_H_
 
-#include <boost/circular_buffer.hpp>
+#include "history_window.h"
+#include "ring_buffer.h"
 #include <QChartView>
 #include <QLineSeries>
 #include <QWidget>
@@ -50,17 +51,18 @@ public slots:
     void addData(qreal tow, qreal gdop, qreal pdop, qreal hdop, qreal vdop);
     void redraw();
     void clear();
-    void setBufferSize(size_t size);
+    void setHistoryWindow(double seconds);
 
 private:
-    void populateSeries(boost::circular_buffer<QPointF> queue, QtCharts::QLineSeries *series);
+    void populateSeries(const RingBuffer<QPointF> &buffer, QtCharts::QLineSeries *series);
 
-    size_t m_bufferSize;
+    HistoryWindow m_window;
 
-    boost::circular_buffer<QPointF> m_gdopBuffer;
-    boost::circular_buffer<QPointF> m_pdopBuffer;
-    boost::circular_buffer<QPointF> m_hdopBuffer;
-    boost::circular_buffer<QPointF> m_vdopBuffer;
+    RingBuffer<QPointF> m_gdopBuffer;
+    RingBuffer<QPointF> m_pdopBuffer;
+    RingBuffer<QPointF> m_hdopBuffer;
+    RingBuffer<QPointF> m_vdopBuffer;
+    uint64_t m_drawnGeneration = 0;
 
     QtCharts::QChartView *m_chartView = nullptr;
 
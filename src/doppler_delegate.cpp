@@ -32,28 +32,21 @@
 
 
 #include "doppler_delegate.h"
+#include "channel_table_model.h"
 #include <QApplication>
 #include <QDebug>
 #include <QPainter>
-#include <limits>
 
 #define SPARKLINE_MIN_EM_WIDTH 10
 
 DopplerDelegate::DopplerDelegate(QWidget *parent) : QStyledItemDelegate(parent)
 {
-    // Default buffer size.
-    m_bufferSize = 100;
 }
 
 DopplerDelegate::~DopplerDelegate()
 {
 }
 
-void DopplerDelegate::setBufferSize(int size)
-{
-    m_bufferSize = size;
-}
-
 void DopplerDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
     const QModelIndex &index) const
 {
@@ -67,11 +60,12 @@ void DopplerDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
         y_data << var.at(i).toPointF().y();
     }
 
-    double min_x = std::numeric_limits<double>::max();
-    double max_x = -std::numeric_limits<double>::max();
+    const QRectF range = index.data(ChannelTableModel::SparklineRangeRole).toRectF();
+    double min_x = range.left();
+    double max_x = range.right();
 
-    double min_y = std::numeric_limits<double>::max();
-    double max_y = -std::numeric_limits<double>::max();
+    double min_y = range.top();
+    double max_y = range.bottom();
 
     int em_w = option.fontMetrics.height();
 
@@ -106,39 +100,11 @@ void DopplerDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     QVector<QPointF> fpoints;
     QStyledItemDelegate::paint(painter, option, index);
 
-    if (points.isEmpty() || m_bufferSize < 1.0 || contentHeight <= 0)
+    if (points.isEmpty() || contentHeight <= 0)
     {
         return;
     }
 
-    while (points.length() > m_bufferSize)
-    {
-        points.removeFirst();
-    }
-
-    foreach (val, points)
-    {
-        if (val.x() < min_x)
-        {
-            min_x = val.x();
-        }
-
-        if (val.x() > max_x)
-        {
-            max_x = val.x();
-        }
-
-        if (val.y() < min_y)
-        {
-            min_y = val.y();
-        }
-
-        if (val.y() > max_y)
-        {
-            max_y = val.y();
-        }
-    }
-
     foreach (val, points)
     {
         double x = sparklineWidth * (val.x() - min_x) / (max_x - min_x);
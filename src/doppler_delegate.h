@@ -43,7 +43,6 @@ public:
     ~DopplerDelegate();
 
 public slots:
-    void setBufferSize(int size);
 
 protected:
     void paint(QPainter *painter, const QStyleOptionViewItem &option,
@@ -55,7 +54,6 @@ protected:
 private:
     void drawGuides(QPainter *painter, QRect cellRect, QRect sparklineRect, QRect textRect) const;
 
-    int m_bufferSize;
 };
 
 #endif  // GNSS_SDR_MONITOR_DOPPLER_DELEGATE_H_
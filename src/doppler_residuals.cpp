@@ -0,0 +1,337 @@
+/*!
+ * \file doppler_residuals.cpp
+ * \brief Implementation of the Doppler residual monitor and receiver clock drift estimator.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "doppler_residuals.h"
+#include "gnss_time.h"
+#include <QString>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr double SPEED_OF_LIGHT = 299792458.0;  // [m/s]
+constexpr double NOMINAL_TRAVEL_TIME = 0.075;   // Used until the pseudorange is valid [s]
+constexpr double HALF_WEEK = GnssTime::SECONDS_PER_WEEK / 2.0;
+}  // namespace
+
+/*!
+ Returns the carrier frequency of \a signal, as named in the GnssSynchro messages. The GLONASS
+ signals need the FDMA \a frequency_channel of the satellite.
+ */
+double DopplerResidualModule::carrierFrequency(const std::string &signal, int frequency_channel)
+{
+    if (signal == "1C" || signal == "1B") return 1575.42e6;
+    if (signal == "2S") return 1227.60e6;
+    if (signal == "L5" || signal == "5X") return 1176.45e6;
+    if (signal == "7X") return 1207.14e6;
+    if (signal == "E6") return 1278.75e6;
+    if (signal == "B1") return 1561.098e6;
+    if (signal == "B3") return 1268.52e6;
+    if (signal == "1G") return 1602.0e6 + frequency_channel * 0.5625e6;
+    if (signal == "2G") return 1246.0e6 + frequency_channel * 0.4375e6;
+    return 0.0;
+}
+
+/*!
+ Each channel alone gives a clock drift, -unexplained / frequency. Their median is not moved by a
+ minority of outliers, the channels within OUTLIER_HZ of it are then fitted by least squares:
+
+     unexplained[i] = -frequency[i] * clock_drift
+
+ \a residual is what the fitted drift leaves of each channel, \a outlier flags those above
+ OUTLIER_HZ. Returns the number of channels fitted, 0 if fewer than MIN_CHANNELS are given or if
+ the channels near the median are not a majority.
+ */
+int DopplerResidualModule::solve(const std::vector<double> &frequency, const std::vector<double> &unexplained,
+    double &clock_drift, std::vector<double> &residual, std::vector<bool> &outlier)
+{
+    const size_t n = std::min(frequency.size(), unexplained.size());
+    residual.assign(n, 0.0);
+    outlier.assign(n, false);
+    if (n < static_cast<size_t>(MIN_CHANNELS))
+    {
+        return 0;
+    }
+
+    std::vector<double> drift(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        drift[i] = -unexplained[i] / frequency[i];
+    }
+    std::nth_element(drift.begin(), drift.begin() + n / 2, drift.end());
+    const double median = drift[n / 2];
+
+    double sum_fy = 0.0;
+    double sum_ff = 0.0;
+    int used = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (std::abs(unexplained[i] + frequency[i] * median) <= OUTLIER_HZ)
+        {
+            sum_fy += frequency[i] * unexplained[i];
+            sum_ff += frequency[i] * frequency[i];
+            used++;
+        }
+    }
+    if (2 * used <= static_cast<int>(n))
+    {
+        return 0;
+    }
+
+    clock_drift = -sum_fy / sum_ff;
+    for (size_t i = 0; i < n; i++)
+    {
+        residual[i] = unexplained[i] + frequency[i] * clock_drift;
+        outlier[i] = std::abs(residual[i]) > OUTLIER_HZ;
+    }
+    return used;
+}
+
+/*!
+ Predicts the Doppler of every channel locked on a satellite with an ephemeris, solves the
+ receiver clock drift and keeps the residuals for publish(). Needs a PVT with a valid position
+ and time no older than MAX_PVT_AGE.
+ */
+void DopplerResidualModule::process(const AnalyticsEpoch &epoch)
+{
+    drainInbox();
+    m_solved = false;
+
+    const PvtSnapshot &pvt = epoch.pvt;
+    if (!epoch.hasPvt || !pvt.hasValidTime() || !pvt.hasValidPosition())
+    {
+        return;
+    }
+
+    m_solution.residuals.clear();
+    m_frequency.clear();
+    m_unexplained.clear();
+    for (int i = 0; i < epoch.observables.observable_size(); i++)
+    {
+        const gnss_sdr::GnssSynchro &observable = epoch.observables.observable(i);
+        if (observable.fs() == 0)
+        {
+            continue;
+        }
+
+        Channel &channel = m_channels[observable.channel_id()];
+        if (channel.prn != observable.prn() || channel.system != observable.system())
+        {
+            // Another satellite in the channel.
+            channel = Channel();
+            channel.system = observable.system();
+            channel.prn = observable.prn();
+        }
+        if (!observable.flag_valid_symbol_output())
+        {
+            continue;
+        }
+
+        // The observables may be on the other side of a week rollover from the PVT.
+        double age = observable.rx_time() - pvt.rx_time;
+        int week = static_cast<int>(pvt.week);
+        if (age < -HALF_WEEK)
+        {
+            age += GnssTime::SECONDS_PER_WEEK;
+            week++;
+        }
+        else if (age > HALF_WEEK)
+        {
+            age -= GnssTime::SECONDS_PER_WEEK;
+            week--;
+        }
+        if (std::abs(age) > MAX_PVT_AGE)
+        {
+            continue;
+        }
+
+        double travel_time = NOMINAL_TRAVEL_TIME;
+        if (observable.flag_valid_pseudorange() && observable.pseudorange_m() > 0.0 &&
+            observable.pseudorange_m() < 4.0 * NOMINAL_TRAVEL_TIME * SPEED_OF_LIGHT)
+        {
+            travel_time = observable.pseudorange_m() / SPEED_OF_LIGHT;
+        }
+        const double transmit = GnssTime::gpsSeconds(week, observable.rx_time()) - travel_time;
+
+        SatelliteMotion motion;
+        if (!m_ephemerides.motion(observable.system(), observable.prn(), transmit, motion))
+        {
+            continue;
+        }
+        const double frequency = carrierFrequency(observable.signal(), motion.frequencyChannel);
+        if (frequency <= 0.0)
+        {
+            continue;
+        }
+
+        const double dx = motion.position.x - pvt.pos_x;
+        const double dy = motion.position.y - pvt.pos_y;
+        const double dz = motion.position.z - pvt.pos_z;
+        const double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (range <= 0.0)
+        {
+            continue;
+        }
+        const double range_rate = ((motion.velocity.x - pvt.vel_x) * dx +
+                                      (motion.velocity.y - pvt.vel_y) * dy +
+                                      (motion.velocity.z - pvt.vel_z) * dz) /
+                                  range;
+
+        // Measured Doppler, -(range rate + c * (receiver - satellite clock drift)) / wavelength,
+        // with the known terms taken out.
+        m_frequency.push_back(frequency);
+        m_unexplained.push_back(observable.carrier_doppler_hz() +
+                                frequency * (range_rate - SPEED_OF_LIGHT * motion.clockDrift) / SPEED_OF_LIGHT);
+
+        Residual residual;
+        residual.channelId = observable.channel_id();
+        residual.system = observable.system();
+        residual.prn = observable.prn();
+        residual.rxTime = observable.rx_time();
+        m_solution.residuals.push_back(residual);
+    }
+
+    const int used = solve(m_frequency, m_unexplained, m_solution.clockDrift, m_residual, m_outlier);
+    if (used == 0)
+    {
+        return;
+    }
+    m_solution.timeMs = epoch.timeMs;
+    m_solution.used = used;
+    m_solved = true;
+
+    for (size_t i = 0; i < m_solution.residuals.size(); i++)
+    {
+        Residual &residual = m_solution.residuals[i];
+        residual.hz = m_residual[i];
+        residual.outlier = m_outlier[i];
+
+        Channel &channel = m_channels[residual.channelId];
+        // Only formatted for the events, not for every channel of every epoch.
+        auto satellite = [&residual] {
+            return QString("%1%2 (channel %3)")
+                .arg(QString::fromStdString(residual.system))
+                .arg(residual.prn, 2, 10, QChar('0'))
+                .arg(residual.channelId);
+        };
+        if (!residual.outlier)
+        {
+            if (channel.flagged)
+            {
+                MonitorEvent event;
+                event.severity = MonitorEvent::Severity::Info;
+                event.message = QString("%1: Doppler agrees again with the prediction").arg(satellite());
+                event.value = residual.hz;
+                m_pendingEvents.push_back(event);
+            }
+            channel.flagged = false;
+            channel.outlierSinceMs = -1;
+            continue;
+        }
+
+        if (channel.outlierSinceMs < 0)
+        {
+            channel.outlierSinceMs = epoch.timeMs;
+        }
+        if (!channel.flagged && epoch.timeMs - channel.outlierSinceMs >= OUTLIER_HOLD_MS)
+        {
+            channel.flagged = true;
+            MonitorEvent event;
+            event.severity = MonitorEvent::Severity::Alert;
+            event.message = QString("%1: Doppler %2 Hz off the prediction from the ephemeris and the PVT")
+                                .arg(satellite())
+                                .arg(residual.hz, 0, 'f', 1);
+            event.value = residual.hz;
+            m_pendingEvents.push_back(event);
+        }
+    }
+}
+
+/*!
+ Hands the solution of the last epoch to the sink and logs the outliers found in it.
+ */
+void DopplerResidualModule::publish()
+{
+    if (m_solved && m_sink)
+    {
+        m_sink(m_solution);
+    }
+    m_solved = false;
+
+    for (const MonitorEvent &event : m_pendingEvents)
+    {
+        if (m_log)
+        {
+            m_log->add(event.severity, "Doppler check", event.message, event.value);
+        }
+    }
+    m_pendingEvents.clear();
+}
+
+void DopplerResidualModule::reset()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_inboxMutex);
+        m_inbox.clear();
+    }
+    m_ephemerides.clear();
+    m_channels.clear();
+    m_solution = Solution();
+    m_solved = false;
+    m_pendingEvents.clear();
+}
+
+void DopplerResidualModule::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!enabled)
+    {
+        std::lock_guard<std::mutex> lock(m_inboxMutex);
+        m_inbox.clear();
+    }
+}
+
+/*!
+ Applies the ephemerides received since the last epoch.
+ */
+void DopplerResidualModule::drainInbox()
+{
+    std::map<std::pair<char, int>, std::function<void(EphemerisStore &)>> inbox;
+    {
+        std::lock_guard<std::mutex> lock(m_inboxMutex);
+        inbox.swap(m_inbox);
+    }
+    for (const auto &update : inbox)
+    {
+        update.second(m_ephemerides);
+    }
+}
@@ -0,0 +1,163 @@
+/*!
+ * \file doppler_residuals.h
+ * \brief Interface of the Doppler residual monitor and receiver clock drift estimator.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_DOPPLER_RESIDUALS_H_
+#define GNSS_SDR_MONITOR_DOPPLER_RESIDUALS_H_
+
+#include "analytics_host.h"
+#include "ephemeris_store.h"
+#include "event_log.h"
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+ Analytics module that compares the carrier Doppler measured on every
+ channel with the one predicted from the satellite velocity of the broadcast
+ ephemeris and the receiver velocity of the PVT.
+
+ What is left once the geometry and the satellite clock drift are removed is
+ the same for every channel up to the carrier frequency: the drift of the
+ receiver oscillator. It is solved for each epoch by least squares over the
+ channels that agree with the median, and the residual of each channel is
+ what the drift does not explain. A channel whose residual stays above
+ OUTLIER_HZ for OUTLIER_HOLD_MS raises an alert, as it points at a tracking
+ problem or at a signal that does not come from where the satellite is.
+
+ The module keeps its own copy of the ephemerides, fed from the GUI thread
+ with addEphemeris() and applied by process() on the worker. Until then only
+ the latest ephemeris of each satellite is held, and none while the module
+ is disabled.
+ */
+class DopplerResidualModule : public AnalyticsModule
+{
+public:
+    static constexpr double OUTLIER_HZ = 10.0;
+    static constexpr qint64 OUTLIER_HOLD_MS = 5000;
+    static constexpr int MIN_CHANNELS = 3;      // Fewer cannot tell the outlier from the others.
+    static constexpr double MAX_PVT_AGE = 2.0;  // Between the PVT and the observables [s]
+
+    struct Residual
+    {
+        int channelId = 0;
+        std::string system;
+        unsigned int prn = 0;
+        double rxTime = 0.0;   // Receiver time of week of the observable [s]
+        double hz = 0.0;       // Measured minus predicted Doppler, clock drift removed.
+        bool outlier = false;  // Above OUTLIER_HZ.
+    };
+
+    struct Solution
+    {
+        qint64 timeMs = 0;        // Monitor clock of the epoch.
+        double clockDrift = 0.0;  // Receiver clock drift [s/s]
+        int used = 0;             // Channels in the clock drift.
+        std::vector<Residual> residuals;
+    };
+
+    // Called on the GUI thread with the solution of every epoch that has one.
+    using Sink = std::function<void(const Solution &solution)>;
+
+    explicit DopplerResidualModule(EventLog *log = nullptr) : m_log(log) {}
+
+    QString name() const override { return "Doppler residuals"; }
+    void process(const AnalyticsEpoch &epoch) override;
+    void publish() override;
+    void reset() override;
+
+    void setSink(Sink sink) { m_sink = std::move(sink); }
+
+    // On the GUI thread. A disabled module drops the ephemerides instead of queueing them.
+    void setEnabled(bool enabled);
+
+    // On the GUI thread, the ephemeris is applied before the next epoch is processed.
+    template <typename Ephemeris>
+    void addEphemeris(const Ephemeris &ephemeris)
+    {
+        if (!m_enabled)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_inboxMutex);
+        m_inbox[{systemOf(ephemeris), static_cast<int>(ephemeris.prn())}] =
+            [ephemeris](EphemerisStore &store) { store.update(ephemeris); };
+    }
+
+    // Carrier frequency of \a signal, 0 if unknown [Hz]
+    static double carrierFrequency(const std::string &signal, int frequency_channel);
+
+    // Fits the clock drift to the Doppler left by the geometry of each channel, in Hz, and fills
+    // the residuals. Returns the channels used, 0 if there are too few to tell the outliers.
+    static int solve(const std::vector<double> &frequency, const std::vector<double> &unexplained,
+        double &clock_drift, std::vector<double> &residual, std::vector<bool> &outlier);
+
+private:
+    struct Channel
+    {
+        std::string system;
+        unsigned int prn = 0;
+        qint64 outlierSinceMs = -1;
+        bool flagged = false;
+    };
+
+    static char systemOf(const gnss_sdr::GpsEphemeris &) { return 'G'; }
+    static char systemOf(const gnss_sdr::GalileoEphemeris &) { return 'E'; }
+    static char systemOf(const gnss_sdr::BeidouEphemeris &) { return 'C'; }
+    static char systemOf(const gnss_sdr::GlonassGnavEphemeris &) { return 'R'; }
+
+    void drainInbox();
+
+    bool m_enabled = true;
+    std::mutex m_inboxMutex;
+    std::map<std::pair<char, int>, std::function<void(EphemerisStore &)>> m_inbox;  // Latest per satellite.
+
+    // Written by process() only.
+    EphemerisStore m_ephemerides;
+    std::map<int, Channel> m_channels;
+    Solution m_solution;
+    bool m_solved = false;
+    std::vector<MonitorEvent> m_pendingEvents;
+
+    // Scratch of process(), kept to avoid reallocating every epoch.
+    std::vector<double> m_frequency;
+    std::vector<double> m_unexplained;
+    std::vector<double> m_residual;
+    std::vector<bool> m_outlier;
+
+    EventLog *m_log;
+    Sink m_sink;
+};
+
+#endif  // GNSS_SDR_MONITOR_DOPPLER_RESIDUALS_H_
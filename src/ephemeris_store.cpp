@@ -0,0 +1,319 @@
+/*!
+ * \file ephemeris_store.cpp
+ * \brief Implementation of the store that keeps the latest broadcast ephemeris of
+ * every satellite of every constellation and computes their positions.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "ephemeris_store.h"
+#include "gnss_time.h"
+#include <cmath>
+
+namespace
+{
+constexpr double SPEED_OF_LIGHT = 299792458.0;  // [m/s]
+}  // namespace
+
+template <typename Traits>
+bool EphemerisStore::KeplerSet<Traits>::update(const KeplerElements &e)
+{
+    if (e.prn <= 0 || e.prn > MAX_PRN || e.sqrtA <= 0.0)
+    {
+        return false;
+    }
+
+    int &index = slot[e.prn];
+    if (index < 0)
+    {
+        index = static_cast<int>(elements.size());
+        elements.push_back(e);
+        previous.emplace_back();
+        positions.emplace_back();
+    }
+    else
+    {
+        KeplerElements &current = elements[index];
+        if (current.iode == e.iode && current.toe == e.toe)
+        {
+            return false;
+        }
+        previous[index] = current;
+        current = e;
+    }
+
+    epoch = -1.0;
+    return true;
+}
+
+template <typename Traits>
+bool EphemerisStore::KeplerSet<Traits>::position(int prn, double gps_tow, EcefPosition &position)
+{
+    if (!contains(prn))
+    {
+        return false;
+    }
+
+    if (gps_tow != epoch)
+    {
+        KeplerPropagator<Traits>::propagate(elements.data(), elements.size(), gps_tow, positions.data());
+        epoch = gps_tow;
+    }
+
+    position = positions[slot[prn]];
+    return true;
+}
+
+/*!
+ Propagates \a prn alone at \a gps_tow, leaving the positions of the batch as they are. The
+ velocity is the central difference of the positions half a second around \a gps_tow, well below
+ a mm/s off the analytical one.
+ */
+template <typename Traits>
+bool EphemerisStore::KeplerSet<Traits>::motion(int prn, double gps_tow, SatelliteMotion &motion) const
+{
+    if (!contains(prn))
+    {
+        return false;
+    }
+
+    using Propagator = KeplerPropagator<Traits>;
+    const KeplerElements &e = elements[slot[prn]];
+    const double t = gps_tow + Traits::TIME_OFFSET;
+    const EcefPosition before = Propagator::position(e, t - 0.5);
+    const EcefPosition after = Propagator::position(e, t + 0.5);
+
+    motion.position = Propagator::position(e, t);
+    motion.velocity.x = after.x - before.x;
+    motion.velocity.y = after.y - before.y;
+    motion.velocity.z = after.z - before.z;
+    motion.clockDrift = e.af1 + 2.0 * e.af2 * Propagator::sinceReference(t, e.toc);
+    motion.frequencyChannel = 0;
+    return true;
+}
+
+/*!
+ Propagates the previous and the current ephemeris of \a prn together at \a gps_tow. A negative
+ \a gps_tow compares them halfway between their reference times, where both are within their fit.
+ */
+template <typename Traits>
+bool EphemerisStore::KeplerSet<Traits>::jump(int prn, double gps_tow, EphemerisJump &jump) const
+{
+    if (!contains(prn) || previous[slot[prn]].iode < 0)
+    {
+        return false;
+    }
+
+    using Propagator = KeplerPropagator<Traits>;
+    const KeplerElements pair[2] = {previous[slot[prn]], elements[slot[prn]]};
+    if (gps_tow < 0.0)
+    {
+        gps_tow = pair[0].toe + Propagator::sinceReference(pair[1].toe, pair[0].toe) / 2.0 - Traits::TIME_OFFSET;
+    }
+    if (std::abs(Propagator::sinceReference(gps_tow + Traits::TIME_OFFSET, pair[0].toe)) > MAX_SWITCH_AGE)
+    {
+        return false;
+    }
+
+    EcefPosition p[2];
+    Propagator::propagate(pair, 2, gps_tow, p);
+
+    const double dx = p[1].x - p[0].x;
+    const double dy = p[1].y - p[0].y;
+    const double dz = p[1].z - p[0].z;
+    const double r = std::sqrt(p[1].x * p[1].x + p[1].y * p[1].y + p[1].z * p[1].z);
+
+    jump.oldIode = pair[0].iode;
+    jump.newIode = pair[1].iode;
+    jump.gpsSeconds = gps_tow;
+    jump.orbit = std::sqrt(dx * dx + dy * dy + dz * dz);
+    jump.radial = (dx * p[1].x + dy * p[1].y + dz * p[1].z) / r;
+    jump.clock = SPEED_OF_LIGHT *
+                 (Propagator::clockOffset(pair[1], gps_tow) - Propagator::clockOffset(pair[0], gps_tow));
+    return true;
+}
+
+template <typename Traits>
+void EphemerisStore::KeplerSet<Traits>::clear()
+{
+    slot.fill(-1);
+    elements.clear();
+    previous.clear();
+    positions.clear();
+    epoch = -1.0;
+}
+
+EphemerisStore::EphemerisStore()
+{
+    m_glonassSlot.fill(-1);
+}
+
+bool EphemerisStore::update(const gnss_sdr::GpsEphemeris &ephemeris)
+{
+    KeplerElements e = keplerElementsFrom(ephemeris);
+    e.iode = ephemeris.iode_sf2();
+    e.health = ephemeris.sv_health();
+    return m_gps.update(e);
+}
+
+bool EphemerisStore::update(const gnss_sdr::GalileoEphemeris &ephemeris)
+{
+    KeplerElements e = keplerElementsFrom(ephemeris);
+    e.iode = ephemeris.iod_ephemeris();
+    e.health = ephemeris.e1b_hs() | ephemeris.e5a_hs() | ephemeris.e5b_hs();
+    return m_galileo.update(e);
+}
+
+bool EphemerisStore::update(const gnss_sdr::BeidouEphemeris &ephemeris)
+{
+    KeplerElements e = keplerElementsFrom(ephemeris);
+    e.iode = ephemeris.aode();
+    e.health = ephemeris.sath1();
+    return m_beidou.update(e);
+}
+
+bool EphemerisStore::update(const gnss_sdr::GlonassGnavEphemeris &ephemeris)
+{
+    int prn = ephemeris.prn();
+    if (prn <= 0 || prn > MAX_PRN)
+    {
+        return false;
+    }
+
+    GlonassStateVector s;
+    s.prn = prn;
+    s.freq_channel = ephemeris.freq_channel();
+    s.health = ephemeris.b_n() & 0x4;
+    s.t_b = ephemeris.t_b();
+    s.pos[0] = ephemeris.xn() * 1e3;
+    s.pos[1] = ephemeris.yn() * 1e3;
+    s.pos[2] = ephemeris.zn() * 1e3;
+    s.vel[0] = ephemeris.vxn() * 1e3;
+    s.vel[1] = ephemeris.vyn() * 1e3;
+    s.vel[2] = ephemeris.vzn() * 1e3;
+    s.acc[0] = ephemeris.axn() * 1e3;
+    s.acc[1] = ephemeris.ayn() * 1e3;
+    s.acc[2] = ephemeris.azn() * 1e3;
+    s.tau_n = ephemeris.tau_n();
+    s.gamma_n = ephemeris.gamma_n();
+
+    int &index = m_glonassSlot[prn];
+    if (index < 0)
+    {
+        index = static_cast<int>(m_glonass.size());
+        m_glonass.emplace_back(s);
+        return true;
+    }
+
+    if (m_glonass[index].ephemeris().t_b == s.t_b)
+    {
+        return false;
+    }
+    m_glonass[index] = GlonassPropagator(s);
+    return true;
+}
+
+bool EphemerisStore::contains(const std::string &system, int prn) const
+{
+    if (system == "G") return m_gps.contains(prn);
+    if (system == "E") return m_galileo.contains(prn);
+    if (system == "C") return m_beidou.contains(prn);
+    if (system == "R") return prn > 0 && prn <= MAX_PRN && m_glonassSlot[prn] >= 0;
+    return false;
+}
+
+/*!
+ Computes the ECEF position of satellite \a prn of \a system at \a gps_seconds.
+ Returns false if there is no ephemeris for it.
+ */
+bool EphemerisStore::position(const std::string &system, int prn, double gps_seconds, EcefPosition &position)
+{
+    double gps_tow = std::fmod(gps_seconds, static_cast<double>(GnssTime::SECONDS_PER_WEEK));
+
+    if (system == "G") return m_gps.position(prn, gps_tow, position);
+    if (system == "E") return m_galileo.position(prn, gps_tow, position);
+    if (system == "C") return m_beidou.position(prn, gps_tow, position);
+    if (system == "R" && prn > 0 && prn <= MAX_PRN && m_glonassSlot[prn] >= 0)
+    {
+        double utc = GnssTime::fromGps(gps_seconds, TimeSystem::GLONASS);
+        double tod = std::fmod(utc, 86400.0);
+        position = m_glonass[m_glonassSlot[prn]].position(tod);
+        return true;
+    }
+    return false;
+}
+
+/*!
+ Computes the ECEF position and velocity and the clock drift of satellite \a prn of \a system at
+ \a gps_seconds. Returns false if there is no ephemeris for it.
+ */
+bool EphemerisStore::motion(const std::string &system, int prn, double gps_seconds, SatelliteMotion &motion)
+{
+    double gps_tow = std::fmod(gps_seconds, static_cast<double>(GnssTime::SECONDS_PER_WEEK));
+
+    if (system == "G") return m_gps.motion(prn, gps_tow, motion);
+    if (system == "E") return m_galileo.motion(prn, gps_tow, motion);
+    if (system == "C") return m_beidou.motion(prn, gps_tow, motion);
+    if (system == "R" && prn > 0 && prn <= MAX_PRN && m_glonassSlot[prn] >= 0)
+    {
+        GlonassPropagator &propagator = m_glonass[m_glonassSlot[prn]];
+        double utc = GnssTime::fromGps(gps_seconds, TimeSystem::GLONASS);
+        double tod = std::fmod(utc, 86400.0);
+        motion.position = propagator.position(tod);
+        motion.velocity = propagator.velocity();
+        motion.clockDrift = propagator.ephemeris().gamma_n;
+        motion.frequencyChannel = propagator.ephemeris().freq_channel;
+        return true;
+    }
+    return false;
+}
+
+/*!
+ Compares the current ephemeris of satellite \a prn of \a system with the one it replaced, at
+ \a gps_seconds since the GPS epoch. If \a gps_seconds is negative they are compared halfway
+ between their reference times. Returns false for GLONASS, for the first ephemeris of a satellite
+ and if the replaced one is older than MAX_SWITCH_AGE at that time.
+ */
+bool EphemerisStore::jump(const std::string &system, int prn, double gps_seconds, EphemerisJump &jump) const
+{
+    double gps_tow = gps_seconds < 0.0 ? -1.0 : std::fmod(gps_seconds, static_cast<double>(GnssTime::SECONDS_PER_WEEK));
+
+    if (system == "G") return m_gps.jump(prn, gps_tow, jump);
+    if (system == "E") return m_galileo.jump(prn, gps_tow, jump);
+    if (system == "C") return m_beidou.jump(prn, gps_tow, jump);
+    return false;
+}
+
+void EphemerisStore::clear()
+{
+    m_gps.clear();
+    m_galileo.clear();
+    m_beidou.clear();
+    m_glonassSlot.fill(-1);
+    m_glonass.clear();
+}
@@ -0,0 +1,143 @@
+/*!
+ * \file ephemeris_store.h
+ * \brief Interface of the store that keeps the latest broadcast ephemeris of
+ * every satellite of every constellation and computes their positions.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_EPHEMERIS_STORE_H_
+#define GNSS_SDR_MONITOR_EPHEMERIS_STORE_H_
+
+#include "beidou_ephemeris.pb.h"
+#include "galileo_ephemeris.pb.h"
+#include "glonass_gnav_ephemeris.pb.h"
+#include "gps_ephemeris.pb.h"
+#include "orbit_propagator.h"
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/*!
+ Discontinuity between two consecutive ephemerides of a satellite, evaluated at the same time.
+ */
+struct EphemerisJump
+{
+    int oldIode = -1;
+    int newIode = -1;
+    double gpsSeconds = 0.0;  // Time of the comparison [s since the GPS epoch, or of week]
+    double orbit = 0.0;       // Distance between both positions [m]
+    double radial = 0.0;      // Radial component of the position change, new minus old [m]
+    double clock = 0.0;       // Satellite clock change times c, new minus old [m]
+
+    // Change of the modelled pseudorange for a user near the nadir [m].
+    double range() const { return radial - clock; }
+
+    // Nominal uploads move the range by decimetres and the orbit by a few metres.
+    static constexpr double RANGE_ALERT = 5.0;   // [m]
+    static constexpr double ORBIT_ALERT = 50.0;  // [m]
+    bool isLarge() const { return std::abs(range()) > RANGE_ALERT || orbit > ORBIT_ALERT; }
+};
+
+/*!
+ State of a satellite needed to predict its Doppler.
+ */
+struct SatelliteMotion
+{
+    EcefPosition position;  // [m]
+    EcefPosition velocity;  // [m/s]
+    double clockDrift = 0.0;   // Satellite clock drift from the broadcast polynomial [s/s]
+    int frequencyChannel = 0;  // GLONASS FDMA channel number, 0 for the other systems.
+};
+
+/*!
+ Latest broadcast ephemeris of every GPS, Galileo, BeiDou and GLONASS satellite.
+
+ Keplerian satellites of one system are kept in a dense array and propagated
+ together: the first position request for a new epoch computes the whole
+ system in one batch, later requests for the same epoch are lookups. GLONASS
+ satellites keep their own integrator and its cached state.
+ */
+class EphemerisStore
+{
+public:
+    static constexpr int MAX_PRN = 64;
+
+    EphemerisStore();
+
+    // Each update returns true if the ephemeris is new for that satellite.
+    bool update(const gnss_sdr::GpsEphemeris &ephemeris);
+    bool update(const gnss_sdr::GalileoEphemeris &ephemeris);
+    bool update(const gnss_sdr::BeidouEphemeris &ephemeris);
+    bool update(const gnss_sdr::GlonassGnavEphemeris &ephemeris);
+
+    bool contains(const std::string &system, int prn) const;
+
+    // ECEF position of a satellite at \a gps_seconds since the GPS epoch.
+    bool position(const std::string &system, int prn, double gps_seconds, EcefPosition &position);
+
+    // ECEF position, velocity and clock drift of a satellite at \a gps_seconds since the GPS epoch.
+    bool motion(const std::string &system, int prn, double gps_seconds, SatelliteMotion &motion);
+
+    // Older ephemerides are not compared with the one that replaced them.
+    static constexpr double MAX_SWITCH_AGE = 4.0 * 3600.0;  // [s]
+
+    // Compares the ephemeris of a Keplerian satellite with the one it replaced.
+    bool jump(const std::string &system, int prn, double gps_seconds, EphemerisJump &jump) const;
+
+    void clear();
+
+private:
+    template <typename Traits>
+    struct KeplerSet
+    {
+        std::array<int, MAX_PRN + 1> slot;  // Index in elements, or -1.
+        std::vector<KeplerElements> elements;
+        std::vector<KeplerElements> previous;  // Replaced by elements, iode -1 if none.
+        std::vector<EcefPosition> positions;
+        double epoch = -1.0;  // GPS time of week of positions.
+
+        KeplerSet() { clear(); }
+        bool update(const KeplerElements &e);
+        bool contains(int prn) const { return prn > 0 && prn <= MAX_PRN && slot[prn] >= 0; }
+        bool position(int prn, double gps_tow, EcefPosition &position);
+        bool motion(int prn, double gps_tow, SatelliteMotion &motion) const;
+        bool jump(int prn, double gps_tow, EphemerisJump &jump) const;
+        void clear();
+    };
+
+    KeplerSet<GpsOrbitTraits> m_gps;
+    KeplerSet<GalileoOrbitTraits> m_galileo;
+    KeplerSet<BeidouOrbitTraits> m_beidou;
+
+    std::array<int, MAX_PRN + 1> m_glonassSlot;
+    std::vector<GlonassPropagator> m_glonass;
+};
+
+#endif  // GNSS_SDR_MONITOR_EPHEMERIS_STORE_H_
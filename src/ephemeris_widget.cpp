@@ -31,13 +31,12 @@
  */
 
 #include "ephemeris_widget.h"
-#include <QTimerEvent>
 #include <QFont>
 #include <QSizePolicy>
 #include <algorithm>
 
 EphemerisWidget::EphemerisWidget(QWidget *parent)
-    : QWidget(parent), m_maxAgeSeconds(DEFAULT_MAX_AGE_SECONDS)
+    : QWidget(parent), m_maxAgeSeconds(DEFAULT_MAX_AGE_SECONDS), m_clock(nullptr)
 {
     setMinimumSize(600, 400);
     
@@ -61,7 +60,8 @@ EphemerisWidget::EphemerisWidget(QWidget *parent)
     m_tabWidget->addTab(placeholderWidget, "Waiting for data");
     
     // Start cleanup timer
-    m_cleanupTimerId = startTimer(CLEANUP_INTERVAL_MS);
+    connect(&m_cleanupTimer, &ClockTimer::timeout, this, &EphemerisWidget::removeStaleData);
+    m_cleanupTimer.start(CLEANUP_INTERVAL_MS);
     
     setLayout(mainLayout);
 }
@@ -312,7 +312,7 @@ void EphemerisWidget::updateTabData(int prn, const gnss_sdr::GpsEphemeris &ephem
     
     // Update header information
     tabData.prnLabel->setText(QString::number(prn));
-    tabData.lastUpdate = QDateTime::currentDateTime();
+    tabData.lastUpdate = QDateTime::fromMSecsSinceEpoch(clockNowMs(m_clock));
     tabData.lastUpdateLabel->setText(tabData.lastUpdate.toString("hh:mm:ss"));
     tabData.statusLabel->setText("Active");
     tabData.statusLabel->setStyleSheet("color: green; font-weight: bold;");
@@ -414,7 +414,7 @@ void EphemerisWidget::clear()
 
 void EphemerisWidget::removeStaleData()
 {
-    QDateTime now = QDateTime::currentDateTime();
+    QDateTime now = QDateTime::fromMSecsSinceEpoch(clockNowMs(m_clock));
     std::vector<int> toRemove;
     
     for (const auto &pair : m_ephemerisTabs) {
@@ -484,10 +484,8 @@ QStringList EphemerisWidget::getActivePRNs() const
     return prns;
 }
 
-void EphemerisWidget::timerEvent(QTimerEvent *event)
+void EphemerisWidget::setClock(MonitorClock *clock)
 {
-    if (event->timerId() == m_cleanupTimerId) {
-        removeStaleData();
-    }
-    QWidget::timerEvent(event);
+    m_clock = clock;
+    m_cleanupTimer.setClock(clock);
 }
@@ -34,6 +34,7 @@
 #define GNSS_SDR_MONITOR_EPHEMERIS_WIDGET_H_
 
 #include "gps_ephemeris.pb.h"
+#include "monitor_clock.h"
 #include <QWidget>
 #include <QTabWidget>
 #include <QTableWidget>
@@ -127,6 +128,7 @@ public:
     // Configuration
     void setMaxAge(int seconds) { m_maxAgeSeconds = seconds; }
     int getMaxAge() const { return m_maxAgeSeconds; }
+    void setClock(MonitorClock *clock);
     
     // Statistics
     int getSatelliteCount() const { return m_ephemerisTabs.size(); }
@@ -142,9 +144,6 @@ signals:
     void satelliteAdded(int prn);
     void satelliteRemoved(int prn);
 
-protected:
-    void timerEvent(QTimerEvent *event) override;
-
 private:
     void createTabForSatellite(int prn);
     void updateTabData(int prn, const gnss_sdr::GpsEphemeris &ephemeris);
@@ -161,7 +160,8 @@ private:
     std::map<int, std::unique_ptr<EphemerisTabData>> m_ephemerisTabs;  // PRN -> tab data
     
     int m_maxAgeSeconds;
-    int m_cleanupTimerId;
+    MonitorClock *m_clock;
+    ClockTimer m_cleanupTimer;
     
     static constexpr int CLEANUP_INTERVAL_MS = 5000;  // 5 seconds
     static constexpr int DEFAULT_MAX_AGE_SECONDS = 300;  // 5 minutes
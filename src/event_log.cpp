@@ -0,0 +1,93 @@
+/*!
+ * \file event_log.cpp
+ * \brief Implementation of the log of the events detected by the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "event_log.h"
+
+const char *MonitorEvent::severityName(Severity severity)
+{
+    switch (severity)
+    {
+    case Severity::Warning:
+        return "Warning";
+    case Severity::Alert:
+        return "Alert";
+    default:
+        return "Info";
+    }
+}
+
+/*!
+ Constructs an empty EventLog that keeps the last DEFAULT_CAPACITY events.
+ */
+EventLog::EventLog(QObject *parent) : QObject(parent)
+{
+    m_events.setCapacity(DEFAULT_CAPACITY);
+}
+
+/*!
+ Sets the clock that timestamps the events, so that they follow the virtual time during replay.
+ */
+void EventLog::setClock(MonitorClock *clock)
+{
+    m_clock = clock;
+}
+
+void EventLog::setCapacity(size_t capacity)
+{
+    m_events.setCapacity(capacity);
+}
+
+/*!
+ Records an event of \a severity raised by \a source and notifies the views.
+ */
+void EventLog::add(MonitorEvent::Severity severity, const QString &source, const QString &message, double value)
+{
+    MonitorEvent event;
+    event.timeMs = clockNowMs(m_clock);
+    event.severity = severity;
+    event.source = source;
+    event.message = message;
+    event.value = value;
+    m_events.push_back(event);
+
+    emit eventAdded(event);
+    if (severity == MonitorEvent::Severity::Alert)
+    {
+        emit alertRaised(event);
+    }
+}
+
+void EventLog::clear()
+{
+    m_events.clear();
+    emit cleared();
+}
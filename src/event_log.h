@@ -0,0 +1,93 @@
+/*!
+ * \file event_log.h
+ * \brief Interface of the log of the events detected by the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_EVENT_LOG_H_
+#define GNSS_SDR_MONITOR_EVENT_LOG_H_
+
+#include "monitor_clock.h"
+#include "ring_buffer.h"
+#include <QObject>
+#include <QString>
+
+struct MonitorEvent
+{
+    enum class Severity
+    {
+        Info,
+        Warning,
+        Alert
+    };
+
+    qint64 timeMs = 0;  // Monitor clock, virtual during replay [ms since the Unix epoch]
+    Severity severity = Severity::Info;
+    QString source;     // Detector that raised the event
+    QString message;
+    double value = 0.0;  // Magnitude that triggered the event, in the unit of the detector
+
+    static const char *severityName(Severity severity);
+};
+
+/*!
+ Bounded log of the events raised by the detectors of the monitor. The oldest
+ events are dropped once the log is full.
+ */
+class EventLog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1000;
+
+    explicit EventLog(QObject *parent = nullptr);
+
+    void setClock(MonitorClock *clock);
+    void setCapacity(size_t capacity);
+
+    void add(MonitorEvent::Severity severity, const QString &source, const QString &message, double value = 0.0);
+
+    const RingBuffer<MonitorEvent> &events() const { return m_events; }
+
+signals:
+    void eventAdded(const MonitorEvent &event);
+    // Also emitted for every event of Alert severity, after eventAdded().
+    void alertRaised(const MonitorEvent &event);
+    void cleared();
+
+public slots:
+    void clear();
+
+private:
+    MonitorClock *m_clock = nullptr;
+    RingBuffer<MonitorEvent> m_events;
+};
+
+#endif  // GNSS_SDR_MONITOR_EVENT_LOG_H_
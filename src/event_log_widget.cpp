@@ -0,0 +1,136 @@
+/*!
+ * \file event_log_widget.cpp
+ * \brief Implementation of a widget that lists the events detected by the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "event_log_widget.h"
+#include <QDateTime>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+/*!
+ Constructs an EventLogWidget that lists the newest events first.
+ */
+EventLogWidget::EventLogWidget(QWidget *parent) : QWidget(parent)
+{
+    m_table = new QTableWidget(0, 4, this);
+    m_table->setHorizontalHeaderLabels({"Time (UTC)", "Severity", "Source", "Event"});
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    m_table->verticalHeader()->hide();
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->setWordWrap(false);
+
+    auto *clear = new QPushButton("Clear", this);
+
+    auto *buttons = new QHBoxLayout();
+    buttons->addStretch();
+    buttons->addWidget(clear);
+
+    auto *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(5, 5, 5, 5);
+    layout->addWidget(m_table);
+    layout->addLayout(buttons);
+
+    connect(clear, &QPushButton::clicked, this, [this] {
+        if (m_log)
+        {
+            m_log->clear();
+        }
+    });
+}
+
+/*!
+ Shows the events of \a log and follows the new ones. The widget does not take ownership of \a log.
+ */
+void EventLogWidget::setEventLog(EventLog *log)
+{
+    if (m_log)
+    {
+        disconnect(m_log, nullptr, this, nullptr);
+    }
+    m_log = log;
+    if (m_log)
+    {
+        connect(m_log, &EventLog::eventAdded, this, &EventLogWidget::addEvent);
+        connect(m_log, &EventLog::cleared, this, &EventLogWidget::reload);
+    }
+    reload();
+}
+
+void EventLogWidget::addEvent(const MonitorEvent &event)
+{
+    m_table->insertRow(0);
+    const QStringList cells = {
+        QDateTime::fromMSecsSinceEpoch(event.timeMs).toUTC().toString("yyyy-MM-dd hh:mm:ss"),
+        MonitorEvent::severityName(event.severity),
+        event.source,
+        event.message};
+
+    QColor background;
+    if (event.severity == MonitorEvent::Severity::Alert)
+    {
+        background = QColor(255, 190, 190);
+    }
+    else if (event.severity == MonitorEvent::Severity::Warning)
+    {
+        background = QColor(255, 225, 170);
+    }
+
+    for (int column = 0; column < cells.size(); column++)
+    {
+        auto *item = new QTableWidgetItem(cells[column]);
+        if (background.isValid())
+        {
+            item->setBackground(background);
+        }
+        m_table->setItem(0, column, item);
+    }
+    m_table->item(0, 3)->setToolTip(event.message);
+
+    // Keep the same events as the log.
+    int capacity = m_log ? static_cast<int>(m_log->events().capacity()) : 0;
+    while (capacity > 0 && m_table->rowCount() > capacity)
+    {
+        m_table->removeRow(m_table->rowCount() - 1);
+    }
+}
+
+void EventLogWidget::reload()
+{
+    m_table->setRowCount(0);
+    if (m_log)
+    {
+        m_log->events().forEach([this](const MonitorEvent &event) { addEvent(event); });
+    }
+}
@@ -0,0 +1,59 @@
+/*!
+ * \file event_log_widget.h
+ * \brief Interface of a widget that lists the events detected by the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_EVENT_LOG_WIDGET_H_
+#define GNSS_SDR_MONITOR_EVENT_LOG_WIDGET_H_
+
+#include "event_log.h"
+#include <QWidget>
+
+class QTableWidget;
+
+class EventLogWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit EventLogWidget(QWidget *parent = nullptr);
+
+    void setEventLog(EventLog *log);
+
+private slots:
+    void addEvent(const MonitorEvent &event);
+    void reload();
+
+private:
+    EventLog *m_log = nullptr;
+    QTableWidget *m_table;
+};
+
+#endif  // GNSS_SDR_MONITOR_EVENT_LOG_WIDGET_H_
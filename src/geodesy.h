@@ -0,0 +1,296 @@
+/*!
+ * \file geodesy.h
+ * \brief Batch conversions between ECEF, geodetic, local ENU and azimuth and
+ * elevation coordinates over arrays of points.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_GEODESY_H_
+#define GNSS_SDR_MONITOR_GEODESY_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GNSS_SDR_MONITOR_GEODESY_SSE2
+#endif
+
+/*!
+ WGS 84 transforms over structure-of-arrays inputs: each coordinate is its own
+ array of \a n values, so the loops run over contiguous doubles.
+
+ The geodetic conversions need millimetres and keep the libm functions; ECEF to
+ ENU is a rotation and runs two points per SSE2 instruction. Azimuth and
+ elevation use a polynomial arctangent, also two points at a time, accurate to
+ about 1e-6 degrees, far below what a sky plot or an elevation mask can tell.
+ Angles are in degrees and distances in metres.
+ */
+namespace geodesy
+{
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEG = PI / 180.0;
+
+constexpr double WGS84_A = 6378137.0;                     // Semi-major axis [m]
+constexpr double WGS84_F = 1.0 / 298.257223563;           // Flattening
+constexpr double WGS84_B = WGS84_A * (1.0 - WGS84_F);     // Semi-minor axis [m]
+constexpr double WGS84_E2 = WGS84_F * (2.0 - WGS84_F);    // First eccentricity squared
+constexpr double WGS84_EP2 = WGS84_E2 / (1.0 - WGS84_E2); // Second eccentricity squared
+
+/*!
+ East, north, up frame tangent to the ellipsoid at a point.
+ */
+struct LocalFrame
+{
+    double origin[3] = {0.0, 0.0, 0.0};  // ECEF [m]
+    double sinLat = 0.0;
+    double cosLat = 1.0;
+    double sinLon = 0.0;
+    double cosLon = 1.0;
+
+    static LocalFrame at(double latitude, double longitude, double height);
+};
+
+inline void geodeticToEcef(const double *latitude, const double *longitude, const double *height, size_t n,
+    double *x, double *y, double *z)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const double sin_lat = std::sin(latitude[i] * DEG);
+        const double cos_lat = std::cos(latitude[i] * DEG);
+        const double radius = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+        x[i] = (radius + height[i]) * cos_lat * std::cos(longitude[i] * DEG);
+        y[i] = (radius + height[i]) * cos_lat * std::sin(longitude[i] * DEG);
+        z[i] = (radius * (1.0 - WGS84_E2) + height[i]) * sin_lat;
+    }
+}
+
+/*!
+ Converts ECEF positions to geodetic ones with the closed form of Heikkinen (1982), exact
+ to well below a millimetre anywhere but within a few kilometres of the centre of the Earth.
+ */
+inline void ecefToGeodetic(const double *x, const double *y, const double *z, size_t n,
+    double *latitude, double *longitude, double *height)
+{
+    constexpr double a2 = WGS84_A * WGS84_A;
+    constexpr double b2 = WGS84_B * WGS84_B;
+    for (size_t i = 0; i < n; i++)
+    {
+        const double z2 = z[i] * z[i];
+        const double p2 = x[i] * x[i] + y[i] * y[i];
+        const double p = std::sqrt(p2);
+        const double f = 54.0 * b2 * z2;
+        const double g = p2 + (1.0 - WGS84_E2) * z2 - WGS84_E2 * (a2 - b2);
+        const double c = WGS84_E2 * WGS84_E2 * f * p2 / (g * g * g);
+        const double s = std::cbrt(1.0 + c + std::sqrt(c * c + 2.0 * c));
+        const double k = s + 1.0 + 1.0 / s;
+        const double pp = f / (3.0 * k * k * g * g);
+        const double q = std::sqrt(1.0 + 2.0 * WGS84_E2 * WGS84_E2 * pp);
+        const double r0 = -pp * WGS84_E2 * p / (1.0 + q) +
+                          std::sqrt(std::max(0.0, 0.5 * a2 * (1.0 + 1.0 / q) - pp * (1.0 - WGS84_E2) * z2 / (q * (1.0 + q)) - 0.5 * pp * p2));
+        const double d = p - WGS84_E2 * r0;
+        const double u = std::sqrt(d * d + z2);
+        const double v = std::sqrt(d * d + (1.0 - WGS84_E2) * z2);
+        const double z0 = b2 * z[i] / (WGS84_A * v);
+
+        height[i] = u * (1.0 - b2 / (WGS84_A * v));
+        latitude[i] = std::atan2(z[i] + WGS84_EP2 * z0, p) / DEG;
+        longitude[i] = std::atan2(y[i], x[i]) / DEG;
+    }
+}
+
+inline LocalFrame LocalFrame::at(double latitude, double longitude, double height)
+{
+    LocalFrame frame;
+    geodeticToEcef(&latitude, &longitude, &height, 1, &frame.origin[0], &frame.origin[1], &frame.origin[2]);
+    frame.sinLat = std::sin(latitude * DEG);
+    frame.cosLat = std::cos(latitude * DEG);
+    frame.sinLon = std::sin(longitude * DEG);
+    frame.cosLon = std::cos(longitude * DEG);
+    return frame;
+}
+
+/*!
+ Expresses ECEF positions as east, north and up offsets from the origin of \a frame. Also
+ gives the ENU errors of a set of positions with respect to a reference one.
+ */
+inline void ecefToEnu(const LocalFrame &frame, const double *x, const double *y, const double *z, size_t n,
+    double *east, double *north, double *up)
+{
+    // Rows of the rotation from ECEF to ENU.
+    const double ex = -frame.sinLon, ey = frame.cosLon;
+    const double nx = -frame.sinLat * frame.cosLon, ny = -frame.sinLat * frame.sinLon, nz = frame.cosLat;
+    const double ux = frame.cosLat * frame.cosLon, uy = frame.cosLat * frame.sinLon, uz = frame.sinLat;
+
+    size_t i = 0;
+#ifdef GNSS_SDR_MONITOR_GEODESY_SSE2
+    const __m128d ox = _mm_set1_pd(frame.origin[0]);
+    const __m128d oy = _mm_set1_pd(frame.origin[1]);
+    const __m128d oz = _mm_set1_pd(frame.origin[2]);
+    for (; i + 2 <= n; i += 2)
+    {
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), ox);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), oy);
+        const __m128d dz = _mm_sub_pd(_mm_loadu_pd(z + i), oz);
+        _mm_storeu_pd(east + i, _mm_add_pd(_mm_mul_pd(_mm_set1_pd(ex), dx), _mm_mul_pd(_mm_set1_pd(ey), dy)));
+        _mm_storeu_pd(north + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(nx), dx), _mm_mul_pd(_mm_set1_pd(ny), dy)),
+                                     _mm_mul_pd(_mm_set1_pd(nz), dz)));
+        _mm_storeu_pd(up + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(ux), dx), _mm_mul_pd(_mm_set1_pd(uy), dy)),
+                                  _mm_mul_pd(_mm_set1_pd(uz), dz)));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        const double dx = x[i] - frame.origin[0];
+        const double dy = y[i] - frame.origin[1];
+        const double dz = z[i] - frame.origin[2];
+        east[i] = ex * dx + ey * dy;
+        north[i] = nx * dx + ny * dy + nz * dz;
+        up[i] = ux * dx + uy * dy + uz * dz;
+    }
+}
+
+namespace detail
+{
+// Coefficients of the odd series of atan(r) for |r| <= tan(pi / 8), truncated after r^15.
+constexpr double ATAN_TAN_PI_8 = 0.41421356237309503;
+constexpr double ATAN_SERIES[8] = {1.0, -1.0 / 3.0, 1.0 / 5.0, -1.0 / 7.0, 1.0 / 9.0, -1.0 / 11.0, 1.0 / 13.0, -1.0 / 15.0};
+
+/*!
+ atan2(\a y, \a x) in radians, with the same steps as the SSE2 version so that both agree.
+ */
+inline double atan2(double y, double x)
+{
+    const double ax = std::abs(x);
+    const double ay = std::abs(y);
+    const double mx = ax > ay ? ax : ay;
+    const double mn = ax > ay ? ay : ax;
+    double t = mx > 0.0 ? mn / mx : 0.0;
+
+    const bool reduce = t > ATAN_TAN_PI_8;
+    const double r = reduce ? (t - 1.0) / (t + 1.0) : t;
+    const double r2 = r * r;
+    double poly = ATAN_SERIES[7];
+    for (int k = 6; k >= 0; k--)
+    {
+        poly = poly * r2 + ATAN_SERIES[k];
+    }
+    double angle = r * poly + (reduce ? PI / 4.0 : 0.0);
+
+    angle = ay > ax ? PI / 2.0 - angle : angle;
+    angle = x < 0.0 ? PI - angle : angle;
+    return y < 0.0 ? -angle : angle;
+}
+
+#ifdef GNSS_SDR_MONITOR_GEODESY_SSE2
+inline __m128d select(__m128d mask, __m128d a, __m128d b)
+{
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+inline __m128d atan2(__m128d y, __m128d x)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d ax = _mm_andnot_pd(sign, x);
+    const __m128d ay = _mm_andnot_pd(sign, y);
+    const __m128d mx = _mm_max_pd(ax, ay);
+    const __m128d mn = _mm_min_pd(ax, ay);
+    const __m128d t = select(_mm_cmpgt_pd(mx, zero), _mm_div_pd(mn, select(_mm_cmpgt_pd(mx, zero), mx, one)), zero);
+
+    const __m128d reduce = _mm_cmpgt_pd(t, _mm_set1_pd(ATAN_TAN_PI_8));
+    const __m128d r = select(reduce, _mm_div_pd(_mm_sub_pd(t, one), _mm_add_pd(t, one)), t);
+    const __m128d r2 = _mm_mul_pd(r, r);
+    __m128d poly = _mm_set1_pd(ATAN_SERIES[7]);
+    for (int k = 6; k >= 0; k--)
+    {
+        poly = _mm_add_pd(_mm_mul_pd(poly, r2), _mm_set1_pd(ATAN_SERIES[k]));
+    }
+    __m128d angle = _mm_add_pd(_mm_mul_pd(r, poly), _mm_and_pd(reduce, _mm_set1_pd(PI / 4.0)));
+
+    angle = select(_mm_cmpgt_pd(ay, ax), _mm_sub_pd(_mm_set1_pd(PI / 2.0), angle), angle);
+    angle = select(_mm_cmplt_pd(x, zero), _mm_sub_pd(_mm_set1_pd(PI), angle), angle);
+    return select(_mm_cmplt_pd(y, zero), _mm_xor_pd(angle, sign), angle);
+}
+#endif
+}  // namespace detail
+
+/*!
+ Converts ENU offsets to azimuth, clockwise from north in [0, 360), and elevation above the horizon.
+ */
+inline void enuToAzEl(const double *east, const double *north, const double *up, size_t n,
+    double *azimuth, double *elevation)
+{
+    size_t i = 0;
+#ifdef GNSS_SDR_MONITOR_GEODESY_SSE2
+    const __m128d to_deg = _mm_set1_pd(1.0 / DEG);
+    const __m128d full_turn = _mm_set1_pd(360.0);
+    const __m128d zero = _mm_setzero_pd();
+    for (; i + 2 <= n; i += 2)
+    {
+        const __m128d e = _mm_loadu_pd(east + i);
+        const __m128d no = _mm_loadu_pd(north + i);
+        const __m128d u = _mm_loadu_pd(up + i);
+        const __m128d horizontal = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(e, e), _mm_mul_pd(no, no)));
+
+        __m128d az = _mm_mul_pd(detail::atan2(e, no), to_deg);
+        az = _mm_add_pd(az, _mm_and_pd(_mm_cmplt_pd(az, zero), full_turn));
+        _mm_storeu_pd(azimuth + i, az);
+        _mm_storeu_pd(elevation + i, _mm_mul_pd(detail::atan2(u, horizontal), to_deg));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        double az = detail::atan2(east[i], north[i]) / DEG;
+        azimuth[i] = az < 0.0 ? az + 360.0 : az;
+        elevation[i] = detail::atan2(up[i], std::sqrt(east[i] * east[i] + north[i] * north[i])) / DEG;
+    }
+}
+
+/*!
+ Azimuth and elevation of the ECEF positions of \a n satellites seen from the origin of \a frame.
+ */
+inline void lookAngles(const LocalFrame &frame, const double *x, const double *y, const double *z, size_t n,
+    double *azimuth, double *elevation)
+{
+    // Stack scratch in blocks, so that any number of satellites converts without allocating.
+    constexpr size_t BLOCK = 64;
+    double east[BLOCK], north[BLOCK], up[BLOCK];
+    for (size_t first = 0; first < n; first += BLOCK)
+    {
+        const size_t count = n - first < BLOCK ? n - first : BLOCK;
+        ecefToEnu(frame, x + first, y + first, z + first, count, east, north, up);
+        enuToAzEl(east, north, up, count, azimuth + first, elevation + first);
+    }
+}
+}  // namespace geodesy
+
+#endif  // GNSS_SDR_MONITOR_GEODESY_H_
@@ -0,0 +1,288 @@
+/*!
+ * \file geoid_model.cpp
+ * \brief Implementation of a geoid model interpolated from a memory-mapped grid file.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "geoid_model.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Catmull-Rom weights of the four nodes around a point at \a t in [0, 1) from the second one.
+void cubicWeights(double t, double w[4])
+{
+    w[0] = ((-0.5 * t + 1.0) * t - 0.5) * t;
+    w[1] = (1.5 * t - 2.5) * t * t + 1.0;
+    w[2] = ((-1.5 * t + 2.0) * t + 0.5) * t;
+    w[3] = (0.5 * t - 0.5) * t * t;
+}
+}  // namespace
+
+GeoidModel::GeoidModel() = default;
+
+GeoidModel::~GeoidModel()
+{
+    close();
+}
+
+/*!
+ Maps the geoid grid in \a path. Returns false, and leaves the model closed, if it is not a valid grid.
+ */
+bool GeoidModel::open(const QString &path)
+{
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        return fail(QString("Cannot open %1: %2").arg(path, m_file.errorString()));
+    }
+
+    // Header: magic, width, height and maximum value, with comments in between.
+    QStringList fields;
+    m_offset = 0.0;
+    m_scale = 1.0;
+    while (fields.size() < 4 && !m_file.atEnd())
+    {
+        const QString line = QString::fromLatin1(m_file.readLine()).trimmed();
+        if (line.startsWith('#'))
+        {
+            const QStringList comment = line.mid(1).split(' ', QString::SkipEmptyParts);
+            if (comment.size() == 2 && comment[0] == "Offset")
+            {
+                m_offset = comment[1].toDouble();
+            }
+            else if (comment.size() == 2 && comment[0] == "Scale")
+            {
+                m_scale = comment[1].toDouble();
+            }
+            continue;
+        }
+        fields += line.split(' ', QString::SkipEmptyParts);
+    }
+
+    if (fields.size() != 4 || fields[0] != "P5" || fields[3] != "65535")
+    {
+        return fail(path + " is not a 16-bit geoid grid");
+    }
+
+    m_width = fields[1].toInt();
+    m_height = fields[2].toInt();
+    const qint64 data_start = m_file.pos();
+    const qint64 data_size = 2 * static_cast<qint64>(m_width) * m_height;
+    if (m_width < 4 || m_height < 4 || m_file.size() < data_start + data_size)
+    {
+        return fail(path + " is truncated");
+    }
+
+    m_data = m_file.map(data_start, data_size);
+    if (!m_data)
+    {
+        return fail(QString("Cannot map %1: %2").arg(path, m_file.errorString()));
+    }
+
+    // The rows include both poles, the columns do not repeat longitude 0 at 360.
+    m_rowSpacing = 180.0 / (m_height - 1);
+    m_columnSpacing = 360.0 / m_width;
+    for (Tile &t : m_tiles)
+    {
+        t.key = -1;
+    }
+    m_errorString.clear();
+    return true;
+}
+
+void GeoidModel::close()
+{
+    if (m_data)
+    {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    m_file.close();
+    m_width = 0;
+    m_height = 0;
+}
+
+bool GeoidModel::fail(const QString &message)
+{
+    m_errorString = message;
+    close();
+    return false;
+}
+
+/*!
+ Interpolates the geoid height above the WGS 84 ellipsoid at \a latitude and \a longitude, in
+ degrees, into \a undulation. The orthometric height is the ellipsoidal one minus \a undulation.
+ */
+bool GeoidModel::undulation(double latitude, double longitude, double &undulation)
+{
+    if (!m_data || !std::isfinite(latitude) || !std::isfinite(longitude))
+    {
+        return false;
+    }
+
+    longitude = std::fmod(longitude, 360.0);
+    if (longitude < 0.0)
+    {
+        longitude += 360.0;
+    }
+    const double y = (90.0 - std::max(-90.0, std::min(90.0, latitude))) / m_rowSpacing;
+    const double x = longitude / m_columnSpacing;
+    const int row = std::min(static_cast<int>(y), m_height - 2);
+    const int column = static_cast<int>(x);
+    const double ty = y - row;
+    const double tx = x - column;
+
+    if (m_interpolation == Interpolation::Bilinear)
+    {
+        const double top = node(row, column) * (1.0 - tx) + node(row, column + 1) * tx;
+        const double bottom = node(row + 1, column) * (1.0 - tx) + node(row + 1, column + 1) * tx;
+        undulation = top * (1.0 - ty) + bottom * ty;
+        return true;
+    }
+
+    double wx[4];
+    double wy[4];
+    cubicWeights(tx, wx);
+    cubicWeights(ty, wy);
+    undulation = 0.0;
+    for (int i = 0; i < 4; i++)
+    {
+        double line = 0.0;
+        for (int j = 0; j < 4; j++)
+        {
+            line += wx[j] * node(row - 1 + i, column - 1 + j);
+        }
+        undulation += wy[i] * line;
+    }
+    return true;
+}
+
+/*!
+ Height of the grid node at \a row and \a column, which wraps around in longitude and is clamped at the poles.
+ */
+float GeoidModel::node(int row, int column)
+{
+    row = std::max(0, std::min(m_height - 1, row));
+    column %= m_width;
+    if (column < 0)
+    {
+        column += m_width;
+    }
+
+    const int tiles_per_row = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+    const Tile &t = tile((row / TILE_SIZE) * tiles_per_row + column / TILE_SIZE);
+    return t.heights[(row % TILE_SIZE) * TILE_SIZE + column % TILE_SIZE];
+}
+
+/*!
+ Returns the decoded tile \a key, decoding it over the least recently used one on a miss.
+ */
+const GeoidModel::Tile &GeoidModel::tile(int key)
+{
+    m_useCount++;
+    if (m_tiles[m_lastTile].key == key)
+    {
+        m_tiles[m_lastTile].used = m_useCount;
+        return m_tiles[m_lastTile];
+    }
+
+    int victim = 0;
+    for (int i = 0; i < CACHE_TILES; i++)
+    {
+        if (m_tiles[i].key == key)
+        {
+            m_lastTile = i;
+            m_tiles[i].used = m_useCount;
+            return m_tiles[i];
+        }
+        if (m_tiles[i].used < m_tiles[victim].used)
+        {
+            victim = i;
+        }
+    }
+
+    Tile &t = m_tiles[victim];
+    const int tiles_per_row = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+    const int first_row = (key / tiles_per_row) * TILE_SIZE;
+    const int first_column = (key % tiles_per_row) * TILE_SIZE;
+    const int rows = m_height - first_row < TILE_SIZE ? m_height - first_row : TILE_SIZE;
+    const int columns = m_width - first_column < TILE_SIZE ? m_width - first_column : TILE_SIZE;
+    for (int r = 0; r < rows; r++)
+    {
+        const uchar *sample = m_data + 2 * (static_cast<qint64>(first_row + r) * m_width + first_column);
+        for (int c = 0; c < columns; c++, sample += 2)
+        {
+            const int raw = (sample[0] << 8) | sample[1];
+            t.heights[r * TILE_SIZE + c] = static_cast<float>(m_offset + m_scale * raw);
+        }
+    }
+    t.key = key;
+    t.used = m_useCount;
+    m_lastTile = victim;
+    return t;
+}
+
+/*!
+ Returns the most detailed geoid grid installed where GeographicLib looks for them, or an empty string.
+ */
+QString GeoidModel::findDefault()
+{
+    QStringList directories;
+    for (const char *variable : {"GEOGRAPHICLIB_GEOID_PATH", "GEOGRAPHICLIB_DATA"})
+    {
+        const QString value = QString::fromLocal8Bit(qgetenv(variable));
+        if (!value.isEmpty())
+        {
+            directories << (QString(variable) == "GEOGRAPHICLIB_DATA" ? value + "/geoids" : value);
+        }
+    }
+    directories << "/usr/local/share/GeographicLib/geoids"
+                << "/usr/share/GeographicLib/geoids"
+                << "/opt/homebrew/share/GeographicLib/geoids";
+
+    const QStringList names = {"egm2008-1.pgm", "egm2008-2_5.pgm", "egm2008-5.pgm", "egm96-5.pgm", "egm96-15.pgm"};
+    for (const QString &directory : directories)
+    {
+        for (const QString &name : names)
+        {
+            QFileInfo info(QDir(directory).filePath(name));
+            if (info.isFile())
+            {
+                return info.absoluteFilePath();
+            }
+        }
+    }
+    return QString();
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file geoid_model.h
+ * \brief Interface of a geoid model interpolated from a memory-mapped grid file.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_GEOID_MODEL_H_
+#define GNSS_SDR_MONITOR_GEOID_MODEL_H_
+
+#include <QFile>
+#include <QString>
+#include <array>
+#include <cstdint>
+
+/*!
+ Geoid undulation interpolated from a global grid such as EGM96 or EGM2008.
+
+ The grid is read in the format of the GeographicLib geoid files (egm96-5.pgm,
+ egm2008-1.pgm...): a binary PGM of big-endian 16-bit samples, one row per
+ latitude from 90 degrees north and one column per longitude from 0 degrees
+ east, with the offset and scale of the samples in the header comments. The
+ file is memory-mapped and the samples around the receiver are decoded once
+ into a small cache of tiles, so an epoch costs a few multiplications and no
+ I/O after the first.
+ */
+class GeoidModel
+{
+public:
+    enum class Interpolation
+    {
+        Bilinear,
+        Bicubic
+    };
+
+    static constexpr int TILE_SIZE = 16;   // Nodes per side of a cached tile
+    static constexpr int CACHE_TILES = 8;
+
+    GeoidModel();
+    ~GeoidModel();
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    QString fileName() const { return m_file.fileName(); }
+    QString errorString() const { return m_errorString; }
+
+    void setInterpolation(Interpolation interpolation) { m_interpolation = interpolation; }
+    Interpolation interpolation() const { return m_interpolation; }
+
+    // Height of the geoid above the WGS 84 ellipsoid, in metres.
+    bool undulation(double latitude, double longitude, double &undulation);
+
+    // Geoid grids found in the usual GeographicLib locations.
+    static QString findDefault();
+
+private:
+    struct Tile
+    {
+        int key = -1;
+        uint64_t used = 0;
+        std::array<float, TILE_SIZE * TILE_SIZE> heights;
+    };
+
+    bool fail(const QString &message);
+    float node(int row, int column);
+    const Tile &tile(int key);
+
+    QFile m_file;
+    const uchar *m_data = nullptr;  // First sample of the mapped grid
+    int m_width = 0;
+    int m_height = 0;
+    double m_offset = 0.0;
+    double m_scale = 1.0;
+    double m_rowSpacing = 0.0;     // [deg]
+    double m_columnSpacing = 0.0;  // [deg]
+    Interpolation m_interpolation = Interpolation::Bilinear;
+    QString m_errorString;
+
+    std::array<Tile, CACHE_TILES> m_tiles;
+    int m_lastTile = 0;
+    uint64_t m_useCount = 0;
+};
+
+#endif  // GNSS_SDR_MONITOR_GEOID_MODEL_H_
@@ -0,0 +1,285 @@
+/*!
+ * \file gnss_time.cpp
+ * \brief Implementation of the GNSS time service: conversions between GNSS
+ * time scales, week unwrapping and cached UTC formatting.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "gnss_time.h"
+#include <QDateTime>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+struct LeapSecond
+{
+    qint64 gps_seconds;  // First GPS second at which the new offset applies.
+    int gps_utc;         // GPS-UTC offset from then on, in seconds.
+};
+
+// GPS-UTC offsets since the GPS epoch. Append new entries as the IERS announces them.
+const LeapSecond LEAP_SECONDS[] = {
+    {46828801, 1},    // 1981-07-01
+    {78364802, 2},    // 1982-07-01
+    {109900803, 3},   // 1983-07-01
+    {173059204, 4},   // 1985-07-01
+    {252028805, 5},   // 1988-01-01
+    {315187206, 6},   // 1990-01-01
+    {346723207, 7},   // 1991-01-01
+    {393984008, 8},   // 1992-07-01
+    {425520009, 9},   // 1993-07-01
+    {457056010, 10},  // 1994-07-01
+    {504489611, 11},  // 1996-01-01
+    {551750412, 12},  // 1997-07-01
+    {599184013, 13},  // 1999-01-01
+    {820108814, 14},  // 2006-01-01
+    {914803215, 15},  // 2009-01-01
+    {1025136016, 16}, // 2012-07-01
+    {1119744017, 17}, // 2015-07-01
+    {1167264018, 18}  // 2017-01-01
+};
+
+const double HALF_WEEK = GnssTime::SECONDS_PER_WEEK / 2.0;
+}  // namespace
+
+
+/*!
+ Returns the formatted UTC string for the instant \a utc_seconds (since the Unix epoch) plus \a fraction of a second.
+ */
+QString UtcFormatter::format(qint64 utc_seconds, double fraction)
+{
+    qint64 minute = utc_seconds / 60;
+    if (minute != m_minute)
+    {
+        m_minute = minute;
+        m_minutePrefix = QDateTime::fromSecsSinceEpoch(minute * 60, Qt::UTC).toString("yyyy-MMM-dd hh:mm:");
+        m_second = -1;
+    }
+
+    if (utc_seconds != m_second)
+    {
+        m_second = utc_seconds;
+        m_secondText = QString("%1").arg(utc_seconds % 60, 2, 10, QChar('0'));
+    }
+
+    int micros = std::min(999999, static_cast<int>(std::lround(fraction * 1e6)));
+
+    QString text;
+    text.reserve(m_minutePrefix.size() + 16);
+    text.append(m_minutePrefix).append(m_secondText).append('.');
+    text.append(QString("%1").arg(micros, 6, 10, QChar('0')));
+    text.append(QStringLiteral(" UTC"));
+    return text;
+}
+
+void UtcFormatter::reset()
+{
+    m_minute = -1;
+    m_second = -1;
+}
+
+
+double GnssTime::gpsSeconds(quint32 week, double tow)
+{
+    return static_cast<double>(week) * SECONDS_PER_WEEK + tow;
+}
+
+int GnssTime::leapSeconds(double gps_seconds)
+{
+    int offset = 0;
+    for (const LeapSecond &leap : LEAP_SECONDS)
+    {
+        if (gps_seconds < leap.gps_seconds)
+        {
+            break;
+        }
+        offset = leap.gps_utc;
+    }
+    return offset;
+}
+
+double GnssTime::fromGps(double gps_seconds, TimeSystem target)
+{
+    switch (target)
+    {
+    case TimeSystem::GPS:
+        return gps_seconds;
+    case TimeSystem::UTC:
+        return gps_seconds - leapSeconds(gps_seconds) + GPS_EPOCH_UNIX;
+    case TimeSystem::GST:
+        return gps_seconds - GST_EPOCH_GPS_WEEK * SECONDS_PER_WEEK;
+    case TimeSystem::BDT:
+        return gps_seconds - BDT_EPOCH_GPS_WEEK * SECONDS_PER_WEEK - BDT_GPS_OFFSET;
+    case TimeSystem::GLONASS:
+        return fromGps(gps_seconds, TimeSystem::UTC) + GLONASS_UTC_OFFSET;
+    }
+    return gps_seconds;
+}
+
+double GnssTime::toGps(double seconds, TimeSystem source)
+{
+    switch (source)
+    {
+    case TimeSystem::GPS:
+        return seconds;
+    case TimeSystem::UTC:
+        {
+            // The offset depends on the GPS time we are solving for, so evaluate
+            // it at the estimate obtained with the offset of the UTC instant.
+            double gps = seconds - GPS_EPOCH_UNIX;
+            gps += leapSeconds(gps);
+            return seconds - GPS_EPOCH_UNIX + leapSeconds(gps);
+        }
+    case TimeSystem::GST:
+        return seconds + GST_EPOCH_GPS_WEEK * SECONDS_PER_WEEK;
+    case TimeSystem::BDT:
+        return seconds + BDT_EPOCH_GPS_WEEK * SECONDS_PER_WEEK + BDT_GPS_OFFSET;
+    case TimeSystem::GLONASS:
+        return toGps(seconds - GLONASS_UTC_OFFSET, TimeSystem::UTC);
+    }
+    return seconds;
+}
+
+
+/*!
+ Constructs a time service with no time reference.
+ */
+GnssTime::GnssTime()
+{
+    reset();
+}
+
+/*!
+ Maps the time of week \a tow of a sample without week number to the continuous time axis.
+ */
+double GnssTime::continuousTime(double tow)
+{
+    if (!m_hasReference)
+    {
+        m_hasReference = true;
+        m_lastTow = tow;
+    }
+
+    if (tow < m_lastTow - HALF_WEEK)
+    {
+        // Week rollover.
+        m_currentWeek++;
+        m_lastTow = tow;
+    }
+    else if (tow > m_lastTow + HALF_WEEK)
+    {
+        // Late sample from the previous week, do not move the state backwards.
+        return static_cast<double>(m_currentWeek - 1 - m_referenceWeek) * SECONDS_PER_WEEK + tow;
+    }
+    else if (tow > m_lastTow)
+    {
+        m_lastTow = tow;
+    }
+
+    return static_cast<double>(m_currentWeek - m_referenceWeek) * SECONDS_PER_WEEK + tow;
+}
+
+/*!
+ Maps the \a week and time of week \a tow of a sample to the continuous time axis.
+ */
+double GnssTime::continuousTime(quint32 week, double tow)
+{
+    if (!m_weekKnown)
+    {
+        // Re-anchor the relative weeks counted so far on the absolute week number,
+        // keeping every value already handed out unchanged.
+        if (!m_hasReference)
+        {
+            m_hasReference = true;
+            m_lastTow = tow;
+            m_currentWeek = week;
+            m_referenceWeek = week;
+        }
+        else
+        {
+            qint64 shift = static_cast<qint64>(week) - m_currentWeek;
+            m_currentWeek += shift;
+            m_referenceWeek += shift;
+        }
+        m_weekKnown = true;
+    }
+
+    if (static_cast<qint64>(week) > m_currentWeek ||
+        (static_cast<qint64>(week) == m_currentWeek && tow > m_lastTow))
+    {
+        m_currentWeek = week;
+        m_lastTow = tow;
+    }
+
+    return static_cast<double>(static_cast<qint64>(week) - m_referenceWeek) * SECONDS_PER_WEEK + tow;
+}
+
+/*!
+ Returns the UTC time corresponding to the GPS \a week and time of week \a tow as a formatted string.
+ */
+QString GnssTime::formatUtc(quint32 week, double tow)
+{
+    double whole_tow = std::floor(tow);
+    qint64 gps_int_seconds = static_cast<qint64>(week) * SECONDS_PER_WEEK + static_cast<qint64>(whole_tow);
+    qint64 utc_seconds = gps_int_seconds - leapSeconds(gps_int_seconds) + GPS_EPOCH_UNIX;
+
+    return m_utcFormatter.format(utc_seconds, tow - whole_tow);
+}
+
+/*!
+ Forgets the time reference, so that the next sample restarts the continuous time axis.
+ */
+void GnssTime::reset()
+{
+    m_hasReference = false;
+    m_weekKnown = false;
+    m_referenceWeek = 0;
+    m_currentWeek = 0;
+    m_lastTow = 0.0;
+    m_utcFormatter.reset();
+}
+
+GnssTime::State GnssTime::state() const
+{
+    return {m_hasReference, m_weekKnown, m_referenceWeek, m_currentWeek, m_lastTow};
+}
+
+/*!
+ Continues the continuous time axis from \a state, as saved by state() in an earlier session.
+ */
+void GnssTime::restore(const State &state)
+{
+    m_hasReference = state.hasReference;
+    m_weekKnown = state.weekKnown;
+    m_referenceWeek = state.referenceWeek;
+    m_currentWeek = state.currentWeek;
+    m_lastTow = state.lastTow;
+    m_utcFormatter.reset();
+}
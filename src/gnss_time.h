@@ -0,0 +1,135 @@
+/*!
+ * \file gnss_time.h
+ * \brief Interface of the GNSS time service: conversions between GNSS
+ * time scales, week unwrapping and cached UTC formatting.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_GNSS_TIME_H_
+#define GNSS_SDR_MONITOR_GNSS_TIME_H_
+
+#include <QString>
+#include <QtGlobal>
+
+enum class TimeSystem
+{
+    GPS,
+    UTC,
+    GST,     // Galileo System Time
+    BDT,     // BeiDou Time
+    GLONASS  // UTC(SU) + 3 h
+};
+
+/*!
+ Formats UTC instants as "yyyy-MMM-dd hh:mm:ss.ffffff UTC".
+
+ The date and minute prefix is only rendered by QDateTime when the minute
+ changes and the seconds field only when the second changes; between those
+ only the fractional part is formatted.
+ */
+class UtcFormatter
+{
+public:
+    QString format(qint64 utc_seconds, double fraction);
+    void reset();
+
+private:
+    qint64 m_minute = -1;
+    qint64 m_second = -1;
+    QString m_minutePrefix;
+    QString m_secondText;
+};
+
+/*!
+ Central time service shared by every view of the monitor.
+
+ The static helpers convert between GPS time and the other GNSS time scales
+ using the built-in GPS-UTC leap second table. The instance keeps the state
+ needed to turn time-of-week stamps into a continuous time axis that does not
+ jump back at the week rollover, and caches the formatted UTC string.
+ */
+class GnssTime
+{
+public:
+    static constexpr qint64 SECONDS_PER_WEEK = 604800;
+    static constexpr qint64 GPS_EPOCH_UNIX = 315964800;  // 1980-01-06T00:00:00Z
+    static constexpr qint64 GST_EPOCH_GPS_WEEK = 1024;   // 1999-08-22T00:00:00 GPS
+    static constexpr qint64 BDT_EPOCH_GPS_WEEK = 1356;   // 2006-01-01T00:00:00 BDT
+    static constexpr qint64 BDT_GPS_OFFSET = 14;         // BDT = GPS - 14 s
+    static constexpr qint64 GLONASS_UTC_OFFSET = 10800;  // UTC(SU) + 3 h
+
+    // Seconds since the GPS epoch for a given GPS week and time of week.
+    static double gpsSeconds(quint32 week, double tow);
+
+    // GPS-UTC offset in force at \a gps_seconds, from the leap second table.
+    static int leapSeconds(double gps_seconds);
+
+    // Converts \a gps_seconds since the GPS epoch to seconds of \a target.
+    // UTC and GLONASS results are seconds since the Unix epoch, GST and BDT
+    // results are seconds since their own epochs.
+    static double fromGps(double gps_seconds, TimeSystem target);
+    static double toGps(double seconds, TimeSystem source);
+
+    GnssTime();
+
+    // Continuous time axis, in seconds, for series stamped with a time of
+    // week only. Rollovers are detected as backward jumps of more than half
+    // a week; late samples from the previous week are mapped back to it.
+    double continuousTime(double tow);
+
+    // Continuous time axis, in seconds, for series carrying a week number.
+    double continuousTime(quint32 week, double tow);
+
+    // Formatted UTC time for a GPS week and time of week.
+    QString formatUtc(quint32 week, double tow);
+
+    void reset();
+
+    // What continuousTime() has learned so far, to keep restored series on the same axis.
+    struct State
+    {
+        bool hasReference = false;
+        bool weekKnown = false;
+        qint64 referenceWeek = 0;
+        qint64 currentWeek = 0;
+        double lastTow = 0.0;
+    };
+    State state() const;
+    void restore(const State &state);
+
+private:
+    bool m_hasReference;
+    bool m_weekKnown;        // False while only TOW-only samples have been seen.
+    qint64 m_referenceWeek;  // Week mapped to t = 0 on the continuous axis.
+    qint64 m_currentWeek;    // Week of the most recent sample.
+    double m_lastTow;
+    UtcFormatter m_utcFormatter;
+};
+
+#endif  // GNSS_SDR_MONITOR_GNSS_TIME_H_
@@ -34,6 +34,7 @@ GpsEphemerisWrapper::GpsEphemerisWrapper(QObject *parent)
     : QObject{parent}
 {
     m_bufferSize = 100;
+    m_bufferEphemeris.setCapacity(m_bufferSize);
 }
 
 void GpsEphemerisWrapper::addGpsEphemeris(const gnss_sdr::GpsEphemeris &gpsEphemeris)
@@ -32,7 +32,7 @@
 #define GPS_EPHEMERIS_WRAPPER_H
 
 #include "gps_ephemeris.pb.h"
-#include <boost/circular_buffer.hpp>
+#include "ring_buffer.h"
 #include <QObject>
 #include <QVariant>
 
@@ -51,7 +51,7 @@ signals:
 
 private:
     size_t m_bufferSize;
-    boost::circular_buffer<gnss_sdr::GpsEphemeris> m_bufferEphemeris;
+    RingBuffer<gnss_sdr::GpsEphemeris> m_bufferEphemeris;
 };
 
 #endif  // GPS_EPHEMERIS_WRAPPER_H
@@ -0,0 +1,282 @@
+/*!
+ * \file health_matrix_widget.cpp
+ * \brief Implementation of a widget that shows the health and integrity flags of
+ * the GPS constellation as a PRN by flag matrix.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "health_matrix_widget.h"
+#include <QHelpEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <algorithm>
+
+namespace
+{
+QColor severityColor(SatelliteHealth::Severity severity)
+{
+    switch (severity)
+    {
+    case SatelliteHealth::Severity::Fault:
+        return QColor(220, 60, 60);
+    case SatelliteHealth::Severity::Warning:
+        return QColor(240, 170, 60);
+    default:
+        return QColor(120, 160, 210);
+    }
+}
+}  // namespace
+
+/*!
+ Constructs a HealthMatrixWidget with one column per GPS PRN and one row per flag.
+ */
+HealthMatrixWidget::HealthMatrixWidget(QWidget *parent) : QWidget(parent)
+{
+    setMinimumSize(minimumSizeHint());
+}
+
+/*!
+ Sets the flags shown by the matrix. The widget does not take ownership of \a health.
+ */
+void HealthMatrixWidget::setSatelliteHealth(const SatelliteHealth *health)
+{
+    m_health = health;
+    update();
+}
+
+/*!
+ Sets the PRNs currently tracked by the receiver. They are marked under their number
+ and, if unhealthy, outlined in red. The matrix is repainted by the next redraw().
+ */
+void HealthMatrixWidget::setTracked(const SatelliteHealth::PrnSet &tracked)
+{
+    m_tracked = tracked;
+}
+
+QSize HealthMatrixWidget::minimumSizeHint() const
+{
+    return QSize(LABEL_WIDTH + SatelliteHealth::MAX_PRN * MIN_CELL_WIDTH + 2 * MARGIN,
+        HEADER_HEIGHT + SatelliteHealth::FLAG_COUNT * ROW_HEIGHT + 2 * MARGIN);
+}
+
+/*!
+ Repaints the matrix if the flags or the tracked satellites changed since the last paint.
+ */
+void HealthMatrixWidget::redraw()
+{
+    uint64_t revision = m_health ? m_health->revision() : 0;
+    if (revision != m_drawnRevision || m_tracked != m_drawnTracked)
+    {
+        update();
+    }
+}
+
+void HealthMatrixWidget::clear()
+{
+    m_tracked.reset();
+    update();
+}
+
+QRect HealthMatrixWidget::cellRect(int prn, int row) const
+{
+    int cell_width = std::max(MIN_CELL_WIDTH, (width() - LABEL_WIDTH - 2 * MARGIN) / SatelliteHealth::MAX_PRN);
+    int x = MARGIN + LABEL_WIDTH + (prn - 1) * cell_width;
+    if (row < 0)
+    {
+        return QRect(x, MARGIN, cell_width, HEADER_HEIGHT);
+    }
+    return QRect(x, MARGIN + HEADER_HEIGHT + row * ROW_HEIGHT, cell_width, ROW_HEIGHT);
+}
+
+/*!
+ Returns the PRN under \a point, or 0, and sets \a row to the flag row, -1 for the header.
+ */
+int HealthMatrixWidget::prnAt(const QPoint &point, int &row) const
+{
+    QRect first = cellRect(1, -1);
+    int x = point.x() - first.left();
+    int y = point.y() - MARGIN;
+    if (x < 0 || y < 0)
+    {
+        return 0;
+    }
+
+    int prn = x / first.width() + 1;
+    row = y < HEADER_HEIGHT ? -1 : (y - HEADER_HEIGHT) / ROW_HEIGHT;
+    if (prn > SatelliteHealth::MAX_PRN || row >= SatelliteHealth::FLAG_COUNT)
+    {
+        return 0;
+    }
+    return prn;
+}
+
+/*!
+ Describes satellite \a prn, and the flag of \a row if any. Only built when a tooltip is requested.
+ */
+QString HealthMatrixWidget::toolTip(int prn, int row) const
+{
+    QString text = QString("GPS PRN %1").arg(prn, 2, 10, QChar('0'));
+    if (m_tracked[prn])
+    {
+        text += " (tracked)";
+    }
+    if (!m_health || !m_health->contains(prn))
+    {
+        return text + "\nNo ephemeris yet";
+    }
+
+    text += QString("\nIODE %1, SV health %2, URA index %3")
+                .arg(m_health->iode(prn))
+                .arg(m_health->health(prn))
+                .arg(m_health->ura(prn));
+    if (row >= 0)
+    {
+        auto flag = static_cast<SatelliteHealth::Flag>(row);
+        text += QString("\n%1: %2")
+                    .arg(SatelliteHealth::flagDescription(flag))
+                    .arg(m_health->flags(prn)[flag] ? "yes" : "no");
+    }
+    return text;
+}
+
+bool HealthMatrixWidget::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip)
+    {
+        auto *help = static_cast<QHelpEvent *>(event);
+        int row = -1;
+        int prn = prnAt(help->pos(), row);
+        if (prn > 0)
+        {
+            QToolTip::showText(help->globalPos(), toolTip(prn, row), this);
+        }
+        else
+        {
+            QToolTip::hideText();
+            event->ignore();
+        }
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+void HealthMatrixWidget::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    drawStaticLayer(painter);
+
+    m_drawnRevision = m_health ? m_health->revision() : 0;
+    m_drawnTracked = m_tracked;
+    if (!m_health)
+    {
+        return;
+    }
+
+    // Cells only: every label lives in the static layer.
+    const QColor clear_color(200, 235, 200);
+    for (int prn = 1; prn <= SatelliteHealth::MAX_PRN; prn++)
+    {
+        if (m_tracked[prn])
+        {
+            QRect header = cellRect(prn, -1);
+            painter.fillRect(header.left() + 1, header.bottom() - 2, header.width() - 2, 3, QColor(40, 110, 200));
+        }
+        if (!m_health->contains(prn))
+        {
+            continue;
+        }
+
+        const SatelliteHealth::Flags flags = m_health->flags(prn);
+        for (int row = 0; row < SatelliteHealth::FLAG_COUNT; row++)
+        {
+            QColor color = flags[row] ? severityColor(SatelliteHealth::severity(static_cast<SatelliteHealth::Flag>(row)))
+                                      : clear_color;
+            painter.fillRect(cellRect(prn, row).adjusted(1, 1, -1, -1), color);
+        }
+    }
+
+    // Outline the tracked satellites that should not be used.
+    const SatelliteHealth::PrnSet alarm = m_tracked & m_health->unhealthy();
+    if (alarm.any())
+    {
+        painter.setPen(QPen(QColor(200, 0, 0), 2));
+        painter.setBrush(Qt::NoBrush);
+        for (int prn = 1; prn <= SatelliteHealth::MAX_PRN; prn++)
+        {
+            if (alarm[prn])
+            {
+                painter.drawRect(cellRect(prn, -1).united(cellRect(prn, SatelliteHealth::FLAG_COUNT - 1)).adjusted(1, 1, -1, -1));
+            }
+        }
+    }
+}
+
+void HealthMatrixWidget::drawStaticLayer(QPainter &painter)
+{
+    // Flag names, PRN numbers and the grid only depend on the geometry.
+    const qreal dpr = painter.device()->devicePixelRatioF();
+    if (!m_staticLayer.isNull() && m_staticLayerDpr == dpr && m_staticLayer.size() == size() * dpr)
+    {
+        painter.drawImage(QPointF(0, 0), m_staticLayer);
+        return;
+    }
+
+    m_staticLayer = QImage(size() * dpr, QImage::Format_ARGB32_Premultiplied);
+    m_staticLayer.setDevicePixelRatio(dpr);
+    m_staticLayer.fill(palette().color(QPalette::Window));
+    m_staticLayerDpr = dpr;
+
+    QPainter layer(&m_staticLayer);
+    QFont font = this->font();
+    font.setPointSize(8);
+    layer.setFont(font);
+    layer.setPen(palette().color(QPalette::WindowText));
+
+    for (int row = 0; row < SatelliteHealth::FLAG_COUNT; row++)
+    {
+        QRect label(MARGIN, cellRect(1, row).top(), LABEL_WIDTH - 4, ROW_HEIGHT);
+        layer.drawText(label, Qt::AlignRight | Qt::AlignVCenter,
+            SatelliteHealth::flagName(static_cast<SatelliteHealth::Flag>(row)));
+    }
+    for (int prn = 1; prn <= SatelliteHealth::MAX_PRN; prn++)
+    {
+        layer.drawText(cellRect(prn, -1), Qt::AlignCenter, QString::number(prn));
+    }
+
+    // Empty cells, for the satellites without ephemeris.
+    for (int prn = 1; prn <= SatelliteHealth::MAX_PRN; prn++)
+    {
+        for (int row = 0; row < SatelliteHealth::FLAG_COUNT; row++)
+        {
+            layer.fillRect(cellRect(prn, row).adjusted(1, 1, -1, -1), QColor(225, 225, 225));
+        }
+    }
+
+    painter.drawImage(QPointF(0, 0), m_staticLayer);
+}
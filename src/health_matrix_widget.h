@@ -0,0 +1,83 @@
+/*!
+ * \file health_matrix_widget.h
+ * \brief Interface of a widget that shows the health and integrity flags of
+ * the GPS constellation as a PRN by flag matrix.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_HEALTH_MATRIX_WIDGET_H_
+#define GNSS_SDR_MONITOR_HEALTH_MATRIX_WIDGET_H_
+
+#include "satellite_health.h"
+#include <QImage>
+#include <QWidget>
+
+class HealthMatrixWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit HealthMatrixWidget(QWidget *parent = nullptr);
+
+    void setSatelliteHealth(const SatelliteHealth *health);
+    void setTracked(const SatelliteHealth::PrnSet &tracked);
+
+    QSize minimumSizeHint() const override;
+
+public slots:
+    void redraw();
+    void clear();
+
+protected:
+    bool event(QEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void drawStaticLayer(QPainter &painter);
+    QRect cellRect(int prn, int row) const;
+    int prnAt(const QPoint &point, int &row) const;
+    QString toolTip(int prn, int row) const;
+
+    const SatelliteHealth *m_health = nullptr;
+    SatelliteHealth::PrnSet m_tracked;
+    uint64_t m_drawnRevision = 0;
+    SatelliteHealth::PrnSet m_drawnTracked;
+
+    // Labels and grid, redrawn only when the geometry changes
+    QImage m_staticLayer;
+    qreal m_staticLayerDpr = 0.0;
+
+    static constexpr int LABEL_WIDTH = 70;
+    static constexpr int HEADER_HEIGHT = 20;
+    static constexpr int ROW_HEIGHT = 18;
+    static constexpr int MIN_CELL_WIDTH = 16;
+    static constexpr int MARGIN = 5;
+};
+
+#endif  // GNSS_SDR_MONITOR_HEALTH_MATRIX_WIDGET_H_
@@ -0,0 +1,173 @@
+/*!
+ * \file history_window.h
+ * \brief Retention of a series as a span of time, with the ring capacity that
+ * holds it sized from the estimated rate of the series.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_HISTORY_WINDOW_H_
+#define GNSS_SDR_MONITOR_HISTORY_WINDOW_H_
+
+#include "ring_buffer.h"
+#include <cmath>
+#include <cstddef>
+
+/*!
+ Keeps a series for a number of seconds instead of a number of samples, so that series
+ that arrive at different rates cover the same span and their charts line up.
+
+ The rate is estimated from the times of the samples, smoothed over a few dozen of
+ them. The capacity follows it: it grows as soon as the window no longer fits, and
+ shrinks only when the window fills less than half of it, so that it is not resized
+ back and forth as the rate jitters. Gaps in the series are limited to four times the
+ current interval, so that a pause does not shrink the capacity at once.
+ */
+class HistoryWindow
+{
+public:
+    static constexpr double DEFAULT_SECONDS = 60.0;
+    static constexpr size_t MIN_CAPACITY = 16;
+    static constexpr size_t MAX_CAPACITY = size_t(1) << 20;
+
+    explicit HistoryWindow(double seconds = DEFAULT_SECONDS) { setSeconds(seconds); }
+
+    /*!
+     Sets the length of the window to \a seconds and sizes the capacity for it at the rate estimated so far.
+     */
+    void setSeconds(double seconds)
+    {
+        m_seconds = seconds > 0.0 ? seconds : DEFAULT_SECONDS;
+        m_capacity = m_interval > 0.0 ? capacityFor(m_interval) : MIN_CAPACITY;
+    }
+
+    double seconds() const { return m_seconds; }
+    size_t capacity() const { return m_capacity; }
+    double rate() const { return m_interval > 0.0 ? 1.0 / m_interval : 0.0; }
+
+    /*!
+     Feeds the \a time of a new sample, in seconds. Returns true if capacity() changed, so that
+     the caller resizes its rings.
+     */
+    bool observe(double time)
+    {
+        if (m_hasTime && time > m_lastTime)
+        {
+            double interval = time - m_lastTime;
+            if (m_interval <= 0.0)
+            {
+                m_interval = interval;
+            }
+            else
+            {
+                interval = interval < 4.0 * m_interval ? interval : 4.0 * m_interval;
+                m_interval += (interval - m_interval) / SMOOTHING;
+            }
+        }
+        m_lastTime = time;
+        m_hasTime = true;
+        if (m_interval <= 0.0)
+        {
+            return false;
+        }
+
+        const double needed = std::ceil(m_seconds / m_interval) + 1.0;
+        if (needed <= static_cast<double>(m_capacity) && needed * MARGIN >= 0.5 * static_cast<double>(m_capacity))
+        {
+            return false;
+        }
+        const size_t capacity = capacityFor(m_interval);
+        if (capacity == m_capacity)
+        {
+            return false;
+        }
+        m_capacity = capacity;
+        return true;
+    }
+
+    /*!
+     Forgets the rate, for a series that starts again. The capacity is kept until the new rate is known.
+     */
+    void reset()
+    {
+        m_hasTime = false;
+        m_interval = 0.0;
+    }
+
+private:
+    static constexpr double MARGIN = 1.25;
+    static constexpr double SMOOTHING = 32.0;
+
+    size_t capacityFor(double interval) const
+    {
+        const double capacity = std::ceil((std::ceil(m_seconds / interval) + 1.0) * MARGIN);
+        if (capacity >= static_cast<double>(MAX_CAPACITY))
+        {
+            return MAX_CAPACITY;
+        }
+        return capacity <= static_cast<double>(MIN_CAPACITY) ? MIN_CAPACITY : static_cast<size_t>(capacity);
+    }
+
+    double m_seconds = DEFAULT_SECONDS;
+    size_t m_capacity = MIN_CAPACITY;
+    double m_interval = 0.0;  // Smoothed time between samples [s], 0 until known.
+    double m_lastTime = 0.0;
+    bool m_hasTime = false;
+};
+
+/*!
+ Returns the index of the first element of \a buffer, sorted by time, whose time given by
+ \a time_of is not before \a start. Returns buffer.size() if there is none.
+ */
+template <typename T, typename TimeOf>
+size_t ringLowerBound(const RingBuffer<T> &buffer, double start, TimeOf time_of)
+{
+    size_t first = 0;
+    size_t count = buffer.size();
+    while (count > 0)
+    {
+        const size_t half = count / 2;
+        if (time_of(buffer[first + half]) < start)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+    return first;
+}
+
+inline size_t ringLowerBound(const RingBuffer<double> &buffer, double start)
+{
+    return ringLowerBound(buffer, start, [](double time) { return time; });
+}
+
+#endif  // GNSS_SDR_MONITOR_HISTORY_WINDOW_H_
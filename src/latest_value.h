@@ -0,0 +1,131 @@
+/*!
+ * \file latest_value.h
+ * \brief Triple-buffered cell that publishes the latest value of a
+ * trivially copyable type from one writer to any number of readers.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_LATEST_VALUE_H_
+#define GNSS_SDR_MONITOR_LATEST_VALUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*!
+ Single-writer, multi-reader cell holding the most recently published value.
+
+ The writer rotates through three slots, so the slot a reader picks up is not
+ written again until two more values have been published. Each slot carries a
+ sequence number that readers check after copying; a reader only retries in the
+ unlikely case it was preempted for two whole publication periods. Neither side
+ ever takes a lock or allocates.
+ */
+template <typename T>
+class LatestValue
+{
+    static_assert(std::is_trivially_copyable<T>::value, "LatestValue requires a trivially copyable type");
+
+public:
+    LatestValue() = default;
+    LatestValue(const LatestValue &) = delete;
+    LatestValue &operator=(const LatestValue &) = delete;
+
+    /*!
+     Publishes \a value. Must only be called from one thread at a time.
+     */
+    void publish(const T &value)
+    {
+        uint64_t version = m_version + 1;
+        Slot &slot = m_slots[version % 3];
+
+        uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.value, &value, sizeof(T));
+        slot.seq.store(seq + 2, std::memory_order_release);
+
+        m_version = version;
+        m_latest.store(version, std::memory_order_release);
+    }
+
+    /*!
+     Copies the latest published value into \a out. Returns false if nothing was published yet.
+     */
+    bool read(T &out) const
+    {
+        for (;;)
+        {
+            uint64_t version = m_latest.load(std::memory_order_acquire);
+            if (version == 0)
+            {
+                return false;
+            }
+
+            const Slot &slot = m_slots[version % 3];
+            uint64_t before = slot.seq.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                continue;
+            }
+
+            std::memcpy(&out, &slot.value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.seq.load(std::memory_order_relaxed) == before)
+            {
+                return true;
+            }
+        }
+    }
+
+    /*!
+     Returns the number of values published so far (0 means the cell is empty).
+     */
+    uint64_t version() const { return m_latest.load(std::memory_order_acquire); }
+
+    /*!
+     Marks the cell as empty. Must be called from the writer thread.
+     */
+    void reset() { m_latest.store(0, std::memory_order_release); }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> seq{0};
+        T value{};
+    };
+
+    Slot m_slots[3];
+    std::atomic<uint64_t> m_latest{0};
+    uint64_t m_version = 0;  // Writer-side copy of m_latest.
+};
+
+#endif  // GNSS_SDR_MONITOR_LATEST_VALUE_H_
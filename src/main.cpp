@@ -30,8 +30,13 @@
  */
 
 
+#include "dashboard_snapshotter.h"
 #include "main_window.h"
+#include "recording_editor.h"
+#include "replay_benchmark.h"
+#include "session_diff.h"
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDesktopWidget>
 #include <QStyle>
 
@@ -42,7 +47,51 @@ int main(int argc, char *argv[])
     app.setOrganizationDomain("gnss-sdr.org");
     app.setApplicationName("gnss-sdr-monitor");
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription("A graphical user interface to monitor the GNSS-SDR status in real time.");
+    parser.addHelpOption();
+    ReplayBenchmark::addOptions(parser);
+    DashboardSnapshotter::addOptions(parser);
+    SessionDiff::addOptions(parser);
+    RecordingEditor::addOptions(parser);
+    parser.process(app);
+
+    if (parser.isSet("benchmark"))
+    {
+        ReplayBenchmark benchmark(ReplayBenchmark::options(parser));
+        return benchmark.run();
+    }
+
+    if (parser.isSet("diff"))
+    {
+        return SessionDiff::run(parser);
+    }
+
+    if (RecordingEditor::isRequested(parser))
+    {
+        return RecordingEditor::run(parser);
+    }
+
     MainWindow w;
+
+    DashboardSnapshotter snapshotter;
+    if (parser.isSet("snapshot-dir"))
+    {
+        if (!snapshotter.configure(parser, w.views()))
+        {
+            qCritical("%s", qPrintable(snapshotter.errorString()));
+            return 1;
+        }
+        snapshotter.setClock(w.clock());
+        snapshotter.start();
+    }
+
+    if (parser.isSet("headless"))
+    {
+        // Lay the views out as if they were on screen, without mapping a window.
+        w.setAttribute(Qt::WA_DontShowOnScreen);
+        w.showViews();
+    }
     w.show();
 
     return app.exec();
@@ -36,31 +36,53 @@
 #include "doppler_delegate.h"
 #include "led_delegate.h"
 #include "preferences_dialog.h"
+#include "session_diff_dialog.h"
 #include "skyplot_widget.h"
 #include "ephemeris_widget.h"
+#include "geodesy.h"
 #include "ui_main_window.h"
+#include <QDateTime>
 #include <QDebug>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QInputDialog>
+#include <QMenu>
 #include <QQmlContext>
+#include <QScrollBar>
 #include <QtCharts>
-#include <QtNetwork/QHostAddress>
-#include <QtNetwork/QNetworkDatagram>
 #include <QLabel>
-#include <QDateTime>
+#include <chrono>
 #include <cmath>
+#include <memory>
 
-MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), ui(new Ui::MainWindow)
+MainWindow::MainWindow(QWidget *parent, Mode mode)
+    : QMainWindow(parent), ui(new Ui::MainWindow), m_streams(this, this), m_mode(mode)
 {
     // Use a timer to delay updating the model to a fixed amount of times per
-    // second.
+    // second. Like every other timer of the views it follows m_clock, so that
+    // a replay refreshes the views at the same points of the data at any speed.
+    m_updateTimer.setClock(&m_clock);
+    m_fixTimer.setClock(&m_clock);
+    m_fixTimer.setSingleShot(true);
+    m_fixTimer.setInterval(FIX_TIMEOUT_MS);
+    connect(&m_fixTimer, &ClockTimer::timeout, this, [this] { setFix(false, "no PVT received"); });
     m_updateTimer.setInterval(500);
     m_updateTimer.setSingleShot(true);
-    connect(&m_updateTimer, &QTimer::timeout, [this] { m_model->update(); });
+    connect(&m_updateTimer, &ClockTimer::timeout, this, &MainWindow::refreshTable);
+
+    // The channel table sends each column at its own rate, so it is polled at the fastest one.
+    m_tableTimer.setClock(&m_clock);
+    m_tableTimer.setInterval(ChannelTableModel::SCALAR_INTERVAL_MS);
+    m_tableTimer.setSingleShot(true);
+    connect(&m_tableTimer, &ClockTimer::timeout, this, &MainWindow::refreshTable);
 
     ui->setupUi(this);
 
     // Monitor_Pvt_Wrapper.
     m_monitorPvtWrapper = new MonitorPvtWrapper();
+    m_monitorPvtWrapper->setTimeService(&m_gnssTime);
+    m_monitorPvtWrapper->setClock(&m_clock);
     m_GpsEphemerisWrapper = new GpsEphemerisWrapper();
 
     // Telecommand widget.
@@ -86,7 +108,7 @@ MainWindow::MainWindow(QWidget *parent)
     m_altitudeDockWidget->setWidget(m_altitudeWidget);
     addDockWidget(Qt::TopDockWidgetArea, m_altitudeDockWidget);
     connect(m_monitorPvtWrapper, &MonitorPvtWrapper::altitudeChanged, m_altitudeWidget, &AltitudeWidget::addData);
-    connect(&m_updateTimer, &QTimer::timeout, m_altitudeWidget, &AltitudeWidget::redraw);
+    connect(&m_updateTimer, &ClockTimer::timeout, m_altitudeWidget, &AltitudeWidget::redraw);
     m_altitudeDockWidget->setHidden(true);
 
     // Dilution of precision widget.
@@ -95,22 +117,59 @@ MainWindow::MainWindow(QWidget *parent)
     m_DOPDockWidget->setWidget(m_DOPWidget);
     addDockWidget(Qt::TopDockWidgetArea, m_DOPDockWidget);
     connect(m_monitorPvtWrapper, &MonitorPvtWrapper::dopChanged, m_DOPWidget, &DOPWidget::addData);
-    connect(&m_updateTimer, &QTimer::timeout, m_DOPWidget, &DOPWidget::redraw);
+    connect(&m_updateTimer, &ClockTimer::timeout, m_DOPWidget, &DOPWidget::redraw);
     m_DOPDockWidget->setHidden(true);
 
     // SkyPlot widget.
     m_skyplotDockWidget = new QDockWidget("Sky Plot", this);
     m_skyplotWidget = new SkyPlotWidget(m_skyplotDockWidget);
+    m_skyplotWidget->setEphemerisStore(&m_ephemerisStore);
+    m_skyplotWidget->setCn0Model(&m_cn0Model);
+    connect(m_skyplotWidget, &SkyPlotWidget::forgetExpectedCn0, this, [this] { m_cn0Model.clear(); });
+    m_skyplotWidget->setSatelliteHealth(&m_satelliteHealth);
+    m_skyplotWidget->setClock(&m_clock);
     m_skyplotDockWidget->setWidget(m_skyplotWidget);
     addDockWidget(Qt::TopDockWidgetArea, m_skyplotDockWidget);
+    connect(m_monitorPvtWrapper, &MonitorPvtWrapper::dataChanged, this, &MainWindow::updatePvtViews);
 
     // Ephemeris widget.
     m_ephemerisDockWidget = new QDockWidget("Ephemeris Data", this);
     m_ephemerisWidget = new EphemerisWidget(m_ephemerisDockWidget);
+    m_ephemerisWidget->setClock(&m_clock);
     m_ephemerisDockWidget->setWidget(m_ephemerisWidget);
     addDockWidget(Qt::BottomDockWidgetArea, m_ephemerisDockWidget);
     m_ephemerisDockWidget->setHidden(false);
 
+    // Satellite health widget.
+    m_healthDockWidget = new QDockWidget("Satellite Health", this);
+    m_healthWidget = new HealthMatrixWidget(m_healthDockWidget);
+    m_healthWidget->setSatelliteHealth(&m_satelliteHealth);
+    m_healthDockWidget->setWidget(m_healthWidget);
+    addDockWidget(Qt::BottomDockWidgetArea, m_healthDockWidget);
+    connect(&m_updateTimer, &ClockTimer::timeout, m_healthWidget, &HealthMatrixWidget::redraw);
+    m_healthDockWidget->setHidden(true);
+
+    // Event log widget.
+    m_eventLog.setClock(&m_clock);
+    m_eventDockWidget = new QDockWidget("Events", this);
+    m_eventLogWidget = new EventLogWidget(m_eventDockWidget);
+    m_eventLogWidget->setEventLog(&m_eventLog);
+    m_eventDockWidget->setWidget(m_eventLogWidget);
+    addDockWidget(Qt::BottomDockWidgetArea, m_eventDockWidget);
+    connect(&m_eventLog, &EventLog::alertRaised, this, &MainWindow::showAlert);
+    connect(&m_eventLog, &EventLog::alertRaised, this, &MainWindow::captureAlert);
+    m_eventDockWidget->setHidden(true);
+
+    // Analytics panel. The modules run on the workers of m_analytics, off the ingest.
+    m_analytics.setClock(&m_clock);
+    m_analyticsDockWidget = new QDockWidget("Analytics", this);
+    m_analyticsPanel = new AnalyticsPanel(m_analyticsDockWidget);
+    m_analyticsPanel->setHost(&m_analytics);
+    m_analyticsDockWidget->setWidget(m_analyticsPanel);
+    addDockWidget(Qt::BottomDockWidgetArea, m_analyticsDockWidget);
+    connect(&m_updateTimer, &ClockTimer::timeout, m_analyticsPanel, &AnalyticsPanel::redraw);
+    m_analyticsDockWidget->setHidden(true);
+
     // QMenuBar.
     ui->actionQuit->setIcon(QIcon::fromTheme("application-exit"));
     ui->actionQuit->setShortcuts(QKeySequence::Quit);
@@ -120,11 +179,15 @@ MainWindow::MainWindow(QWidget *parent)
 
     connect(ui->actionQuit, &QAction::triggered, qApp, &QApplication::quit);
     connect(ui->actionPreferences, &QAction::triggered, this, &MainWindow::showPreferences);
+    connect(ui->actionReplay, &QAction::triggered, this, &MainWindow::replaySession);
+    connect(ui->actionCompare, &QAction::triggered, this, &MainWindow::compareSessions);
 
     // QToolbar.
     m_start = ui->mainToolBar->addAction("Start");
     m_stop = ui->mainToolBar->addAction("Stop");
     m_clear = ui->mainToolBar->addAction("Clear");
+    m_record = ui->mainToolBar->addAction("Record");
+    m_record->setCheckable(true);
     ui->mainToolBar->addSeparator();
     m_closePlotsAction = ui->mainToolBar->addAction("Close Plots");
     ui->mainToolBar->addSeparator();
@@ -134,6 +197,9 @@ MainWindow::MainWindow(QWidget *parent)
     ui->mainToolBar->addAction(m_DOPDockWidget->toggleViewAction());
     ui->mainToolBar->addAction(m_skyplotDockWidget->toggleViewAction());
     ui->mainToolBar->addAction(m_ephemerisDockWidget->toggleViewAction());
+    ui->mainToolBar->addAction(m_healthDockWidget->toggleViewAction());
+    ui->mainToolBar->addAction(m_eventDockWidget->toggleViewAction());
+    ui->mainToolBar->addAction(m_analyticsDockWidget->toggleViewAction());
 
     m_start->setEnabled(false);
     m_stop->setEnabled(true);
@@ -142,15 +208,46 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_start, &QAction::triggered, this, &MainWindow::toggleCapture);
     connect(m_stop, &QAction::triggered, this, &MainWindow::toggleCapture);
     connect(m_clear, &QAction::triggered, this, &MainWindow::clearEntries);
+    connect(m_record, &QAction::toggled, this, &MainWindow::toggleRecording);
     connect(m_closePlotsAction, &QAction::triggered, this, &MainWindow::closePlots);
 
     // Status Bar Setup
     m_gpsTimeLabel = new QLabel(this);
     m_gpsTimeLabel->setText("UTC Time: N/A");
     statusBar()->addWidget(m_gpsTimeLabel);
+    m_clockDriftLabel = new QLabel(this);
+    m_clockDriftLabel->setText("Clock drift: N/A");
+    m_clockDriftLabel->setToolTip("Receiver oscillator drift solved from the Doppler of the tracked channels");
+    statusBar()->addPermanentWidget(m_clockDriftLabel);
 
     // Model.
     m_model = new ChannelTableModel();
+    m_model->setTimeService(&m_gnssTime);
+    m_model->setCn0Model(&m_cn0Model);
+    m_model->setSatelliteHealth(&m_satelliteHealth);
+
+    // Analytics modules, the table shows their results.
+    auto cn0_estimator = std::make_unique<Cn0EstimatorModule>(&m_eventLog);
+    m_model->setCn0Estimates(cn0_estimator.get());
+    m_analytics.addModule(std::move(cn0_estimator));
+    auto doppler_residuals = std::make_unique<DopplerResidualModule>(&m_eventLog);
+    doppler_residuals->setSink([this](const DopplerResidualModule::Solution &solution) {
+        for (const DopplerResidualModule::Residual &residual : solution.residuals)
+        {
+            m_model->addDopplerResidual(residual);
+        }
+        m_clockDriftLabel->setText(QString("Clock drift: %1 ppb (%2 channels)")
+                                       .arg(solution.clockDrift * 1e9, 0, 'f', 1)
+                                       .arg(solution.used));
+    });
+    m_dopplerResiduals = doppler_residuals.get();
+    const int doppler_index = m_analytics.addModule(std::move(doppler_residuals));
+    connect(&m_analytics, &AnalyticsHost::enabledChanged, this, [this, doppler_index](int index, bool enabled) {
+        if (index == doppler_index)
+        {
+            m_dopplerResiduals->setEnabled(enabled);
+        }
+    });
 
     // QTableView.
     // Tie the model to the view.
@@ -162,25 +259,80 @@ MainWindow::MainWindow(QWidget *parent)
     ui->tableView->setItemDelegateForColumn(6, new Cn0Delegate());
     ui->tableView->setItemDelegateForColumn(7, new DopplerDelegate());
     ui->tableView->setItemDelegateForColumn(9, new LedDelegate());
+    ui->tableView->setItemDelegateForColumn(13, new DopplerDelegate());
     ui->tableView->setAlternatingRowColors(true);
     ui->tableView->setSelectionBehavior(QTableView::SelectRows);
 
-    // Sockets.
-    m_socketGnssSynchro = new QUdpSocket(this);
-    m_socketMonitorPvt = new QUdpSocket(this);
-    m_socketGpsEphemeris = new QUdpSocket(this);
+    // The C/N0 estimated from the prompt I/Q is shown next to the one reported by the receiver.
+    QHeaderView *header = ui->tableView->horizontalHeader();
+    header->moveSection(header->visualIndex(12), header->visualIndex(6) + 1);
+
+    // Columns that are hidden or scrolled out of sight are not refreshed.
+    header->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(header, &QHeaderView::customContextMenuRequested, this, &MainWindow::showColumnMenu);
+    connect(header, &QHeaderView::sectionResized, this, &MainWindow::updateVisibleColumns);
+    connect(header, &QHeaderView::sectionMoved, this, &MainWindow::updateVisibleColumns);
+    connect(header, &QHeaderView::geometriesChanged, this, &MainWindow::updateVisibleColumns);
+    connect(ui->tableView->horizontalScrollBar(), &QScrollBar::valueChanged, this, &MainWindow::updateVisibleColumns);
+    connect(ui->tableView->horizontalScrollBar(), &QScrollBar::rangeChanged, this, &MainWindow::updateVisibleColumns);
+    ui->tableView->viewport()->installEventFilter(this);  // Widening the window or the dock shows more columns.
+
+    // Streams. The sockets are bound in setPort().
+    m_streams.setRecorder(&m_recorder);
+    m_streams.setAlertCapture(&m_alertCapture);
+    connect(&m_alertCapture, &AlertCapture::captureStarted, this, [this](const QString &path, double buffered_seconds) {
+        m_eventLog.add(MonitorEvent::Severity::Info, "Alert capture",
+            QString("Recording the raw data from %1 s before the alert to %2").arg(buffered_seconds, 0, 'f', 0).arg(path),
+            buffered_seconds);
+    });
+    connect(&m_alertCapture, &AlertCapture::captureFinished, this, [this](const QString &path, quint64 datagrams) {
+        m_eventLog.add(MonitorEvent::Severity::Info, "Alert capture",
+            QString("%1 datagrams saved to %2").arg(datagrams).arg(path), static_cast<double>(datagrams));
+    });
+
+    // Replay. Recorded datagrams go through the same dispatch as live ones.
+    m_player.setClock(&m_clock);
+    m_player.setDispatcher([this](quint16 stream_id, const char *data, int size) {
+        dispatchRecord(stream_id, data, size);
+    });
+    connect(&m_player, &SessionPlayer::finished, this, &MainWindow::replayFinished);
+
+    // Query API. Requests copy what they need here, on the GUI thread, and run on the server's workers.
+    m_queryServer.setSnapshotProvider([this](const SeriesRequest &request) {
+        auto snapshot = std::make_shared<SeriesSnapshot>();
+        m_model->fillSnapshot(request, *snapshot);
+        m_monitorPvtWrapper->fillSnapshot(request, *snapshot);
+        return std::shared_ptr<const SeriesSnapshot>(snapshot);
+    });
+
+    // Session state. Copied here, on the GUI thread, and written by its worker for the next start.
+    m_sessionState.setProvider([this](SessionState::Snapshot &snapshot) {
+        if (m_clock.isVirtual())
+        {
+            // Keep the state of the live session, not the one of a replay.
+            return false;
+        }
+        snapshot.time = m_gnssTime.state();
+        m_monitorPvtWrapper->copyHistory(snapshot.pvt);
+        m_model->saveState(snapshot.channels);
+        return true;
+    });
 
     // Connect Signals & Slots.
-    connect(m_socketGnssSynchro, &QUdpSocket::readyRead, this, &MainWindow::receiveGnssSynchro);
-    connect(m_socketMonitorPvt, &QUdpSocket::readyRead, this, &MainWindow::receiveMonitorPvt);
-    connect(m_socketGpsEphemeris, &QUdpSocket::readyRead, this, &MainWindow::receiveGpsEphemeris);
+    connect(&m_updateTimer, &ClockTimer::timeout, this, &MainWindow::viewsRefreshed);
     connect(qApp, &QApplication::aboutToQuit, this, &MainWindow::quit);
     connect(ui->tableView, &QTableView::clicked, this, &MainWindow::expandPlot);
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::about);
     connect(ui->actionAboutQt, &QAction::triggered, qApp, &QApplication::aboutQt);
 
-    // Load settings from last session.
+    // Load settings and state from last session.
     loadSettings();
+    if (m_mode == Mode::Benchmark)
+    {
+        return;
+    }
+    restoreSession();
+    m_sessionState.start();
 }
 
 MainWindow::~MainWindow() { delete ui; }
@@ -192,6 +344,15 @@ void MainWindow::closeEvent(QCloseEvent *event)
     QMainWindow::closeEvent(event);
 }
 
+bool MainWindow::eventFilter(QObject *object, QEvent *event)
+{
+    if (object == ui->tableView->viewport() && event->type() == QEvent::Resize)
+    {
+        updateVisibleColumns();
+    }
+    return QMainWindow::eventFilter(object, event);
+}
+
 void MainWindow::updateChart(QtCharts::QChart *chart, QtCharts::QXYSeries *series, const QModelIndex &index)
 {
     QPointF p;
@@ -236,160 +397,488 @@ void MainWindow::toggleCapture()
     }
 }
 
-void MainWindow::receiveGnssSynchro()
+/*!
+ Starts recording every incoming datagram to a file chosen by the user, or stops the current recording.
+ */
+void MainWindow::toggleRecording(bool checked)
 {
-    bool newData = false;
-    while (m_socketGnssSynchro->hasPendingDatagrams())
+    if (!checked)
     {
-        newData = true;
-        QNetworkDatagram datagram = m_socketGnssSynchro->receiveDatagram();
-        m_stocks = readGnssSynchro(datagram.data().data(), datagram.data().size());
+        m_recorder.close();
+        statusBar()->showMessage("Recording stopped", 3000);
+        return;
+    }
 
-        if (m_stop->isEnabled())
-        {
-            m_model->populateChannels(&m_stocks);
-            m_skyplotWidget->updateSatellites(m_stocks);
-            m_clear->setEnabled(true);
-        }
+    QString defaultName = "gnss-sdr-monitor-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".gsdr";
+    QString fileName = QFileDialog::getSaveFileName(this, "Record Session", defaultName, "Recordings (*.gsdr)");
+
+    if (fileName.isEmpty() || !m_recorder.open(fileName))
+    {
+        QSignalBlocker blocker(m_record);
+        m_record->setChecked(false);
+        return;
+    }
+
+    statusBar()->showMessage("Recording to " + fileName, 3000);
+}
+
+/*!
+ Replays a recorded session through the views, or stops the replay in progress.
+ The live streams are closed and the clock runs on the recorded timestamps until the replay ends.
+ */
+void MainWindow::replaySession()
+{
+    if (m_player.isPlaying())
+    {
+        m_player.stop();
+        replayFinished();
+        return;
     }
-    if (newData && !m_updateTimer.isActive())
+
+    QString fileName = QFileDialog::getOpenFileName(this, "Replay Session", QString(), "Recordings (*.gsdr)");
+    if (fileName.isEmpty())
     {
-        m_updateTimer.start();
+        return;
     }
+
+    bool ok = false;
+    double speed = QInputDialog::getDouble(this, "Replay Session", "Speed (0 = as fast as possible):",
+        1.0, 0.0, 1000.0, 1, &ok);
+    if (!ok)
+    {
+        return;
+    }
+
+    if (!m_player.open(fileName))
+    {
+        QMessageBox::warning(this, "Replay Session", "Cannot open " + fileName + ": " + m_player.errorString());
+        return;
+    }
+
+    beginReplay(m_player.firstTimestamp() / 1000);
+    m_player.setSpeed(speed);
+    m_player.start();
+
+    ui->actionReplay->setText("Stop Replay");
+    statusBar()->showMessage("Replaying " + fileName);
+}
+
+void MainWindow::replayFinished()
+{
+    endReplay();
+
+    ui->actionReplay->setText("Replay Session...");
+    statusBar()->showMessage(QString("Replay finished, %1 records").arg(m_player.recordsPlayed()), 5000);
 }
 
-void MainWindow::receiveMonitorPvt()
+/*!
+ Compares two recorded sessions in a separate dialog, without touching the live views.
+ */
+void MainWindow::compareSessions()
 {
-    while (m_socketMonitorPvt->hasPendingDatagrams())
+    QString before = QFileDialog::getOpenFileName(this, "Compare Sessions: Before", QString(), "Recordings (*.gsdr)");
+    if (before.isEmpty())
     {
-        QNetworkDatagram datagram = m_socketMonitorPvt->receiveDatagram();
-        m_monitorPvt = readMonitorPvt(datagram.data().data(), datagram.data().size());
+        return;
+    }
 
-        if (m_stop->isEnabled())
-        {
-            m_monitorPvtWrapper->addMonitorPvt(m_monitorPvt);
+    QString after = QFileDialog::getOpenFileName(this, "Compare Sessions: After", QFileInfo(before).path(),
+        "Recordings (*.gsdr)");
+    if (after.isEmpty())
+    {
+        return;
+    }
 
-            double receiver_tow = m_monitorPvt.rx_time();
-            uint32_t receiver_week = m_monitorPvt.week();
+    const QStringList alignments = {"Time since the start of each session", "Receive time"};
+    bool ok = false;
+    QString alignment = QInputDialog::getItem(this, "Compare Sessions", "Align the sessions on:", alignments, 0, false, &ok);
+    if (!ok)
+    {
+        return;
+    }
 
-                    // A valid fix requires a week number > 0 and a valid Time-of-Week.
-            if (receiver_week > 0 && receiver_tow >= 0.0 && receiver_tow < 604800)
-            {
-                // Constants for GPS time conversion
-                const QDateTime gps_epoch(QDate(1980, 1, 6), QTime(0, 0, 0), Qt::UTC);
-                const int leap_seconds = 18; // Current GPS-UTC leap second offset
-                const int secs_in_week = 604800;
+    SessionDiffDialog *dialog = new SessionDiffDialog(before, after,
+        alignment == alignments.at(1) ? SessionDiff::Alignment::Absolute : SessionDiff::Alignment::Relative, this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
 
-                        // Calculate the total seconds from GPS epoch using the received week and TOW
-                qint64 gps_int_seconds = (static_cast<qint64>(receiver_week) * secs_in_week) + static_cast<qint64>(floor(receiver_tow));
-                double gps_frac_seconds = fmod(receiver_tow, 1.0);
+/*!
+ Detaches the views from the live streams and starts the virtual clock at \a start_ms, so that records can be fed with dispatchRecord().
+ */
+void MainWindow::beginReplay(qint64 start_ms)
+{
+    // Never record a replay into a new recording.
+    m_record->setChecked(false);
+    m_record->setEnabled(false);
 
-                        // Convert to QDateTime and apply the leap second correction to get UTC
-                QDateTime utc_time = gps_epoch.addSecs(gps_int_seconds).addSecs(-leap_seconds);
+    m_streams.close();
+    clearEntries();
+    m_clock.startVirtual(start_ms);
+}
 
-                        // Format the string to your desired format
-                QString fractional_str = QString::number(gps_frac_seconds, 'f', 6).mid(1);
-                QString formatted_time = utc_time.toString("yyyy-MMM-dd hh:mm:ss") + fractional_str + " UTC";
+/*!
+ Returns to the wall clock and the live streams.
+ */
+void MainWindow::endReplay()
+{
+    m_clock.setLive();
+    m_streams.bind();
 
-                m_gpsTimeLabel->setText(formatted_time);
-            }
-            else if (m_monitorPvt.IsInitialized())
-            {
-                // The receiver is sending data, but it doesn't contain a valid time fix yet.
-                m_gpsTimeLabel->setText("UTC Time: Awaiting PVT fix...");
-            }
+    m_record->setEnabled(true);
+}
 
-                    // Update sky plot with receiver position
-            double lat = m_monitorPvt.latitude();
-            double lon = m_monitorPvt.longitude();
+/*!
+ Decodes a recorded datagram of stream \a stream_id and hands it to the views, exactly like a live one.
+ */
+bool MainWindow::dispatchRecord(quint16 stream_id, const char *data, int size)
+{
+    return m_streams.dispatch(stream_id, data, size);
+}
 
-            bool validPosition = (lat >= -90.0 && lat <= 90.0 &&
-                                  lon >= -180.0 && lon <= 180.0 &&
-                                  (std::abs(lat) > 0.001 || std::abs(lon) > 0.001));
+std::vector<std::pair<QString, QWidget *>> MainWindow::views() const
+{
+    return {{"channels", ui->tableView},
+        {"skyplot", m_skyplotWidget},
+        {"dop", m_DOPWidget},
+        {"altitude", m_altitudeWidget},
+        {"ephemeris", m_ephemerisWidget},
+        {"health", m_healthWidget},
+        {"analytics", m_analyticsPanel}};
+}
 
-            if (validPosition) {
-                m_skyplotWidget->updateReceiverPosition(m_monitorPvt);
-            }
+/*!
+ Shows the docks of all the views returned by views(), so that they are laid out and can be rendered.
+ */
+void MainWindow::showViews()
+{
+    for (const auto &view : views())
+    {
+        if (auto *dock = qobject_cast<QDockWidget *>(view.second->parentWidget()))
+        {
+            dock->show();
         }
     }
 }
 
-void MainWindow::clearEntries()
+void MainWindow::handle(GnssSynchroStream, const gnss_sdr::Observables &stocks)
 {
-    m_model->clearChannels();
-    m_model->update();
+    if (!m_stop->isEnabled())
+    {
+        return;
+    }
 
-    m_altitudeWidget->clear();
-    m_DOPWidget->clear();
-    m_skyplotWidget->clear();
-    m_ephemerisWidget->clear();
-    m_gpsTimeLabel->setText("UTC Time: N/A");
+    if (m_restoredSession)
+    {
+        m_restoredSession = false;
+        statusBar()->clearMessage();
+    }
 
-    m_clear->setEnabled(false);
+    PvtSnapshot pvt;
+    const bool has_pvt = m_monitorPvtWrapper->latest(pvt);
+
+    m_model->populateChannels(&stocks);
+    observeCn0(stocks, has_pvt ? &pvt : nullptr);
+    m_skyplotWidget->updateSatellites(stocks);
+    m_analytics.submit(stocks, has_pvt ? &pvt : nullptr);
+
+    SatelliteHealth::PrnSet tracked;
+    for (int i = 0; i < stocks.observable_size(); i++)
+    {
+        const gnss_sdr::GnssSynchro &channel = stocks.observable(i);
+        if (channel.system() == "G" && channel.flag_valid_symbol_output() &&
+            channel.prn() > 0 && channel.prn() <= SatelliteHealth::MAX_PRN)
+        {
+            tracked.set(channel.prn());
+        }
+    }
+    m_healthWidget->setTracked(tracked);
+    m_clear->setEnabled(true);
+
+    if (!m_updateTimer.isActive())
+    {
+        m_updateTimer.start();
+    }
+    if (!m_tableTimer.isActive())
+    {
+        m_tableTimer.start();
+    }
 }
 
-void MainWindow::quit() { saveSettings(); }
+void MainWindow::handle(MonitorPvtStream, const gnss_sdr::MonitorPvt &monitorPvt)
+{
+    if (m_stop->isEnabled())
+    {
+        m_monitorPvtWrapper->addMonitorPvt(monitorPvt);
+
+        // The receiver stops sending PVT when it has no solution, so silence is a loss of fix too.
+        const bool has_fix = PvtSnapshot::fromMonitorPvt(monitorPvt).hasFix();
+        setFix(has_fix, QString("%1 satellites in the solution").arg(monitorPvt.valid_sats()));
+        if (has_fix)
+        {
+            m_fixTimer.start();
+        }
+    }
+}
 
-gnss_sdr::Observables MainWindow::readGnssSynchro(char buff[], int bytes)
+/*!
+ Logs the changes of the PVT fix. A loss raises an alert, which starts an alert capture.
+ */
+void MainWindow::setFix(bool has_fix, const QString &reason)
 {
-    try
+    if (has_fix == m_hasFix)
+    {
+        return;
+    }
+    m_hasFix = has_fix;
+    if (has_fix)
     {
-        std::string data(buff, bytes);
-        m_stocks.ParseFromString(data);
+        m_eventLog.add(MonitorEvent::Severity::Info, "PVT", "Position fix acquired");
+        return;
     }
-    catch (std::exception &e)
+
+    m_fixTimer.stop();
+    if (m_stop->isEnabled())
     {
-        qDebug() << e.what();
+        m_eventLog.add(MonitorEvent::Severity::Alert, "PVT", "Position fix lost: " + reason);
     }
+}
 
-    return m_stocks;
+void MainWindow::handle(GpsEphemerisStream, const gnss_sdr::GpsEphemeris &gpsEphemeris)
+{
+    if (m_stop->isEnabled())
+    {
+        m_GpsEphemerisWrapper->addGpsEphemeris(gpsEphemeris);
+        m_sessionState.keepEphemeris(GpsEphemerisStream::id, gpsEphemeris.prn(), gpsEphemeris);
+        m_dopplerResiduals->addEphemeris(gpsEphemeris);
+        if (m_ephemerisStore.update(gpsEphemeris))
+        {
+            checkEphemerisUpload("G", gpsEphemeris.prn());
+        }
+        if (m_satelliteHealth.update(gpsEphemeris))
+        {
+            m_model->markChanged(2);
+        }
+        m_ephemerisWidget->updateEphemeris(gpsEphemeris);
+    }
 }
 
-gnss_sdr::MonitorPvt MainWindow::readMonitorPvt(char buff[], int bytes)
+void MainWindow::handle(GalileoEphemerisStream, const gnss_sdr::GalileoEphemeris &ephemeris)
 {
-    try
+    if (m_stop->isEnabled())
     {
-        std::string data(buff, bytes);
-        m_monitorPvt.ParseFromString(data);
+        m_sessionState.keepEphemeris(GalileoEphemerisStream::id, ephemeris.prn(), ephemeris);
+        m_dopplerResiduals->addEphemeris(ephemeris);
+        if (m_ephemerisStore.update(ephemeris))
+        {
+            checkEphemerisUpload("E", ephemeris.prn());
+        }
     }
-    catch (std::exception &e)
+}
+
+void MainWindow::handle(BeidouEphemerisStream, const gnss_sdr::BeidouEphemeris &ephemeris)
+{
+    if (m_stop->isEnabled())
     {
-        qDebug() << e.what();
+        m_sessionState.keepEphemeris(BeidouEphemerisStream::id, ephemeris.prn(), ephemeris);
+        m_dopplerResiduals->addEphemeris(ephemeris);
+        if (m_ephemerisStore.update(ephemeris))
+        {
+            checkEphemerisUpload("C", ephemeris.prn());
+        }
     }
+}
 
-    return m_monitorPvt;
+void MainWindow::handle(GlonassEphemerisStream, const gnss_sdr::GlonassGnavEphemeris &ephemeris)
+{
+    if (m_stop->isEnabled())
+    {
+        m_sessionState.keepEphemeris(GlonassEphemerisStream::id, ephemeris.prn(), ephemeris);
+        m_dopplerResiduals->addEphemeris(ephemeris);
+        m_ephemerisStore.update(ephemeris);
+    }
 }
 
-gnss_sdr::GpsEphemeris MainWindow::readGpsEphemeris(char buff[], int bytes)
+/*!
+ Refreshes the views that only show the latest PVT: the UTC time in the status bar and the receiver position in the sky plot.
+ Runs at most once per frame, whatever the PVT rate.
+ */
+void MainWindow::updatePvtViews()
 {
-    try
+    PvtSnapshot pvt;
+    if (!m_monitorPvtWrapper->latest(pvt))
+    {
+        return;
+    }
+
+    // A valid fix requires a week number > 0 and a valid Time-of-Week.
+    if (pvt.hasValidTime())
     {
-        std::string data(buff, bytes);
-        m_gpsEphemeris.ParseFromString(data);
+        m_gpsTimeLabel->setText(m_gnssTime.formatUtc(pvt.week, pvt.rx_time));
     }
-    catch (std::exception &e)
+    else
     {
-        qDebug() << e.what();
+        // The receiver is sending data, but it doesn't contain a valid time fix yet.
+        m_gpsTimeLabel->setText("UTC Time: Awaiting PVT fix...");
     }
 
-    return m_gpsEphemeris;
+    // Update sky plot with receiver position
+    if (pvt.hasValidPosition())
+    {
+        m_skyplotWidget->updateReceiverPosition(pvt);
+    }
 }
 
-void MainWindow::receiveGpsEphemeris()
+/*!
+ Feeds the C/N0 of every tracked channel of \a stocks to the C/N0 vs elevation model, which the channel
+ table and the sky plot read. The elevation is the one sent by the receiver or, without it, the one of
+ the broadcast ephemeris seen from the position of \a pvt. Channels without either are not compared.
+ */
+void MainWindow::observeCn0(const gnss_sdr::Observables &stocks, const PvtSnapshot *pvt)
 {
-    while (m_socketGpsEphemeris->hasPendingDatagrams())
+    const bool has_position = pvt && pvt->hasValidPosition();
+    const geodesy::LocalFrame frame = has_position ? geodesy::LocalFrame::at(pvt->latitude, pvt->longitude, pvt->height)
+                                                   : geodesy::LocalFrame();
+
+    for (int i = 0; i < stocks.observable_size(); i++)
     {
-        QNetworkDatagram datagram = m_socketGpsEphemeris->receiveDatagram();
-        m_gpsEphemeris = readGpsEphemeris(datagram.data().data(), datagram.data().size());
+        const gnss_sdr::GnssSynchro &channel = stocks.observable(i);
+        if (channel.fs() == 0)
+        {
+            continue;
+        }
+
+        double elevation = -1.0;
+        if (channel.flag_valid_satellite_position() && channel.has_satellite_elevation_deg())
+        {
+            elevation = channel.satellite_elevation_deg();
+        }
+        else if (has_position)
+        {
+            EcefPosition position;
+            if (m_ephemerisStore.position(channel.system(), channel.prn(),
+                    GnssTime::gpsSeconds(pvt->week, channel.rx_time()), position))
+            {
+                double azimuth = 0.0;
+                geodesy::lookAngles(frame, &position.x, &position.y, &position.z, 1, &azimuth, &elevation);
+            }
+        }
 
-        if (m_stop->isEnabled())
+        // observe() forgets the channel without an elevation, or below the horizon from a stale ephemeris.
+        if (channel.flag_valid_symbol_output())
+        {
+            m_cn0Model.observe(channel.channel_id(), channel.system(), channel.signal(), elevation, channel.cn0_db_hz());
+        }
+        else
         {
-            m_GpsEphemerisWrapper->addGpsEphemeris(m_gpsEphemeris);
-            m_ephemerisWidget->updateEphemeris(m_gpsEphemeris);
+            m_cn0Model.clearChannel(channel.channel_id());
         }
     }
 }
 
+/*!
+ Measures the discontinuity between the ephemeris just received for satellite \a prn of \a system
+ and the one it replaces, at the latest receiver time, and logs it. Large jumps raise an alert.
+ */
+void MainWindow::checkEphemerisUpload(const std::string &system, int prn)
+{
+    double gps_seconds = -1.0;
+    PvtSnapshot pvt;
+    if (m_monitorPvtWrapper->latest(pvt) && pvt.hasValidTime())
+    {
+        gps_seconds = GnssTime::gpsSeconds(pvt.week, pvt.rx_time);
+    }
+
+    EphemerisJump jump;
+    if (!m_ephemerisStore.jump(system, prn, gps_seconds, jump))
+    {
+        return;
+    }
+
+    QString message = QString("%1%2 IODE %3 → %4: orbit %5 m (radial %6 m), clock %7 m, range %8 m")
+                          .arg(QString::fromStdString(system))
+                          .arg(prn, 2, 10, QChar('0'))
+                          .arg(jump.oldIode)
+                          .arg(jump.newIode)
+                          .arg(jump.orbit, 0, 'f', 2)
+                          .arg(jump.radial, 0, 'f', 2)
+                          .arg(jump.clock, 0, 'f', 2)
+                          .arg(jump.range(), 0, 'f', 2);
+    m_eventLog.add(jump.isLarge() ? MonitorEvent::Severity::Alert : MonitorEvent::Severity::Info,
+        "Ephemeris upload", message, std::abs(jump.range()));
+}
+
+/*!
+ Brings an alert of the event log to the user's attention.
+ */
+void MainWindow::showAlert(const MonitorEvent &event)
+{
+    statusBar()->showMessage(event.source + ": " + event.message, 10000);
+    m_eventDockWidget->show();
+    QApplication::alert(this);
+}
+
+/*!
+ Records the raw datagrams around an alert of the live streams, see AlertCapture. Replays are not captured.
+ */
+void MainWindow::captureAlert(const MonitorEvent &event)
+{
+    Q_UNUSED(event)
+    if (m_clock.isVirtual())
+    {
+        return;
+    }
+
+    const qint64 now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+    if (!m_alertCapture.trigger(now_us))
+    {
+        statusBar()->showMessage(m_alertCapture.errorString(), 5000);
+    }
+}
+
+void MainWindow::clearEntries()
+{
+    m_model->clearChannels();
+    m_model->update();
+
+    m_altitudeWidget->clear();
+    m_DOPWidget->clear();
+    m_skyplotWidget->clear();
+    m_cn0Model.clearChannels();
+    m_ephemerisWidget->clear();
+    m_ephemerisStore.clear();
+    m_satelliteHealth.clear();
+    m_healthWidget->clear();
+    m_analytics.reset();
+    m_gnssTime.reset();
+    m_fixTimer.stop();
+    m_hasFix = false;
+    m_sessionState.clearEphemerides();
+    m_gpsTimeLabel->setText("UTC Time: N/A");
+    m_clockDriftLabel->setText("Clock drift: N/A");
+    if (m_restoredSession)
+    {
+        m_restoredSession = false;
+        statusBar()->clearMessage();
+    }
+
+    m_clear->setEnabled(false);
+}
+
+void MainWindow::quit()
+{
+    m_recorder.close();
+    m_alertCapture.stop();
+    if (m_mode == Mode::Benchmark)
+    {
+        return;
+    }
+    m_sessionState.saveAndWait();
+    saveSettings();
+}
+
 void MainWindow::saveSettings()
 {
     m_settings.beginGroup("Main_Window");
@@ -403,10 +892,31 @@ void MainWindow::saveSettings()
     {
         m_settings.setArrayIndex(i);
         m_settings.setValue("width", ui->tableView->columnWidth(i));
+        m_settings.setValue("hidden", ui->tableView->isColumnHidden(i));
     }
     m_settings.endArray();
     m_settings.endGroup();
 
+    m_settings.beginGroup("Sky_Plot");
+    m_settings.setValue("color_mode", static_cast<int>(m_skyplotWidget->colorMode()));
+    m_settings.setValue("cn0_model", m_cn0Model.save());
+    m_settings.endGroup();
+
+    m_settings.beginGroup("Altitude");
+    m_settings.setValue("height_mode", static_cast<int>(m_altitudeWidget->heightMode()));
+    m_settings.endGroup();
+
+    m_settings.beginGroup("Analytics");
+    for (int i = 0; i < m_analytics.moduleCount(); i++)
+    {
+        const AnalyticsHost::ModuleStats stats = m_analytics.stats(i);
+        m_settings.beginGroup(stats.name);
+        m_settings.setValue("enabled", stats.enabled);
+        m_settings.setValue("budget", stats.budgetPercent);
+        m_settings.endGroup();
+    }
+    m_settings.endGroup();
+
     qDebug() << "Settings Saved";
 }
 
@@ -423,38 +933,189 @@ void MainWindow::loadSettings()
     {
         m_settings.setArrayIndex(i);
         ui->tableView->setColumnWidth(i, m_settings.value("width", 100).toInt());
+        ui->tableView->setColumnHidden(i, m_settings.value("hidden", false).toBool());
     }
     m_settings.endArray();
     m_settings.endGroup();
+    updateVisibleColumns();
+
+    m_settings.beginGroup("Sky_Plot");
+    m_skyplotWidget->setColorMode(static_cast<SkyPlotWidget::ColorMode>(m_settings.value("color_mode", 0).toInt()));
+    m_cn0Model.restore(m_settings.value("cn0_model").toByteArray());
+    m_settings.endGroup();
+
+    m_settings.beginGroup("Altitude");
+    m_altitudeWidget->setHeightMode(static_cast<AltitudeWidget::HeightMode>(m_settings.value("height_mode", 0).toInt()));
+    m_settings.endGroup();
+
+    m_settings.beginGroup("Analytics");
+    for (int i = 0; i < m_analytics.moduleCount(); i++)
+    {
+        const AnalyticsHost::ModuleStats stats = m_analytics.stats(i);
+        m_settings.beginGroup(stats.name);
+        m_analytics.setEnabled(i, m_settings.value("enabled", stats.enabled).toBool());
+        m_analytics.setBudget(i, m_settings.value("budget", stats.budgetPercent).toDouble());
+        m_settings.endGroup();
+    }
+    m_settings.endGroup();
+    m_analyticsPanel->redraw();
 
-    setPort();
+    m_model->loadPreferences();
+    applyHistoryWindow();
+    if (m_mode != Mode::Benchmark)
+    {
+        setPort();
+    }
+    loadGeoid();
+    configureAlertCapture();
 
     qDebug() << "Settings Loaded";
 }
 
+/*!
+ Shows the state saved by the previous session, if enabled in the preferences, so that the views are
+ not empty while the receiver starts. The restored channels are marked as stale until the receiver
+ sends data for them again. Ephemerides go through the handlers of the live streams.
+ */
+void MainWindow::restoreSession()
+{
+    m_settings.beginGroup("Preferences_Dialog");
+    const bool restore = m_settings.value("restore_session", true).toBool();
+    m_settings.endGroup();
+
+    SessionState::Snapshot snapshot;
+    if (!restore || !m_sessionState.load(snapshot))
+    {
+        if (!m_sessionState.errorString().isEmpty())
+        {
+            statusBar()->showMessage(m_sessionState.errorString(), 5000);
+        }
+        return;
+    }
+
+    m_gnssTime.restore(snapshot.time);
+    for (const gnss_sdr::MonitorPvt &pvt : snapshot.pvt)
+    {
+        m_monitorPvtWrapper->addMonitorPvt(pvt);
+    }
+    updatePvtViews();
+    for (const auto &ephemeris : snapshot.ephemerides)
+    {
+        dispatchRecord(ephemeris.first, ephemeris.second.data(), static_cast<int>(ephemeris.second.size()));
+    }
+    m_model->restoreState(snapshot.channels);
+
+    // The sky plot shows the restored satellites as not valid until they are tracked again.
+    gnss_sdr::Observables observables;
+    for (const ChannelTableModel::ChannelState &channel : snapshot.channels)
+    {
+        gnss_sdr::GnssSynchro *observable = observables.add_observable();
+        *observable = channel.channel;
+        observable->set_flag_valid_symbol_output(false);
+    }
+    m_skyplotWidget->updateSatellites(observables);
+
+    m_model->update();
+    m_altitudeWidget->redraw();
+    m_DOPWidget->redraw();
+    m_healthWidget->redraw();
+    m_clear->setEnabled(true);
+
+    m_restoredSession = true;
+    statusBar()->showMessage(QString("Showing the state saved at %1, waiting for the receiver")
+                                 .arg(QDateTime::fromMSecsSinceEpoch(snapshot.savedMs).toString("yyyy-MM-dd hh:mm:ss")));
+}
+
 void MainWindow::showPreferences()
 {
     PreferencesDialog *preferences = new PreferencesDialog(this);
     connect(preferences, &PreferencesDialog::accepted, m_model,
-        &ChannelTableModel::setBufferSize);
+        &ChannelTableModel::loadPreferences);
+    connect(preferences, &PreferencesDialog::accepted, this,
+        &MainWindow::applyHistoryWindow);
     connect(preferences, &PreferencesDialog::accepted, this,
         &MainWindow::setPort);
+    connect(preferences, &PreferencesDialog::accepted, this,
+        &MainWindow::loadGeoid);
+    connect(preferences, &PreferencesDialog::accepted, this,
+        &MainWindow::configureAlertCapture);
     preferences->exec();
 }
 
 void MainWindow::setPort()
 {
-    QSettings settings;
-    settings.beginGroup("Preferences_Dialog");
-    m_portGnssSynchro = settings.value("port_gnss_synchro", 1111).toInt();
-    m_portMonitorPvt = settings.value("port_monitor_pvt", 1112).toInt();
-    m_portGpsEphemeris = settings.value("port_gps_ephemeris", 1113).toInt();
-    settings.endGroup();
+    m_streams.bind();
+
+    m_settings.beginGroup("Preferences_Dialog");
+    m_queryServer.listen(static_cast<quint16>(m_settings.value("port_query_api", 0).toUInt()));
+    m_settings.endGroup();
+}
+
+/*!
+ Gives the PVT history and its charts the time window set in the preferences. The channel table
+ reads it along with its other preferences.
+ */
+void MainWindow::applyHistoryWindow()
+{
+    m_settings.beginGroup("Preferences_Dialog");
+    const double seconds = m_settings.value("history_window", HistoryWindow::DEFAULT_SECONDS).toDouble();
+    m_settings.endGroup();
+
+    m_monitorPvtWrapper->setHistoryWindow(seconds);
+    m_altitudeWidget->setHistoryWindow(seconds);
+    m_DOPWidget->setHistoryWindow(seconds);
+}
+
+/*!
+ Sizes the ring of raw datagrams and the window of the alert captures from the preferences.
+ */
+void MainWindow::configureAlertCapture()
+{
+    m_settings.beginGroup("Preferences_Dialog");
+    const int before = m_settings.value("alert_capture_before", AlertCapture::DEFAULT_SECONDS).toInt();
+    const int after = m_settings.value("alert_capture_after", AlertCapture::DEFAULT_SECONDS).toInt();
+    const int buffer_mb = m_settings.value("alert_capture_buffer_mb", AlertCapture::DEFAULT_BUFFER_MB).toInt();
+    m_settings.endGroup();
+
+    m_alertCapture.configure(before, after, buffer_mb);
+}
+
+/*!
+ Maps the geoid grid set in the preferences, or the one installed with GeographicLib if none is set,
+ for the orthometric height. Without a grid only the ellipsoidal height is available.
+ */
+void MainWindow::loadGeoid()
+{
+    m_settings.beginGroup("Preferences_Dialog");
+    QString path = m_settings.value("geoid_path").toString();
+    int interpolation = m_settings.value("geoid_interpolation", 0).toInt();
+    m_settings.endGroup();
+
+    if (path.isEmpty())
+    {
+        path = GeoidModel::findDefault();
+    }
+
+    if (path != m_geoid.fileName() || !m_geoid.isOpen())
+    {
+        m_monitorPvtWrapper->setGeoidModel(nullptr);
+        m_altitudeWidget->setGeoidName(QString());
+        if (path.isEmpty())
+        {
+            m_geoid.close();
+            return;
+        }
+        if (!m_geoid.open(path))
+        {
+            statusBar()->showMessage(m_geoid.errorString(), 5000);
+            return;
+        }
+    }
 
-    m_socketGnssSynchro->disconnectFromHost();
-    m_socketGnssSynchro->bind(QHostAddress::Any, m_portGnssSynchro);
-    m_socketMonitorPvt->bind(QHostAddress::Any, m_portMonitorPvt);
-    m_socketGpsEphemeris->bind(QHostAddress::Any, m_portGpsEphemeris);
+    m_geoid.setInterpolation(interpolation == 1 ? GeoidModel::Interpolation::Bicubic
+                                                : GeoidModel::Interpolation::Bilinear);
+    m_monitorPvtWrapper->setGeoidModel(&m_geoid);
+    m_altitudeWidget->setGeoidName(QFileInfo(path).completeBaseName());
 }
 
 void MainWindow::expandPlot(const QModelIndex &index)
@@ -497,7 +1158,7 @@ void MainWindow::expandPlot(const QModelIndex &index)
                 [this, index]() { m_plotsConstellation.erase(index.row()); });
 
             // Update chart on timer timeout.
-            connect(&m_updateTimer, &QTimer::timeout, chart, [this, chart, series, index]() {
+            connect(&m_updateTimer, &ClockTimer::timeout, chart, [this, chart, series, index]() {
                 updateChart(chart, series, index);
             });
 
@@ -539,7 +1200,7 @@ void MainWindow::expandPlot(const QModelIndex &index)
                 [this, index]() { m_plotsCn0.erase(index.row()); });
 
             // Update chart on timer timeout.
-            connect(&m_updateTimer, &QTimer::timeout, chart, [this, chart, series, index]() {
+            connect(&m_updateTimer, &ClockTimer::timeout, chart, [this, chart, series, index]() {
                 updateChart(chart, series, index);
             });
 
@@ -581,7 +1242,7 @@ void MainWindow::expandPlot(const QModelIndex &index)
                 [this, index]() { m_plotsDoppler.erase(index.row()); });
 
             // Update chart on timer timeout.
-            connect(&m_updateTimer, &QTimer::timeout, chart, [this, chart, series, index]() {
+            connect(&m_updateTimer, &ClockTimer::timeout, chart, [this, chart, series, index]() {
                 updateChart(chart, series, index);
             });
 
@@ -602,6 +1263,59 @@ void MainWindow::expandPlot(const QModelIndex &index)
     chartView->show();
 }
 
+/*!
+ Sends the channel table columns due for a refresh, and polls again while some are still pending.
+ */
+void MainWindow::refreshTable()
+{
+    if (m_model->refresh(clockNowMs(&m_clock)) && !m_tableTimer.isActive())
+    {
+        m_tableTimer.start();
+    }
+}
+
+/*!
+ Tells the model which columns of the channel table are shown and at least partly on screen.
+ */
+void MainWindow::updateVisibleColumns()
+{
+    const QHeaderView *header = ui->tableView->horizontalHeader();
+    const int first = header->visualIndexAt(0);
+    const int last = header->visualIndexAt(header->viewport()->width() - 1);
+    for (int column = 0; column < m_model->getColumns(); column++)
+    {
+        const int visual = header->visualIndex(column);
+        const bool on_screen = (first < 0 || visual >= first) && (last < 0 || visual <= last);
+        m_model->setColumnVisible(column, !header->isSectionHidden(column) && on_screen);
+    }
+
+    // The columns that just came into view are sent with the next refresh.
+    if (m_model->hasDirtyColumns() && !m_tableTimer.isActive())
+    {
+        m_tableTimer.start();
+    }
+}
+
+/*!
+ Shows the menu that hides and shows the columns of the channel table at \a pos of its header.
+ */
+void MainWindow::showColumnMenu(const QPoint &pos)
+{
+    QHeaderView *header = ui->tableView->horizontalHeader();
+    QMenu menu(this);
+    for (int column = 0; column < m_model->getColumns(); column++)
+    {
+        QAction *action = menu.addAction(m_model->headerData(column, Qt::Horizontal, Qt::DisplayRole).toString());
+        action->setCheckable(true);
+        action->setChecked(!header->isSectionHidden(column));
+        connect(action, &QAction::toggled, this, [this, column](bool shown) {
+            ui->tableView->setColumnHidden(column, !shown);
+            updateVisibleColumns();
+        });
+    }
+    menu.exec(header->mapToGlobal(pos));
+}
+
 void MainWindow::closePlots()
 {
     for (auto const &ch : m_plotsConstellation)
@@ -33,15 +33,30 @@
 #ifndef GNSS_SDR_MONITOR_MAIN_WINDOW_H_
 #define GNSS_SDR_MONITOR_MAIN_WINDOW_H_
 
+#include "alert_capture.h"
 #include "altitude_widget.h"
+#include "analytics_host.h"
+#include "analytics_panel.h"
 #include "channel_table_model.h"
+#include "cn0_elevation_model.h"
 #include "dop_widget.h"
+#include "doppler_residuals.h"
+#include "ephemeris_store.h"
 #include "ephemeris_widget.h"
-#include "gnss_synchro.pb.h"
-#include "monitor_pvt.pb.h"
-#include "gps_ephemeris.pb.h"
+#include "event_log.h"
+#include "event_log_widget.h"
+#include "geoid_model.h"
+#include "gnss_time.h"
 #include "gps_ephemeris_wrapper.h"
+#include "health_matrix_widget.h"
+#include "monitor_clock.h"
 #include "monitor_pvt_wrapper.h"
+#include "monitor_streams.h"
+#include "query_server.h"
+#include "satellite_health.h"
+#include "session_player.h"
+#include "session_recorder.h"
+#include "session_state.h"
 #include "telecommand_widget.h"
 #include "skyplot_widget.h"
 #include <QAbstractTableModel>
@@ -50,9 +65,7 @@
 #include <QMainWindow>
 #include <QQuickWidget>
 #include <QSettings>
-#include <QTimer>
 #include <QXYSeries>
-#include <QtNetwork/QUdpSocket>
 
 class QLabel;
 
@@ -71,38 +84,79 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *parent = nullptr);
+    enum class Mode
+    {
+        Interactive,
+        Benchmark  // Neither restores nor saves the session, and binds no port.
+    };
+
+    explicit MainWindow(QWidget *parent = nullptr, Mode mode = Mode::Interactive);
     ~MainWindow();
 
-    gnss_sdr::Observables readGnssSynchro(char buff[], int bytes);
-    gnss_sdr::MonitorPvt readMonitorPvt(char buff[], int bytes);
-    gnss_sdr::GpsEphemeris readGpsEphemeris(char buff[], int bytes);
+    // Consumers of the streams declared in monitor_streams.h.
+    void handle(GnssSynchroStream, const gnss_sdr::Observables &stocks);
+    void handle(MonitorPvtStream, const gnss_sdr::MonitorPvt &monitorPvt);
+    void handle(GpsEphemerisStream, const gnss_sdr::GpsEphemeris &gpsEphemeris);
+    void handle(GalileoEphemerisStream, const gnss_sdr::GalileoEphemeris &ephemeris);
+    void handle(BeidouEphemerisStream, const gnss_sdr::BeidouEphemeris &ephemeris);
+    void handle(GlonassEphemerisStream, const gnss_sdr::GlonassGnavEphemeris &ephemeris);
+
     void loadSettings();
     void saveSettings();
 
+    // Replay entry points, shared by the interactive replay and the benchmark.
+    void beginReplay(qint64 start_ms);
+    void endReplay();
+    bool dispatchRecord(quint16 stream_id, const char *data, int size);
+    MonitorClock *clock() { return &m_clock; }
+
+    // The views that can be rendered on their own, by name.
+    std::vector<std::pair<QString, QWidget *>> views() const;
+    void showViews();
+
+signals:
+    // Emitted after each refresh of the views, once the model and plots are up to date.
+    void viewsRefreshed();
+
 public slots:
     void toggleCapture();
-    void receiveGnssSynchro();
-    void receiveMonitorPvt();
-    void receiveGpsEphemeris();
+    void toggleRecording(bool checked);
+    void replaySession();
+    void replayFinished();
+    void compareSessions();
+    void updatePvtViews();
+    void showAlert(const MonitorEvent &event);
+    void captureAlert(const MonitorEvent &event);
     void clearEntries();
     void quit();
     void showPreferences();
     void setPort();
+    void loadGeoid();
+    void configureAlertCapture();
+    void applyHistoryWindow();
     void expandPlot(const QModelIndex &index);
+    void refreshTable();
+    void updateVisibleColumns();
+    void showColumnMenu(const QPoint &pos);
     void closePlots();
     void deletePlots();
     void about();
 
 protected:
     void closeEvent(QCloseEvent *event) override;
+    bool eventFilter(QObject *object, QEvent *event) override;
 
 private:
     void updateChart(QtCharts::QChart *chart, QtCharts::QXYSeries *series, const QModelIndex &index);
+    void checkEphemerisUpload(const std::string &system, int prn);
+    void observeCn0(const gnss_sdr::Observables &stocks, const PvtSnapshot *pvt);
+    void setFix(bool has_fix, const QString &reason);
+    void restoreSession();
 
     Ui::MainWindow *ui;
 
     QLabel *m_gpsTimeLabel;
+    QLabel *m_clockDriftLabel;
 
     QDockWidget *m_mapDockWidget;
     QDockWidget *m_telecommandDockWidget;
@@ -110,6 +164,9 @@ private:
     QDockWidget *m_DOPDockWidget;
     QDockWidget *m_skyplotDockWidget;
     QDockWidget *m_ephemerisDockWidget;
+    QDockWidget *m_healthDockWidget;
+    QDockWidget *m_eventDockWidget;
+    QDockWidget *m_analyticsDockWidget;
 
     QQuickWidget *m_mapWidget;
     TelecommandWidget *m_telecommandWidget;
@@ -117,27 +174,43 @@ private:
     DOPWidget *m_DOPWidget;
     SkyPlotWidget *m_skyplotWidget;
     EphemerisWidget *m_ephemerisWidget;
+    HealthMatrixWidget *m_healthWidget;
+    EventLogWidget *m_eventLogWidget;
+    AnalyticsPanel *m_analyticsPanel;
 
     ChannelTableModel *m_model;
-    QUdpSocket *m_socketGnssSynchro;
-    QUdpSocket *m_socketMonitorPvt;
-    QUdpSocket *m_socketGpsEphemeris;
-    gnss_sdr::Observables m_stocks;
+    MonitorClock m_clock;
+    MonitorStreams::Registry<MainWindow> m_streams;
+    SessionRecorder m_recorder;
+    AlertCapture m_alertCapture;
+    SessionPlayer m_player;
+    SessionState m_sessionState;
+    bool m_restoredSession = false;
+    QueryServer m_queryServer;
+    GnssTime m_gnssTime;
+    GeoidModel m_geoid;
     MonitorPvtWrapper *m_monitorPvtWrapper;
     GpsEphemerisWrapper *m_GpsEphemerisWrapper;
-    gnss_sdr::MonitorPvt m_monitorPvt;
-    gnss_sdr::GpsEphemeris m_gpsEphemeris;
+    EphemerisStore m_ephemerisStore;
+    Cn0ElevationModel m_cn0Model;
+    SatelliteHealth m_satelliteHealth;
+    EventLog m_eventLog;
+    AnalyticsHost m_analytics;
+    DopplerResidualModule *m_dopplerResiduals;  // Owned by m_analytics.
 
     std::vector<int> m_channels;
-    quint16 m_portGnssSynchro;
-    quint16 m_portMonitorPvt;
-    quint16 m_portGpsEphemeris;
+    Mode m_mode;
     QSettings m_settings;
-    QTimer m_updateTimer;
+    ClockTimer m_updateTimer;
+    ClockTimer m_tableTimer;
+    ClockTimer m_fixTimer;  // Runs out when no PVT with a fix arrives for FIX_TIMEOUT_MS.
+    bool m_hasFix = false;
+    static constexpr int FIX_TIMEOUT_MS = 3000;
 
     QAction *m_start;
     QAction *m_stop;
     QAction *m_clear;
+    QAction *m_record;
     QAction *m_closePlotsAction;
 
     int m_bufferSize;
@@ -0,0 +1,236 @@
+/*!
+ * \file monitor_clock.cpp
+ * \brief Implementation of the injectable clock shared by the timers of the
+ * monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "monitor_clock.h"
+#include <algorithm>
+
+MonitorClock::MonitorClock(QObject *parent)
+    : QObject(parent), m_mode(Mode::Live), m_virtualMs(0), m_nextSequence(0)
+{
+}
+
+MonitorClock::~MonitorClock()
+{
+    for (ClockTimer *timer : m_timers)
+    {
+        timer->m_clock = nullptr;
+    }
+}
+
+qint64 MonitorClock::nowMs() const
+{
+    return m_mode == Mode::Virtual ? m_virtualMs : QDateTime::currentMSecsSinceEpoch();
+}
+
+/*!
+ Returns to wall time. Active timers are restarted with their full interval.
+ */
+void MonitorClock::setLive()
+{
+    setMode(Mode::Live);
+}
+
+/*!
+ Switches to virtual time starting at \a start_ms. Active timers are restarted with their full interval.
+ */
+void MonitorClock::startVirtual(qint64 start_ms)
+{
+    m_virtualMs = start_ms;
+    setMode(Mode::Virtual);
+}
+
+/*!
+ Moves the virtual time forward to \a ms, firing every timer that falls due on
+ the way in deadline order. Time never moves backwards.
+ */
+void MonitorClock::advanceTo(qint64 ms)
+{
+    if (m_mode != Mode::Virtual)
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        ClockTimer *next = nullptr;
+        for (ClockTimer *timer : m_timers)
+        {
+            if (!timer->m_virtualActive || timer->m_deadline > ms)
+            {
+                continue;
+            }
+            if (!next || timer->m_deadline < next->m_deadline ||
+                (timer->m_deadline == next->m_deadline && timer->m_sequence < next->m_sequence))
+            {
+                next = timer;
+            }
+        }
+
+        if (!next)
+        {
+            break;
+        }
+
+        m_virtualMs = std::max(m_virtualMs, next->m_deadline);
+        if (next->m_singleShot)
+        {
+            next->m_virtualActive = false;
+        }
+        else
+        {
+            next->m_deadline += std::max(1, next->m_interval);
+            next->m_sequence = m_nextSequence++;
+        }
+        emit next->timeout();
+    }
+
+    m_virtualMs = std::max(m_virtualMs, ms);
+}
+
+void MonitorClock::setMode(Mode mode)
+{
+    bool changed = mode != m_mode;
+    m_mode = mode;
+
+    // Timers may be stopped or started by the slots they trigger, so iterate over a copy.
+    std::vector<ClockTimer *> timers = m_timers;
+    for (ClockTimer *timer : timers)
+    {
+        timer->rearm();
+    }
+
+    if (changed)
+    {
+        emit modeChanged(mode);
+    }
+}
+
+void MonitorClock::registerTimer(ClockTimer *timer)
+{
+    m_timers.push_back(timer);
+}
+
+void MonitorClock::unregisterTimer(ClockTimer *timer)
+{
+    m_timers.erase(std::remove(m_timers.begin(), m_timers.end(), timer), m_timers.end());
+}
+
+
+ClockTimer::ClockTimer(QObject *parent)
+    : QObject(parent), m_clock(nullptr), m_interval(0), m_singleShot(false),
+      m_virtualActive(false), m_deadline(0), m_sequence(0)
+{
+    connect(&m_timer, &QTimer::timeout, this, &ClockTimer::timeout);
+}
+
+ClockTimer::~ClockTimer()
+{
+    if (m_clock)
+    {
+        m_clock->unregisterTimer(this);
+    }
+}
+
+/*!
+ Makes the timer follow \a clock. An active timer is restarted with its full interval.
+ */
+void ClockTimer::setClock(MonitorClock *clock)
+{
+    if (clock == m_clock)
+    {
+        return;
+    }
+
+    if (m_clock)
+    {
+        m_clock->unregisterTimer(this);
+    }
+    m_clock = clock;
+    if (m_clock)
+    {
+        m_clock->registerTimer(this);
+    }
+    rearm();
+}
+
+void ClockTimer::setInterval(int msec)
+{
+    m_interval = msec;
+    m_timer.setInterval(msec);
+}
+
+void ClockTimer::setSingleShot(bool singleShot)
+{
+    m_singleShot = singleShot;
+    m_timer.setSingleShot(singleShot);
+}
+
+bool ClockTimer::isActive() const
+{
+    return m_virtualActive || m_timer.isActive();
+}
+
+void ClockTimer::start()
+{
+    stop();
+    if (usesVirtualTime())
+    {
+        m_deadline = m_clock->nowMs() + m_interval;
+        m_sequence = m_clock->m_nextSequence++;
+        m_virtualActive = true;
+    }
+    else
+    {
+        m_timer.start();
+    }
+}
+
+void ClockTimer::start(int msec)
+{
+    setInterval(msec);
+    start();
+}
+
+void ClockTimer::stop()
+{
+    m_timer.stop();
+    m_virtualActive = false;
+}
+
+void ClockTimer::rearm()
+{
+    if (isActive())
+    {
+        start();
+    }
+}
@@ -0,0 +1,144 @@
+/*!
+ * \file monitor_clock.h
+ * \brief Injectable clock shared by the timers of the monitor: wall time when
+ * live, virtual time advanced by the data timestamps during replay.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_MONITOR_CLOCK_H_
+#define GNSS_SDR_MONITOR_MONITOR_CLOCK_H_
+
+#include <QDateTime>
+#include <QObject>
+#include <QTimer>
+#include <vector>
+
+class ClockTimer;
+
+/*!
+ Source of time for everything in the monitor that depends on it: refresh
+ timers, stale data cleanup and "last seen" stamps.
+
+ In live mode the time is the wall clock and ClockTimers are plain QTimers.
+ In virtual mode the time only moves when advanceTo() is called, normally by
+ the replay with the timestamp of each record, and the timers that fall due
+ are fired in deadline order from within that call. A replay therefore
+ produces the same sequence of events at any speed.
+ */
+class MonitorClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Mode
+    {
+        Live,
+        Virtual
+    };
+
+    explicit MonitorClock(QObject *parent = nullptr);
+    ~MonitorClock();
+
+    Mode mode() const { return m_mode; }
+    bool isVirtual() const { return m_mode == Mode::Virtual; }
+
+    // Milliseconds since the Unix epoch.
+    qint64 nowMs() const;
+    QDateTime now() const { return QDateTime::fromMSecsSinceEpoch(nowMs()); }
+
+    void setLive();
+    void startVirtual(qint64 start_ms);
+    void advanceTo(qint64 ms);
+
+signals:
+    void modeChanged(MonitorClock::Mode mode);
+
+private:
+    friend class ClockTimer;
+    void registerTimer(ClockTimer *timer);
+    void unregisterTimer(ClockTimer *timer);
+    void setMode(Mode mode);
+
+    Mode m_mode;
+    qint64 m_virtualMs;
+    quint64 m_nextSequence;
+    std::vector<ClockTimer *> m_timers;
+};
+
+/*!
+ Returns the current time of \a clock, or the wall time if there is no clock.
+ */
+inline qint64 clockNowMs(const MonitorClock *clock)
+{
+    return clock ? clock->nowMs() : QDateTime::currentMSecsSinceEpoch();
+}
+
+/*!
+ Drop-in replacement for the subset of QTimer used by the views, driven by a MonitorClock.
+ Without a clock it behaves exactly like a QTimer.
+ */
+class ClockTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClockTimer(QObject *parent = nullptr);
+    ~ClockTimer();
+
+    void setClock(MonitorClock *clock);
+
+    void setInterval(int msec);
+    int interval() const { return m_interval; }
+    void setSingleShot(bool singleShot);
+    bool isSingleShot() const { return m_singleShot; }
+    bool isActive() const;
+
+public slots:
+    void start();
+    void start(int msec);
+    void stop();
+
+signals:
+    void timeout();
+
+private:
+    friend class MonitorClock;
+    bool usesVirtualTime() const { return m_clock && m_clock->isVirtual(); }
+    void rearm();
+
+    MonitorClock *m_clock;
+    QTimer m_timer;
+    int m_interval;
+    bool m_singleShot;
+    bool m_virtualActive;
+    qint64 m_deadline;
+    quint64 m_sequence;  // Orders timers that fall due at the same time.
+};
+
+#endif  // GNSS_SDR_MONITOR_MONITOR_CLOCK_H_
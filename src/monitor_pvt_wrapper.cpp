@@ -31,21 +31,24 @@
 
 
 #include "monitor_pvt_wrapper.h"
+#include "geodesy.h"
 #include <QDebug>
 #include <QGeoCoordinate>
+#include <QThread>
+#include <algorithm>
+#include <limits>
 
 /*!
  Constructs a MonitorPvtWrapper object.
  */
-MonitorPvtWrapper::MonitorPvtWrapper(QObject *parent) : QObject(parent)
+MonitorPvtWrapper::MonitorPvtWrapper(QObject *parent) : QObject(parent), m_notifyPending(false)
 {
-    m_bufferSize = 100;
+    m_notifyTimer.setSingleShot(true);
+    connect(&m_notifyTimer, &ClockTimer::timeout, this, &MonitorPvtWrapper::notify);
 
-    m_bufferMonitorPvt.resize(m_bufferSize);
-    m_bufferMonitorPvt.clear();
-
-    m_path.resize(m_bufferSize);
-    m_path.clear();
+    m_bufferMonitorPvt.setCapacity(m_window.capacity());
+    m_time.setCapacity(m_window.capacity());
+    m_path.setCapacity(m_window.capacity());
 }
 
 /*!
@@ -53,16 +56,54 @@ MonitorPvtWrapper::MonitorPvtWrapper(QObject *parent) : QObject(parent)
  */
 void MonitorPvtWrapper::addMonitorPvt(const gnss_sdr::MonitorPvt &monitor_pvt)
 {
+    // Time on the continuous axis shared with the other views, in seconds.
+    double time = monitor_pvt.rx_time();
+    if (m_gnssTime)
+    {
+        time = monitor_pvt.week() > 0 ? m_gnssTime->continuousTime(monitor_pvt.week(), time)
+                                      : m_gnssTime->continuousTime(time);
+    }
+
+    if (m_window.observe(time))
+    {
+        m_bufferMonitorPvt.setCapacity(m_window.capacity());
+        m_time.setCapacity(m_window.capacity());
+        m_path.setCapacity(m_window.capacity());
+    }
     m_bufferMonitorPvt.push_back(monitor_pvt);
+    m_time.push_back(time);
 
     Coordinates coord;
     coord.latitude = monitor_pvt.latitude();
     coord.longitude = monitor_pvt.longitude();
     m_path.push_back(coord);
 
-    emit dataChanged();
-    emit altitudeChanged(monitor_pvt.tow_at_current_symbol_ms(), monitor_pvt.height());
-    emit dopChanged(monitor_pvt.tow_at_current_symbol_ms(), monitor_pvt.gdop(), monitor_pvt.pdop(), monitor_pvt.hdop(), monitor_pvt.vdop());
+    m_latest.publish(PvtSnapshot::fromMonitorPvt(monitor_pvt));
+    if (!m_notifyPending.exchange(true))
+    {
+        // Hop to the thread that owns the wrapper in case ingest runs elsewhere. On the
+        // same thread schedule right away, so that a replay driving the virtual clock
+        // sees the same notifications at any speed.
+        if (QThread::currentThread() == thread())
+        {
+            scheduleNotification();
+        }
+        else
+        {
+            QMetaObject::invokeMethod(this, [this] { scheduleNotification(); }, Qt::QueuedConnection);
+        }
+    }
+
+    // Once per epoch, so that the views only copy heights.
+    double orthometric = std::numeric_limits<double>::quiet_NaN();
+    double undulation = 0.0;
+    if (m_geoid && m_geoid->undulation(monitor_pvt.latitude(), monitor_pvt.longitude(), undulation))
+    {
+        orthometric = monitor_pvt.height() - undulation;
+    }
+
+    emit altitudeChanged(time, monitor_pvt.height(), orthometric);
+    emit dopChanged(time, monitor_pvt.gdop(), monitor_pvt.pdop(), monitor_pvt.hdop(), monitor_pvt.vdop());
 }
 
 /*!
@@ -73,24 +114,182 @@ gnss_sdr::MonitorPvt MonitorPvtWrapper::getLastMonitorPvt()
     return m_bufferMonitorPvt.back();
 }
 
+/*!
+ Copies the latest published PVT into \a snapshot without blocking the ingest side.
+ Returns false if no PVT has been received since the last clear.
+ */
+bool MonitorPvtWrapper::latest(PvtSnapshot &snapshot) const
+{
+    return m_latest.read(snapshot);
+}
+
+/*!
+ Copies into \a snapshot the history of the PVT fields selected by \a request.
+ */
+void MonitorPvtWrapper::fillSnapshot(const SeriesRequest &request, SeriesSnapshot &snapshot) const
+{
+    if (request.kind != SeriesRequest::Kind::Pvt)
+    {
+        return;
+    }
+
+    std::vector<double> time;
+    m_time.copyTo(time);
+    std::vector<double> enu[3];
+    bool enu_done = false;
+    for (const QString &field : request.fields)
+    {
+        SeriesSnapshot::Series series;
+        series.field = field;
+        series.time = time;
+
+        const int axis = SeriesRequest::enuFields().indexOf(field);
+        const SeriesRequest::PvtGetter value = SeriesRequest::pvtGetter(field);
+        if (axis >= 0)
+        {
+            if (!enu_done)
+            {
+                enuErrors(enu);
+                enu_done = true;
+            }
+            series.values = enu[axis];
+        }
+        else if (value)
+        {
+            series.values.reserve(time.size());
+            m_bufferMonitorPvt.forEach([&series, value](const gnss_sdr::MonitorPvt &pvt) {
+                series.values.push_back(value(pvt));
+            });
+        }
+        else
+        {
+            continue;
+        }
+        snapshot.series.push_back(std::move(series));
+    }
+}
+
+/*!
+ Appends to \a history the PVT kept in the history window, oldest first.
+ */
+void MonitorPvtWrapper::copyHistory(std::vector<gnss_sdr::MonitorPvt> &history) const
+{
+    m_bufferMonitorPvt.copyTo(history);
+}
+
+/*!
+ Fills \a enu with the east, north and up offsets of every fix in the history from their mean
+ ECEF position, converted in one batch.
+ */
+void MonitorPvtWrapper::enuErrors(std::vector<double> (&enu)[3]) const
+{
+    std::vector<double> x, y, z;
+    x.reserve(m_bufferMonitorPvt.size());
+    y.reserve(m_bufferMonitorPvt.size());
+    z.reserve(m_bufferMonitorPvt.size());
+    double mean[3] = {0.0, 0.0, 0.0};
+    m_bufferMonitorPvt.forEach([&](const gnss_sdr::MonitorPvt &pvt) {
+        x.push_back(pvt.pos_x());
+        y.push_back(pvt.pos_y());
+        z.push_back(pvt.pos_z());
+        mean[0] += pvt.pos_x();
+        mean[1] += pvt.pos_y();
+        mean[2] += pvt.pos_z();
+    });
+    if (x.empty())
+    {
+        return;
+    }
+
+    double latitude, longitude, height;
+    for (double &m : mean)
+    {
+        m /= static_cast<double>(x.size());
+    }
+    geodesy::ecefToGeodetic(&mean[0], &mean[1], &mean[2], 1, &latitude, &longitude, &height);
+    const geodesy::LocalFrame frame = geodesy::LocalFrame::at(latitude, longitude, height);
+
+    for (std::vector<double> &axis : enu)
+    {
+        axis.resize(x.size());
+    }
+    geodesy::ecefToEnu(frame, x.data(), y.data(), z.data(), x.size(), enu[0].data(), enu[1].data(), enu[2].data());
+}
+
+/*!
+ Sets the time service used to place the PVT history on the continuous time axis shared by all views.
+ */
+void MonitorPvtWrapper::setTimeService(GnssTime *gnss_time)
+{
+    m_gnssTime = gnss_time;
+}
+
+/*!
+ Sets the geoid model used to derive the orthometric height of each PVT, or none if \a geoid is null.
+ */
+void MonitorPvtWrapper::setGeoidModel(GeoidModel *geoid)
+{
+    m_geoid = geoid;
+}
+
+/*!
+ Sets the clock that paces the notifications, so that they follow the virtual time during replay.
+ */
+void MonitorPvtWrapper::setClock(MonitorClock *clock)
+{
+    m_clock = clock;
+    m_notifyTimer.setClock(clock);
+    m_lastNotifyMs = -1;
+}
+
+/*!
+ Starts the frame timer so that all the PVT published until it fires results in a single notification.
+ */
+void MonitorPvtWrapper::scheduleNotification()
+{
+    if (m_notifyTimer.isActive())
+    {
+        return;
+    }
+
+    int wait = 0;
+    if (m_lastNotifyMs >= 0)
+    {
+        wait = static_cast<int>(std::max<qint64>(0, FRAME_INTERVAL_MS - (clockNowMs(m_clock) - m_lastNotifyMs)));
+    }
+    m_notifyTimer.start(wait);
+}
+
+void MonitorPvtWrapper::notify()
+{
+    m_notifyPending = false;
+    m_lastNotifyMs = clockNowMs(m_clock);
+    emit dataChanged();
+}
+
 /*!
  Clears all the data from the internal data structures.
  */
 void MonitorPvtWrapper::clearData()
 {
     m_bufferMonitorPvt.clear();
+    m_time.clear();
     m_path.clear();
+    m_latest.reset();
+    m_window.reset();
 
     emit dataChanged();
 }
 
 /*!
- Sets the size of the internal circular buffers that store the data.
+ Keeps the PVT of the last \a seconds. The circular buffers are sized from the rate of the PVT.
  */
-void MonitorPvtWrapper::setBufferSize(size_t size)
+void MonitorPvtWrapper::setHistoryWindow(double seconds)
 {
-    m_bufferSize = size;
-    m_bufferMonitorPvt.resize(m_bufferSize);
+    m_window.setSeconds(seconds);
+    m_bufferMonitorPvt.setCapacity(m_window.capacity());
+    m_time.setCapacity(m_window.capacity());
+    m_path.setCapacity(m_window.capacity());
 }
 
 /*!
@@ -98,10 +297,10 @@ void MonitorPvtWrapper::setBufferSize(size_t size)
  */
 QVariant MonitorPvtWrapper::position() const
 {
-    if (!m_bufferMonitorPvt.empty())
+    PvtSnapshot pvt;
+    if (m_latest.read(pvt))
     {
-        gnss_sdr::MonitorPvt mpvt = m_bufferMonitorPvt.back();
-        return QVariant::fromValue(QGeoCoordinate(mpvt.latitude(), mpvt.longitude()));
+        return QVariant::fromValue(QGeoCoordinate(pvt.latitude, pvt.longitude));
     }
     else
     {
@@ -117,11 +316,10 @@ QVariantList MonitorPvtWrapper::path() const
     if (!m_path.empty())
     {
         QVariantList list;
-        for (size_t i = 0; i < m_path.size(); i++)
-        {
-            Coordinates coord = m_path.at(i);
+        list.reserve(static_cast<int>(m_path.size()));
+        m_path.forEach([&list](const Coordinates &coord) {
             list << QVariant::fromValue(QGeoCoordinate(coord.latitude, coord.longitude));
-        }
+        });
         return list;
     }
     else
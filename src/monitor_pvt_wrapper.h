@@ -33,10 +33,19 @@
 #ifndef GNSS_SDR_MONITOR_MONITOR_PVT_WRAPPER_H_
 #define GNSS_SDR_MONITOR_MONITOR_PVT_WRAPPER_H_
 
+#include "geoid_model.h"
+#include "gnss_time.h"
+#include "history_window.h"
+#include "latest_value.h"
+#include "monitor_clock.h"
 #include "monitor_pvt.pb.h"
-#include <boost/circular_buffer.hpp>
+#include "pvt_snapshot.h"
+#include "ring_buffer.h"
+#include "series_query.h"
 #include <QObject>
 #include <QVariant>
+#include <atomic>
+#include <vector>
 
 class MonitorPvtWrapper : public QObject
 {
@@ -49,6 +58,12 @@ public:
     void addMonitorPvt(const gnss_sdr::MonitorPvt &monitor_pvt);
 
     gnss_sdr::MonitorPvt getLastMonitorPvt();
+    bool latest(PvtSnapshot &snapshot) const;
+    void fillSnapshot(const SeriesRequest &request, SeriesSnapshot &snapshot) const;
+    void copyHistory(std::vector<gnss_sdr::MonitorPvt> &history) const;
+    void setTimeService(GnssTime *gnss_time);
+    void setGeoidModel(GeoidModel *geoid);
+    void setClock(MonitorClock *clock);
 
     QVariant position() const;
     QVariantList path() const;
@@ -60,18 +75,34 @@ public:
     };
 
 signals:
+    // Coalesced: emitted at most once per frame no matter how fast PVT arrives.
     void dataChanged();
-    void altitudeChanged(qreal newTow, qreal newAltitude);
-    void dopChanged(qreal newTow, qreal newGdop, qreal newPdop, qreal newHdop, qreal newVdop);
+    // newOrthometric is NaN without a geoid model.
+    void altitudeChanged(qreal newTime, qreal newAltitude, qreal newOrthometric);
+    void dopChanged(qreal newTime, qreal newGdop, qreal newPdop, qreal newHdop, qreal newVdop);
 
 public slots:
     void clearData();
-    void setBufferSize(size_t size);
+    void setHistoryWindow(double seconds);
 
 private:
-    size_t m_bufferSize;
-    boost::circular_buffer<gnss_sdr::MonitorPvt> m_bufferMonitorPvt;
-    boost::circular_buffer<Coordinates> m_path;
+    void scheduleNotification();
+    void enuErrors(std::vector<double> (&enu)[3]) const;
+    void notify();
+
+    HistoryWindow m_window;
+    GnssTime *m_gnssTime = nullptr;
+    GeoidModel *m_geoid = nullptr;
+    LatestValue<PvtSnapshot> m_latest;
+    std::atomic<bool> m_notifyPending;
+    MonitorClock *m_clock = nullptr;
+    ClockTimer m_notifyTimer;
+    qint64 m_lastNotifyMs = -1;
+
+    static constexpr int FRAME_INTERVAL_MS = 16;
+    RingBuffer<gnss_sdr::MonitorPvt> m_bufferMonitorPvt;
+    RingBuffer<double> m_time;  // Continuous time of each entry of m_bufferMonitorPvt.
+    RingBuffer<Coordinates> m_path;
 };
 
 #endif  // GNSS_SDR_MONITOR_MONITOR_PVT_WRAPPER_H_
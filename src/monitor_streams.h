@@ -0,0 +1,104 @@
+/*!
+ * \file monitor_streams.h
+ * \brief Declaration of the streams published by GNSS-SDR that the monitor
+ * listens to.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_MONITOR_STREAMS_H_
+#define GNSS_SDR_MONITOR_MONITOR_STREAMS_H_
+
+#include "beidou_ephemeris.pb.h"
+#include "galileo_ephemeris.pb.h"
+#include "glonass_gnav_ephemeris.pb.h"
+#include "gnss_synchro.pb.h"
+#include "gps_ephemeris.pb.h"
+#include "monitor_pvt.pb.h"
+#include "stream_registry.h"
+
+struct GnssSynchroStream
+{
+    using Message = gnss_sdr::Observables;
+    static constexpr quint16 id = 1;
+    static constexpr quint16 defaultPort = 1111;
+    static const char *settingsKey() { return "port_gnss_synchro"; }
+    static const char *label() { return "GNSS_Synchro port:"; }
+};
+
+struct MonitorPvtStream
+{
+    using Message = gnss_sdr::MonitorPvt;
+    static constexpr quint16 id = 2;
+    static constexpr quint16 defaultPort = 1112;
+    static const char *settingsKey() { return "port_monitor_pvt"; }
+    static const char *label() { return "Monitor_Pvt port:"; }
+};
+
+struct GpsEphemerisStream
+{
+    using Message = gnss_sdr::GpsEphemeris;
+    static constexpr quint16 id = 3;
+    static constexpr quint16 defaultPort = 1113;
+    static const char *settingsKey() { return "port_gps_ephemeris"; }
+    static const char *label() { return "GPS_Ephemeris port:"; }
+};
+
+struct GalileoEphemerisStream
+{
+    using Message = gnss_sdr::GalileoEphemeris;
+    static constexpr quint16 id = 4;
+    static constexpr quint16 defaultPort = 1114;
+    static const char *settingsKey() { return "port_galileo_ephemeris"; }
+    static const char *label() { return "Galileo_Ephemeris port:"; }
+};
+
+struct BeidouEphemerisStream
+{
+    using Message = gnss_sdr::BeidouEphemeris;
+    static constexpr quint16 id = 5;
+    static constexpr quint16 defaultPort = 1115;
+    static const char *settingsKey() { return "port_beidou_ephemeris"; }
+    static const char *label() { return "BeiDou_Ephemeris port:"; }
+};
+
+struct GlonassEphemerisStream
+{
+    using Message = gnss_sdr::GlonassGnavEphemeris;
+    static constexpr quint16 id = 6;
+    static constexpr quint16 defaultPort = 1116;
+    static const char *settingsKey() { return "port_glonass_ephemeris"; }
+    static const char *label() { return "GLONASS_Ephemeris port:"; }
+};
+
+// Adding a stream: declare it above, append it here and give the handler a
+// handle() overload for it.
+using MonitorStreams = StreamList<GnssSynchroStream, MonitorPvtStream, GpsEphemerisStream,
+    GalileoEphemerisStream, BeidouEphemerisStream, GlonassEphemerisStream>;
+
+#endif  // GNSS_SDR_MONITOR_MONITOR_STREAMS_H_
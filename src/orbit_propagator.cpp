@@ -0,0 +1,142 @@
+/*!
+ * \file orbit_propagator.cpp
+ * \brief Implementation of the GLONASS RK4 orbit integrator.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "orbit_propagator.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// PZ-90 constants from the GLONASS ICD.
+constexpr double GLO_GM = 398600.4418e9;     // [m^3/s^2]
+constexpr double GLO_AE = 6378136.0;         // [m]
+constexpr double GLO_C20 = -1082.62575e-6;  // Second zonal harmonic
+constexpr double GLO_OMEGA = 7.292115e-5;    // [rad/s]
+constexpr double SECONDS_PER_DAY = 86400.0;
+}  // namespace
+
+GlonassPropagator::GlonassPropagator(const GlonassStateVector &ephemeris)
+    : m_ephemeris(ephemeris), m_cacheTime(0.0)
+{
+    std::memcpy(m_cacheState, m_ephemeris.pos, sizeof(m_ephemeris.pos));
+    std::memcpy(m_cacheState + 3, m_ephemeris.vel, sizeof(m_ephemeris.vel));
+}
+
+/*!
+ Returns the satellite position at GLONASS time of day \a tod, integrating from
+ whichever of t_b and the cached state is closer.
+ */
+EcefPosition GlonassPropagator::position(double tod)
+{
+    double dt = tod - m_ephemeris.t_b;
+    if (dt > SECONDS_PER_DAY / 2)
+    {
+        dt -= SECONDS_PER_DAY;
+    }
+    else if (dt < -SECONDS_PER_DAY / 2)
+    {
+        dt += SECONDS_PER_DAY;
+    }
+
+    if (std::abs(dt - m_cacheTime) > std::abs(dt))
+    {
+        std::memcpy(m_cacheState, m_ephemeris.pos, sizeof(m_ephemeris.pos));
+        std::memcpy(m_cacheState + 3, m_ephemeris.vel, sizeof(m_ephemeris.vel));
+        m_cacheTime = 0.0;
+    }
+
+    double remaining = dt - m_cacheTime;
+    while (std::abs(remaining) > 1e-9)
+    {
+        double h = std::max(-STEP, std::min(STEP, remaining));
+        integrate(m_cacheState, h);
+        remaining -= h;
+    }
+    m_cacheTime = dt;
+
+    EcefPosition p;
+    p.x = m_cacheState[0];
+    p.y = m_cacheState[1];
+    p.z = m_cacheState[2];
+    return p;
+}
+
+/*!
+ Returns the satellite velocity integrated along with the last position returned by position().
+ */
+EcefPosition GlonassPropagator::velocity() const
+{
+    EcefPosition v;
+    v.x = m_cacheState[3];
+    v.y = m_cacheState[4];
+    v.z = m_cacheState[5];
+    return v;
+}
+
+void GlonassPropagator::integrate(double state[6], double h) const
+{
+    double k1[6], k2[6], k3[6], k4[6], tmp[6];
+
+    derivatives(state, k1);
+    for (int i = 0; i < 6; i++) tmp[i] = state[i] + 0.5 * h * k1[i];
+    derivatives(tmp, k2);
+    for (int i = 0; i < 6; i++) tmp[i] = state[i] + 0.5 * h * k2[i];
+    derivatives(tmp, k3);
+    for (int i = 0; i < 6; i++) tmp[i] = state[i] + h * k3[i];
+    derivatives(tmp, k4);
+
+    for (int i = 0; i < 6; i++)
+    {
+        state[i] += h / 6.0 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+    }
+}
+
+void GlonassPropagator::derivatives(const double s[6], double out[6]) const
+{
+    const double x = s[0], y = s[1], z = s[2];
+    const double vx = s[3], vy = s[4], vz = s[5];
+
+    const double r2 = x * x + y * y + z * z;
+    const double r = std::sqrt(r2);
+    const double mu = GLO_GM / (r2 * r);
+    const double rho2 = GLO_AE * GLO_AE / r2;
+    const double z2 = 5.0 * z * z / r2;
+    const double j2 = 1.5 * GLO_C20 * mu * rho2;
+    const double w2 = GLO_OMEGA * GLO_OMEGA;
+
+    out[0] = vx;
+    out[1] = vy;
+    out[2] = vz;
+    out[3] = -mu * x + j2 * x * (1.0 - z2) + w2 * x + 2.0 * GLO_OMEGA * vy + m_ephemeris.acc[0];
+    out[4] = -mu * y + j2 * y * (1.0 - z2) + w2 * y - 2.0 * GLO_OMEGA * vx + m_ephemeris.acc[1];
+    out[5] = -mu * z + j2 * z * (3.0 - z2) + m_ephemeris.acc[2];
+}
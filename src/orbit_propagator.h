@@ -0,0 +1,304 @@
+/*!
+ * \file orbit_propagator.h
+ * \brief Broadcast orbit propagators: a batched Keplerian propagator with
+ * per-system constants as traits, and a GLONASS RK4 integrator.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_ORBIT_PROPAGATOR_H_
+#define GNSS_SDR_MONITOR_ORBIT_PROPAGATOR_H_
+
+#include <cmath>
+#include <cstddef>
+
+struct EcefPosition
+{
+    double x = 0.0;  // [m]
+    double y = 0.0;  // [m]
+    double z = 0.0;  // [m]
+};
+
+/*!
+ Broadcast Keplerian elements, common to GPS, Galileo and BeiDou.
+ Times are seconds of week in the time scale of the system.
+ */
+struct KeplerElements
+{
+    int prn = 0;
+    int iode = -1;
+    int week = 0;
+    int health = 0;
+    double toe = 0.0;
+    double toc = 0.0;
+
+    double sqrtA = 0.0;
+    double ecc = 0.0;
+    double M_0 = 0.0;
+    double delta_n = 0.0;
+    double OMEGA_0 = 0.0;
+    double OMEGAdot = 0.0;
+    double i_0 = 0.0;
+    double idot = 0.0;
+    double omega = 0.0;
+    double Cuc = 0.0;
+    double Cus = 0.0;
+    double Crc = 0.0;
+    double Crs = 0.0;
+    double Cic = 0.0;
+    double Cis = 0.0;
+
+    double af0 = 0.0;
+    double af1 = 0.0;
+    double af2 = 0.0;
+};
+
+/*!
+ Fills the orbital and clock fields shared by the GPS, Galileo and BeiDou ephemeris messages.
+ */
+template <typename Message>
+KeplerElements keplerElementsFrom(const Message &m)
+{
+    KeplerElements e;
+    e.prn = m.prn();
+    e.week = m.wn();
+    e.toe = m.toe();
+    e.toc = m.toc();
+    e.sqrtA = m.sqrta();
+    e.ecc = m.ecc();
+    e.M_0 = m.m_0();
+    e.delta_n = m.delta_n();
+    e.OMEGA_0 = m.omega_0();
+    e.OMEGAdot = m.omegadot();
+    e.i_0 = m.i_0();
+    e.idot = m.idot();
+    e.omega = m.omega();
+    e.Cuc = m.cuc();
+    e.Cus = m.cus();
+    e.Crc = m.crc();
+    e.Crs = m.crs();
+    e.Cic = m.cic();
+    e.Cis = m.cis();
+    e.af0 = m.af0();
+    e.af1 = m.af1();
+    e.af2 = m.af2();
+    return e;
+}
+
+// Per-system constants of the Keplerian propagator.
+struct GpsOrbitTraits
+{
+    static constexpr char SYSTEM = 'G';
+    static constexpr double GM = 3.986005e14;              // [m^3/s^2]
+    static constexpr double OMEGA_EARTH = 7.2921151467e-5;  // [rad/s]
+    static constexpr double TIME_OFFSET = 0.0;              // System time - GPS time [s]
+    static bool isGeo(int) { return false; }
+};
+
+struct GalileoOrbitTraits
+{
+    static constexpr char SYSTEM = 'E';
+    static constexpr double GM = 3.986004418e14;
+    static constexpr double OMEGA_EARTH = 7.2921151467e-5;
+    static constexpr double TIME_OFFSET = 0.0;  // GST seconds of week match GPS.
+    static bool isGeo(int) { return false; }
+};
+
+struct BeidouOrbitTraits
+{
+    static constexpr char SYSTEM = 'C';
+    static constexpr double GM = 3.986004418e14;
+    static constexpr double OMEGA_EARTH = 7.292115e-5;
+    static constexpr double TIME_OFFSET = -14.0;  // BDT = GPS - 14 s
+    static bool isGeo(int prn) { return prn <= 5 || prn >= 59; }
+};
+
+/*!
+ Propagates broadcast Keplerian ephemerides following IS-GPS-200, with the
+ system constants resolved at compile time from \a Traits.
+ */
+template <typename Traits>
+struct KeplerPropagator
+{
+    static constexpr double HALF_WEEK = 302400.0;
+
+    /*!
+     Writes to \a out the ECEF positions of the \a n satellites in \a elements at
+     \a gps_tow, the GPS time of week in seconds.
+     */
+    static void propagate(const KeplerElements *elements, size_t n, double gps_tow, EcefPosition *out)
+    {
+        const double t = gps_tow + Traits::TIME_OFFSET;
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = position(elements[i], t);
+        }
+    }
+
+    /*!
+     Satellite clock offset from the broadcast polynomial at \a gps_tow, in seconds.
+     */
+    static double clockOffset(const KeplerElements &e, double gps_tow)
+    {
+        const double dt = sinceReference(gps_tow + Traits::TIME_OFFSET, e.toc);
+        return e.af0 + (e.af1 + e.af2 * dt) * dt;
+    }
+
+    // Time from \a reference to \a t, both seconds of week, across a week rollover.
+    static double sinceReference(double t, double reference)
+    {
+        double dt = t - reference;
+        if (dt > HALF_WEEK)
+        {
+            dt -= 2.0 * HALF_WEEK;
+        }
+        else if (dt < -HALF_WEEK)
+        {
+            dt += 2.0 * HALF_WEEK;
+        }
+        return dt;
+    }
+
+    static EcefPosition position(const KeplerElements &e, double t)
+    {
+        const double tk = sinceReference(t, e.toe);
+
+        const double a = e.sqrtA * e.sqrtA;
+        const double n = std::sqrt(Traits::GM / (a * a * a)) + e.delta_n;
+        const double M = e.M_0 + n * tk;
+
+        // Eccentric anomaly by Newton iteration; converges in a few steps for e < 0.1.
+        double E = M;
+        for (int it = 0; it < 8; it++)
+        {
+            double dE = (E - e.ecc * std::sin(E) - M) / (1.0 - e.ecc * std::cos(E));
+            E -= dE;
+            if (std::abs(dE) < 1e-13)
+            {
+                break;
+            }
+        }
+
+        const double sinE = std::sin(E);
+        const double cosE = std::cos(E);
+        const double nu = std::atan2(std::sqrt(1.0 - e.ecc * e.ecc) * sinE, cosE - e.ecc);
+        const double phi = nu + e.omega;
+        const double sin2phi = std::sin(2.0 * phi);
+        const double cos2phi = std::cos(2.0 * phi);
+
+        const double u = phi + e.Cus * sin2phi + e.Cuc * cos2phi;
+        const double r = a * (1.0 - e.ecc * cosE) + e.Crs * sin2phi + e.Crc * cos2phi;
+        const double inc = e.i_0 + e.idot * tk + e.Cis * sin2phi + e.Cic * cos2phi;
+
+        const double xp = r * std::cos(u);
+        const double yp = r * std::sin(u);
+        const double cosi = std::cos(inc);
+        const double sini = std::sin(inc);
+
+        EcefPosition p;
+        if (Traits::isGeo(e.prn))
+        {
+            // BeiDou GEO: the elements refer to a frame rotated by -5 deg about X.
+            const double Omega = e.OMEGA_0 + e.OMEGAdot * tk - Traits::OMEGA_EARTH * e.toe;
+            const double cosO = std::cos(Omega);
+            const double sinO = std::sin(Omega);
+            const double xg = xp * cosO - yp * cosi * sinO;
+            const double yg = xp * sinO + yp * cosi * cosO;
+            const double zg = yp * sini;
+
+            constexpr double cos5 = 0.99619469809174553;   // cos(-5 deg)
+            constexpr double sin5 = -0.087155742747658166;  // sin(-5 deg)
+            const double rot = Traits::OMEGA_EARTH * tk;
+            const double cosR = std::cos(rot);
+            const double sinR = std::sin(rot);
+            const double y1 = yg * cos5 + zg * sin5;
+            const double z1 = -yg * sin5 + zg * cos5;
+            p.x = xg * cosR + y1 * sinR;
+            p.y = -xg * sinR + y1 * cosR;
+            p.z = z1;
+        }
+        else
+        {
+            const double Omega = e.OMEGA_0 + (e.OMEGAdot - Traits::OMEGA_EARTH) * tk - Traits::OMEGA_EARTH * e.toe;
+            const double cosO = std::cos(Omega);
+            const double sinO = std::sin(Omega);
+            p.x = xp * cosO - yp * cosi * sinO;
+            p.y = xp * sinO + yp * cosi * cosO;
+            p.z = yp * sini;
+        }
+        return p;
+    }
+};
+
+/*!
+ GLONASS immediate data: state vector in PZ-90 at t_b, in meters and seconds.
+ */
+struct GlonassStateVector
+{
+    int prn = 0;
+    int freq_channel = 0;
+    int health = 0;
+    double t_b = 0.0;  // Seconds of the day, Moscow time.
+    double pos[3] = {0.0, 0.0, 0.0};
+    double vel[3] = {0.0, 0.0, 0.0};
+    double acc[3] = {0.0, 0.0, 0.0};  // Luni-solar acceleration, constant over the fit interval.
+    double tau_n = 0.0;
+    double gamma_n = 0.0;
+};
+
+/*!
+ Integrates the GLONASS equations of motion (ICD appendix 3.1.2) with a fixed
+ step RK4. The last integrated state is cached, so the usual case of a time
+ slightly after the previous request costs a single step instead of the whole
+ arc from t_b.
+ */
+class GlonassPropagator
+{
+public:
+    static constexpr double STEP = 60.0;  // [s]
+
+    explicit GlonassPropagator(const GlonassStateVector &ephemeris = GlonassStateVector());
+
+    const GlonassStateVector &ephemeris() const { return m_ephemeris; }
+
+    // Position at \a tod, the GLONASS time of day in seconds.
+    EcefPosition position(double tod);
+
+    // Velocity at the time of the last position() [m/s]
+    EcefPosition velocity() const;
+
+private:
+    void integrate(double state[6], double dt) const;
+    void derivatives(const double state[6], double out[6]) const;
+
+    GlonassStateVector m_ephemeris;
+    double m_cacheTime;  // Offset from t_b of the cached state [s]
+    double m_cacheState[6];
+};
+
+#endif  // GNSS_SDR_MONITOR_ORBIT_PROPAGATOR_H_
@@ -31,9 +31,17 @@
 
 
 #include "preferences_dialog.h"
+#include "alert_capture.h"
+#include "channel_table_model.h"
+#include "monitor_streams.h"
 #include "ui_preferences_dialog.h"
 #include <QDebug>
+#include <QComboBox>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QLabel>
 #include <QSettings>
+#include <QSpinBox>
 
 PreferencesDialog::PreferencesDialog(QWidget *parent) : QDialog(parent),
                                                         ui(new Ui::PreferencesDialog)
@@ -42,13 +50,73 @@ PreferencesDialog::PreferencesDialog(QWidget *parent) : QDialog(parent),
 
     QSettings settings;
     settings.beginGroup("Preferences_Dialog");
-    ui->buffer_size_spinBox->setValue(settings.value("buffer_size", 1000).toInt());
-    ui->port_gnss_synchro_spinBox->setValue(settings.value("port_gnss_synchro", 1111).toInt());
-    ui->port_monitor_pvt_spinBox->setValue(settings.value("port_monitor_pvt", 1112).toInt());
-    ui->port_gps_ephemeris_spinBox->setValue(settings.value("port_gps_ephemeris", 1113).toInt());
+    ui->history_window_spinBox->setValue(settings.value("history_window", HistoryWindow::DEFAULT_SECONDS).toInt());
+    ui->query_port_spinBox->setValue(settings.value("port_query_api", 0).toInt());
+    ui->geoid_path_lineEdit->setText(settings.value("geoid_path").toString());
+    ui->geoid_interpolation_comboBox->setCurrentIndex(settings.value("geoid_interpolation", 0).toInt());
+    ui->restore_session_checkBox->setChecked(settings.value("restore_session", true).toBool());
+    ui->alert_capture_before_spinBox->setValue(settings.value("alert_capture_before", AlertCapture::DEFAULT_SECONDS).toInt());
+    ui->alert_capture_after_spinBox->setValue(settings.value("alert_capture_after", AlertCapture::DEFAULT_SECONDS).toInt());
+    ui->alert_capture_buffer_spinBox->setValue(settings.value("alert_capture_buffer_mb", AlertCapture::DEFAULT_BUFFER_MB).toInt());
+
+    // One port editor per registered stream.
+    for (const StreamDescriptor &stream : MonitorStreams::descriptors())
+    {
+        QSpinBox *spinBox = new QSpinBox(this);
+        spinBox->setMaximum(65535);
+        spinBox->setValue(settings.value(stream.settingsKey, stream.defaultPort).toInt());
+        ui->formLayout->addRow(new QLabel(stream.label, this), spinBox);
+        m_portSpinBoxes.emplace_back(stream.settingsKey, spinBox);
+    }
+
+    // One decimation editor per series of the channel history. Only the parameter of the chosen policy is editable.
+    for (int series = 0; series < ChannelTableModel::SERIES_COUNT; series++)
+    {
+        const auto &descriptor = ChannelTableModel::seriesDescriptor(static_cast<ChannelTableModel::Series>(series));
+        const QString key = descriptor.settingsKey;
+        const SeriesDecimator::Config defaults;
+
+        DecimationEditor editor{descriptor.settingsKey, new QComboBox(this), new QSpinBox(this), new QSpinBox(this)};
+        for (int policy = 0; policy <= static_cast<int>(SeriesDecimator::Policy::Last); policy++)
+        {
+            editor.policy->addItem(SeriesDecimator::policyName(static_cast<SeriesDecimator::Policy>(policy)));
+        }
+        editor.policy->setToolTip("Reduction of the samples before they are stored. Recordings keep every sample.");
+        editor.every->setRange(1, 100000);
+        editor.every->setPrefix("1 in ");
+        editor.bucketMs->setRange(1, 60000);
+        editor.bucketMs->setSuffix(" ms");
+
+        editor.policy->setCurrentIndex(settings.value(key + "_policy", 0).toInt());
+        editor.every->setValue(settings.value(key + "_every", defaults.every).toInt());
+        editor.bucketMs->setValue(settings.value(key + "_bucket_ms", defaults.bucketMs).toInt());
+
+        auto enableParameter = [editor](int index) {
+            const auto policy = static_cast<SeriesDecimator::Policy>(index);
+            editor.every->setEnabled(policy == SeriesDecimator::Policy::EveryNth);
+            editor.bucketMs->setEnabled(policy != SeriesDecimator::Policy::All && policy != SeriesDecimator::Policy::EveryNth);
+        };
+        enableParameter(editor.policy->currentIndex());
+        connect(editor.policy, QOverload<int>::of(&QComboBox::currentIndexChanged), this, enableParameter);
+
+        QHBoxLayout *layout = new QHBoxLayout();
+        layout->addWidget(editor.policy, 1);
+        layout->addWidget(editor.every);
+        layout->addWidget(editor.bucketMs);
+        ui->formLayout->addRow(new QLabel(descriptor.label, this), layout);
+        m_decimationEditors.push_back(editor);
+    }
     settings.endGroup();
 
     connect(this, &PreferencesDialog::accepted, this, &PreferencesDialog::onAccept);
+    connect(ui->geoid_path_toolButton, &QToolButton::clicked, this, [this] {
+        QString path = QFileDialog::getOpenFileName(this, "Geoid Grid", ui->geoid_path_lineEdit->text(),
+            "Geoid grids (*.pgm);;All files (*)");
+        if (!path.isEmpty())
+        {
+            ui->geoid_path_lineEdit->setText(path);
+        }
+    });
 }
 
 PreferencesDialog::~PreferencesDialog()
@@ -60,10 +128,25 @@ void PreferencesDialog::onAccept()
 {
     QSettings settings;
     settings.beginGroup("Preferences_Dialog");
-    settings.setValue("buffer_size", ui->buffer_size_spinBox->value());
-    settings.setValue("port_gnss_synchro", ui->port_gnss_synchro_spinBox->value());
-    settings.setValue("port_monitor_pvt", ui->port_monitor_pvt_spinBox->value());
-    settings.setValue("port_gps_ephemeris", ui->port_gps_ephemeris_spinBox->value());
+    settings.setValue("history_window", ui->history_window_spinBox->value());
+    settings.setValue("port_query_api", ui->query_port_spinBox->value());
+    settings.setValue("geoid_path", ui->geoid_path_lineEdit->text());
+    settings.setValue("geoid_interpolation", ui->geoid_interpolation_comboBox->currentIndex());
+    settings.setValue("restore_session", ui->restore_session_checkBox->isChecked());
+    settings.setValue("alert_capture_before", ui->alert_capture_before_spinBox->value());
+    settings.setValue("alert_capture_after", ui->alert_capture_after_spinBox->value());
+    settings.setValue("alert_capture_buffer_mb", ui->alert_capture_buffer_spinBox->value());
+    for (const auto &port : m_portSpinBoxes)
+    {
+        settings.setValue(port.first, port.second->value());
+    }
+    for (const DecimationEditor &editor : m_decimationEditors)
+    {
+        const QString key = editor.settingsKey;
+        settings.setValue(key + "_policy", editor.policy->currentIndex());
+        settings.setValue(key + "_every", editor.every->value());
+        settings.setValue(key + "_bucket_ms", editor.bucketMs->value());
+    }
     settings.endGroup();
 
     qDebug() << "Preferences Saved";
@@ -34,6 +34,11 @@
 #define GNSS_SDR_MONITOR_PREFERENCES_DIALOG_H_
 
 #include <QDialog>
+#include <utility>
+#include <vector>
+
+class QComboBox;
+class QSpinBox;
 
 namespace Ui
 {
@@ -50,6 +55,17 @@ public:
 
 private:
     Ui::PreferencesDialog *ui;
+    std::vector<std::pair<const char *, QSpinBox *>> m_portSpinBoxes;  // Settings key and editor of each stream port.
+
+    // Editors of the decimation of one series of the channel history.
+    struct DecimationEditor
+    {
+        const char *settingsKey;
+        QComboBox *policy;
+        QSpinBox *every;
+        QSpinBox *bucketMs;
+    };
+    std::vector<DecimationEditor> m_decimationEditors;
 
 private slots:
     void onAccept();
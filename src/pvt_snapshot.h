@@ -0,0 +1,122 @@
+/*!
+ * \file pvt_snapshot.h
+ * \brief Plain copy of the MonitorPvt fields that the views consume.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_PVT_SNAPSHOT_H_
+#define GNSS_SDR_MONITOR_PVT_SNAPSHOT_H_
+
+#include "monitor_pvt.pb.h"
+#include <cmath>
+#include <cstdint>
+
+/*!
+ Trivially copyable subset of a MonitorPvt message, cheap enough to be
+ published and read on every epoch by any number of views.
+ */
+struct PvtSnapshot
+{
+    uint32_t tow_at_current_symbol_ms = 0;
+    uint32_t week = 0;
+    double rx_time = 0.0;
+    double user_clk_offset = 0.0;
+
+    double pos_x = 0.0;
+    double pos_y = 0.0;
+    double pos_z = 0.0;
+    double vel_x = 0.0;
+    double vel_y = 0.0;
+    double vel_z = 0.0;
+
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double height = 0.0;
+
+    uint32_t valid_sats = 0;
+    uint32_t solution_status = 0;
+
+    double gdop = 0.0;
+    double pdop = 0.0;
+    double hdop = 0.0;
+    double vdop = 0.0;
+
+    static PvtSnapshot fromMonitorPvt(const gnss_sdr::MonitorPvt &pvt)
+    {
+        PvtSnapshot s;
+        s.tow_at_current_symbol_ms = pvt.tow_at_current_symbol_ms();
+        s.week = pvt.week();
+        s.rx_time = pvt.rx_time();
+        s.user_clk_offset = pvt.user_clk_offset();
+        s.pos_x = pvt.pos_x();
+        s.pos_y = pvt.pos_y();
+        s.pos_z = pvt.pos_z();
+        s.vel_x = pvt.vel_x();
+        s.vel_y = pvt.vel_y();
+        s.vel_z = pvt.vel_z();
+        s.latitude = pvt.latitude();
+        s.longitude = pvt.longitude();
+        s.height = pvt.height();
+        s.valid_sats = pvt.valid_sats();
+        s.solution_status = pvt.solution_status();
+        s.gdop = pvt.gdop();
+        s.pdop = pvt.pdop();
+        s.hdop = pvt.hdop();
+        s.vdop = pvt.vdop();
+        return s;
+    }
+
+    /*!
+     Returns true if the snapshot carries a usable week number and time of week.
+     */
+    bool hasValidTime() const
+    {
+        return week > 0 && rx_time >= 0.0 && rx_time < 604800.0;
+    }
+
+    /*!
+     Returns true if the snapshot is a position solution from at least four satellites.
+     */
+    bool hasFix() const
+    {
+        return hasValidPosition() && valid_sats >= 4;
+    }
+
+    /*!
+     Returns true if the latitude and longitude are in range and not the null island.
+     */
+    bool hasValidPosition() const
+    {
+        return latitude >= -90.0 && latitude <= 90.0 &&
+               longitude >= -180.0 && longitude <= 180.0 &&
+               (std::abs(latitude) > 0.001 || std::abs(longitude) > 0.001);
+    }
+};
+
+#endif  // GNSS_SDR_MONITOR_PVT_SNAPSHOT_H_
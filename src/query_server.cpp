@@ -0,0 +1,210 @@
+/*!
+ * \file query_server.cpp
+ * \brief Implementation of a local HTTP server that answers queries over the
+ * series held by the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "query_server.h"
+#include <QDebug>
+#include <QRunnable>
+#include <QThread>
+#include <QUrl>
+#include <QUrlQuery>
+#include <algorithm>
+
+namespace
+{
+/*!
+ Runs one query on the worker pool and posts the response back to the server's thread.
+ */
+class QueryTask : public QRunnable
+{
+public:
+    QueryTask(QueryServer *server, std::function<void(const SeriesQuery::Response &)> deliver,
+        const SeriesRequest &request, std::shared_ptr<const SeriesSnapshot> snapshot)
+        : m_server(server), m_deliver(std::move(deliver)), m_request(request), m_snapshot(std::move(snapshot))
+    {
+    }
+
+    void run() override
+    {
+        const SeriesQuery::Response response = SeriesQuery::run(m_request, *m_snapshot);
+        auto deliver = m_deliver;
+        QMetaObject::invokeMethod(m_server, [deliver, response] { deliver(response); }, Qt::QueuedConnection);
+    }
+
+private:
+    QueryServer *m_server;
+    std::function<void(const SeriesQuery::Response &)> m_deliver;
+    SeriesRequest m_request;
+    std::shared_ptr<const SeriesSnapshot> m_snapshot;
+};
+
+const char *reasonPhrase(int status)
+{
+    switch (status)
+    {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    case 413:
+        return "Payload Too Large";
+    default:
+        return "Internal Server Error";
+    }
+}
+}  // namespace
+
+QueryServer::QueryServer(QObject *parent) : QObject(parent), m_nextRequest(0)
+{
+    m_pool.setMaxThreadCount(std::max(1, std::min(QThread::idealThreadCount() / 2, 4)));
+    connect(&m_server, &QTcpServer::newConnection, this, &QueryServer::accept);
+}
+
+QueryServer::~QueryServer()
+{
+    close();
+    m_pool.waitForDone();
+}
+
+bool QueryServer::listen(quint16 port)
+{
+    if (m_server.isListening() && m_server.serverPort() == port)
+    {
+        return true;
+    }
+
+    close();
+    if (port == 0)
+    {
+        return true;
+    }
+
+    if (!m_server.listen(QHostAddress::LocalHost, port))
+    {
+        qDebug() << "Cannot start the query API on port" << port << m_server.errorString();
+        return false;
+    }
+    return true;
+}
+
+void QueryServer::close()
+{
+    m_server.close();
+}
+
+void QueryServer::accept()
+{
+    while (QTcpSocket *socket = m_server.nextPendingConnection())
+    {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] { read(socket); });
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+/*!
+ Waits for the complete request head on \a socket, then parses it and hands the query to the worker pool.
+ */
+void QueryServer::read(QTcpSocket *socket)
+{
+    const QByteArray head = socket->peek(MAX_REQUEST_BYTES);
+    const int end = head.indexOf("\r\n\r\n");
+    if (end < 0)
+    {
+        if (head.size() >= MAX_REQUEST_BYTES)
+        {
+            socket->write(encode(SeriesQuery::error(413, "request too large")));
+            socket->disconnectFromHost();
+        }
+        return;
+    }
+
+    // Only one request per connection, anything after the head is ignored.
+    socket->disconnect(this);
+    socket->readAll();
+
+    const QList<QByteArray> line = head.left(head.indexOf("\r\n")).split(' ');
+    if (line.size() != 3 || line.at(0) != "GET")
+    {
+        socket->write(encode(SeriesQuery::error(405, "only GET is supported")));
+        socket->disconnectFromHost();
+        return;
+    }
+
+    const QUrl url(QString::fromLatin1(line.at(1)));
+    SeriesRequest request;
+    QString error;
+    const int status = SeriesRequest::parse(url.path(), QUrlQuery(url), request, error);
+    if (status != 200 || !m_provider)
+    {
+        socket->write(encode(SeriesQuery::error(status != 200 ? status : 500, error)));
+        socket->disconnectFromHost();
+        return;
+    }
+
+    const quint64 id = m_nextRequest++;
+    m_pending[id] = socket;
+    m_pool.start(new QueryTask(this, [this, id](const SeriesQuery::Response &response) { reply(id, response); },
+        request, m_provider(request)));
+}
+
+void QueryServer::reply(quint64 request_id, const SeriesQuery::Response &response)
+{
+    auto it = m_pending.find(request_id);
+    if (it == m_pending.end())
+    {
+        return;
+    }
+
+    QPointer<QTcpSocket> socket = it->second;
+    m_pending.erase(it);
+    if (socket)
+    {
+        socket->write(encode(response));
+        socket->disconnectFromHost();
+    }
+}
+
+QByteArray QueryServer::encode(const SeriesQuery::Response &response)
+{
+    QByteArray message;
+    message.reserve(response.body.size() + 128);
+    message += "HTTP/1.1 " + QByteArray::number(response.status) + " " + reasonPhrase(response.status) + "\r\n";
+    message += "Content-Type: " + response.contentType + "\r\n";
+    message += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    message += "Connection: close\r\n\r\n";
+    message += response.body;
+    return message;
+}
@@ -0,0 +1,96 @@
+/*!
+ * \file query_server.h
+ * \brief Interface of a local HTTP server that answers queries over the
+ * series held by the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_QUERY_SERVER_H_
+#define GNSS_SDR_MONITOR_QUERY_SERVER_H_
+
+#include "series_query.h"
+#include <QObject>
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThreadPool>
+#include <functional>
+#include <map>
+#include <memory>
+
+/*!
+ Minimal HTTP/1.1 server, bound to the loopback interface only, for tools
+ that pull series out of a running monitor, e.g.
+
+   curl 'http://localhost:8090/api/series?sat=G12&field=cn0&last=600&points=500'
+
+ See SeriesRequest for the paths and parameters. Each connection carries one
+ GET request. The request is parsed and the data it needs is copied on the
+ GUI thread by the snapshot provider; trimming, downsampling and encoding run
+ on a worker pool, so a slow or large query never holds up ingest or
+ rendering.
+
+ Only the history kept in memory is served. Recordings are not read back
+ for older spans: they hold raw datagrams on their receive time, from which
+ every field would have to be derived again.
+ */
+class QueryServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    using SnapshotProvider = std::function<std::shared_ptr<const SeriesSnapshot>(const SeriesRequest &)>;
+
+    explicit QueryServer(QObject *parent = nullptr);
+    ~QueryServer();
+
+    void setSnapshotProvider(const SnapshotProvider &provider) { m_provider = provider; }
+
+    // Listens on localhost:\a port, or stops listening if \a port is 0.
+    bool listen(quint16 port);
+    void close();
+    bool isListening() const { return m_server.isListening(); }
+    quint16 port() const { return m_server.serverPort(); }
+
+private:
+    void accept();
+    void read(QTcpSocket *socket);
+    void reply(quint64 request_id, const SeriesQuery::Response &response);
+    static QByteArray encode(const SeriesQuery::Response &response);
+
+    static constexpr int MAX_REQUEST_BYTES = 8192;
+
+    QTcpServer m_server;
+    QThreadPool m_pool;
+    SnapshotProvider m_provider;
+    quint64 m_nextRequest;
+    std::map<quint64, QPointer<QTcpSocket>> m_pending;  // Sockets waiting for a worker, by request.
+};
+
+#endif  // GNSS_SDR_MONITOR_QUERY_SERVER_H_
@@ -0,0 +1,522 @@
+/*!
+ * \file recording_editor.cpp
+ * \brief Implementation of a tool that trims, splits and merges recordings.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "recording_editor.h"
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTextStream>
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace
+{
+/*!
+ Decodes the record at \a offset of a block \a payload into \a record and moves \a offset past it.
+ Returns false at the end of the block or if the record is truncated.
+ */
+bool decodeRecord(const QByteArray &payload, int &offset, RecordView &record)
+{
+    if (offset + recording::RecordHeader::SIZE > payload.size())
+    {
+        return false;
+    }
+
+    recording::RecordHeader header;
+    recording::decode(payload.constData() + offset, header);
+    if (header.size > static_cast<quint32>(payload.size() - offset - recording::RecordHeader::SIZE))
+    {
+        return false;
+    }
+
+    record.timestamp_us = header.timestamp_us;
+    record.stream_id = header.stream_id;
+    record.data = payload.constData() + offset + recording::RecordHeader::SIZE;
+    record.size = static_cast<int>(header.size);
+    offset += recording::RecordHeader::SIZE + static_cast<int>(header.size);
+    return true;
+}
+
+/*!
+ Read cursor of one of the recordings being merged. Between blocks the next timestamp is the first of
+ the next block, taken from the index; inside a decoded block it is the one of the pending record.
+ */
+struct MergeInput
+{
+    SessionReader reader;
+    size_t block = 0;  // Next block to load.
+    QByteArray payload;
+    int offset = 0;
+    quint32 remaining = 0;
+    bool inBlock = false;
+    RecordView head;
+
+    bool done() const { return !inBlock && block >= reader.index().size(); }
+    qint64 nextTimestamp() const { return inBlock ? head.timestamp_us : reader.index()[block].first_timestamp_us; }
+
+    void advance()
+    {
+        inBlock = remaining > 0 && decodeRecord(payload, offset, head);
+        if (inBlock)
+        {
+            remaining--;
+        }
+    }
+
+    bool load()
+    {
+        recording::BlockHeader header;
+        if (!reader.readBlock(block++, header, payload))
+        {
+            return false;
+        }
+        offset = 0;
+        remaining = header.record_count;
+        advance();
+        return true;
+    }
+};
+}  // namespace
+
+/*!
+ Writes the records of \a input with timestamps in [\a from_us, \a to_us) to \a output.
+ Returns false and sets the error string if a file cannot be read or written.
+ */
+bool RecordingEditor::trim(const QString &input, const QString &output, qint64 from_us, qint64 to_us)
+{
+    reset();
+
+    SessionReader reader;
+    SessionRecorder recorder;
+    if (!openInput(reader, input) || !openOutput(recorder, output, {input}))
+    {
+        return false;
+    }
+
+    const bool ok = appendSpan(reader, recorder, from_us, to_us);
+    recorder.close();
+    return ok;
+}
+
+/*!
+ Cuts \a input into consecutive pieces of \a piece_us, starting at its first record. The pieces are
+ written next to \a output, with a three digit sequence number appended to its base name.
+ */
+bool RecordingEditor::split(const QString &input, const QString &output, qint64 piece_us)
+{
+    reset();
+    if (piece_us <= 0)
+    {
+        return fail("The length of the pieces must be positive");
+    }
+
+    SessionReader reader;
+    if (!openInput(reader, input))
+    {
+        return false;
+    }
+
+    const QFileInfo info(output);
+    const QString suffix = info.suffix().isEmpty() ? QString("gsdr") : info.suffix();
+    const qint64 last = reader.lastTimestamp();
+    int piece = 1;
+    for (qint64 start = reader.firstTimestamp(); start <= last; start += piece_us, piece++)
+    {
+        const QString path = info.dir().filePath(
+            QString("%1-%2.%3").arg(info.completeBaseName()).arg(piece, 3, 10, QChar('0')).arg(suffix));
+
+        SessionRecorder recorder;
+        if (!openOutput(recorder, path, {input}))
+        {
+            return false;
+        }
+
+        const bool ok = appendSpan(reader, recorder, start, start + piece_us);
+        recorder.close();
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ Interleaves the records of \a inputs by timestamp into \a output, keeping the order of the inputs for
+ equal timestamps. Runs of blocks that end before the next record of every other input are copied whole.
+ */
+bool RecordingEditor::merge(const QStringList &inputs, const QString &output)
+{
+    reset();
+
+    // A linear scan over the cursors: the inputs are a handful of receivers.
+    std::vector<std::unique_ptr<MergeInput>> cursors;
+    for (const QString &path : inputs)
+    {
+        cursors.emplace_back(new MergeInput);
+        if (!openInput(cursors.back()->reader, path))
+        {
+            return false;
+        }
+    }
+
+    SessionRecorder recorder;
+    if (!openOutput(recorder, output, inputs))
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        MergeInput *best = nullptr;
+        for (const auto &cursor : cursors)
+        {
+            if (!cursor->done() && (!best || cursor->nextTimestamp() < best->nextTimestamp()))
+            {
+                best = cursor.get();
+            }
+        }
+        if (!best)
+        {
+            break;
+        }
+
+        // Latest time that can still be written from best. Records are ordered by (timestamp, input), so best
+        // goes first on a tie with the inputs after it, and after the inputs before it.
+        qint64 others = std::numeric_limits<qint64>::max();
+        bool before = true;
+        for (const auto &cursor : cursors)
+        {
+            if (cursor.get() == best)
+            {
+                before = false;
+            }
+            else if (!cursor->done())
+            {
+                others = std::min(others, before ? cursor->nextTimestamp() - 1 : cursor->nextTimestamp());
+            }
+        }
+
+        if (!best->inBlock)
+        {
+            const std::vector<recording::IndexEntry> &index = best->reader.index();
+            size_t end = best->block;
+            while (end < index.size() && index[end].last_timestamp_us <= others)
+            {
+                end++;
+            }
+
+            if (end > best->block)
+            {
+                if (!recorder.copyBlocks(best->reader, best->block, end))
+                {
+                    recorder.close();
+                    return fail("Cannot copy blocks to " + output);
+                }
+                m_copiedBlocks += end - best->block;
+                best->block = end;
+            }
+            else if (!best->load())
+            {
+                recorder.close();
+                return fail("Cannot read a block of " + best->reader.device()->fileName());
+            }
+            continue;
+        }
+
+        while (best->inBlock && best->head.timestamp_us <= others)
+        {
+            recorder.record(best->head.stream_id, best->head.timestamp_us, best->head.data, best->head.size);
+            m_encodedRecords++;
+            best->advance();
+        }
+    }
+
+    recorder.close();
+    return true;
+}
+
+/*!
+ Truncates \a path after its last valid block and writes the block index and trailer, so that it opens as a
+ recording that was closed normally. Recordings that were closed are left untouched.
+ */
+bool RecordingEditor::recover(const QString &path)
+{
+    reset();
+
+    SessionReader reader;
+    if (!openInput(reader, path))
+    {
+        return false;
+    }
+    if (!reader.isRecovered())
+    {
+        return true;
+    }
+
+    const std::vector<recording::IndexEntry> index = reader.index();
+    const qint64 end = reader.dataEnd();
+    reader.close();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite) || !file.resize(end) || !file.seek(end) ||
+        !SessionRecorder::writeIndex(file, index))
+    {
+        return fail(path + ": " + file.errorString());
+    }
+    m_outputs << path;
+    m_recoveredBlocks = index.size();
+    return true;
+}
+
+void RecordingEditor::reset()
+{
+    m_error.clear();
+    m_outputs.clear();
+    m_copiedBlocks = 0;
+    m_encodedRecords = 0;
+    m_recoveredBlocks = 0;
+}
+
+bool RecordingEditor::fail(const QString &message)
+{
+    m_error = message;
+    return false;
+}
+
+bool RecordingEditor::openInput(SessionReader &reader, const QString &path)
+{
+    if (!reader.open(path))
+    {
+        return fail(path + ": " + reader.errorString());
+    }
+    return true;
+}
+
+/*!
+ Starts the recording \a path, refusing to overwrite any of the \a inputs.
+ */
+bool RecordingEditor::openOutput(SessionRecorder &recorder, const QString &path, const QStringList &inputs)
+{
+    for (const QString &input : inputs)
+    {
+        if (QFileInfo::exists(path) && QFileInfo(input).canonicalFilePath() == QFileInfo(path).canonicalFilePath())
+        {
+            return fail("The output would overwrite " + input);
+        }
+    }
+
+    if (!recorder.open(path))
+    {
+        return fail(path + ": " + recorder.errorString());
+    }
+    m_outputs << path;
+    return true;
+}
+
+/*!
+ Appends the records of \a reader with timestamps in [\a from_us, \a to_us) to \a recorder. Blocks inside
+ the span are copied as they are; the ones across its boundaries are decoded and filtered.
+ */
+bool RecordingEditor::appendSpan(SessionReader &reader, SessionRecorder &recorder, qint64 from_us, qint64 to_us)
+{
+    const std::vector<recording::IndexEntry> &index = reader.index();
+    auto inside = [&index, from_us, to_us](size_t i) {
+        return index[i].first_timestamp_us >= from_us && index[i].last_timestamp_us < to_us;
+    };
+
+    size_t i = static_cast<size_t>(std::lower_bound(index.begin(), index.end(), from_us,
+                                       [](const recording::IndexEntry &e, qint64 t) { return e.last_timestamp_us < t; }) -
+                                   index.begin());
+
+    recording::BlockHeader header;
+    QByteArray payload;
+    while (i < index.size() && index[i].first_timestamp_us < to_us)
+    {
+        if (inside(i))
+        {
+            size_t end = i;
+            while (end < index.size() && inside(end))
+            {
+                end++;
+            }
+            if (!recorder.copyBlocks(reader, i, end))
+            {
+                return fail("Cannot copy blocks to " + recorder.fileName());
+            }
+            m_copiedBlocks += end - i;
+            i = end;
+            continue;
+        }
+
+        if (!reader.readBlock(i, header, payload))
+        {
+            return fail("Cannot read a block of " + reader.device()->fileName());
+        }
+
+        int offset = 0;
+        RecordView record;
+        for (quint32 n = 0; n < header.record_count && decodeRecord(payload, offset, record); n++)
+        {
+            if (record.timestamp_us >= from_us && record.timestamp_us < to_us)
+            {
+                recorder.record(record.stream_id, record.timestamp_us, record.data, record.size);
+                m_encodedRecords++;
+            }
+        }
+        i++;
+    }
+    return true;
+}
+
+void RecordingEditor::addOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"trim", "Copy the span --from to --to of the recording given as argument to --output and exit."});
+    parser.addOption({"from", "Start of --trim, in seconds since the first record.", "seconds", "0"});
+    parser.addOption({"to", "End of --trim, in seconds since the first record (default: end of the recording).",
+        "seconds"});
+    parser.addOption({"split", "Cut the recording given as argument into pieces of this length, numbered after "
+                               "--output, and exit.", "seconds"});
+    parser.addOption({"merge", "Interleave the recordings given as arguments by time into --output and exit."});
+    parser.addOption({"output", "Recording written by --trim, --split or --merge.", "file"});
+    parser.addOption({"recover", "Rebuild the index of the recordings given as arguments if they were not closed, "
+                                 "for example after a crash, and exit."});
+}
+
+bool RecordingEditor::isRequested(const QCommandLineParser &parser)
+{
+    return parser.isSet("trim") || parser.isSet("split") || parser.isSet("merge") || parser.isSet("recover");
+}
+
+/*!
+ Runs the edit requested on the command line and returns the exit status of the program.
+ */
+int RecordingEditor::run(const QCommandLineParser &parser)
+{
+    QTextStream out(stdout);
+    const QStringList inputs = parser.positionalArguments();
+    if (parser.isSet("recover"))
+    {
+        int status = 0;
+        for (const QString &path : inputs)
+        {
+            RecordingEditor editor;
+            if (!editor.recover(path))
+            {
+                out << "Error: " << editor.errorString() << endl;
+                status = 1;
+            }
+            else if (editor.outputs().isEmpty())
+            {
+                out << path << " was closed properly" << endl;
+            }
+            else
+            {
+                out << QString("Recovered %1 blocks of %2").arg(editor.recoveredBlocks()).arg(path) << endl;
+            }
+        }
+        return status;
+    }
+
+    const QString output = parser.value("output");
+    if (output.isEmpty())
+    {
+        out << "--trim, --split and --merge need an --output file" << endl;
+        return 2;
+    }
+    if ((parser.isSet("merge") && inputs.size() < 2) || (!parser.isSet("merge") && inputs.size() != 1))
+    {
+        out << "--merge needs two or more recordings, --trim and --split exactly one" << endl;
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    RecordingEditor editor;
+    bool ok = false;
+    if (parser.isSet("merge"))
+    {
+        ok = editor.merge(inputs, output);
+    }
+    else
+    {
+        SessionReader reader;
+        if (!reader.open(inputs.at(0)))
+        {
+            out << inputs.at(0) << ": " << reader.errorString() << endl;
+            return 1;
+        }
+        const qint64 first = reader.firstTimestamp();
+        reader.close();
+
+        bool valid = true;
+        if (parser.isSet("split"))
+        {
+            const double piece = parser.value("split").toDouble(&valid);
+            ok = valid && editor.split(inputs.at(0), output, static_cast<qint64>(piece * 1e6));
+        }
+        else
+        {
+            bool valid_to = true;
+            const double from = parser.value("from").toDouble(&valid);
+            const double to = parser.isSet("to") ? parser.value("to").toDouble(&valid_to) : -1.0;
+            valid = valid && valid_to;
+            const qint64 to_us = to < 0.0 ? std::numeric_limits<qint64>::max() : first + static_cast<qint64>(to * 1e6);
+            ok = valid && editor.trim(inputs.at(0), output, first + static_cast<qint64>(from * 1e6), to_us);
+        }
+
+        if (!valid)
+        {
+            out << "--from, --to and --split take a number of seconds" << endl;
+            return 2;
+        }
+    }
+
+    if (!ok)
+    {
+        out << "Error: " << editor.errorString() << endl;
+        return 1;
+    }
+
+    for (const QString &file : editor.outputs())
+    {
+        out << "Wrote " << file << endl;
+    }
+    out << QString::asprintf("%llu blocks copied, %llu records rewritten in %.2f s",
+               static_cast<unsigned long long>(editor.copiedBlocks()),
+               static_cast<unsigned long long>(editor.encodedRecords()), timer.elapsed() / 1000.0)
+        << endl;
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*!
+ * \file recording_editor.h
+ * \brief Interface of a tool that trims, splits and merges recordings.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_RECORDING_EDITOR_H_
+#define GNSS_SDR_MONITOR_RECORDING_EDITOR_H_
+
+#include "session_reader.h"
+#include "session_recorder.h"
+#include <QString>
+#include <QStringList>
+
+class QCommandLineParser;
+
+/*!
+ Cuts and joins recordings through their block index.
+
+ Blocks that fall entirely inside the requested span are copied byte for
+ byte, so the cost of a cut does not depend on its length; only the blocks
+ that straddle a boundary are decoded and their records written again. A
+ merge interleaves several recordings by receive timestamp, records with the
+ same timestamp in the order of the inputs, and copies a run of blocks as it
+ is whenever none of the other recordings has a record before its end, which
+ is most of the time for recordings that do not overlap. The index and trailer of each output are rebuilt on close.
+ Recovery appends the index that the reader rebuilds for a recording that
+ was never closed, after dropping the incomplete block at its end.
+ */
+class RecordingEditor
+{
+public:
+    // Copies the records with timestamps in [\a from_us, \a to_us) of \a input to \a output.
+    bool trim(const QString &input, const QString &output, qint64 from_us, qint64 to_us);
+
+    // Cuts \a input into pieces of \a piece_us named after \a output: name-001.gsdr, name-002.gsdr, ...
+    bool split(const QString &input, const QString &output, qint64 piece_us);
+
+    // Interleaves the records of \a inputs by timestamp into \a output.
+    bool merge(const QStringList &inputs, const QString &output);
+
+    // Closes a recording that was cut short, in place, with the index rebuilt from its checkpoints.
+    bool recover(const QString &path);
+
+    QString errorString() const { return m_error; }
+    QStringList outputs() const { return m_outputs; }
+    quint64 copiedBlocks() const { return m_copiedBlocks; }
+    quint64 encodedRecords() const { return m_encodedRecords; }
+    quint64 recoveredBlocks() const { return m_recoveredBlocks; }
+
+    // Command line front end: --trim, --split, --merge and --recover.
+    static void addOptions(QCommandLineParser &parser);
+    static bool isRequested(const QCommandLineParser &parser);
+    static int run(const QCommandLineParser &parser);
+
+private:
+    void reset();
+    bool fail(const QString &message);
+    bool openInput(SessionReader &reader, const QString &path);
+    bool openOutput(SessionRecorder &recorder, const QString &path, const QStringList &inputs);
+    bool appendSpan(SessionReader &reader, SessionRecorder &recorder, qint64 from_us, qint64 to_us);
+
+    QString m_error;
+    QStringList m_outputs;
+    quint64 m_copiedBlocks = 0;
+    quint64 m_encodedRecords = 0;
+    quint64 m_recoveredBlocks = 0;
+};
+
+#endif  // GNSS_SDR_MONITOR_RECORDING_EDITOR_H_
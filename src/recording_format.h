@@ -0,0 +1,300 @@
+/*!
+ * \file recording_format.h
+ * \brief On-disk layout of the session recordings written by the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_RECORDING_FORMAT_H_
+#define GNSS_SDR_MONITOR_RECORDING_FORMAT_H_
+
+#include "crc32c.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ A recording is a sequence of raw datagrams exactly as received, tagged with
+ the id of the stream they came from and a receive timestamp. All integers are
+ little-endian.
+
+   FileHeader
+   Block 0: BlockHeader, record, record, ...
+   Block 1: ...
+   Checkpoint, IndexEntry x n    (every CHECKPOINT_BLOCKS blocks)
+   Block ...
+   IndexEntry x N      (written on close)
+   Trailer             (written on close)
+
+ Each record is a RecordHeader followed by `size` payload bytes. Blocks never
+ split a record, so any block can be decoded on its own, and the index lets
+ readers seek to a time without scanning the file.
+
+ Since version 2 every block carries a CRC-32C of its header and payload, and
+ the recorder periodically writes a checkpoint with the index entries of the
+ blocks written since the previous one. The checkpoints are chained backwards
+ and the file header points to the latest, so a recording that was never
+ closed is indexed from its checkpoints plus a scan of the blocks after the
+ last one. Version 1 recordings have a 16 byte file header, no checksums and
+ no checkpoints.
+ */
+namespace recording
+{
+constexpr char FILE_MAGIC[8] = {'G', 'S', 'D', 'R', 'M', 'O', 'N', '\0'};
+constexpr uint32_t FORMAT_VERSION = 2;
+constexpr uint32_t BLOCK_MAGIC = 0x4B4C4247;       // "GBLK"
+constexpr uint32_t CHECKPOINT_MAGIC = 0x504B4347;  // "GCKP"
+constexpr uint32_t TRAILER_MAGIC = 0x58444947;     // "GIDX"
+
+constexpr uint32_t FLAG_BLOCK_CRC = 1;  // BlockHeader::crc is set.
+
+constexpr uint32_t TARGET_BLOCK_BYTES = 64 * 1024;
+constexpr int64_t MAX_BLOCK_SPAN_US = 1000000;
+constexpr uint32_t CHECKPOINT_BLOCKS = 256;
+constexpr int64_t CHECKPOINT_SPAN_US = 30000000;
+
+struct FileHeader
+{
+    static constexpr int SIZE = 32;
+    static constexpr int V1_SIZE = 16;             // Version 1 headers end after the flags.
+    static constexpr int LAST_CHECKPOINT_POS = 16;  // Updated in place after each checkpoint.
+    uint32_t version = FORMAT_VERSION;
+    uint32_t flags = FLAG_BLOCK_CRC;
+    uint64_t last_checkpoint = 0;  // File offset of the latest Checkpoint, 0 if none.
+
+    int size() const { return version >= 2 ? SIZE : V1_SIZE; }
+};
+
+struct BlockHeader
+{
+    static constexpr int SIZE = 32;
+    uint32_t payload_size = 0;
+    uint32_t record_count = 0;
+    uint32_t crc = 0;
+    int64_t first_timestamp_us = 0;
+    int64_t last_timestamp_us = 0;
+};
+
+struct RecordHeader
+{
+    static constexpr int SIZE = 16;
+    int64_t timestamp_us = 0;
+    uint16_t stream_id = 0;
+    uint32_t size = 0;
+};
+
+struct Checkpoint
+{
+    static constexpr int SIZE = 32;
+    uint32_t entry_count = 0;  // IndexEntry records that follow.
+    uint32_t crc = 0;          // Over the checkpoint header and its entries.
+    uint64_t previous = 0;     // File offset of the previous Checkpoint, 0 for the first.
+};
+
+struct IndexEntry
+{
+    static constexpr int SIZE = 32;
+    uint64_t offset = 0;  // File offset of the BlockHeader.
+    int64_t first_timestamp_us = 0;
+    int64_t last_timestamp_us = 0;
+    uint32_t record_count = 0;
+};
+
+struct Trailer
+{
+    static constexpr int SIZE = 24;
+    uint32_t entry_count = 0;
+    uint64_t index_offset = 0;
+};
+
+// Little-endian field helpers, independent of the host byte order.
+template <typename T>
+inline void put(char *dst, T value)
+{
+    uint64_t v = static_cast<uint64_t>(value);
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        dst[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+}
+
+template <typename T>
+inline T get(const char *src)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        v |= static_cast<uint64_t>(static_cast<unsigned char>(src[i])) << (8 * i);
+    }
+    return static_cast<T>(v);
+}
+
+inline void encode(const FileHeader &h, char *dst)
+{
+    std::memcpy(dst, FILE_MAGIC, sizeof(FILE_MAGIC));
+    put<uint32_t>(dst + 8, h.version);
+    put<uint32_t>(dst + 12, h.flags);
+    put<uint64_t>(dst + 16, h.last_checkpoint);
+    put<uint64_t>(dst + 24, 0);
+}
+
+// Decodes the first V1_SIZE bytes; the rest of a version 2 header is decoded by decodeTail().
+inline bool decode(const char *src, FileHeader &h)
+{
+    if (std::memcmp(src, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        return false;
+    }
+    h.version = get<uint32_t>(src + 8);
+    h.flags = get<uint32_t>(src + 12);
+    h.last_checkpoint = 0;
+    return true;
+}
+
+inline void decodeTail(const char *src, FileHeader &h)
+{
+    h.last_checkpoint = get<uint64_t>(src + FileHeader::LAST_CHECKPOINT_POS);
+}
+
+inline void encode(const BlockHeader &h, char *dst)
+{
+    put<uint32_t>(dst, BLOCK_MAGIC);
+    put<uint32_t>(dst + 4, h.payload_size);
+    put<uint32_t>(dst + 8, h.record_count);
+    put<uint32_t>(dst + 12, h.crc);
+    put<int64_t>(dst + 16, h.first_timestamp_us);
+    put<int64_t>(dst + 24, h.last_timestamp_us);
+}
+
+inline bool decode(const char *src, BlockHeader &h)
+{
+    if (get<uint32_t>(src) != BLOCK_MAGIC)
+    {
+        return false;
+    }
+    h.payload_size = get<uint32_t>(src + 4);
+    h.record_count = get<uint32_t>(src + 8);
+    h.crc = get<uint32_t>(src + 12);
+    h.first_timestamp_us = get<int64_t>(src + 16);
+    h.last_timestamp_us = get<int64_t>(src + 24);
+    return true;
+}
+
+// CRC-32C of a block, over its encoded header with a zero crc field followed by the payload.
+inline uint32_t checksum(BlockHeader h, const char *payload)
+{
+    char raw[BlockHeader::SIZE];
+    h.crc = 0;
+    encode(h, raw);
+    return crc32c(payload, h.payload_size, crc32c(raw, sizeof(raw)));
+}
+
+inline void encode(const RecordHeader &h, char *dst)
+{
+    put<int64_t>(dst, h.timestamp_us);
+    put<uint16_t>(dst + 8, h.stream_id);
+    put<uint16_t>(dst + 10, 0);
+    put<uint32_t>(dst + 12, h.size);
+}
+
+inline void decode(const char *src, RecordHeader &h)
+{
+    h.timestamp_us = get<int64_t>(src);
+    h.stream_id = get<uint16_t>(src + 8);
+    h.size = get<uint32_t>(src + 12);
+}
+
+inline void encode(const Checkpoint &c, char *dst)
+{
+    put<uint32_t>(dst, CHECKPOINT_MAGIC);
+    put<uint32_t>(dst + 4, c.entry_count);
+    put<uint32_t>(dst + 8, c.crc);
+    put<uint32_t>(dst + 12, 0);
+    put<uint64_t>(dst + 16, c.previous);
+    put<uint64_t>(dst + 24, 0);
+}
+
+inline bool decode(const char *src, Checkpoint &c)
+{
+    if (get<uint32_t>(src) != CHECKPOINT_MAGIC)
+    {
+        return false;
+    }
+    c.entry_count = get<uint32_t>(src + 4);
+    c.crc = get<uint32_t>(src + 8);
+    c.previous = get<uint64_t>(src + 16);
+    return true;
+}
+
+// CRC-32C of a checkpoint, over its encoded header with a zero crc field followed by the encoded entries.
+inline uint32_t checksum(Checkpoint c, const char *entries)
+{
+    char raw[Checkpoint::SIZE];
+    c.crc = 0;
+    encode(c, raw);
+    return crc32c(entries, static_cast<size_t>(c.entry_count) * IndexEntry::SIZE, crc32c(raw, sizeof(raw)));
+}
+
+inline void encode(const IndexEntry &e, char *dst)
+{
+    put<uint64_t>(dst, e.offset);
+    put<int64_t>(dst + 8, e.first_timestamp_us);
+    put<int64_t>(dst + 16, e.last_timestamp_us);
+    put<uint32_t>(dst + 24, e.record_count);
+    put<uint32_t>(dst + 28, 0);
+}
+
+inline void decode(const char *src, IndexEntry &e)
+{
+    e.offset = get<uint64_t>(src);
+    e.first_timestamp_us = get<int64_t>(src + 8);
+    e.last_timestamp_us = get<int64_t>(src + 16);
+    e.record_count = get<uint32_t>(src + 24);
+}
+
+inline void encode(const Trailer &t, char *dst)
+{
+    put<uint32_t>(dst, TRAILER_MAGIC);
+    put<uint32_t>(dst + 4, t.entry_count);
+    put<uint64_t>(dst + 8, t.index_offset);
+    put<uint64_t>(dst + 16, 0);
+}
+
+inline bool decode(const char *src, Trailer &t)
+{
+    if (get<uint32_t>(src) != TRAILER_MAGIC)
+    {
+        return false;
+    }
+    t.entry_count = get<uint32_t>(src + 4);
+    t.index_offset = get<uint64_t>(src + 8);
+    return true;
+}
+}  // namespace recording
+
+#endif  // GNSS_SDR_MONITOR_RECORDING_FORMAT_H_
@@ -0,0 +1,399 @@
+/*!
+ * \file replay_benchmark.cpp
+ * \brief Implementation of the replay benchmark, which measures the cost of
+ * the views on a recorded or synthetic session.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "replay_benchmark.h"
+#include "allocation_counter.h"
+#include "main_window.h"
+#include "monitor_streams.h"
+#include "session_reader.h"
+#include "synthetic_session.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImage>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+/*!
+ Adds the command line options of the benchmark to \a parser.
+ */
+void ReplayBenchmark::addOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"benchmark", "Replay sessions through all the views as fast as possible, report frame times, "
+                                   "allocations and memory, and exit. Use -platform offscreen without a display."});
+    parser.addOption({"recording", "Recording replayed by --benchmark instead of the synthetic sessions.", "file"});
+    parser.addOption({"channels", "Channel counts of the synthetic sessions.", "list", "50,200,500"});
+    parser.addOption({"duration", "Length of the synthetic sessions.", "seconds", "120"});
+    parser.addOption({"golden", "Directory of golden images the rendered views are compared to.", "dir"});
+    parser.addOption({"update-golden", "Write the rendered views to the --golden directory instead of comparing them."});
+    parser.addOption({"max-p99-ms", "Fail if the 99th percentile frame time exceeds this budget.", "ms"});
+    parser.addOption({"max-allocs-per-epoch", "Fail if the allocations per epoch exceed this budget.", "count"});
+    parser.addOption({"max-rss-mb", "Fail if the peak resident memory exceeds this budget.", "MB"});
+}
+
+/*!
+ Reads the benchmark options from a \a parser that has processed the command line.
+ */
+ReplayBenchmark::Options ReplayBenchmark::options(const QCommandLineParser &parser)
+{
+    Options options;
+    options.recording = parser.value("recording");
+    options.seconds = std::max(1, parser.value("duration").toInt());
+    options.goldenDir = parser.value("golden");
+    options.updateGolden = parser.isSet("update-golden");
+    options.maxP99FrameMs = parser.value("max-p99-ms").toDouble();
+    options.maxAllocationsPerEpoch = parser.value("max-allocs-per-epoch").toDouble();
+    options.maxPeakRssMb = parser.value("max-rss-mb").toDouble();
+
+    options.channels.clear();
+    for (const QString &count : parser.value("channels").split(',', QString::SkipEmptyParts))
+    {
+        if (count.toInt() > 0)
+        {
+            options.channels.push_back(count.toInt());
+        }
+    }
+    return options;
+}
+
+ReplayBenchmark::ReplayBenchmark(const Options &options) : m_options(options), m_out(stdout)
+{
+}
+
+/*!
+ Runs the benchmark on the recording, or on one synthetic session per channel count, and prints a line per run.
+ The windows use default settings kept in a temporary directory, and leave the files of the user untouched.
+ */
+int ReplayBenchmark::run()
+{
+    std::vector<std::pair<QString, QString>> sessions;  // Label and path.
+    QTemporaryDir temporary;
+    if (!temporary.isValid())
+    {
+        m_out << "Cannot create a temporary directory" << endl;
+        return 2;
+    }
+
+    QStandardPaths::setTestModeEnabled(true);
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, temporary.filePath("settings"));
+    QSettings::setPath(QSettings::IniFormat, QSettings::SystemScope, temporary.filePath("settings"));
+
+    if (!m_options.recording.isEmpty())
+    {
+        sessions.emplace_back(QFileInfo(m_options.recording).completeBaseName(), m_options.recording);
+    }
+    else
+    {
+        for (int channels : m_options.channels)
+        {
+            const QString label = QString("%1ch").arg(channels);
+            const QString path = temporary.filePath(label + ".gsdr");
+            QString error;
+            if (!SyntheticSession::write(path, channels, m_options.seconds, &error))
+            {
+                m_out << "Cannot write the synthetic session: " << error << endl;
+                return 2;
+            }
+            sessions.emplace_back(label, path);
+        }
+    }
+
+    if (!AllocationCounter::isEnabled())
+    {
+        m_out << "Allocations are not counted, configure with -DENABLE_ALLOCATION_COUNTER=ON" << endl;
+    }
+    m_out << QString::asprintf("%-12s %9s %7s %6s %8s %8s %10s %12s %11s %7s",
+                 "session", "records", "epochs", "frames", "p50 ms", "p99 ms", "paint p99", "allocs/epoch", "peak RSS MB", "golden")
+          << endl;
+
+    bool ok = true;
+    for (const auto &session : sessions)
+    {
+        Result result;
+        result.label = session.first;
+        if (!replay(session.second, result))
+        {
+            return 2;
+        }
+        report(result);
+        ok = withinBudgets(result) && ok;
+    }
+    return ok ? 0 : 1;
+}
+
+/*!
+ Replays the recording at \a path through a new MainWindow with every view visible, filling \a result.
+ */
+bool ReplayBenchmark::replay(const QString &path, Result &result)
+{
+    SessionReader reader;
+    if (!reader.open(path))
+    {
+        m_out << "Cannot open " << path << ": " << reader.errorString() << endl;
+        return false;
+    }
+
+    // A fixed geometry, so that frame times and images compare between runs.
+    MainWindow window(nullptr, MainWindow::Mode::Benchmark);
+    window.resize(1400, 900);
+    window.showViews();
+    window.show();
+    QCoreApplication::processEvents();
+
+    window.beginReplay(reader.firstTimestamp() / 1000);
+    MonitorClock *clock = window.clock();
+
+    // A frame is everything done since the previous one: decoding and ingesting the records,
+    // refreshing the model and plots, and painting the whole window.
+    QElapsedTimer frame;
+    QObject::connect(&window, &MainWindow::viewsRefreshed, [&window, &frame, &result] {
+        QElapsedTimer paint;
+        paint.start();
+        window.repaint();
+        result.paintMs.push_back(paint.nsecsElapsed() / 1e6);
+        result.frameMs.push_back(frame.nsecsElapsed() / 1e6);
+        frame.restart();
+    });
+
+    const quint64 allocations = AllocationCounter::count();
+    frame.start();
+
+    RecordView record;
+    while (reader.next(record))
+    {
+        clock->advanceTo(record.timestamp_us / 1000);
+        window.dispatchRecord(record.stream_id, record.data, record.size);
+        result.records++;
+        if (record.stream_id == GnssSynchroStream::id)
+        {
+            result.epochs++;
+        }
+    }
+
+    // Let the refreshes still pending on the recorded data happen.
+    clock->advanceTo(clock->nowMs() + 1000);
+
+    if (AllocationCounter::isEnabled() && result.epochs > 0)
+    {
+        result.allocationsPerEpoch = static_cast<double>(AllocationCounter::count() - allocations) / result.epochs;
+    }
+
+    QCoreApplication::processEvents();
+    result.peakRssMb = peakRssMb();
+
+    if (!m_options.goldenDir.isEmpty())
+    {
+        result.goldenFailures = compareGolden(window, result.label);
+    }
+    return true;
+}
+
+/*!
+ Renders every deterministic view of \a window and compares it with the golden image of the same name for \a label,
+ or writes the golden images when updating them. Returns the number of views that do not match.
+ */
+int ReplayBenchmark::compareGolden(const MainWindow &window, const QString &label)
+{
+    QDir dir(m_options.goldenDir);
+    if (m_options.updateGolden && !dir.mkpath("."))
+    {
+        m_out << "Cannot create " << dir.path() << endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto &view : window.views())
+    {
+        // The analytics panel shows measured per-module cost and load, which differ from run to run.
+        if (view.first == "analytics")
+        {
+            continue;
+        }
+
+        const QImage image = view.second->grab().toImage().convertToFormat(QImage::Format_ARGB32);
+        const QString name = label + "_" + view.first;
+
+        if (m_options.updateGolden)
+        {
+            if (!image.save(dir.filePath(name + ".png")))
+            {
+                failures++;
+            }
+            continue;
+        }
+
+        const QImage golden = QImage(dir.filePath(name + ".png")).convertToFormat(QImage::Format_ARGB32);
+        if (golden.isNull())
+        {
+            m_out << "Missing golden image " << dir.filePath(name + ".png") << endl;
+            failures++;
+            continue;
+        }
+
+        const double mismatch = mismatchRatio(image, golden);
+        if (mismatch > GOLDEN_TOLERANCE)
+        {
+            // Keep what was drawn next to the golden image for inspection.
+            image.save(dir.filePath(name + ".actual.png"));
+            m_out << QString::asprintf("%s differs from the golden image in %.2f%% of the pixels",
+                         qPrintable(name), 100.0 * mismatch)
+                  << endl;
+            failures++;
+        }
+    }
+    return failures;
+}
+
+bool ReplayBenchmark::withinBudgets(const Result &result)
+{
+    bool ok = result.goldenFailures == 0;
+
+    const double p99 = percentile(result.frameMs, 0.99);
+    if (m_options.maxP99FrameMs > 0.0 && p99 > m_options.maxP99FrameMs)
+    {
+        m_out << QString::asprintf("%s: p99 frame time %.2f ms over the %.2f ms budget",
+                     qPrintable(result.label), p99, m_options.maxP99FrameMs)
+              << endl;
+        ok = false;
+    }
+    if (m_options.maxAllocationsPerEpoch > 0.0 && result.allocationsPerEpoch > m_options.maxAllocationsPerEpoch)
+    {
+        m_out << QString::asprintf("%s: %.1f allocations per epoch over the budget of %.1f",
+                     qPrintable(result.label), result.allocationsPerEpoch, m_options.maxAllocationsPerEpoch)
+              << endl;
+        ok = false;
+    }
+    if (m_options.maxPeakRssMb > 0.0 && result.peakRssMb > m_options.maxPeakRssMb)
+    {
+        m_out << QString::asprintf("%s: peak RSS %.1f MB over the %.1f MB budget",
+                     qPrintable(result.label), result.peakRssMb, m_options.maxPeakRssMb)
+              << endl;
+        ok = false;
+    }
+    return ok;
+}
+
+void ReplayBenchmark::report(const Result &result)
+{
+    const QString allocations = result.allocationsPerEpoch < 0.0 ? QString("n/a") : QString::number(result.allocationsPerEpoch, 'f', 1);
+    QString golden = "-";
+    if (!m_options.goldenDir.isEmpty() && m_options.updateGolden)
+    {
+        golden = "updated";
+    }
+    else if (!m_options.goldenDir.isEmpty())
+    {
+        golden = result.goldenFailures == 0 ? "ok" : "FAIL";
+    }
+    m_out << QString::asprintf("%-12s %9llu %7llu %6zu %8.2f %8.2f %10.2f %12s %11.1f %7s",
+                 qPrintable(result.label), static_cast<unsigned long long>(result.records),
+                 static_cast<unsigned long long>(result.epochs), result.frameMs.size(),
+                 percentile(result.frameMs, 0.5), percentile(result.frameMs, 0.99), percentile(result.paintMs, 0.99),
+                 qPrintable(allocations), result.peakRssMb, qPrintable(golden))
+          << endl;
+}
+
+/*!
+ Returns the \a p quantile of \a values using the nearest rank, or 0 if there are none.
+ */
+double ReplayBenchmark::percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    const size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+    const size_t i = std::min(values.size() - 1, rank > 0 ? rank - 1 : 0);
+    std::nth_element(values.begin(), values.begin() + i, values.end());
+    return values[i];
+}
+
+/*!
+ Returns the fraction of pixels of \a image that differ from \a golden by more than PIXEL_TOLERANCE in any channel.
+ Images of different sizes do not match at all.
+ */
+double ReplayBenchmark::mismatchRatio(const QImage &image, const QImage &golden)
+{
+    if (image.size() != golden.size() || image.width() == 0 || image.height() == 0)
+    {
+        return 1.0;
+    }
+
+    quint64 different = 0;
+    for (int y = 0; y < image.height(); y++)
+    {
+        const QRgb *a = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        const QRgb *b = reinterpret_cast<const QRgb *>(golden.constScanLine(y));
+        for (int x = 0; x < image.width(); x++)
+        {
+            if (std::abs(qRed(a[x]) - qRed(b[x])) > PIXEL_TOLERANCE ||
+                std::abs(qGreen(a[x]) - qGreen(b[x])) > PIXEL_TOLERANCE ||
+                std::abs(qBlue(a[x]) - qBlue(b[x])) > PIXEL_TOLERANCE ||
+                std::abs(qAlpha(a[x]) - qAlpha(b[x])) > PIXEL_TOLERANCE)
+            {
+                different++;
+            }
+        }
+    }
+    return static_cast<double>(different) / (static_cast<double>(image.width()) * image.height());
+}
+
+/*!
+ Returns the peak resident set size of the process, in MB, or 0 where it is not available.
+ It never decreases, so with several sessions each value covers the runs before it too.
+ */
+double ReplayBenchmark::peakRssMb()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef Q_OS_MACOS
+        return usage.ru_maxrss / (1024.0 * 1024.0);  // Bytes.
+#else
+        return usage.ru_maxrss / 1024.0;  // Kilobytes.
+#endif
+    }
+#endif
+    return 0.0;
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file replay_benchmark.h
+ * \brief Interface of the replay benchmark, which measures the cost of the
+ * views on a recorded or synthetic session.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_REPLAY_BENCHMARK_H_
+#define GNSS_SDR_MONITOR_REPLAY_BENCHMARK_H_
+
+#include <QString>
+#include <QTextStream>
+#include <vector>
+
+class MainWindow;
+class QCommandLineParser;
+class QImage;
+
+/*!
+ Replays sessions through a complete MainWindow as fast as possible and
+ reports what the views cost: the time per frame (ingest of the records since
+ the previous refresh plus the refresh and repaint of every view), the time
+ spent painting, the heap allocations per observables epoch and the peak
+ resident memory. Run with "-platform offscreen" it needs neither a display
+ nor a GPU.
+
+ Without a recording it generates SyntheticSession files with the requested
+ channel counts, so that results are comparable between machines and
+ commits. The views can also be rendered and compared against golden images
+ to catch optimisations that change what is drawn.
+
+ run() returns 0 when every run is within the budgets, 1 when a budget is
+ exceeded or an image does not match, and 2 when a session cannot be read.
+ */
+class ReplayBenchmark
+{
+public:
+    struct Options
+    {
+        QString recording;  // Replayed as is when set, instead of the synthetic sessions.
+        std::vector<int> channels = {50, 200, 500};
+        int seconds = 120;
+        QString goldenDir;
+        bool updateGolden = false;
+
+        // Budgets, 0 disables them.
+        double maxP99FrameMs = 0.0;
+        double maxAllocationsPerEpoch = 0.0;
+        double maxPeakRssMb = 0.0;
+    };
+
+    static void addOptions(QCommandLineParser &parser);
+    static Options options(const QCommandLineParser &parser);
+
+    explicit ReplayBenchmark(const Options &options);
+    int run();
+
+private:
+    struct Result
+    {
+        QString label;
+        quint64 records = 0;
+        quint64 epochs = 0;
+        std::vector<double> frameMs;
+        std::vector<double> paintMs;
+        double allocationsPerEpoch = -1.0;  // Negative when allocations are not counted.
+        double peakRssMb = 0.0;
+        int goldenFailures = 0;
+    };
+
+    bool replay(const QString &path, Result &result);
+    int compareGolden(const MainWindow &window, const QString &label);
+    bool withinBudgets(const Result &result);
+    void report(const Result &result);
+
+    static double percentile(std::vector<double> values, double p);
+    static double mismatchRatio(const QImage &image, const QImage &golden);
+    static double peakRssMb();
+
+    static constexpr double GOLDEN_TOLERANCE = 0.002;  // Fraction of pixels allowed to differ.
+    static constexpr int PIXEL_TOLERANCE = 16;         // Per channel, absorbs antialiasing noise.
+
+    Options m_options;
+    QTextStream m_out;
+};
+
+#endif  // GNSS_SDR_MONITOR_REPLAY_BENCHMARK_H_
@@ -0,0 +1,399 @@
+/*!
+ * \file ring_buffer.h
+ * \brief Contiguous ring buffer with power-of-two storage, two-segment
+ * span access and vectorised range reductions.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_RING_BUFFER_H_
+#define GNSS_SDR_MONITOR_RING_BUFFER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GNSS_SDR_MONITOR_RING_BUFFER_SSE2
+#endif
+
+/*!
+ Read-only view over a contiguous run of elements stored in a RingBuffer.
+ */
+template <typename T>
+struct RingSpan
+{
+    const T *data = nullptr;
+    size_t size = 0;
+
+    const T *begin() const { return data; }
+    const T *end() const { return data + size; }
+    bool empty() const { return size == 0; }
+};
+
+/*!
+ Fixed-capacity FIFO that overwrites its oldest element when full.
+
+ The storage is always a power of two so that indexing is a mask instead of a
+ modulo, while the logical capacity is exactly the one requested. Elements are
+ never moved once written, so consumers can read the whole history through
+ segments() as at most two contiguous spans (oldest first) without copying.
+
+ Every mutation bumps generation(), which lets views cache derived data (series,
+ axis ranges, rendered sparklines) and skip the work when nothing has changed.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+    using value_type = T;
+    using Segments = std::pair<RingSpan<T>, RingSpan<T>>;
+
+    explicit RingBuffer(size_t capacity = 0) { setCapacity(capacity); }
+
+    /*!
+     Sets the maximum number of elements to \a capacity, keeping the newest ones.
+     */
+    void setCapacity(size_t capacity)
+    {
+        if (capacity == m_capacity)
+        {
+            return;
+        }
+
+        std::vector<T> storage(roundUpToPowerOfTwo(capacity));
+        size_t keep = std::min(m_size, capacity);
+        for (size_t i = 0; i < keep; i++)
+        {
+            storage[i] = std::move((*this)[m_size - keep + i]);
+        }
+
+        m_storage.swap(storage);
+        m_mask = m_storage.size() - 1;
+        m_capacity = capacity;
+        m_head = 0;
+        m_size = keep;
+        m_generation++;
+    }
+
+    size_t capacity() const { return m_capacity; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == m_capacity; }
+
+    /*!
+     Returns a counter that changes every time the contents of the buffer change.
+     */
+    uint64_t generation() const { return m_generation; }
+
+    void push_back(const T &value)
+    {
+        if (m_capacity == 0)
+        {
+            return;
+        }
+
+        if (m_size < m_capacity)
+        {
+            m_storage[(m_head + m_size) & m_mask] = value;
+            m_size++;
+        }
+        else
+        {
+            m_storage[(m_head + m_size) & m_mask] = value;
+            m_head = (m_head + 1) & m_mask;
+        }
+        m_generation++;
+    }
+
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+        m_generation++;
+    }
+
+    /*!
+     Returns the element at logical position \a i, where 0 is the oldest element.
+     */
+    const T &operator[](size_t i) const { return m_storage[(m_head + i) & m_mask]; }
+    T &operator[](size_t i) { return m_storage[(m_head + i) & m_mask]; }
+
+    const T &at(size_t i) const
+    {
+        if (i >= m_size)
+        {
+            throw std::out_of_range("RingBuffer::at");
+        }
+        return (*this)[i];
+    }
+
+    const T &front() const { return (*this)[0]; }
+    const T &back() const { return (*this)[m_size - 1]; }
+
+    /*!
+     Returns the logical range [\a first, \a first + \a count) as at most two contiguous spans.
+     */
+    Segments segments(size_t first, size_t count) const
+    {
+        Segments result;
+        if (first >= m_size || count == 0 || m_storage.empty())
+        {
+            return result;
+        }
+
+        count = std::min(count, m_size - first);
+        size_t start = (m_head + first) & m_mask;
+        size_t untilWrap = m_storage.size() - start;
+
+        result.first.data = m_storage.data() + start;
+        result.first.size = std::min(count, untilWrap);
+        if (count > untilWrap)
+        {
+            result.second.data = m_storage.data();
+            result.second.size = count - untilWrap;
+        }
+        return result;
+    }
+
+    /*!
+     Returns the whole contents of the buffer as at most two contiguous spans, oldest first.
+     */
+    Segments segments() const { return segments(0, m_size); }
+
+    /*!
+     Calls \a f on every element of the logical range [\a first, \a first + \a count) in order.
+     */
+    template <typename F>
+    void forEach(size_t first, size_t count, F f) const
+    {
+        Segments s = segments(first, count);
+        for (const T &v : s.first) f(v);
+        for (const T &v : s.second) f(v);
+    }
+
+    template <typename F>
+    void forEach(F f) const { forEach(0, m_size, f); }
+
+    /*!
+     Appends the whole contents of the buffer to \a out, oldest first.
+     */
+    template <typename Container>
+    void copyTo(Container &out) const
+    {
+        Segments s = segments();
+        out.reserve(out.size() + static_cast<typename Container::size_type>(m_size));
+        for (const T &v : s.first) out.push_back(v);
+        for (const T &v : s.second) out.push_back(v);
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t n)
+    {
+        size_t p = 1;
+        while (p < n)
+        {
+            p <<= 1;
+        }
+        return n == 0 ? 0 : p;
+    }
+
+    std::vector<T> m_storage;
+    size_t m_mask = 0;
+    size_t m_capacity = 0;
+    size_t m_head = 0;
+    size_t m_size = 0;
+    uint64_t m_generation = 0;
+};
+
+
+/*!
+ Minimum and maximum of a set of values. Empty ranges yield min > max.
+ */
+struct RingRange
+{
+    double min = std::numeric_limits<double>::max();
+    double max = -std::numeric_limits<double>::max();
+
+    bool valid() const { return min <= max; }
+    void merge(const RingRange &other)
+    {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+namespace ring_simd
+{
+/*!
+ Accumulates the minimum and maximum of \a n contiguous doubles.
+ */
+inline void reduce(const double *v, size_t n, RingRange &range)
+{
+    size_t i = 0;
+#ifdef GNSS_SDR_MONITOR_RING_BUFFER_SSE2
+    if (n >= 4)
+    {
+        __m128d vmin = _mm_set1_pd(range.min);
+        __m128d vmax = _mm_set1_pd(range.max);
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128d x = _mm_loadu_pd(v + i);
+            vmin = _mm_min_pd(vmin, x);
+            vmax = _mm_max_pd(vmax, x);
+        }
+        double lo[2], hi[2];
+        _mm_storeu_pd(lo, vmin);
+        _mm_storeu_pd(hi, vmax);
+        range.min = std::min(lo[0], lo[1]);
+        range.max = std::max(hi[0], hi[1]);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        range.min = std::min(range.min, v[i]);
+        range.max = std::max(range.max, v[i]);
+    }
+}
+
+/*!
+ Returns the sum of \a n contiguous doubles.
+ */
+inline double sum(const double *v, size_t n)
+{
+    size_t i = 0;
+    double total = 0.0;
+#ifdef GNSS_SDR_MONITOR_RING_BUFFER_SSE2
+    if (n >= 4)
+    {
+        __m128d vsum = _mm_setzero_pd();
+        for (; i + 2 <= n; i += 2)
+        {
+            vsum = _mm_add_pd(vsum, _mm_loadu_pd(v + i));
+        }
+        double s[2];
+        _mm_storeu_pd(s, vsum);
+        total = s[0] + s[1];
+    }
+#endif
+    for (; i < n; i++)
+    {
+        total += v[i];
+    }
+    return total;
+}
+
+/*!
+ Accumulates the per-lane minimum and maximum of \a n interleaved (x, y) pairs.
+ */
+inline void reducePairs(const double *xy, size_t n, RingRange &rx, RingRange &ry)
+{
+    size_t i = 0;
+#ifdef GNSS_SDR_MONITOR_RING_BUFFER_SSE2
+    if (n >= 2)
+    {
+        __m128d vmin = _mm_set_pd(ry.min, rx.min);
+        __m128d vmax = _mm_set_pd(ry.max, rx.max);
+        for (; i < n; i++)
+        {
+            __m128d p = _mm_loadu_pd(xy + 2 * i);
+            vmin = _mm_min_pd(vmin, p);
+            vmax = _mm_max_pd(vmax, p);
+        }
+        double lo[2], hi[2];
+        _mm_storeu_pd(lo, vmin);
+        _mm_storeu_pd(hi, vmax);
+        rx.min = lo[0];
+        ry.min = lo[1];
+        rx.max = hi[0];
+        ry.max = hi[1];
+    }
+#endif
+    for (; i < n; i++)
+    {
+        rx.min = std::min(rx.min, xy[2 * i]);
+        rx.max = std::max(rx.max, xy[2 * i]);
+        ry.min = std::min(ry.min, xy[2 * i + 1]);
+        ry.max = std::max(ry.max, xy[2 * i + 1]);
+    }
+}
+}  // namespace ring_simd
+
+
+/*!
+ Returns the minimum and maximum of the logical range [\a first, \a first + \a count) of \a buffer.
+ */
+inline RingRange ringMinMax(const RingBuffer<double> &buffer, size_t first, size_t count)
+{
+    RingRange range;
+    RingBuffer<double>::Segments s = buffer.segments(first, count);
+    ring_simd::reduce(s.first.data, s.first.size, range);
+    ring_simd::reduce(s.second.data, s.second.size, range);
+    return range;
+}
+
+/*!
+ Returns the mean of the logical range [\a first, \a first + \a count) of \a buffer, or 0 if it is empty.
+ */
+inline double ringMean(const RingBuffer<double> &buffer, size_t first, size_t count)
+{
+    RingBuffer<double>::Segments s = buffer.segments(first, count);
+    const size_t n = s.first.size + s.second.size;
+    return n > 0 ? (ring_simd::sum(s.first.data, s.first.size) + ring_simd::sum(s.second.data, s.second.size)) / n : 0.0;
+}
+
+/*!
+ Returns the x and y ranges of a logical range of a buffer of points such as QPointF,
+ i.e. any standard-layout type made of exactly two doubles.
+ */
+template <typename Point>
+std::pair<RingRange, RingRange> ringMinMaxXY(const RingBuffer<Point> &buffer, size_t first, size_t count)
+{
+    static_assert(std::is_standard_layout<Point>::value && sizeof(Point) == 2 * sizeof(double),
+        "ringMinMaxXY requires a point type made of two doubles");
+
+    std::pair<RingRange, RingRange> result;
+    typename RingBuffer<Point>::Segments s = buffer.segments(first, count);
+    ring_simd::reducePairs(reinterpret_cast<const double *>(s.first.data), s.first.size, result.first, result.second);
+    ring_simd::reducePairs(reinterpret_cast<const double *>(s.second.data), s.second.size, result.first, result.second);
+    return result;
+}
+
+template <typename Point>
+std::pair<RingRange, RingRange> ringMinMaxXY(const RingBuffer<Point> &buffer)
+{
+    return ringMinMaxXY(buffer, 0, buffer.size());
+}
+
+#endif  // GNSS_SDR_MONITOR_RING_BUFFER_H_
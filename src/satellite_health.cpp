@@ -0,0 +1,172 @@
+/*!
+ * \file satellite_health.cpp
+ * \brief Implementation of the health and integrity flags of the GPS satellites,
+ * decoded from their broadcast ephemeris.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "satellite_health.h"
+
+SatelliteHealth::SatelliteHealth() = default;
+
+/*!
+ Decodes the flags of the satellite of \a ephemeris if its IODE differs from the last one seen.
+ Returns false, without touching anything, for a repeated ephemeris.
+ */
+bool SatelliteHealth::update(const gnss_sdr::GpsEphemeris &ephemeris)
+{
+    int prn = ephemeris.prn();
+    if (prn <= 0 || prn > MAX_PRN)
+    {
+        return false;
+    }
+
+    Satellite &sat = m_satellites[prn];
+    int iode = ephemeris.iode_sf2();
+    if (m_known[prn] && sat.iode == iode)
+    {
+        return false;
+    }
+
+    Flags flags;
+    flags[Unhealthy] = ephemeris.sv_health() != 0;
+    flags[Alert] = ephemeris.alert_flag();
+    flags[UraDegraded] = ephemeris.sv_accuracy() >= URA_DEGRADED_INDEX;
+    flags[ExtendedFit] = ephemeris.fit_interval_flag();
+    flags[Integrity] = ephemeris.integrity_status_flag();
+    flags[AntiSpoofing] = ephemeris.antispoofing_flag();
+
+    bool changed = !m_known[prn] || sat.flags != flags || sat.health != ephemeris.sv_health() ||
+                   sat.ura != ephemeris.sv_accuracy();
+    sat.flags = flags;
+    sat.health = ephemeris.sv_health();
+    sat.ura = ephemeris.sv_accuracy();
+    sat.iode = iode;
+    m_known[prn] = true;
+    m_unhealthy[prn] = flags[Unhealthy] || flags[Alert];
+    if (changed)
+    {
+        m_revision++;
+    }
+    return true;
+}
+
+SatelliteHealth::Flags SatelliteHealth::flags(int prn) const
+{
+    return contains(prn) ? m_satellites[prn].flags : Flags();
+}
+
+int SatelliteHealth::health(int prn) const
+{
+    return contains(prn) ? m_satellites[prn].health : 0;
+}
+
+int SatelliteHealth::ura(int prn) const
+{
+    return contains(prn) ? m_satellites[prn].ura : -1;
+}
+
+int SatelliteHealth::iode(int prn) const
+{
+    return contains(prn) ? m_satellites[prn].iode : -1;
+}
+
+/*!
+ Returns true if satellite \a prn of \a system broadcasts a flag of Fault severity.
+ Only GPS satellites are known.
+ */
+bool SatelliteHealth::isUnhealthy(const std::string &system, int prn) const
+{
+    return system == "G" && prn > 0 && prn <= MAX_PRN && m_unhealthy[prn];
+}
+
+const char *SatelliteHealth::flagName(Flag flag)
+{
+    switch (flag)
+    {
+    case Unhealthy:
+        return "Health";
+    case Alert:
+        return "Alert";
+    case UraDegraded:
+        return "URA";
+    case ExtendedFit:
+        return "Fit > 4 h";
+    case Integrity:
+        return "Integrity";
+    case AntiSpoofing:
+        return "A-S";
+    default:
+        return "";
+    }
+}
+
+const char *SatelliteHealth::flagDescription(Flag flag)
+{
+    switch (flag)
+    {
+    case Unhealthy:
+        return "The satellite is flagged unhealthy (SV health not zero)";
+    case Alert:
+        return "Alert: the URA may be worse than indicated, use at your own risk";
+    case UraDegraded:
+        return "User range accuracy worse than 48 m";
+    case ExtendedFit:
+        return "Ephemeris curve fit over more than 4 hours";
+    case Integrity:
+        return "Enhanced level of integrity assurance";
+    case AntiSpoofing:
+        return "Anti-spoofing mode on";
+    default:
+        return "";
+    }
+}
+
+SatelliteHealth::Severity SatelliteHealth::severity(Flag flag)
+{
+    switch (flag)
+    {
+    case Unhealthy:
+    case Alert:
+        return Severity::Fault;
+    case UraDegraded:
+    case ExtendedFit:
+        return Severity::Warning;
+    default:
+        return Severity::Info;
+    }
+}
+
+void SatelliteHealth::clear()
+{
+    m_satellites.fill(Satellite());
+    m_known.reset();
+    m_unhealthy.reset();
+    m_revision++;
+}
@@ -0,0 +1,118 @@
+/*!
+ * \file satellite_health.h
+ * \brief Interface of the health and integrity flags of the GPS satellites,
+ * decoded from their broadcast ephemeris.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SATELLITE_HEALTH_H_
+#define GNSS_SDR_MONITOR_SATELLITE_HEALTH_H_
+
+#include "gps_ephemeris.pb.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+/*!
+ Health and integrity flags of every GPS satellite, one bitset per PRN.
+
+ The flags are decoded from the ephemeris only when its IODE changes, so the
+ views can look them up every frame at the cost of a bit test. revision()
+ changes whenever any flag does, so that the views repaint only then.
+ */
+class SatelliteHealth
+{
+public:
+    static constexpr int MAX_PRN = 32;
+
+    enum Flag
+    {
+        Unhealthy,     // SV_health is not zero
+        Alert,         // The URA may be worse than broadcast
+        UraDegraded,   // URA index at or above URA_DEGRADED_INDEX
+        ExtendedFit,   // Fit interval longer than 4 hours
+        Integrity,     // Enhanced integrity assurance
+        AntiSpoofing,  // Anti-spoofing mode on
+        FLAG_COUNT
+    };
+
+    enum class Severity
+    {
+        Fault,    // Do not use the satellite
+        Warning,  // Usable with degraded accuracy
+        Info      // Normal operation
+    };
+
+    using Flags = std::bitset<FLAG_COUNT>;
+    using PrnSet = std::bitset<MAX_PRN + 1>;
+
+    // URA index 8 is 96 m, worse than anything a healthy satellite broadcasts.
+    static constexpr int URA_DEGRADED_INDEX = 8;
+
+    SatelliteHealth();
+
+    // Returns true if the IODE is new for that satellite.
+    bool update(const gnss_sdr::GpsEphemeris &ephemeris);
+
+    bool contains(int prn) const { return prn > 0 && prn <= MAX_PRN && m_known[prn]; }
+    Flags flags(int prn) const;
+    int health(int prn) const;
+    int ura(int prn) const;
+    int iode(int prn) const;
+
+    // Satellites with a flag of Fault severity set.
+    bool isUnhealthy(const std::string &system, int prn) const;
+    const PrnSet &unhealthy() const { return m_unhealthy; }
+    const PrnSet &known() const { return m_known; }
+
+    uint64_t revision() const { return m_revision; }
+
+    static const char *flagName(Flag flag);
+    static const char *flagDescription(Flag flag);
+    static Severity severity(Flag flag);
+
+    void clear();
+
+private:
+    struct Satellite
+    {
+        Flags flags;
+        int health = 0;
+        int ura = -1;
+        int iode = -1;
+    };
+
+    std::array<Satellite, MAX_PRN + 1> m_satellites;
+    PrnSet m_known;
+    PrnSet m_unhealthy;
+    uint64_t m_revision = 0;
+};
+
+#endif  // GNSS_SDR_MONITOR_SATELLITE_HEALTH_H_
@@ -0,0 +1,181 @@
+/*!
+ * \file series_decimator.cpp
+ * \brief Implementation of the reduction of a sampled series to the rate at
+ * which it is displayed, before it is stored.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "series_decimator.h"
+#include <cmath>
+
+/*!
+ Constructs a decimator of samples of \a width values, 1 or 2, that keeps every sample.
+ */
+SeriesDecimator::SeriesDecimator(int width) : m_width(width == 2 ? 2 : 1)
+{
+    reset();
+}
+
+/*!
+ Sets the policy and its parameters, and drops the open bucket.
+ */
+void SeriesDecimator::setConfig(const Config &config)
+{
+    m_config = config;
+    if (m_config.every < 1)
+    {
+        m_config.every = 1;
+    }
+    if (m_config.bucketMs < 1)
+    {
+        m_config.bucketMs = 1;
+    }
+    reset();
+}
+
+/*!
+ Feeds \a sample and writes to \a out the samples to store, if any. Returns their number.
+ The buckets are aligned on multiples of their length, and a bucket is returned when the
+ first sample of a later one arrives.
+ */
+int SeriesDecimator::push(const Sample &sample, Sample out[MAX_OUTPUT])
+{
+    switch (m_config.policy)
+    {
+    case Policy::All:
+        out[0] = sample;
+        return 1;
+
+    case Policy::EveryNth:
+        if (m_count++ % static_cast<uint64_t>(m_config.every) == 0)
+        {
+            out[0] = sample;
+            return 1;
+        }
+        return 0;
+
+    default:
+        break;
+    }
+
+    const auto bucket = static_cast<int64_t>(std::floor(sample.time * 1000.0 / m_config.bucketMs));
+    int count = 0;
+    if (m_samples > 0 && bucket != m_bucket)
+    {
+        count = flush(out);
+    }
+
+    if (m_samples == 0)
+    {
+        m_bucket = bucket;
+        m_sum = {0.0, {0.0, 0.0}};
+        m_min = sample;
+        m_max = sample;
+    }
+    m_samples++;
+    m_sum.time += sample.time;
+    m_sum.value[0] += sample.value[0];
+    m_sum.value[1] += sample.value[1];
+    if (key(sample) < key(m_min))
+    {
+        m_min = sample;
+    }
+    if (key(sample) > key(m_max))
+    {
+        m_max = sample;
+    }
+    m_last = sample;
+    return count;
+}
+
+/*!
+ Drops the open bucket and restarts the count of samples.
+ */
+void SeriesDecimator::reset()
+{
+    m_count = 0;
+    m_samples = 0;
+}
+
+const char *SeriesDecimator::policyName(Policy policy)
+{
+    switch (policy)
+    {
+    case Policy::All:
+        return "All samples";
+    case Policy::EveryNth:
+        return "Every Nth sample";
+    case Policy::Mean:
+        return "Mean per bucket";
+    case Policy::MinMax:
+        return "Min and max per bucket";
+    case Policy::Last:
+        return "Last per bucket";
+    }
+    return "";
+}
+
+int SeriesDecimator::flush(Sample out[MAX_OUTPUT])
+{
+    int count = 1;
+    switch (m_config.policy)
+    {
+    case Policy::Mean:
+        out[0].time = m_sum.time / m_samples;
+        out[0].value[0] = m_sum.value[0] / m_samples;
+        out[0].value[1] = m_sum.value[1] / m_samples;
+        break;
+
+    case Policy::MinMax:
+        if (m_min.time == m_max.time)
+        {
+            out[0] = m_min;
+        }
+        else
+        {
+            const bool min_first = m_min.time < m_max.time;
+            out[0] = min_first ? m_min : m_max;
+            out[1] = min_first ? m_max : m_min;
+            count = 2;
+        }
+        break;
+
+    default:
+        out[0] = m_last;
+        break;
+    }
+    m_samples = 0;
+    return count;
+}
+
+// Value that orders the samples for MinMax: the value, or the squared magnitude of I and Q.
+double SeriesDecimator::key(const Sample &sample) const
+{
+    return m_width == 1 ? sample.value[0] : sample.value[0] * sample.value[0] + sample.value[1] * sample.value[1];
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file series_decimator.h
+ * \brief Interface of the reduction of a sampled series to the rate at which it
+ * is displayed, before it is stored.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SERIES_DECIMATOR_H_
+#define GNSS_SDR_MONITOR_SERIES_DECIMATOR_H_
+
+#include <cstdint>
+
+/*!
+ Reduces a series as its samples arrive, so that a history stores samples at the
+ display rate instead of the receiver rate. A sample carries one value, or two for
+ the prompt I and Q of a constellation, which are always reduced together.
+ */
+class SeriesDecimator
+{
+public:
+    enum class Policy
+    {
+        All,       // Keep every sample.
+        EveryNth,  // Keep one sample out of every `every`.
+        Mean,      // Mean time and value of each bucket of `bucketMs`.
+        MinMax,    // Smallest and largest sample of each bucket, in the order they came.
+        Last       // Last sample of each bucket.
+    };
+
+    struct Config
+    {
+        Policy policy = Policy::All;
+        int every = 10;
+        int bucketMs = 100;
+    };
+
+    struct Sample
+    {
+        double time;
+        double value[2];
+    };
+
+    // Most samples that push() can return at once.
+    static constexpr int MAX_OUTPUT = 2;
+
+    explicit SeriesDecimator(int width = 1);
+
+    void setConfig(const Config &config);
+    const Config &config() const { return m_config; }
+
+    int push(const Sample &sample, Sample out[MAX_OUTPUT]);
+    void reset();
+
+    static const char *policyName(Policy policy);
+
+private:
+    int flush(Sample out[MAX_OUTPUT]);
+    double key(const Sample &sample) const;
+
+    Config m_config;
+    int m_width;
+    uint64_t m_count = 0;
+
+    // Open bucket.
+    int64_t m_bucket = 0;
+    int m_samples = 0;
+    Sample m_sum;
+    Sample m_min;
+    Sample m_max;
+    Sample m_last;
+};
+
+#endif  // GNSS_SDR_MONITOR_SERIES_DECIMATOR_H_
@@ -0,0 +1,362 @@
+/*!
+ * \file series_query.cpp
+ * \brief Implementation of the queries over the in-memory series served by
+ * the query API.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "series_query.h"
+#include <QDataStream>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrlQuery>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+QJsonArray toJsonArray(const std::vector<double> &values)
+{
+    QJsonArray array;
+    for (double value : values)
+    {
+        array.append(value);
+    }
+    return array;
+}
+
+bool readNumber(const QUrlQuery &query, const char *name, double &value, QString &error)
+{
+    if (!query.hasQueryItem(name))
+    {
+        return true;
+    }
+
+    bool ok = false;
+    value = query.queryItemValue(name).toDouble(&ok);
+    // toDouble() takes "nan" and "inf", which no parameter can use.
+    ok = ok && std::isfinite(value);
+    if (!ok)
+    {
+        error = QString("invalid %1").arg(name);
+    }
+    return ok;
+}
+
+bool readFields(const QString &list, const QStringList &known, QStringList &fields, QString &error)
+{
+    fields = list.split(',', QString::SkipEmptyParts);
+    for (const QString &field : fields)
+    {
+        if (!known.contains(field))
+        {
+            error = "unknown field " + field + ", expected one of " + known.join(',');
+            return false;
+        }
+    }
+    return !fields.isEmpty();
+}
+}  // namespace
+
+int SeriesRequest::parse(const QString &path, const QUrlQuery &query, SeriesRequest &request, QString &error)
+{
+    request = SeriesRequest();
+
+    if (path == "/api/channels")
+    {
+        request.kind = Kind::Channels;
+        return 200;
+    }
+    else if (path == "/api/series")
+    {
+        request.kind = Kind::Channel;
+        request.satellite = query.queryItemValue("sat").toUpper();
+        request.signal = query.queryItemValue("signal");
+        if (query.hasQueryItem("channel"))
+        {
+            bool ok = false;
+            request.channelId = query.queryItemValue("channel").toInt(&ok);
+            if (!ok || request.channelId < 0)
+            {
+                error = "invalid channel";
+                return 400;
+            }
+        }
+        if (request.satellite.isEmpty() && request.channelId < 0)
+        {
+            error = "sat or channel is required";
+            return 400;
+        }
+
+        const QString field = query.hasQueryItem("field") ? query.queryItemValue("field") : QString("cn0");
+        if (!readFields(field, channelFields(), request.fields, error))
+        {
+            return 400;
+        }
+    }
+    else if (path == "/api/pvt")
+    {
+        request.kind = Kind::Pvt;
+        const QString fields = query.hasQueryItem("fields") ? query.queryItemValue("fields") : QString("latitude,longitude,height");
+        if (!readFields(fields, pvtFields(), request.fields, error))
+        {
+            return 400;
+        }
+    }
+    else
+    {
+        error = "unknown path " + path;
+        return 404;
+    }
+
+    double points = DEFAULT_POINTS;
+    if (!readNumber(query, "from", request.from, error) || !readNumber(query, "to", request.to, error) ||
+        !readNumber(query, "last", request.last, error) || !readNumber(query, "points", points, error))
+    {
+        return 400;
+    }
+    if (points < 2 || points > MAX_POINTS || request.last < 0.0)
+    {
+        error = QString("points must be in [2, %1] and last positive").arg(MAX_POINTS);
+        return 400;
+    }
+    request.points = static_cast<int>(points);
+
+    const QString format = query.queryItemValue("format");
+    if (!format.isEmpty() && format != "json" && format != "binary")
+    {
+        error = "format must be json or binary";
+        return 400;
+    }
+    request.binary = format == "binary";
+    return 200;
+}
+
+const QStringList &SeriesRequest::channelFields()
+{
+    static const QStringList fields = {"cn0", "doppler", "doppler_residual", "prompt_i", "prompt_q"};
+    return fields;
+}
+
+namespace
+{
+struct PvtField
+{
+    const char *name;
+    SeriesRequest::PvtGetter getter;
+};
+
+const PvtField PVT_FIELDS[] = {
+    {"latitude", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.latitude(); }},
+    {"longitude", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.longitude(); }},
+    {"height", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.height(); }},
+    {"pos_x", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.pos_x(); }},
+    {"pos_y", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.pos_y(); }},
+    {"pos_z", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.pos_z(); }},
+    {"vel_x", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.vel_x(); }},
+    {"vel_y", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.vel_y(); }},
+    {"vel_z", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.vel_z(); }},
+    {"user_clk_offset", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.user_clk_offset(); }},
+    {"valid_sats", [](const gnss_sdr::MonitorPvt &pvt) { return static_cast<double>(pvt.valid_sats()); }},
+    {"gdop", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.gdop(); }},
+    {"pdop", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.pdop(); }},
+    {"hdop", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.hdop(); }},
+    {"vdop", [](const gnss_sdr::MonitorPvt &pvt) { return pvt.vdop(); }},
+};
+}  // namespace
+
+const QStringList &SeriesRequest::pvtFields()
+{
+    static const QStringList fields = [] {
+        QStringList names;
+        for (const PvtField &field : PVT_FIELDS)
+        {
+            names << field.name;
+        }
+        return names + enuFields();
+    }();
+    return fields;
+}
+
+const QStringList &SeriesRequest::enuFields()
+{
+    static const QStringList fields = {"east", "north", "up"};
+    return fields;
+}
+
+SeriesRequest::PvtGetter SeriesRequest::pvtGetter(const QString &field)
+{
+    for (const PvtField &pvt_field : PVT_FIELDS)
+    {
+        if (field == pvt_field.name)
+        {
+            return pvt_field.getter;
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ Answers \a request with the data in \a snapshot, as JSON or, with format=binary, as a little-endian
+ uint32 series count followed, for each series, by a uint32 sample count, the times and the values as doubles.
+ */
+SeriesQuery::Response SeriesQuery::run(const SeriesRequest &request, const SeriesSnapshot &snapshot)
+{
+    Response response;
+
+    if (request.kind == SeriesRequest::Kind::Channels)
+    {
+        QJsonArray channels;
+        for (const SeriesSnapshot::Channel &channel : snapshot.channels)
+        {
+            channels.append(QJsonObject{{"channel", channel.channelId}, {"sat", channel.satellite},
+                {"signal", channel.signal}, {"samples", static_cast<double>(channel.samples)}});
+        }
+        response.contentType = "application/json";
+        response.body = QJsonDocument(QJsonObject{{"channels", channels}}).toJson(QJsonDocument::Compact);
+        return response;
+    }
+
+    if (snapshot.series.empty())
+    {
+        return error(404, "no matching series");
+    }
+
+    QJsonArray series_list;
+    QByteArray binary;
+    QDataStream stream(&binary, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    stream << static_cast<quint32>(snapshot.series.size());
+
+    std::vector<double> time;
+    std::vector<double> values;
+    for (const SeriesSnapshot::Series &series : snapshot.series)
+    {
+        const size_t n = std::min(series.time.size(), series.values.size());
+        double from = request.from;
+        if (request.last > 0.0 && n > 0)
+        {
+            from = std::max(from, series.time[n - 1] - request.last);
+        }
+
+        const double *t = series.time.data();
+        const size_t first = std::lower_bound(t, t + n, from) - t;
+        const size_t last = std::upper_bound(t + first, t + n, request.to) - t;
+        downsample(t, series.values.data(), first, last, request.points, time, values);
+
+        if (request.binary)
+        {
+            stream << static_cast<quint32>(time.size());
+            for (double value : time)
+            {
+                stream << value;
+            }
+            for (double value : values)
+            {
+                stream << value;
+            }
+            continue;
+        }
+
+        QJsonObject object{{"field", series.field}, {"t", toJsonArray(time)}, {"v", toJsonArray(values)}};
+        if (series.channelId >= 0)
+        {
+            object.insert("channel", series.channelId);
+            object.insert("sat", series.satellite);
+            object.insert("signal", series.signal);
+        }
+        series_list.append(object);
+    }
+
+    if (request.binary)
+    {
+        response.contentType = "application/octet-stream";
+        response.body = binary;
+    }
+    else
+    {
+        response.contentType = "application/json";
+        response.body = QJsonDocument(QJsonObject{{"series", series_list}}).toJson(QJsonDocument::Compact);
+    }
+    return response;
+}
+
+SeriesQuery::Response SeriesQuery::error(int status, const QString &message)
+{
+    Response response;
+    response.status = status;
+    response.contentType = "application/json";
+    response.body = QJsonDocument(QJsonObject{{"error", message}}).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+void SeriesQuery::downsample(const double *time, const double *values, size_t first, size_t last, int points,
+    std::vector<double> &time_out, std::vector<double> &values_out)
+{
+    time_out.clear();
+    values_out.clear();
+    if (last <= first)
+    {
+        return;
+    }
+
+    const size_t n = last - first;
+    if (n <= static_cast<size_t>(points))
+    {
+        time_out.assign(time + first, time + last);
+        values_out.assign(values + first, values + last);
+        return;
+    }
+
+    const size_t buckets = std::max(1, points / 2);
+    time_out.reserve(2 * buckets);
+    values_out.reserve(2 * buckets);
+    for (size_t b = 0; b < buckets; b++)
+    {
+        const size_t lo = first + n * b / buckets;
+        const size_t hi = first + n * (b + 1) / buckets;
+        const auto range = std::minmax_element(values + lo, values + hi);
+        size_t i = range.first - values;
+        size_t j = range.second - values;
+        if (i > j)
+        {
+            std::swap(i, j);
+        }
+
+        time_out.push_back(time[i]);
+        values_out.push_back(values[i]);
+        if (j != i)
+        {
+            time_out.push_back(time[j]);
+            values_out.push_back(values[j]);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+/*!
+ * \file series_query.h
+ * \brief Interface of the queries over the in-memory series served by the
+ * query API.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SERIES_QUERY_H_
+#define GNSS_SDR_MONITOR_SERIES_QUERY_H_
+
+#include "monitor_pvt.pb.h"
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <limits>
+#include <vector>
+
+class QUrlQuery;
+
+/*!
+ A query parsed from the path and parameters of an API request:
+
+   /api/channels                   channels currently tracked
+   /api/series?sat=G12&field=cn0   history of one or more channels
+   /api/pvt?fields=height,gdop     history of PVT fields
+
+ Series requests select channels with sat=<system><prn> (optionally narrowed
+ with signal=) or channel=<id>, and
+ field=cn0|doppler|doppler_residual|prompt_i|prompt_q. All of them take from=
+ and to= bounds or last=<seconds> before the newest sample, on the continuous
+ time axis of the views, points=<max points> and format=binary for raw
+ little-endian doubles instead of JSON.
+ */
+struct SeriesRequest
+{
+    enum class Kind
+    {
+        Channels,
+        Channel,
+        Pvt
+    };
+
+    Kind kind = Kind::Channels;
+    QString satellite;     // System letter and PRN, e.g. "G12".
+    QString signal;        // Two-character signal code, e.g. "1C".
+    int channelId = -1;
+    QStringList fields;
+    double from = -std::numeric_limits<double>::infinity();
+    double to = std::numeric_limits<double>::infinity();
+    double last = 0.0;     // Seconds before the newest sample, 0 for no limit.
+    int points = DEFAULT_POINTS;
+    bool binary = false;
+
+    static constexpr int DEFAULT_POINTS = 500;
+    static constexpr int MAX_POINTS = 100000;
+
+    // Returns the HTTP status of the request, 200 if it is valid, and sets \a error otherwise.
+    static int parse(const QString &path, const QUrlQuery &query, SeriesRequest &request, QString &error);
+
+    static const QStringList &channelFields();
+    static const QStringList &pvtFields();
+    // PVT fields derived from the whole history: the east, north and up offsets of each fix
+    // from the mean position, in metres. Also part of pvtFields(), without a getter.
+    static const QStringList &enuFields();
+
+    // Accessor of the PVT field \a field, nullptr if it is not one of pvtFields().
+    using PvtGetter = double (*)(const gnss_sdr::MonitorPvt &);
+    static PvtGetter pvtGetter(const QString &field);
+};
+
+/*!
+ Immutable copy of the data needed to answer one request, taken on the GUI
+ thread so that the rest of the work can run anywhere without locking.
+ */
+struct SeriesSnapshot
+{
+    struct Channel
+    {
+        int channelId = 0;
+        QString satellite;
+        QString signal;
+        size_t samples = 0;
+    };
+
+    struct Series
+    {
+        QString field;
+        int channelId = -1;  // -1 for PVT series.
+        QString satellite;
+        QString signal;
+        std::vector<double> time;
+        std::vector<double> values;
+    };
+
+    std::vector<Channel> channels;
+    std::vector<Series> series;
+};
+
+/*!
+ Answers a request from its snapshot: trims the series to the requested
+ time range, downsamples them and encodes the result. Safe to run on any
+ thread.
+ */
+class SeriesQuery
+{
+public:
+    struct Response
+    {
+        int status = 200;
+        QByteArray contentType;
+        QByteArray body;
+    };
+
+    static Response run(const SeriesRequest &request, const SeriesSnapshot &snapshot);
+    static Response error(int status, const QString &message);
+
+    // Keeps at most \a points samples of [\a first, \a last) by taking the minimum and maximum
+    // of buckets of equal sample count, in time order, so that peaks survive the downsampling.
+    static void downsample(const double *time, const double *values, size_t first, size_t last, int points,
+        std::vector<double> &time_out, std::vector<double> &values_out);
+};
+
+#endif  // GNSS_SDR_MONITOR_SERIES_QUERY_H_
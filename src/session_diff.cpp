@@ -0,0 +1,476 @@
+/*!
+ * \file session_diff.cpp
+ * \brief Implementation of the time-aligned comparison of two recorded
+ * sessions.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "session_diff.h"
+#include "gnss_synchro.pb.h"
+#include "monitor_pvt.pb.h"
+#include "monitor_streams.h"
+#include "pvt_snapshot.h"
+#include "session_reader.h"
+#include <QCommandLineParser>
+#include <QFile>
+#include <QRunnable>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+struct SignalEpoch
+{
+    double cn0Sum = 0.0;
+    int samples = 0;
+    bool locked = false;
+};
+
+struct SessionEpoch
+{
+    std::map<QString, SignalEpoch> signalEpochs;
+    bool hasPvt = false;
+    bool fix = false;
+    quint32 satellites = 0;
+    double dop[SessionDiff::DOP_COUNT] = {};
+
+    bool empty() const { return signalEpochs.empty() && !hasPvt; }
+};
+
+/*!
+ Bins the records of \a reader with timestamps in [\a start_us, \a end_us) into \a epochs, one per second.
+ */
+void readChunk(SessionReader &reader, qint64 start_us, qint64 end_us, std::vector<SessionEpoch> &epochs)
+{
+    epochs.assign(static_cast<size_t>((end_us - start_us + SessionDiff::EPOCH_US - 1) / SessionDiff::EPOCH_US),
+        SessionEpoch());
+
+    gnss_sdr::Observables observables;
+    gnss_sdr::MonitorPvt pvt;
+    RecordView record;
+
+    reader.seek(start_us);
+    while (reader.next(record))
+    {
+        // Records are stored in receive order, so the chunk ends at the first later one.
+        if (record.timestamp_us >= end_us)
+        {
+            break;
+        }
+        if (record.timestamp_us < start_us)
+        {
+            continue;
+        }
+
+        SessionEpoch &epoch = epochs[static_cast<size_t>((record.timestamp_us - start_us) / SessionDiff::EPOCH_US)];
+        if (record.stream_id == GnssSynchroStream::id && observables.ParseFromArray(record.data, record.size))
+        {
+            for (const gnss_sdr::GnssSynchro &obs : observables.observable())
+            {
+                // Same rule as the channel table: channels without a sampling rate are idle.
+                if (obs.fs() == 0)
+                {
+                    continue;
+                }
+
+                const QString key = QString::fromStdString(obs.system()) + QString::number(obs.prn()) + " " +
+                                    QString::fromStdString(obs.signal());
+                SignalEpoch &signal = epoch.signalEpochs[key];
+                signal.cn0Sum += obs.cn0_db_hz();
+                signal.samples++;
+                signal.locked = signal.locked || obs.flag_valid_pseudorange();
+            }
+        }
+        else if (record.stream_id == MonitorPvtStream::id && pvt.ParseFromArray(record.data, record.size))
+        {
+            const PvtSnapshot snapshot = PvtSnapshot::fromMonitorPvt(pvt);
+            epoch.hasPvt = true;
+            epoch.fix = snapshot.hasFix();
+            epoch.satellites = snapshot.valid_sats;
+            epoch.dop[SessionDiff::GDOP] = snapshot.gdop;
+            epoch.dop[SessionDiff::PDOP] = snapshot.pdop;
+            epoch.dop[SessionDiff::HDOP] = snapshot.hdop;
+            epoch.dop[SessionDiff::VDOP] = snapshot.vdop;
+        }
+    }
+}
+
+/*!
+ Compares the epochs of one chunk of both sessions. \a offset_s is the aligned time of the first epoch.
+ */
+void compareChunk(const std::vector<SessionEpoch> (&sessions)[2], double offset_s, SessionDiff::Report &report)
+{
+    const size_t n = std::min(sessions[0].size(), sessions[1].size());
+    for (size_t i = 0; i < n; i++)
+    {
+        const SessionEpoch *epoch[2] = {&sessions[0][i], &sessions[1][i]};
+        if (epoch[0]->empty() && epoch[1]->empty())
+        {
+            continue;
+        }
+
+        SessionDiff::EpochDiff diff;
+        diff.time = offset_s + static_cast<double>(i) * SessionDiff::EPOCH_US / 1e6;
+        report.epochs++;
+
+        for (int s = 0; s < 2; s++)
+        {
+            diff.fix[s] = epoch[s]->fix;
+            diff.satellites[s] = epoch[s]->satellites;
+            report.fixEpochs[s] += epoch[s]->fix ? 1 : 0;
+            if (epoch[s]->hasPvt)
+            {
+                report.dopEpochs[s]++;
+                for (int d = 0; d < SessionDiff::DOP_COUNT; d++)
+                {
+                    diff.dop[s][d] = epoch[s]->dop[d];
+                    report.dopSum[s][d] += epoch[s]->dop[d];
+                }
+            }
+
+            for (const auto &signal : epoch[s]->signalEpochs)
+            {
+                SessionDiff::PrnStats &stats = report.signalStats[signal.first];
+                stats.epochs[s]++;
+                stats.locked[s] += signal.second.locked ? 1 : 0;
+                stats.cn0Sum[s] += signal.second.cn0Sum / signal.second.samples;
+            }
+        }
+
+        // Both maps are sorted by key, so the common signals are found in one pass.
+        double delta_sum = 0.0;
+        auto a = epoch[0]->signalEpochs.begin();
+        auto b = epoch[1]->signalEpochs.begin();
+        while (a != epoch[0]->signalEpochs.end() && b != epoch[1]->signalEpochs.end())
+        {
+            if (a->first < b->first)
+            {
+                ++a;
+            }
+            else if (b->first < a->first)
+            {
+                ++b;
+            }
+            else
+            {
+                const double delta = b->second.cn0Sum / b->second.samples - a->second.cn0Sum / a->second.samples;
+                SessionDiff::PrnStats &stats = report.signalStats[a->first];
+                stats.paired++;
+                stats.deltaSum += delta;
+                stats.deltaSquares += delta * delta;
+                delta_sum += delta;
+                diff.commonSignals++;
+                ++a;
+                ++b;
+            }
+        }
+        diff.meanCn0Delta = diff.commonSignals ? delta_sum / diff.commonSignals : 0.0;
+        report.epochDiffs.push_back(diff);
+    }
+}
+
+/*!
+ Compares chunk [\a start_us, \a end_us) of the aligned time axis, reading each recording with a reader of its
+ own that shares the index of \a indexed.
+ */
+class ChunkTask : public QRunnable
+{
+public:
+    ChunkTask(const SessionReader (&indexed)[2], const qint64 (&origins)[2], qint64 start_us, qint64 end_us,
+        const std::atomic<bool> *cancel, SessionDiff::Report &report)
+        : m_indexed(indexed),
+          m_origins{origins[0], origins[1]},
+          m_start(start_us),
+          m_end(end_us),
+          m_cancel(cancel),
+          m_report(report)
+    {
+    }
+
+    void run() override
+    {
+        if (m_cancel && *m_cancel)
+        {
+            return;
+        }
+
+        std::vector<SessionEpoch> sessions[2];
+        for (int s = 0; s < 2; s++)
+        {
+            SessionReader reader;
+            if (!reader.openShared(m_indexed[s]))
+            {
+                m_report.error = m_indexed[s].fileName() + ": " + reader.errorString();
+                return;
+            }
+            readChunk(reader, m_origins[s] + m_start, m_origins[s] + m_end, sessions[s]);
+        }
+        compareChunk(sessions, m_start / 1e6, m_report);
+    }
+
+private:
+    const SessionReader (&m_indexed)[2];
+    qint64 m_origins[2];
+    qint64 m_start;
+    qint64 m_end;
+    const std::atomic<bool> *m_cancel;
+    SessionDiff::Report &m_report;
+};
+}  // namespace
+
+double SessionDiff::PrnStats::deltaStdDev() const
+{
+    if (paired < 2)
+    {
+        return 0.0;
+    }
+    const double mean = meanDelta();
+    return std::sqrt(std::max(0.0, (deltaSquares - paired * mean * mean) / (paired - 1)));
+}
+
+/*!
+ Adds the results of \a other, which must cover a later span of the aligned time axis.
+ */
+void SessionDiff::Report::merge(const Report &other)
+{
+    if (error.isEmpty())
+    {
+        error = other.error;
+    }
+
+    epochs += other.epochs;
+    for (int s = 0; s < 2; s++)
+    {
+        fixEpochs[s] += other.fixEpochs[s];
+        dopEpochs[s] += other.dopEpochs[s];
+        for (int d = 0; d < DOP_COUNT; d++)
+        {
+            dopSum[s][d] += other.dopSum[s][d];
+        }
+    }
+
+    for (const auto &signal : other.signalStats)
+    {
+        PrnStats &stats = signalStats[signal.first];
+        for (int s = 0; s < 2; s++)
+        {
+            stats.epochs[s] += signal.second.epochs[s];
+            stats.locked[s] += signal.second.locked[s];
+            stats.cn0Sum[s] += signal.second.cn0Sum[s];
+        }
+        stats.paired += signal.second.paired;
+        stats.deltaSum += signal.second.deltaSum;
+        stats.deltaSquares += signal.second.deltaSquares;
+    }
+
+    epochDiffs.insert(epochDiffs.end(), other.epochDiffs.begin(), other.epochDiffs.end());
+}
+
+/*!
+ Compares the recordings \a before and \a after over the span they have in common once aligned.
+ Setting \a cancel from another thread stops the comparison early.
+ */
+SessionDiff::Report SessionDiff::compare(const QString &before, const QString &after, Alignment alignment,
+    const std::atomic<bool> *cancel)
+{
+    Report report;
+    const QString paths[2] = {before, after};
+    SessionReader readers[2];
+    qint64 first[2];
+    qint64 last[2];
+
+    for (int s = 0; s < 2; s++)
+    {
+        if (!readers[s].open(paths[s]))
+        {
+            report.error = paths[s] + ": " + readers[s].errorString();
+            return report;
+        }
+        first[s] = readers[s].firstTimestamp();
+        last[s] = readers[s].lastTimestamp();
+        report.seconds[s] = (last[s] - first[s]) / 1e6;
+    }
+
+    // Origin of the aligned time axis in each recording, and its length.
+    qint64 origins[2] = {first[0], first[1]};
+    qint64 span = std::min(last[0] - first[0], last[1] - first[1]) + EPOCH_US;
+    if (alignment == Alignment::Absolute)
+    {
+        const qint64 origin = std::max(first[0], first[1]);
+        origins[0] = origins[1] = origin - origin % EPOCH_US;
+        span = std::min(last[0], last[1]) - origins[0] + EPOCH_US;
+    }
+    if (span <= 0)
+    {
+        report.error = "The recordings do not overlap";
+        return report;
+    }
+
+    const size_t chunks = static_cast<size_t>((span + CHUNK_US - 1) / CHUNK_US);
+    std::vector<Report> results(chunks);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+    for (size_t c = 0; c < chunks; c++)
+    {
+        const qint64 start = static_cast<qint64>(c) * CHUNK_US;
+        pool.start(new ChunkTask(readers, origins, start, std::min(span, start + CHUNK_US), cancel, results[c]));
+    }
+    pool.waitForDone();
+
+    for (const Report &result : results)
+    {
+        report.merge(result);
+    }
+    if (cancel && *cancel && report.error.isEmpty())
+    {
+        report.error = "Cancelled";
+    }
+    return report;
+}
+
+/*!
+ Prints the summary and the per-signal statistics of \a report as text.
+ */
+void SessionDiff::print(const Report &report, QTextStream &out)
+{
+    if (!report.error.isEmpty())
+    {
+        out << "Error: " << report.error << endl;
+        return;
+    }
+
+    auto percent = [&report](quint64 count) { return report.epochs ? 100.0 * count / report.epochs : 0.0; };
+    auto meanDop = [&report](int s, int d) { return report.dopEpochs[s] ? report.dopSum[s][d] / report.dopEpochs[s] : 0.0; };
+
+    out << QString::asprintf("Recordings: %.0f s before, %.0f s after, %llu aligned epochs compared",
+               report.seconds[0], report.seconds[1], static_cast<unsigned long long>(report.epochs))
+        << endl;
+    out << QString::asprintf("Fix availability: %.2f %% before, %.2f %% after",
+               percent(report.fixEpochs[0]), percent(report.fixEpochs[1]))
+        << endl;
+    out << QString::asprintf("Mean DOP before/after: GDOP %.2f/%.2f  PDOP %.2f/%.2f  HDOP %.2f/%.2f  VDOP %.2f/%.2f",
+               meanDop(0, GDOP), meanDop(1, GDOP), meanDop(0, PDOP), meanDop(1, PDOP),
+               meanDop(0, HDOP), meanDop(1, HDOP), meanDop(0, VDOP), meanDop(1, VDOP))
+        << endl
+        << endl;
+
+    out << QString::asprintf("%-10s %9s %9s %9s %9s %9s %8s %8s %8s %8s",
+               "signal", "epochs A", "epochs B", "lock A s", "lock B s", "lock diff", "CN0 A", "CN0 B", "dCN0", "sd dCN0")
+        << endl;
+    for (const auto &signal : report.signalStats)
+    {
+        const PrnStats &stats = signal.second;
+        out << QString::asprintf("%-10s %9llu %9llu %9llu %9llu %9lld %8.2f %8.2f %8.2f %8.2f",
+                   qPrintable(signal.first),
+                   static_cast<unsigned long long>(stats.epochs[0]), static_cast<unsigned long long>(stats.epochs[1]),
+                   static_cast<unsigned long long>(stats.locked[0]), static_cast<unsigned long long>(stats.locked[1]),
+                   static_cast<long long>(stats.locked[1]) - static_cast<long long>(stats.locked[0]),
+                   stats.meanCn0(0), stats.meanCn0(1), stats.meanDelta(), stats.deltaStdDev())
+            << endl;
+    }
+}
+
+/*!
+ Writes the per-epoch differences of \a report as CSV to \a path.
+ */
+bool SessionDiff::writeEpochs(const Report &report, const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "time,fix_before,fix_after,sats_before,sats_after,"
+           "gdop_before,gdop_after,pdop_before,pdop_after,hdop_before,hdop_after,vdop_before,vdop_after,"
+           "common_signals,mean_cn0_delta\n";
+    for (const EpochDiff &diff : report.epochDiffs)
+    {
+        out << diff.time << ',' << int(diff.fix[0]) << ',' << int(diff.fix[1]) << ','
+            << diff.satellites[0] << ',' << diff.satellites[1];
+        for (int d = 0; d < DOP_COUNT; d++)
+        {
+            out << ',' << diff.dop[0][d] << ',' << diff.dop[1][d];
+        }
+        out << ',' << diff.commonSignals << ',' << diff.meanCn0Delta << '\n';
+    }
+    return true;
+}
+
+void SessionDiff::addOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"diff", "Compare two recordings given as arguments, before and after, print the report and exit."});
+    parser.addOption({"align", "Align the recordings on the time since their start (relative) "
+                               "or on the receive time (absolute).", "mode", "relative"});
+    parser.addOption({"epochs-csv", "Write the per-epoch differences of --diff to this file.", "file"});
+    parser.addPositionalArgument("recordings", "Recordings compared, cut or merged by the options above.",
+        "[recordings...]");
+}
+
+/*!
+ Runs the comparison requested on the command line and returns the exit status of the program.
+ */
+int SessionDiff::run(const QCommandLineParser &parser)
+{
+    QTextStream out(stdout);
+    const QStringList recordings = parser.positionalArguments();
+    if (recordings.size() != 2)
+    {
+        out << "--diff needs two recordings, before and after" << endl;
+        return 2;
+    }
+
+    const QString align = parser.value("align");
+    if (align != "relative" && align != "absolute")
+    {
+        out << "--align must be relative or absolute" << endl;
+        return 2;
+    }
+
+    const Report report = compare(recordings.at(0), recordings.at(1),
+        align == "absolute" ? Alignment::Absolute : Alignment::Relative);
+    print(report, out);
+    if (!report.error.isEmpty())
+    {
+        return 1;
+    }
+
+    if (parser.isSet("epochs-csv") && !writeEpochs(report, parser.value("epochs-csv")))
+    {
+        out << "Cannot write " << parser.value("epochs-csv") << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*!
+ * \file session_diff.h
+ * \brief Interface of the time-aligned comparison of two recorded sessions.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SESSION_DIFF_H_
+#define GNSS_SDR_MONITOR_SESSION_DIFF_H_
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <map>
+#include <vector>
+
+class QCommandLineParser;
+class QTextStream;
+
+/*!
+ Compares two recordings, typically made before and after a change of the
+ receiver configuration.
+
+ Both recordings are binned into one second epochs and merged on a common
+ time axis: either the time since the start of each recording, or the
+ receive time when both sessions ran at the same time. The aligned span is
+ split into chunks that are decoded and compared in parallel, each chunk
+ seeking both recordings through their block index, so only a few chunks are
+ in memory whatever the length of the recordings. Each recording is indexed
+ once and the chunks share its index, each reading with a file handle of its
+ own. The chunk results are
+ merged in time order into per-PRN statistics (CN0 and time in lock) and
+ per-epoch differences (fix availability, satellites and DOP).
+ */
+class SessionDiff
+{
+public:
+    enum class Alignment
+    {
+        Relative,  // Seconds since the first record of each recording.
+        Absolute   // Receive timestamps, for sessions recorded at the same time.
+    };
+
+    // Dilutions of precision, in this order.
+    enum Dop
+    {
+        GDOP,
+        PDOP,
+        HDOP,
+        VDOP,
+        DOP_COUNT
+    };
+
+    struct PrnStats
+    {
+        quint64 epochs[2] = {0, 0};     // Epochs with the signal tracked, before and after.
+        quint64 locked[2] = {0, 0};     // Epochs with a valid pseudorange.
+        double cn0Sum[2] = {0.0, 0.0};  // Sum of the epoch means.
+        quint64 paired = 0;             // Epochs tracked in both sessions.
+        double deltaSum = 0.0;          // CN0 after - before, on paired epochs.
+        double deltaSquares = 0.0;
+
+        double meanCn0(int session) const { return epochs[session] ? cn0Sum[session] / epochs[session] : 0.0; }
+        double meanDelta() const { return paired ? deltaSum / paired : 0.0; }
+        double deltaStdDev() const;
+    };
+
+    struct EpochDiff
+    {
+        double time = 0.0;  // Seconds since the aligned origin.
+        bool fix[2] = {false, false};
+        quint32 satellites[2] = {0, 0};
+        double dop[2][DOP_COUNT] = {};
+        int commonSignals = 0;
+        double meanCn0Delta = 0.0;  // Over the common signals.
+    };
+
+    struct Report
+    {
+        QString error;
+        double seconds[2] = {0.0, 0.0};  // Length of each recording.
+        quint64 epochs = 0;              // Aligned epochs with data in either session.
+        quint64 fixEpochs[2] = {0, 0};
+        quint64 dopEpochs[2] = {0, 0};
+        double dopSum[2][DOP_COUNT] = {};
+        std::map<QString, PrnStats> signalStats;  // By system, PRN and signal, e.g. "G12 1C".
+        std::vector<EpochDiff> epochDiffs;
+
+        void merge(const Report &other);
+    };
+
+    static constexpr qint64 EPOCH_US = 1000000;
+    static constexpr qint64 CHUNK_US = 600 * EPOCH_US;
+
+    static Report compare(const QString &before, const QString &after, Alignment alignment,
+        const std::atomic<bool> *cancel = nullptr);
+
+    static void print(const Report &report, QTextStream &out);
+    static bool writeEpochs(const Report &report, const QString &path);
+
+    // Command line front end: --diff before.gsdr after.gsdr.
+    static void addOptions(QCommandLineParser &parser);
+    static int run(const QCommandLineParser &parser);
+};
+
+#endif  // GNSS_SDR_MONITOR_SESSION_DIFF_H_
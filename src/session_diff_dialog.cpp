@@ -0,0 +1,229 @@
+/*!
+ * \file session_diff_dialog.cpp
+ * \brief Implementation of a dialog that compares two recorded sessions.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "session_diff_dialog.h"
+#include "series_query.h"
+#include <QChart>
+#include <QChartView>
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineSeries>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QRunnable>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <QValueAxis>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+class CompareTask : public QRunnable
+{
+public:
+    CompareTask(SessionDiffDialog *dialog, std::function<void(const SessionDiff::Report &)> done,
+        const QString &before, const QString &after, SessionDiff::Alignment alignment, const std::atomic<bool> *cancel)
+        : m_dialog(dialog), m_done(std::move(done)), m_before(before), m_after(after), m_alignment(alignment), m_cancel(cancel)
+    {
+    }
+
+    void run() override
+    {
+        const SessionDiff::Report report = SessionDiff::compare(m_before, m_after, m_alignment, m_cancel);
+        auto done = m_done;
+        QMetaObject::invokeMethod(m_dialog, [done, report] { done(report); }, Qt::QueuedConnection);
+    }
+
+private:
+    SessionDiffDialog *m_dialog;
+    std::function<void(const SessionDiff::Report &)> m_done;
+    QString m_before;
+    QString m_after;
+    SessionDiff::Alignment m_alignment;
+    const std::atomic<bool> *m_cancel;
+};
+
+constexpr int MAX_CHART_POINTS = 2000;
+}  // namespace
+
+SessionDiffDialog::SessionDiffDialog(const QString &before, const QString &after, SessionDiff::Alignment alignment,
+    QWidget *parent)
+    : QDialog(parent), m_cancel(false)
+{
+    setWindowTitle("Compare Sessions: " + QFileInfo(before).fileName() + " / " + QFileInfo(after).fileName());
+    resize(900, 700);
+
+    m_summary = new QLabel("Comparing...", this);
+    m_summary->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    m_table = new QTableWidget(0, 10, this);
+    m_table->setHorizontalHeaderLabels({"Signal", "Epochs before", "Epochs after", "Lock before [s]", "Lock after [s]",
+        "Lock diff [s]", "C/N0 before", "C/N0 after", "ΔC/N0 [dB-Hz]", "σ ΔC/N0"});
+    m_table->verticalHeader()->hide();
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSortingEnabled(true);
+    m_table->setAlternatingRowColors(true);
+
+    m_chartView = new QtCharts::QChartView(this);
+    m_chartView->setRenderHint(QPainter::Antialiasing);
+    m_chartView->setMinimumHeight(220);
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    m_saveButton = buttons->addButton("Save Epochs...", QDialogButtonBox::ActionRole);
+    m_saveButton->setEnabled(false);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    connect(m_saveButton, &QPushButton::clicked, this, &SessionDiffDialog::saveEpochs);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(m_summary);
+    layout->addWidget(m_table, 1);
+    layout->addWidget(m_chartView, 1);
+    layout->addWidget(buttons);
+
+    m_pool.setMaxThreadCount(1);
+    m_pool.start(new CompareTask(this, [this](const SessionDiff::Report &report) { showReport(report); },
+        before, after, alignment, &m_cancel));
+}
+
+SessionDiffDialog::~SessionDiffDialog()
+{
+    m_cancel = true;
+    m_pool.waitForDone();
+}
+
+void SessionDiffDialog::showReport(const SessionDiff::Report &report)
+{
+    m_report = report;
+    if (!report.error.isEmpty())
+    {
+        m_summary->setText("Cannot compare the sessions: " + report.error);
+        return;
+    }
+
+    auto percent = [&report](quint64 count) { return report.epochs ? 100.0 * count / report.epochs : 0.0; };
+    auto meanDop = [&report](int s, int d) { return report.dopEpochs[s] ? report.dopSum[s][d] / report.dopEpochs[s] : 0.0; };
+    m_summary->setText(QString("%1 aligned epochs. Fix availability %2 % before, %3 % after. "
+                               "Mean PDOP %4 before, %5 after; HDOP %6 before, %7 after.")
+                           .arg(report.epochs)
+                           .arg(percent(report.fixEpochs[0]), 0, 'f', 2)
+                           .arg(percent(report.fixEpochs[1]), 0, 'f', 2)
+                           .arg(meanDop(0, SessionDiff::PDOP), 0, 'f', 2)
+                           .arg(meanDop(1, SessionDiff::PDOP), 0, 'f', 2)
+                           .arg(meanDop(0, SessionDiff::HDOP), 0, 'f', 2)
+                           .arg(meanDop(1, SessionDiff::HDOP), 0, 'f', 2));
+
+    // Numbers are set as display data so that sorting by a column is numeric.
+    auto number = [](double value) {
+        QTableWidgetItem *item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, value);
+        item->setTextAlignment(Qt::AlignCenter);
+        return item;
+    };
+
+    m_table->setSortingEnabled(false);
+    m_table->setRowCount(static_cast<int>(report.signalStats.size()));
+    int row = 0;
+    for (const auto &signal : report.signalStats)
+    {
+        const SessionDiff::PrnStats &stats = signal.second;
+        m_table->setItem(row, 0, new QTableWidgetItem(signal.first));
+        m_table->setItem(row, 1, number(stats.epochs[0]));
+        m_table->setItem(row, 2, number(stats.epochs[1]));
+        m_table->setItem(row, 3, number(stats.locked[0]));
+        m_table->setItem(row, 4, number(stats.locked[1]));
+        m_table->setItem(row, 5, number(static_cast<double>(stats.locked[1]) - static_cast<double>(stats.locked[0])));
+        m_table->setItem(row, 6, number(std::round(stats.meanCn0(0) * 100.0) / 100.0));
+        m_table->setItem(row, 7, number(std::round(stats.meanCn0(1) * 100.0) / 100.0));
+        m_table->setItem(row, 8, number(std::round(stats.meanDelta() * 100.0) / 100.0));
+        m_table->setItem(row, 9, number(std::round(stats.deltaStdDev() * 100.0) / 100.0));
+        row++;
+    }
+    m_table->setSortingEnabled(true);
+    m_table->resizeColumnsToContents();
+
+    // Per-epoch differences, downsampled the same way as the query API.
+    std::vector<double> time;
+    std::vector<double> cn0_delta;
+    std::vector<double> pdop_delta;
+    time.reserve(report.epochDiffs.size());
+    cn0_delta.reserve(report.epochDiffs.size());
+    pdop_delta.reserve(report.epochDiffs.size());
+    for (const SessionDiff::EpochDiff &diff : report.epochDiffs)
+    {
+        time.push_back(diff.time);
+        cn0_delta.push_back(diff.meanCn0Delta);
+        pdop_delta.push_back(diff.dop[1][SessionDiff::PDOP] - diff.dop[0][SessionDiff::PDOP]);
+    }
+
+    QtCharts::QChart *chart = new QtCharts::QChart();
+    chart->setTitle("Differences after - before");
+    auto addSeries = [chart, &time](const std::vector<double> &values, const QString &name) {
+        std::vector<double> t;
+        std::vector<double> v;
+        SeriesQuery::downsample(time.data(), values.data(), 0, values.size(), MAX_CHART_POINTS, t, v);
+
+        QVector<QPointF> points;
+        points.reserve(static_cast<int>(t.size()));
+        for (size_t i = 0; i < t.size(); i++)
+        {
+            points << QPointF(t[i], v[i]);
+        }
+
+        QtCharts::QLineSeries *series = new QtCharts::QLineSeries(chart);
+        series->setName(name);
+        series->replace(points);
+        chart->addSeries(series);
+    };
+    addSeries(cn0_delta, "Mean ΔC/N0 [dB-Hz]");
+    addSeries(pdop_delta, "ΔPDOP");
+    chart->createDefaultAxes();
+    chart->axes(Qt::Horizontal).back()->setTitleText("Aligned time [s]");
+
+    QtCharts::QChart *old = m_chartView->chart();
+    m_chartView->setChart(chart);
+    delete old;
+
+    m_saveButton->setEnabled(!report.epochDiffs.empty());
+}
+
+void SessionDiffDialog::saveEpochs()
+{
+    const QString fileName = QFileDialog::getSaveFileName(this, "Save Epochs", "session-diff.csv", "CSV files (*.csv)");
+    if (!fileName.isEmpty() && !SessionDiff::writeEpochs(m_report, fileName))
+    {
+        QMessageBox::warning(this, "Save Epochs", "Cannot write " + fileName);
+    }
+}
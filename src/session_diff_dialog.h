@@ -0,0 +1,78 @@
+/*!
+ * \file session_diff_dialog.h
+ * \brief Interface of a dialog that compares two recorded sessions.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SESSION_DIFF_DIALOG_H_
+#define GNSS_SDR_MONITOR_SESSION_DIFF_DIALOG_H_
+
+#include "session_diff.h"
+#include <QDialog>
+#include <QThreadPool>
+#include <atomic>
+
+class QLabel;
+class QPushButton;
+class QTableWidget;
+
+namespace QtCharts
+{
+class QChartView;
+}
+
+/*!
+ Runs a SessionDiff in the background and shows its result: a summary, a
+ table with one row per signal and a chart of the per-epoch differences.
+ Closing the dialog cancels a comparison still in progress.
+ */
+class SessionDiffDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    SessionDiffDialog(const QString &before, const QString &after, SessionDiff::Alignment alignment,
+        QWidget *parent = nullptr);
+    ~SessionDiffDialog();
+
+private:
+    void showReport(const SessionDiff::Report &report);
+    void saveEpochs();
+
+    QLabel *m_summary;
+    QTableWidget *m_table;
+    QtCharts::QChartView *m_chartView;
+    QPushButton *m_saveButton;
+
+    SessionDiff::Report m_report;
+    QThreadPool m_pool;
+    std::atomic<bool> m_cancel;
+};
+
+#endif  // GNSS_SDR_MONITOR_SESSION_DIFF_DIALOG_H_
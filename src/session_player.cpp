@@ -0,0 +1,119 @@
+/*!
+ * \file session_player.cpp
+ * \brief Implementation of the replay of recorded sessions, paced by the wall
+ * clock and driving the virtual clock of the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "session_player.h"
+#include <limits>
+
+SessionPlayer::SessionPlayer(QObject *parent)
+    : QObject(parent), m_clock(nullptr), m_speed(1.0), m_hasPending(false), m_records(0)
+{
+    m_tick.setInterval(TICK_MS);
+    connect(&m_tick, &QTimer::timeout, this, &SessionPlayer::step);
+}
+
+bool SessionPlayer::open(const QString &path)
+{
+    stop();
+    return m_reader.open(path);
+}
+
+/*!
+ Starts the replay from the beginning of the recording.
+ */
+void SessionPlayer::start()
+{
+    if (!m_reader.isOpen())
+    {
+        return;
+    }
+
+    m_reader.rewind();
+    m_hasPending = false;
+    m_records = 0;
+    m_wall.start();
+    m_tick.start();
+}
+
+void SessionPlayer::stop()
+{
+    m_tick.stop();
+    m_hasPending = false;
+}
+
+void SessionPlayer::step()
+{
+    const qint64 start_us = m_reader.firstTimestamp();
+    const qint64 target_us = m_speed > 0.0 ? start_us + static_cast<qint64>(m_wall.nsecsElapsed() / 1000 * m_speed)
+                                           : std::numeric_limits<qint64>::max();
+    QElapsedTimer slice;
+    slice.start();
+
+    for (;;)
+    {
+        if (!m_hasPending)
+        {
+            if (!m_reader.next(m_pending))
+            {
+                if (m_clock)
+                {
+                    m_clock->advanceTo(m_clock->nowMs() + FLUSH_MS);
+                }
+                stop();
+                emit finished();
+                return;
+            }
+            m_hasPending = true;
+        }
+
+        if (m_pending.timestamp_us > target_us)
+        {
+            return;
+        }
+
+        if (m_clock)
+        {
+            m_clock->advanceTo(m_pending.timestamp_us / 1000);
+        }
+        if (m_dispatch)
+        {
+            m_dispatch(m_pending.stream_id, m_pending.data, m_pending.size);
+        }
+        m_hasPending = false;
+        m_records++;
+
+        if (m_speed <= 0.0 && slice.elapsed() >= SLICE_MS)
+        {
+            return;
+        }
+    }
+}
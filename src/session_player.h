@@ -0,0 +1,100 @@
+/*!
+ * \file session_player.h
+ * \brief Interface of the replay of recorded sessions, paced by the wall clock
+ * and driving the virtual clock of the monitor.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SESSION_PLAYER_H_
+#define GNSS_SDR_MONITOR_SESSION_PLAYER_H_
+
+#include "monitor_clock.h"
+#include "session_reader.h"
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <functional>
+
+/*!
+ Feeds the records of a recording to a dispatcher in time order.
+
+ Before each record is dispatched the MonitorClock is advanced to the record
+ timestamp, so every timer of the monitor fires at the same point of the data
+ whatever the replay speed. The speed only sets how fast the wall clock lets
+ records through; 0 replays as fast as possible, in slices that keep the GUI
+ responsive.
+ */
+class SessionPlayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Dispatcher = std::function<void(quint16 stream_id, const char *data, int size)>;
+
+    explicit SessionPlayer(QObject *parent = nullptr);
+
+    bool open(const QString &path);
+    QString errorString() const { return m_reader.errorString(); }
+
+    void setClock(MonitorClock *clock) { m_clock = clock; }
+    void setDispatcher(const Dispatcher &dispatcher) { m_dispatch = dispatcher; }
+    void setSpeed(double speed) { m_speed = speed; }
+    double speed() const { return m_speed; }
+
+    bool isPlaying() const { return m_tick.isActive(); }
+    quint64 recordsPlayed() const { return m_records; }
+    qint64 firstTimestamp() const { return m_reader.firstTimestamp(); }
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    void finished();
+
+private:
+    void step();
+
+    static constexpr int TICK_MS = 10;
+    static constexpr int SLICE_MS = 20;     // Work per tick when replaying as fast as possible.
+    static constexpr int FLUSH_MS = 1000;  // Virtual time added at the end so pending refreshes fire.
+
+    SessionReader m_reader;
+    MonitorClock *m_clock;
+    Dispatcher m_dispatch;
+    double m_speed;
+
+    QTimer m_tick;  // Paces the replay in wall time, so deliberately not a ClockTimer.
+    QElapsedTimer m_wall;
+    RecordView m_pending;
+    bool m_hasPending;
+    quint64 m_records;
+};
+
+#endif  // GNSS_SDR_MONITOR_SESSION_PLAYER_H_
@@ -0,0 +1,391 @@
+/*!
+ * \file session_reader.cpp
+ * \brief Implementation of a reader of the session recordings written by
+ * SessionRecorder.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "session_reader.h"
+#include <algorithm>
+
+/*!
+ Opens the recording at \a path and loads its block index.
+ */
+bool SessionReader::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    char header[recording::FileHeader::SIZE];
+    recording::FileHeader fileHeader;
+    const int tail = recording::FileHeader::SIZE - recording::FileHeader::V1_SIZE;
+    if (m_file.read(header, recording::FileHeader::V1_SIZE) != recording::FileHeader::V1_SIZE ||
+        !recording::decode(header, fileHeader) ||
+        fileHeader.version > recording::FORMAT_VERSION ||
+        (fileHeader.version >= 2 && m_file.read(header + recording::FileHeader::V1_SIZE, tail) != tail))
+    {
+        m_error = "Not a gnss-sdr-monitor recording";
+        m_file.close();
+        return false;
+    }
+    if (fileHeader.version >= 2)
+    {
+        recording::decodeTail(header, fileHeader);
+        m_checksums = (fileHeader.flags & recording::FLAG_BLOCK_CRC) != 0;
+    }
+    m_dataOffset = fileHeader.size();
+
+    if (!loadIndex())
+    {
+        // Not closed: start from the checkpoints if they are intact, from the first block otherwise.
+        m_recovered = true;
+        qint64 scan_from = m_dataOffset;
+        if (fileHeader.last_checkpoint == 0 || !loadCheckpoints(fileHeader.last_checkpoint, scan_from))
+        {
+            m_index.clear();
+            scan_from = m_dataOffset;
+        }
+        scanBlocks(scan_from, m_file.size());
+    }
+
+    rewind();
+    return true;
+}
+
+/*!
+ Opens the recording of \a indexed with a file handle of its own and reads it through the index of
+ \a indexed, which must stay open and unchanged while this reader is used.
+ */
+bool SessionReader::openShared(const SessionReader &indexed)
+{
+    close();
+
+    if (!indexed.isOpen())
+    {
+        m_error = "The recording is not open";
+        return false;
+    }
+    m_file.setFileName(indexed.m_file.fileName());
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    m_blocks = indexed.m_blocks;
+    m_dataOffset = indexed.m_dataOffset;
+    m_dataEnd = indexed.m_dataEnd;
+    m_recovered = indexed.m_recovered;
+    m_checksums = indexed.m_checksums;
+    rewind();
+    return true;
+}
+
+void SessionReader::close()
+{
+    m_file.close();
+    m_index.clear();
+    m_blocks = &m_index;
+    m_payload.clear();
+    m_error.clear();
+    m_dataOffset = 0;
+    m_dataEnd = 0;
+    m_recovered = false;
+    m_checksums = false;
+    m_corruptBlocks = 0;
+    m_block = 0;
+    m_offset = 0;
+    m_remaining = 0;
+}
+
+qint64 SessionReader::firstTimestamp() const
+{
+    return m_blocks->empty() ? 0 : m_blocks->front().first_timestamp_us;
+}
+
+qint64 SessionReader::lastTimestamp() const
+{
+    return m_blocks->empty() ? 0 : m_blocks->back().last_timestamp_us;
+}
+
+void SessionReader::seek(qint64 timestamp_us)
+{
+    // Blocks are written in time order, so the index is sorted by last timestamp.
+    auto it = std::lower_bound(m_blocks->begin(), m_blocks->end(), timestamp_us,
+        [](const recording::IndexEntry &e, qint64 t) { return e.last_timestamp_us < t; });
+    seekBlock(static_cast<size_t>(it - m_blocks->begin()));
+}
+
+void SessionReader::seekBlock(size_t i)
+{
+    m_block = i;
+    m_payload.clear();
+    m_offset = 0;
+    m_remaining = 0;
+}
+
+bool SessionReader::next(RecordView &record)
+{
+    while (m_remaining == 0)
+    {
+        if (m_block >= m_blocks->size())
+        {
+            return false;
+        }
+
+        recording::BlockHeader header;
+        if (readBlock(m_block++, header, m_payload))
+        {
+            m_offset = 0;
+            m_remaining = header.record_count;
+        }
+    }
+
+    if (m_offset + recording::RecordHeader::SIZE > m_payload.size())
+    {
+        m_remaining = 0;
+        return next(record);
+    }
+
+    recording::RecordHeader header;
+    recording::decode(m_payload.constData() + m_offset, header);
+    m_offset += recording::RecordHeader::SIZE;
+    if (header.size > static_cast<quint32>(m_payload.size() - m_offset))
+    {
+        // Truncated block: skip what is left of it.
+        m_remaining = 0;
+        return next(record);
+    }
+
+    record.timestamp_us = header.timestamp_us;
+    record.stream_id = header.stream_id;
+    record.data = m_payload.constData() + m_offset;
+    record.size = static_cast<int>(header.size);
+
+    m_offset += static_cast<int>(header.size);
+    m_remaining--;
+    return true;
+}
+
+bool SessionReader::readBlock(size_t i, recording::BlockHeader &header, QByteArray &payload)
+{
+    if (i >= m_blocks->size() || !m_file.seek(static_cast<qint64>((*m_blocks)[i].offset)))
+    {
+        return false;
+    }
+
+    char raw[recording::BlockHeader::SIZE];
+    if (m_file.read(raw, sizeof(raw)) != sizeof(raw) || !recording::decode(raw, header))
+    {
+        return false;
+    }
+
+    payload.resize(static_cast<int>(header.payload_size));
+    if (m_file.read(payload.data(), payload.size()) != payload.size())
+    {
+        return false;
+    }
+
+    if (m_checksums && recording::checksum(header, payload.constData()) != header.crc)
+    {
+        m_corruptBlocks++;
+        return false;
+    }
+    return true;
+}
+
+qint64 SessionReader::blockEnd(size_t i)
+{
+    char raw[recording::BlockHeader::SIZE];
+    recording::BlockHeader header;
+    if (i >= m_blocks->size() || !m_file.seek(static_cast<qint64>((*m_blocks)[i].offset)) ||
+        m_file.read(raw, sizeof(raw)) != sizeof(raw) || !recording::decode(raw, header))
+    {
+        return -1;
+    }
+    return static_cast<qint64>((*m_blocks)[i].offset) + recording::BlockHeader::SIZE + header.payload_size;
+}
+
+bool SessionReader::loadIndex()
+{
+    qint64 size = m_file.size();
+    if (size < m_dataOffset + recording::Trailer::SIZE)
+    {
+        return false;
+    }
+
+    char raw[recording::Trailer::SIZE];
+    recording::Trailer trailer;
+    if (!m_file.seek(size - recording::Trailer::SIZE) ||
+        m_file.read(raw, sizeof(raw)) != sizeof(raw) ||
+        !recording::decode(raw, trailer))
+    {
+        return false;
+    }
+
+    qint64 indexBytes = static_cast<qint64>(trailer.entry_count) * recording::IndexEntry::SIZE;
+    if (static_cast<qint64>(trailer.index_offset) + indexBytes + recording::Trailer::SIZE != size ||
+        !m_file.seek(static_cast<qint64>(trailer.index_offset)))
+    {
+        return false;
+    }
+
+    QByteArray entries = m_file.read(indexBytes);
+    if (entries.size() != indexBytes)
+    {
+        return false;
+    }
+
+    m_index.resize(trailer.entry_count);
+    for (quint32 i = 0; i < trailer.entry_count; i++)
+    {
+        recording::decode(entries.constData() + i * recording::IndexEntry::SIZE, m_index[i]);
+    }
+    m_dataEnd = static_cast<qint64>(trailer.index_offset);
+    return true;
+}
+
+/*!
+ Loads the index entries of the checkpoint at \a offset and of all the ones before it. On success \a scan_from
+ is set to the end of that checkpoint, where the blocks it does not cover start.
+ */
+bool SessionReader::loadCheckpoints(quint64 offset, qint64 &scan_from)
+{
+    std::vector<std::vector<recording::IndexEntry>> chain;
+    char raw[recording::Checkpoint::SIZE];
+    while (offset != 0)
+    {
+        recording::Checkpoint checkpoint;
+        if (offset < static_cast<quint64>(m_dataOffset) || !m_file.seek(static_cast<qint64>(offset)) ||
+            m_file.read(raw, sizeof(raw)) != sizeof(raw) || !recording::decode(raw, checkpoint))
+        {
+            return false;
+        }
+
+        const qint64 bytes = static_cast<qint64>(checkpoint.entry_count) * recording::IndexEntry::SIZE;
+        const QByteArray entries = m_file.read(bytes);
+        if (entries.size() != bytes || recording::checksum(checkpoint, entries.constData()) != checkpoint.crc)
+        {
+            return false;
+        }
+
+        if (chain.empty())
+        {
+            scan_from = static_cast<qint64>(offset) + recording::Checkpoint::SIZE + bytes;
+        }
+        chain.emplace_back(checkpoint.entry_count);
+        for (quint32 i = 0; i < checkpoint.entry_count; i++)
+        {
+            recording::decode(entries.constData() + i * recording::IndexEntry::SIZE, chain.back()[i]);
+        }
+
+        // The chain only goes backwards, so a damaged link cannot loop.
+        if (checkpoint.previous >= offset)
+        {
+            return false;
+        }
+        offset = checkpoint.previous;
+    }
+
+    m_index.clear();
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        m_index.insert(m_index.end(), it->begin(), it->end());
+    }
+    return true;
+}
+
+/*!
+ Appends to the index the blocks found by walking the block headers from \a offset up to \a end, skipping
+ checkpoints. Stops at the first block that does not decode, is incomplete or fails its checksum, which is
+ where a recording interrupted mid-write ends.
+ */
+void SessionReader::scanBlocks(qint64 offset, qint64 end)
+{
+    static_assert(recording::Checkpoint::SIZE == recording::BlockHeader::SIZE, "Headers are told apart by magic");
+    m_dataEnd = offset;
+
+    char raw[recording::BlockHeader::SIZE];
+    QByteArray payload;
+    while (offset + recording::BlockHeader::SIZE <= end && m_file.seek(offset) &&
+           m_file.read(raw, sizeof(raw)) == sizeof(raw))
+    {
+        recording::Checkpoint checkpoint;
+        if (recording::decode(raw, checkpoint))
+        {
+            const qint64 next = offset + recording::Checkpoint::SIZE +
+                                static_cast<qint64>(checkpoint.entry_count) * recording::IndexEntry::SIZE;
+            if (next > end)
+            {
+                break;
+            }
+            offset = next;
+            m_dataEnd = offset;
+            continue;
+        }
+
+        recording::BlockHeader header;
+        if (!recording::decode(raw, header))
+        {
+            break;
+        }
+
+        qint64 next = offset + recording::BlockHeader::SIZE + header.payload_size;
+        if (next > end)
+        {
+            break;
+        }
+
+        if (m_checksums)
+        {
+            payload.resize(static_cast<int>(header.payload_size));
+            if (m_file.read(payload.data(), payload.size()) != payload.size() ||
+                recording::checksum(header, payload.constData()) != header.crc)
+            {
+                break;
+            }
+        }
+
+        recording::IndexEntry entry;
+        entry.offset = static_cast<quint64>(offset);
+        entry.first_timestamp_us = header.first_timestamp_us;
+        entry.last_timestamp_us = header.last_timestamp_us;
+        entry.record_count = header.record_count;
+        m_index.push_back(entry);
+
+        offset = next;
+        m_dataEnd = offset;
+    }
+}
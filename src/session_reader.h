@@ -0,0 +1,124 @@
+/*!
+ * \file session_reader.h
+ * \brief Interface of a reader of the session recordings written by
+ * SessionRecorder.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SESSION_READER_H_
+#define GNSS_SDR_MONITOR_SESSION_READER_H_
+
+#include "recording_format.h"
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <vector>
+
+/*!
+ Datagram read back from a recording. \a data points into the reader's block
+ buffer and stays valid until the next block is loaded.
+ */
+struct RecordView
+{
+    qint64 timestamp_us = 0;
+    quint16 stream_id = 0;
+    const char *data = nullptr;
+    int size = 0;
+};
+
+/*!
+ Reads a recording block by block. The block index comes from the trailer;
+ recordings that were not closed properly are indexed from their latest
+ checkpoint plus a scan of the blocks written after it, stopping at the
+ first block that is incomplete or fails its checksum. Blocks that fail
+ their checksum later, while reading, are skipped.
+
+ Readers working on the same recording from several threads can share the
+ index of one of them with openShared(), so that it is built only once.
+ */
+class SessionReader
+{
+public:
+    bool open(const QString &path);
+    bool openShared(const SessionReader &indexed);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString fileName() const { return m_file.fileName(); }
+    QString errorString() const { return m_error; }
+
+    // True if the recording was not closed and its index had to be rebuilt.
+    bool isRecovered() const { return m_recovered; }
+    // File offset just past the last valid block or checkpoint, where the index starts once closed.
+    qint64 dataEnd() const { return m_dataEnd; }
+    bool hasChecksums() const { return m_checksums; }
+    quint64 corruptBlocks() const { return m_corruptBlocks; }
+
+    const std::vector<recording::IndexEntry> &index() const { return *m_blocks; }
+    qint64 firstTimestamp() const;
+    qint64 lastTimestamp() const;
+
+    // Positions the cursor on the first record of the first block that may contain \a timestamp_us.
+    void seek(qint64 timestamp_us);
+    void rewind() { seekBlock(0); }
+
+    // Reads the next record in file order. Returns false at the end of the recording.
+    bool next(RecordView &record);
+
+    // Loads block \a i into \a payload. Returns false if it is unreadable.
+    bool readBlock(size_t i, recording::BlockHeader &header, QByteArray &payload);
+
+    // File offset just past block \a i, or -1 if its header is unreadable.
+    qint64 blockEnd(size_t i);
+
+    // The recording file, for copying blocks without decoding them.
+    QFile *device() { return &m_file; }
+
+private:
+    bool loadIndex();
+    bool loadCheckpoints(quint64 offset, qint64 &scan_from);
+    void scanBlocks(qint64 offset, qint64 end);
+    void seekBlock(size_t i);
+
+    QFile m_file;
+    QString m_error;
+    std::vector<recording::IndexEntry> m_index;
+    const std::vector<recording::IndexEntry> *m_blocks = &m_index;  // m_index, or the one of the reader shared.
+    qint64 m_dataOffset = 0;  // First block.
+    qint64 m_dataEnd = 0;
+    bool m_recovered = false;
+    bool m_checksums = false;
+    quint64 m_corruptBlocks = 0;
+
+    size_t m_block = 0;       // Next block to load.
+    QByteArray m_payload;     // Current block.
+    int m_offset = 0;         // Read offset in m_payload.
+    quint32 m_remaining = 0;  // Records left in m_payload.
+};
+
+#endif  // GNSS_SDR_MONITOR_SESSION_READER_H_
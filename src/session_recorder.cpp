@@ -0,0 +1,383 @@
+/*!
+ * \file session_recorder.cpp
+ * \brief Implementation of a recorder that writes the raw datagrams of all
+ * monitored streams to a block-indexed session file.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "session_recorder.h"
+#include <QDebug>
+#include <QRunnable>
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+namespace
+{
+/*!
+ Copies \a size bytes at \a src_offset of \a src to \a dst_offset of \a dst, and leaves \a dst positioned after them.
+ On Linux the kernel copies the data, sharing the extents on file systems that support it.
+ */
+bool copyRange(QFile &src, qint64 src_offset, QFile &dst, qint64 dst_offset, qint64 size)
+{
+#ifdef Q_OS_LINUX
+    off64_t in = src_offset;
+    off64_t out = dst_offset;
+    while (size > 0)
+    {
+        ssize_t n = ::copy_file_range(src.handle(), &in, dst.handle(), &out, static_cast<size_t>(size), 0);
+        if (n <= 0)
+        {
+            // Not supported for this pair of files (EXDEV, ENOSYS, ...): copy the rest by hand.
+            break;
+        }
+        size -= n;
+    }
+    src_offset = in;
+    dst_offset = out;
+    if (size == 0)
+    {
+        return dst.seek(dst_offset);
+    }
+#endif
+
+    if (!src.seek(src_offset) || !dst.seek(dst_offset))
+    {
+        return false;
+    }
+
+    QByteArray buffer;
+    while (size > 0)
+    {
+        const qint64 chunk = std::min<qint64>(size, 1 << 20);
+        buffer = src.read(chunk);
+        if (buffer.size() != chunk || dst.write(buffer) != chunk)
+        {
+            return false;
+        }
+        size -= chunk;
+    }
+    return true;
+}
+
+#ifdef Q_OS_UNIX
+/*!
+ Waits until the checkpoint at \a offset and the blocks it covers are on disk, then points the file
+ header to it. Writes at a fixed position, so the recorder keeps appending to the same descriptor.
+ */
+class CheckpointSync : public QRunnable
+{
+public:
+    CheckpointSync(int fd, uint64_t offset) : m_fd(fd), m_offset(offset) {}
+
+    void run() override
+    {
+        char pointer[sizeof(uint64_t)];
+        recording::put<uint64_t>(pointer, m_offset);
+        if (::fsync(m_fd) != 0 ||
+            ::pwrite(m_fd, pointer, sizeof(pointer), recording::FileHeader::LAST_CHECKPOINT_POS) != sizeof(pointer))
+        {
+            qDebug() << "Cannot sync the recording checkpoint at" << m_offset;
+        }
+    }
+
+private:
+    int m_fd;
+    uint64_t m_offset;
+};
+#endif
+}  // namespace
+
+SessionRecorder::SessionRecorder()
+{
+    m_block.reserve(recording::TARGET_BLOCK_BYTES + recording::RecordHeader::SIZE + 65536);
+    m_syncPool.setMaxThreadCount(1);
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+/*!
+ Starts a new recording in the file at \a path, replacing any previous content.
+ */
+bool SessionRecorder::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << "Cannot open recording" << path << m_file.errorString();
+        return false;
+    }
+
+    char header[recording::FileHeader::SIZE];
+    recording::encode(recording::FileHeader(), header);
+    m_file.write(header, sizeof(header));
+
+    m_block.resize(0);
+    m_header = recording::BlockHeader();
+    m_index.clear();
+    m_checkpointed = 0;
+    m_lastCheckpoint = 0;
+    return true;
+}
+
+/*!
+ Writes the pending block, the block index and the trailer, and closes the file.
+ */
+void SessionRecorder::close()
+{
+    if (!m_file.isOpen())
+    {
+        return;
+    }
+
+    flushBlock();
+    writeIndex(m_file, m_index);
+    m_syncPool.waitForDone();
+    m_file.close();
+}
+
+/*!
+ Writes \a index and the trailer that points to it at the current position of \a file.
+ */
+bool SessionRecorder::writeIndex(QFileDevice &file, const std::vector<recording::IndexEntry> &index)
+{
+    recording::Trailer trailer;
+    trailer.index_offset = static_cast<uint64_t>(file.pos());
+    trailer.entry_count = static_cast<uint32_t>(index.size());
+
+    bool ok = true;
+    char entry[recording::IndexEntry::SIZE];
+    for (const recording::IndexEntry &e : index)
+    {
+        recording::encode(e, entry);
+        ok = ok && file.write(entry, sizeof(entry)) == sizeof(entry);
+    }
+
+    char tail[recording::Trailer::SIZE];
+    recording::encode(trailer, tail);
+    ok = ok && file.write(tail, sizeof(tail)) == sizeof(tail);
+    return ok && file.flush();
+}
+
+/*!
+ Appends the datagram \a data of \a size bytes received on stream \a stream_id at \a timestamp_us.
+ */
+void SessionRecorder::record(quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size)
+{
+    if (!m_file.isOpen() || size < 0)
+    {
+        return;
+    }
+
+    if (m_header.record_count > 0 &&
+        timestamp_us - m_header.first_timestamp_us > recording::MAX_BLOCK_SPAN_US)
+    {
+        flushBlock();
+    }
+
+    if (m_header.record_count == 0)
+    {
+        m_header.first_timestamp_us = timestamp_us;
+    }
+    m_header.last_timestamp_us = timestamp_us;
+    m_header.record_count++;
+
+    recording::RecordHeader record;
+    record.timestamp_us = timestamp_us;
+    record.stream_id = stream_id;
+    record.size = static_cast<uint32_t>(size);
+
+    int offset = m_block.size();
+    m_block.resize(offset + recording::RecordHeader::SIZE + static_cast<int>(size));
+    recording::encode(record, m_block.data() + offset);
+    std::memcpy(m_block.data() + offset + recording::RecordHeader::SIZE, data, static_cast<size_t>(size));
+
+    if (static_cast<uint32_t>(m_block.size()) >= recording::TARGET_BLOCK_BYTES)
+    {
+        flushBlock();
+    }
+}
+
+/*!
+ Appends blocks [\a first, \a last) of \a reader byte for byte after the pending records.
+ Adjacent blocks are copied in a single call, so a long run of blocks costs a few system calls.
+ Blocks of recordings without checksums are read and written again with one.
+ */
+bool SessionRecorder::copyBlocks(SessionReader &reader, size_t first, size_t last)
+{
+    const std::vector<recording::IndexEntry> &index = reader.index();
+    if (!m_file.isOpen() || last > index.size())
+    {
+        return false;
+    }
+
+    flushBlock();
+    if (!reader.hasChecksums())
+    {
+        recording::BlockHeader header;
+        QByteArray payload;
+        for (size_t i = first; i < last; i++)
+        {
+            if (!reader.readBlock(i, header, payload))
+            {
+                return false;
+            }
+            writeBlock(header, payload.constData());
+        }
+        return true;
+    }
+
+    while (first < last)
+    {
+        // Extend the run while the next block starts where the previous one ends.
+        size_t end = first;
+        qint64 end_offset = reader.blockEnd(end);
+        while (end_offset >= 0 && end + 1 < last && static_cast<qint64>(index[end + 1].offset) == end_offset)
+        {
+            end_offset = reader.blockEnd(++end);
+        }
+        if (end_offset < 0)
+        {
+            return false;
+        }
+
+        const qint64 begin = static_cast<qint64>(index[first].offset);
+        const qint64 destination = m_file.pos();
+        if (!m_file.flush() || !copyRange(*reader.device(), begin, m_file, destination, end_offset - begin))
+        {
+            return false;
+        }
+
+        for (size_t i = first; i <= end; i++)
+        {
+            recording::IndexEntry entry = index[i];
+            entry.offset = static_cast<uint64_t>(destination + (static_cast<qint64>(entry.offset) - begin));
+            m_index.push_back(entry);
+        }
+        first = end + 1;
+        checkpointIfDue();
+    }
+    return true;
+}
+
+void SessionRecorder::flushBlock()
+{
+    if (m_header.record_count == 0)
+    {
+        return;
+    }
+
+    m_header.payload_size = static_cast<uint32_t>(m_block.size());
+    writeBlock(m_header, m_block.constData());
+
+    m_block.resize(0);
+    m_header = recording::BlockHeader();
+}
+
+/*!
+ Writes a block with its checksum and adds it to the index.
+ */
+void SessionRecorder::writeBlock(recording::BlockHeader header, const char *payload)
+{
+    header.crc = recording::checksum(header, payload);
+
+    recording::IndexEntry entry;
+    entry.offset = static_cast<uint64_t>(m_file.pos());
+    entry.first_timestamp_us = header.first_timestamp_us;
+    entry.last_timestamp_us = header.last_timestamp_us;
+    entry.record_count = header.record_count;
+    m_index.push_back(entry);
+
+    char raw[recording::BlockHeader::SIZE];
+    recording::encode(header, raw);
+    m_file.write(raw, sizeof(raw));
+    m_file.write(payload, header.payload_size);
+    m_file.flush();
+
+    checkpointIfDue();
+}
+
+/*!
+ Writes a checkpoint once CHECKPOINT_BLOCKS blocks or CHECKPOINT_SPAN_US of records have been written since
+ the previous one, so that a recording that is never closed can be indexed without scanning all of it.
+ */
+void SessionRecorder::checkpointIfDue()
+{
+    const size_t pending = m_index.size() - m_checkpointed;
+    if (pending == 0 ||
+        (pending < recording::CHECKPOINT_BLOCKS &&
+            m_index.back().last_timestamp_us - m_index[m_checkpointed].first_timestamp_us < recording::CHECKPOINT_SPAN_US))
+    {
+        return;
+    }
+
+    recording::Checkpoint checkpoint;
+    checkpoint.entry_count = static_cast<uint32_t>(pending);
+    checkpoint.previous = m_lastCheckpoint;
+
+    QByteArray entries(static_cast<int>(pending) * recording::IndexEntry::SIZE, '\0');
+    for (size_t i = 0; i < pending; i++)
+    {
+        recording::encode(m_index[m_checkpointed + i], entries.data() + i * recording::IndexEntry::SIZE);
+    }
+    checkpoint.crc = recording::checksum(checkpoint, entries.constData());
+
+    const qint64 offset = m_file.pos();
+    char raw[recording::Checkpoint::SIZE];
+    recording::encode(checkpoint, raw);
+    m_file.write(raw, sizeof(raw));
+    m_file.write(entries);
+    m_file.flush();
+
+#ifdef Q_OS_UNIX
+    // Only point the file header to the checkpoint once it and the blocks it covers are on disk.
+    m_syncPool.start(new CheckpointSync(m_file.handle(), static_cast<uint64_t>(offset)));
+#else
+    char pointer[sizeof(uint64_t)];
+    recording::put<uint64_t>(pointer, static_cast<uint64_t>(offset));
+    const qint64 end = m_file.pos();
+    if (m_file.seek(recording::FileHeader::LAST_CHECKPOINT_POS))
+    {
+        m_file.write(pointer, sizeof(pointer));
+    }
+    m_file.seek(end);
+    m_file.flush();
+#endif
+
+    m_lastCheckpoint = static_cast<uint64_t>(offset);
+    m_checkpointed = m_index.size();
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file session_recorder.h
+ * \brief Interface of a recorder that writes the raw datagrams of all
+ * monitored streams to a block-indexed session file.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SESSION_RECORDER_H_
+#define GNSS_SDR_MONITOR_SESSION_RECORDER_H_
+
+#include "recording_format.h"
+#include "session_reader.h"
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QThreadPool>
+#include <vector>
+
+/*!
+ Writes the datagrams received on every stream to a recording file.
+
+ Records are accumulated in memory and written one block at a time, either
+ when the block reaches TARGET_BLOCK_BYTES or when it spans more than
+ MAX_BLOCK_SPAN_US, so the cost per datagram is a memcpy. Whole blocks of
+ another recording can also be appended as they are, without decoding them.
+ Each block carries a CRC-32C, and an index checkpoint is written every few
+ hundred blocks or seconds so that a recording cut short by a crash can be
+ indexed quickly. A worker thread waits for each checkpoint to reach the
+ disk before pointing the file header to it, so that the caller never blocks
+ on the disk. The block index and trailer are written when the recording is
+ closed.
+ */
+class SessionRecorder
+{
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+
+    bool open(const QString &path);
+    void close();
+    bool isRecording() const { return m_file.isOpen(); }
+    QString fileName() const { return m_file.fileName(); }
+    QString errorString() const { return m_file.errorString(); }
+
+    void record(quint16 stream_id, qint64 timestamp_us, const char *data, qint64 size);
+    bool copyBlocks(SessionReader &reader, size_t first, size_t last);
+
+    static bool writeIndex(QFileDevice &file, const std::vector<recording::IndexEntry> &index);
+
+private:
+    void flushBlock();
+    void writeBlock(recording::BlockHeader header, const char *payload);
+    void checkpointIfDue();
+
+    QFile m_file;
+    QByteArray m_block;
+    recording::BlockHeader m_header;
+    std::vector<recording::IndexEntry> m_index;
+    size_t m_checkpointed = 0;  // Index entries covered by the checkpoints.
+    uint64_t m_lastCheckpoint = 0;
+    QThreadPool m_syncPool;  // Syncs the checkpoints and updates the header, one at a time.
+};
+
+#endif  // GNSS_SDR_MONITOR_SESSION_RECORDER_H_
@@ -0,0 +1,352 @@
+/*!
+ * \file session_state.cpp
+ * \brief Implementation of the snapshots of the monitor state kept across restarts.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "session_state.h"
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+constexpr quint32 SAVE_MAGIC = 0x47534D53;  // "GSMS"
+constexpr quint32 SAVE_VERSION = 2;         // 2: the channels keep their Doppler residual history.
+
+void writeSeries(QDataStream &out, const std::vector<double> &values)
+{
+    out << static_cast<quint32>(values.size());
+    for (double value : values)
+    {
+        out << value;
+    }
+}
+
+bool readSeries(QDataStream &in, std::vector<double> &values)
+{
+    quint32 count = 0;
+    in >> count;
+    // Eight bytes per value, so a count beyond what is left can only come from a corrupt file.
+    if (in.status() != QDataStream::Ok || count > (in.device()->bytesAvailable() / 8))
+    {
+        return false;
+    }
+    values.resize(count);
+    for (double &value : values)
+    {
+        in >> value;
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+template <typename Message>
+bool readMessage(QDataStream &in, Message &message)
+{
+    QByteArray bytes;
+    in >> bytes;
+    return in.status() == QDataStream::Ok && message.ParseFromArray(bytes.constData(), bytes.size());
+}
+
+/*!
+ Serializes one snapshot and replaces the state file, off the GUI thread.
+ */
+class SessionWriter : public QRunnable
+{
+public:
+    SessionWriter(SessionState::Snapshot snapshot, const QString &path,
+        std::atomic<bool> &busy, std::atomic<quint64> &written)
+        : m_snapshot(std::move(snapshot)), m_path(path), m_busy(busy), m_written(written)
+    {
+    }
+
+    void run() override
+    {
+        // QSaveFile writes to a temporary file and renames it over the old one on commit.
+        QSaveFile file(m_path);
+        if (file.open(QIODevice::WriteOnly))
+        {
+            if (file.write(SessionState::encode(m_snapshot)) < 0)
+            {
+                file.cancelWriting();
+            }
+            if (file.commit())
+            {
+                m_written++;
+            }
+        }
+        if (file.error() != QFileDevice::NoError)
+        {
+            qDebug() << "Cannot write the session state" << m_path << file.errorString();
+        }
+        m_busy = false;
+    }
+
+private:
+    SessionState::Snapshot m_snapshot;
+    QString m_path;
+    std::atomic<bool> &m_busy;
+    std::atomic<quint64> &m_written;
+};
+}  // namespace
+
+/*!
+ Returns the file of the session state in the application data directory.
+ */
+QString SessionState::defaultPath()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("session_state.bin");
+}
+
+/*!
+ Serializes \a snapshot. The header is left uncompressed so that the format can be told before inflating the rest.
+ */
+QByteArray SessionState::encode(const Snapshot &snapshot)
+{
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out << snapshot.savedMs;
+    out << snapshot.time.hasReference << snapshot.time.weekKnown << snapshot.time.referenceWeek
+        << snapshot.time.currentWeek << snapshot.time.lastTow;
+
+    out << static_cast<quint32>(snapshot.ephemerides.size());
+    for (const auto &ephemeris : snapshot.ephemerides)
+    {
+        out << ephemeris.first << QByteArray::fromStdString(ephemeris.second);
+    }
+
+    out << static_cast<quint32>(snapshot.pvt.size());
+    for (const gnss_sdr::MonitorPvt &pvt : snapshot.pvt)
+    {
+        out << QByteArray::fromStdString(pvt.SerializeAsString());
+    }
+
+    out << static_cast<quint32>(snapshot.channels.size());
+    for (const ChannelTableModel::ChannelState &channel : snapshot.channels)
+    {
+        out << QByteArray::fromStdString(channel.channel.SerializeAsString());
+        for (const auto &series : channel.series)
+        {
+            writeSeries(out, series.time);
+            writeSeries(out, series.values[0]);
+            writeSeries(out, series.values[1]);
+        }
+    }
+
+    QByteArray data;
+    QDataStream header(&data, QIODevice::WriteOnly);
+    header << SAVE_MAGIC << SAVE_VERSION;
+    data.append(qCompress(payload));
+    return data;
+}
+
+/*!
+ Reads a snapshot serialized by encode(). Returns false if \a data is not a valid snapshot of this version.
+ */
+bool SessionState::decode(const QByteArray &data, Snapshot &snapshot)
+{
+    snapshot = Snapshot();
+
+    QDataStream header(data);
+    quint32 magic = 0;
+    quint32 version = 0;
+    header >> magic >> version;
+    if (header.status() != QDataStream::Ok || magic != SAVE_MAGIC || version != SAVE_VERSION)
+    {
+        return false;
+    }
+
+    const int header_size = static_cast<int>(sizeof(magic) + sizeof(version));
+    const QByteArray payload = qUncompress(data.mid(header_size));
+    if (payload.isEmpty())
+    {
+        return false;
+    }
+
+    QDataStream in(payload);
+    in >> snapshot.savedMs;
+    in >> snapshot.time.hasReference >> snapshot.time.weekKnown >> snapshot.time.referenceWeek >>
+        snapshot.time.currentWeek >> snapshot.time.lastTow;
+
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        quint16 stream_id = 0;
+        QByteArray bytes;
+        in >> stream_id >> bytes;
+        snapshot.ephemerides.emplace_back(stream_id, bytes.toStdString());
+    }
+
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        gnss_sdr::MonitorPvt pvt;
+        if (!readMessage(in, pvt))
+        {
+            return false;
+        }
+        snapshot.pvt.push_back(std::move(pvt));
+    }
+
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        ChannelTableModel::ChannelState channel;
+        if (!readMessage(in, channel.channel))
+        {
+            return false;
+        }
+        for (auto &series : channel.series)
+        {
+            if (!readSeries(in, series.time) || !readSeries(in, series.values[0]) || !readSeries(in, series.values[1]))
+            {
+                return false;
+            }
+        }
+        snapshot.channels.push_back(std::move(channel));
+    }
+
+    return in.status() == QDataStream::Ok;
+}
+
+SessionState::SessionState(QObject *parent)
+    : QObject(parent), m_path(defaultPath()), m_busy(false), m_written(0), m_skipped(0)
+{
+    // A single worker keeps the snapshots in order and bounds the work in flight to one.
+    m_pool.setMaxThreadCount(1);
+
+    // Not on the monitor clock: the state is saved on the wall clock, replay or not.
+    m_timer.setInterval(DEFAULT_INTERVAL_MS);
+    m_timer.setSingleShot(false);
+    connect(&m_timer, &ClockTimer::timeout, this, &SessionState::save);
+}
+
+SessionState::~SessionState()
+{
+    m_timer.stop();
+    m_pool.waitForDone();
+}
+
+/*!
+ Keeps \a ephemeris of satellite \a prn, received on stream \a stream_id, for the next snapshots.
+ */
+void SessionState::keepEphemeris(quint16 stream_id, int prn, const google::protobuf::MessageLite &ephemeris)
+{
+    ephemeris.SerializeToString(&m_ephemerides[{stream_id, prn}]);
+}
+
+/*!
+ Reads the state file into \a snapshot. Returns false if it cannot be read or is not a valid
+ snapshot, and also, leaving the error string empty, if there is no state file yet.
+ */
+bool SessionState::load(Snapshot &snapshot)
+{
+    m_error.clear();
+
+    QFile file(m_path);
+    if (!file.exists())
+    {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        m_error = "Cannot read the session state " + m_path + ": " + file.errorString();
+        return false;
+    }
+    if (!decode(file.readAll(), snapshot))
+    {
+        m_error = "Invalid session state " + m_path;
+        return false;
+    }
+    return true;
+}
+
+void SessionState::start()
+{
+    if (!m_path.isEmpty())
+    {
+        QDir().mkpath(QFileInfo(m_path).absolutePath());
+    }
+    m_timer.start();
+}
+
+void SessionState::stop()
+{
+    m_timer.stop();
+}
+
+/*!
+ Copies the state through the provider and hands it to the worker thread to be written.
+ Skipped if the previous snapshot is still being written.
+ */
+void SessionState::save()
+{
+    if (!m_provider || m_path.isEmpty())
+    {
+        return;
+    }
+
+    if (m_busy.exchange(true))
+    {
+        m_skipped++;
+        return;
+    }
+
+    Snapshot snapshot;
+    if (!m_provider(snapshot))
+    {
+        m_busy = false;
+        return;
+    }
+    snapshot.savedMs = QDateTime::currentMSecsSinceEpoch();
+    snapshot.ephemerides.reserve(m_ephemerides.size());
+    for (const auto &ephemeris : m_ephemerides)
+    {
+        snapshot.ephemerides.emplace_back(ephemeris.first.first, ephemeris.second);
+    }
+
+    m_pool.start(new SessionWriter(std::move(snapshot), m_path, m_busy, m_written));
+}
+
+/*!
+ Writes a last snapshot and waits until it is on disk, for when the monitor quits.
+ */
+void SessionState::saveAndWait()
+{
+    m_pool.waitForDone();
+    save();
+    m_pool.waitForDone();
+}
@@ -0,0 +1,124 @@
+/*!
+ * \file session_state.h
+ * \brief Interface of the snapshots of the monitor state kept across restarts.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SESSION_STATE_H_
+#define GNSS_SDR_MONITOR_SESSION_STATE_H_
+
+#include "channel_table_model.h"
+#include "gnss_time.h"
+#include "monitor_clock.h"
+#include "monitor_pvt.pb.h"
+#include <google/protobuf/message_lite.h>
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+ Saves the state of the monitor to a file every interval and reads it back
+ at startup, so that a restart shows the previous channels, histories,
+ ephemerides and PVT at once instead of empty views.
+
+ The state is copied on the GUI thread and handed to a worker thread, which
+ serializes it into a compressed binary file and replaces the old one
+ atomically. When the worker is still busy with the previous snapshot the
+ next one is skipped instead of queued. Loading is a single read and is
+ meant to be done before the first frame.
+
+ The latest ephemeris of each satellite is kept here as it arrives, already
+ serialized, as the views only keep what they draw.
+ */
+class SessionState : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Snapshot
+    {
+        qint64 savedMs = 0;  // Wall time of the capture [ms since the Unix epoch]
+        GnssTime::State time;
+        std::vector<std::pair<quint16, std::string>> ephemerides;  // Stream id and serialized message.
+        std::vector<gnss_sdr::MonitorPvt> pvt;                     // Oldest first.
+        std::vector<ChannelTableModel::ChannelState> channels;
+    };
+
+    // Fills the snapshot on the GUI thread. Returns false to skip it, e.g. during a replay.
+    using Provider = std::function<bool(Snapshot &snapshot)>;
+
+    static constexpr int DEFAULT_INTERVAL_MS = 10000;
+
+    static QString defaultPath();
+    static QByteArray encode(const Snapshot &snapshot);
+    static bool decode(const QByteArray &data, Snapshot &snapshot);
+
+    explicit SessionState(QObject *parent = nullptr);
+    ~SessionState();
+
+    void setPath(const QString &path) { m_path = path; }
+    QString path() const { return m_path; }
+    void setProvider(Provider provider) { m_provider = std::move(provider); }
+    void setInterval(int milliseconds) { m_timer.setInterval(milliseconds); }
+
+    void keepEphemeris(quint16 stream_id, int prn, const google::protobuf::MessageLite &ephemeris);
+    void clearEphemerides() { m_ephemerides.clear(); }
+
+    bool load(Snapshot &snapshot);
+    QString errorString() const { return m_error; }
+    quint64 written() const { return m_written; }
+    quint64 skipped() const { return m_skipped; }
+
+public slots:
+    void start();
+    void stop();
+    void save();
+    void saveAndWait();
+
+private:
+    QString m_path;
+    QString m_error;
+    Provider m_provider;
+    std::map<std::pair<quint16, int>, std::string> m_ephemerides;
+
+    ClockTimer m_timer;
+    QThreadPool m_pool;
+    std::atomic<bool> m_busy;
+    std::atomic<quint64> m_written;
+    quint64 m_skipped;
+};
+
+#endif  // GNSS_SDR_MONITOR_SESSION_STATE_H_
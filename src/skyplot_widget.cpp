@@ -31,12 +31,16 @@
  */
 
 #include "skyplot_widget.h"
+#include "gnss_time.h"
 #include <QPaintEvent>
 #include <QPainter>
 #include <QMouseEvent>
 #include <QFontMetrics>
 //#include <QDebug>
 #include <QToolTip>
+#include <QActionGroup>
+#include <QContextMenuEvent>
+#include <QMenu>
 #include <cmath>
 #include <algorithm>
 
@@ -48,9 +52,9 @@
 SatelliteInfo::SatelliteInfo()
     : prn(0), channel_id(-1), elevation(0.0), azimuth(0.0), 
       positionSource(PositionSource::NONE), cn0(0.0), valid(false),
+      hasCn0Deviation(false), cn0Deviation(0.0), expectedCn0(0.0), unhealthy(false),
       seenInThisUpdate(false), missedUpdates(0), highlighted(false)
 {
-    lastSeen = QDateTime::currentDateTime();
 }
 
 bool SatelliteInfo::isPositionValid() const
@@ -82,24 +86,32 @@ QString SatelliteInfo::getStatusString() const
         default: posSource = "Unknown"; break;
     }
     
-    return QString("PRN %1 (%2)\nEl: %3° Az: %4°\nCN0: %5 dB-Hz\nPos: %6\nValid: %7")
+    QString expected = hasCn0Deviation
+        ? QString("%1 dB-Hz (%2%3 dB)").arg(expectedCn0, 0, 'f', 1).arg(cn0Deviation >= 0.0 ? "+" : "").arg(cn0Deviation, 0, 'f', 1)
+        : QString("Not learned yet");
+
+    return QString("PRN %1 (%2)\nEl: %3° Az: %4°\nCN0: %5 dB-Hz\nExpected: %6\nPos: %7\nValid: %8\nHealth: %9")
            .arg(prn)
            .arg(getSystemName())
            .arg(elevation, 0, 'f', 1)
            .arg(azimuth, 0, 'f', 1)
            .arg(cn0, 0, 'f', 1)
+           .arg(expected)
            .arg(posSource)
-           .arg(valid ? "Yes" : "No");
+           .arg(valid ? "Yes" : "No")
+           .arg(unhealthy ? "Unhealthy" : (system == "G" ? "OK" : "Unknown"));
 }
 
 // SkyPlotWidget Implementation
 SkyPlotWidget::SkyPlotWidget(QWidget *parent) 
-    : QWidget(parent), m_needsUpdate(false), m_maxMissedUpdates(DEFAULT_MAX_MISSED_UPDATES),
-      m_receiverLat(0.0), m_receiverLon(0.0), m_receiverHeight(0.0), 
-      m_currentGpsTime(0.0), m_hasReceiverPosition(false),
+    : QWidget(parent), m_staticLayerDpr(0.0), m_clock(nullptr), m_needsUpdate(false), m_maxMissedUpdates(DEFAULT_MAX_MISSED_UPDATES),
+      m_receiverLat(0.0), m_receiverLon(0.0), m_receiverHeight(0.0),
+      m_currentGpsTime(0.0), m_currentGpsWeek(0), m_hasReceiverPosition(false), m_ephemerisStore(nullptr), m_cn0Model(nullptr),
+      m_satelliteHealth(nullptr),
       m_totalSatellites(0), m_satellitesWithRealPos(0), 
       m_satellitesWithComputedPos(0), m_satellitesWithFallbackPos(0),
-      m_hoveredSatellite(nullptr), m_selectedSatellite(nullptr), m_showDebugInfo(false)
+      m_hoveredSatellite(nullptr), m_selectedSatellite(nullptr), m_showDebugInfo(false),
+      m_colorMode(ColorMode::System)
 {
     setMinimumSize(MIN_WIDGET_SIZE, MIN_WIDGET_SIZE);
     setMouseTracking(true);
@@ -107,7 +119,7 @@ SkyPlotWidget::SkyPlotWidget(QWidget *parent)
     // Set up update timer
     m_updateTimer.setInterval(DEFAULT_UPDATE_INTERVAL);
     m_updateTimer.setSingleShot(true);
-    connect(&m_updateTimer, &QTimer::timeout, [this]() {
+    connect(&m_updateTimer, &ClockTimer::timeout, [this]() {
         if (m_needsUpdate) {
             cleanupStaleSatellites();
             update();
@@ -118,45 +130,33 @@ SkyPlotWidget::SkyPlotWidget(QWidget *parent)
     //qDebug() << "SkyPlotWidget initialized";
 }
 
-void SkyPlotWidget::updateReceiverPosition(const gnss_sdr::MonitorPvt &monitor_pvt)
+void SkyPlotWidget::setClock(MonitorClock *clock)
+{
+    m_clock = clock;
+    m_updateTimer.setClock(clock);
+}
+
+void SkyPlotWidget::updateReceiverPosition(const PvtSnapshot &pvt)
 {
-    double newLat = monitor_pvt.latitude();
-    double newLon = monitor_pvt.longitude();
-    double newHeight = monitor_pvt.height();
-    double newTime = monitor_pvt.rx_time();
+    double newLat = pvt.latitude;
+    double newLon = pvt.longitude;
+    double newHeight = pvt.height;
+    double newTime = pvt.rx_time;
     
     // Check for valid GPS coordinates
-    bool validPosition = (newLat >= -90.0 && newLat <= 90.0 &&
-                          newLon >= -180.0 && newLon <= 180.0 &&
-                          (std::abs(newLat) > 0.001 || std::abs(newLon) > 0.001));
-
-    if (validPosition) {
-        bool positionChanged = (!m_hasReceiverPosition || 
-                               std::abs(m_receiverLat - newLat) > 1e-6 ||
-                               std::abs(m_receiverLon - newLon) > 1e-6);
-        
+    if (pvt.hasValidPosition()) {
         m_receiverLat = newLat;
         m_receiverLon = newLon;
         m_receiverHeight = newHeight;
         m_currentGpsTime = newTime;
+        m_currentGpsWeek = pvt.week;
         m_hasReceiverPosition = true;
-        m_lastReceiverUpdate = QDateTime::currentDateTime();
-        
-        if (positionChanged) {
-            //qDebug() << "Receiver position updated:" << m_receiverLat << m_receiverLon;
-            
-            // Recompute positions for satellites using computed positions
-            for (auto &pair : m_satellites) {
-                SatelliteInfo &sat = *pair.second;
-                if (sat.positionSource == PositionSource::COMPUTED || 
-                    sat.positionSource == PositionSource::FALLBACK) {
-                    double elevation, azimuth;
-                    computeApproximatePosition(gnss_sdr::GnssSynchro(), elevation, azimuth);
-                    // We'd need to store the original GnssSynchro data to recompute properly
-                    // For now, positions will be updated on next satellite update
-                }
-            }
-        }
+        m_lastReceiverUpdate = QDateTime::fromMSecsSinceEpoch(clockNowMs(m_clock));
+
+        // Local frame used to turn satellite positions into azimuth and elevation.
+        m_receiverFrame = geodesy::LocalFrame::at(m_receiverLat, m_receiverLon, m_receiverHeight);
+
+        // Computed positions are refreshed on the next satellite update.
     }
     
     scheduleUpdate();
@@ -169,13 +169,15 @@ void SkyPlotWidget::updateSatellites(const gnss_sdr::Observables &observables)
         pair.second->seenInThisUpdate = false;
     }
     
+    computeEphemerisPositions(observables);
+
     // Process each observable
     for (int i = 0; i < observables.observable_size(); i++) {
         const gnss_sdr::GnssSynchro &obs = observables.observable(i);
         
         // Only process valid channels (fs != 0 indicates active channel)
         if (obs.fs() != 0) {
-            processSatellite(obs);
+            processSatellite(obs, i);
         }
     }
     
@@ -201,7 +203,7 @@ void SkyPlotWidget::updateSatellites(const gnss_sdr::Observables &observables)
     scheduleUpdate();
 }
 
-void SkyPlotWidget::processSatellite(const gnss_sdr::GnssSynchro &obs)
+void SkyPlotWidget::processSatellite(const gnss_sdr::GnssSynchro &obs, int index)
 {
     int channel_id = obs.channel_id();
     
@@ -233,7 +235,8 @@ void SkyPlotWidget::processSatellite(const gnss_sdr::GnssSynchro &obs)
     sat.valid = obs.flag_valid_symbol_output();
     sat.seenInThisUpdate = true;
     sat.missedUpdates = 0;
-    sat.lastSeen = QDateTime::currentDateTime();
+    sat.lastSeen = QDateTime::fromMSecsSinceEpoch(clockNowMs(m_clock));
+    sat.unhealthy = m_satelliteHealth && m_satelliteHealth->isUnhealthy(sat.system, sat.prn);
     
     // Determine position source and update position
     double elevation = 0.0, azimuth = 0.0;
@@ -247,9 +250,8 @@ void SkyPlotWidget::processSatellite(const gnss_sdr::GnssSynchro &obs)
             //          << "El:" << elevation << "Az:" << azimuth;
         }
     }
-    // Try computed position if we have receiver position
-    else if (m_hasReceiverPosition) {
-        computeApproximatePosition(obs, elevation, azimuth);
+    // Try the broadcast ephemeris if we have receiver position
+    else if (ephemerisPosition(index, elevation, azimuth)) {
         newPositionSource = PositionSource::COMPUTED;
     }
     // Fall back to pattern-based position
@@ -270,6 +272,15 @@ void SkyPlotWidget::processSatellite(const gnss_sdr::GnssSynchro &obs)
         sat.azimuth = azimuth;
         sat.positionSource = PositionSource::FALLBACK;
     }
+
+    // The model is fed on the ingest, before this update.
+    sat.hasCn0Deviation = false;
+    Cn0ElevationModel::Deviation deviation;
+    if (m_cn0Model && m_cn0Model->deviation(channel_id, deviation)) {
+        sat.hasCn0Deviation = true;
+        sat.cn0Deviation = deviation.deviation;
+        sat.expectedCn0 = deviation.expected;
+    }
 }
 
 bool SkyPlotWidget::extractRealPosition(const gnss_sdr::GnssSynchro &obs, 
@@ -296,13 +307,54 @@ bool SkyPlotWidget::extractRealPosition(const gnss_sdr::GnssSynchro &obs,
     return false;
 }
 
-void SkyPlotWidget::computeApproximatePosition(const gnss_sdr::GnssSynchro &obs, 
-                                             double &elevation, double &azimuth)
+void SkyPlotWidget::computeEphemerisPositions(const gnss_sdr::Observables &observables)
 {
-    elevation = computeSatelliteElevation(obs.prn(), obs.system(), 
-                                        m_receiverLat, m_receiverLon, obs.rx_time());
-    azimuth = computeSatelliteAzimuth(obs.prn(), obs.system(), 
-                                    m_receiverLat, m_receiverLon, obs.rx_time());
+    EphemerisBatch &batch = m_ephemerisBatch;
+    batch.slot.assign(observables.observable_size(), -1);
+    batch.x.clear();
+    batch.y.clear();
+    batch.z.clear();
+    if (!m_hasReceiverPosition || !m_ephemerisStore) {
+        return;
+    }
+
+    // All channels of one Observables message share the same receiver time,
+    // so the store propagates each constellation once per message.
+    for (int i = 0; i < observables.observable_size(); i++) {
+        const gnss_sdr::GnssSynchro &obs = observables.observable(i);
+        double elevation, azimuth;
+        if (obs.fs() == 0 || extractRealPosition(obs, elevation, azimuth)) {
+            continue;
+        }
+
+        EcefPosition sat;
+        double gpsSeconds = GnssTime::gpsSeconds(m_currentGpsWeek, obs.rx_time());
+        if (m_ephemerisStore->position(obs.system(), obs.prn(), gpsSeconds, sat)) {
+            batch.slot[i] = static_cast<int>(batch.x.size());
+            batch.x.push_back(sat.x);
+            batch.y.push_back(sat.y);
+            batch.z.push_back(sat.z);
+        }
+    }
+
+    batch.azimuth.resize(batch.x.size());
+    batch.elevation.resize(batch.x.size());
+    geodesy::lookAngles(m_receiverFrame, batch.x.data(), batch.y.data(), batch.z.data(), batch.x.size(),
+                        batch.azimuth.data(), batch.elevation.data());
+}
+
+bool SkyPlotWidget::ephemerisPosition(int index, double &elevation, double &azimuth) const
+{
+    const EphemerisBatch &batch = m_ephemerisBatch;
+    if (index < 0 || index >= static_cast<int>(batch.slot.size()) || batch.slot[index] < 0) {
+        return false;
+    }
+
+    elevation = batch.elevation[batch.slot[index]];
+    azimuth = batch.azimuth[batch.slot[index]];
+
+    // A tracked satellite below the horizon points at a stale ephemeris.
+    return elevation >= 0.0;
 }
 
 void SkyPlotWidget::computeFallbackPosition(const gnss_sdr::GnssSynchro &obs, 
@@ -391,8 +443,7 @@ void SkyPlotWidget::paintEvent(QPaintEvent *event)
     m_plotArea.setSize(QSize(plotSize, plotSize));
     
     // Draw components
-    drawBackground(painter);
-    drawGrid(painter, m_plotArea);
+    drawStaticLayer(painter);
     drawSatellites(painter, m_plotArea);
     drawLegend(painter, m_legendArea);
     
@@ -401,6 +452,29 @@ void SkyPlotWidget::paintEvent(QPaintEvent *event)
     }
 }
 
+void SkyPlotWidget::drawStaticLayer(QPainter &painter)
+{
+    // The background and the grid only depend on the geometry, so they are drawn once into
+    // an image that every repaint and offscreen snapshot then blits.
+    const qreal dpr = painter.device()->devicePixelRatioF();
+    if (m_staticLayer.isNull() || m_staticLayerArea != m_plotArea || m_staticLayerDpr != dpr ||
+        m_staticLayer.size() != size() * dpr) {
+        m_staticLayer = QImage(size() * dpr, QImage::Format_ARGB32_Premultiplied);
+        m_staticLayer.setDevicePixelRatio(dpr);
+        m_staticLayer.fill(Qt::transparent);
+
+        QPainter layer(&m_staticLayer);
+        layer.setRenderHint(QPainter::Antialiasing, true);
+        layer.setFont(font());
+        drawBackground(layer);
+        drawGrid(layer, m_plotArea);
+
+        m_staticLayerArea = m_plotArea;
+        m_staticLayerDpr = dpr;
+    }
+    painter.drawImage(QPointF(0, 0), m_staticLayer);
+}
+
 void SkyPlotWidget::drawBackground(QPainter &painter)
 {
     painter.fillRect(rect(), QColor(248, 248, 248));
@@ -495,13 +569,16 @@ void SkyPlotWidget::drawSatellites(QPainter &painter, const QRect &plotArea)
         
         QPointF pos = polarToCartesian(sat.elevation, sat.azimuth, plotArea);
         QColor color = getSystemColor(sat.system);
+        if (m_colorMode == ColorMode::Cn0Deviation) {
+            color = sat.hasCn0Deviation ? getDeviationColor(sat.cn0Deviation) : QColor(160, 160, 160);
+        }
         
         // Adjust appearance based on signal quality and status
         int radius = m_plotArea.width() / 2;
         int satSize = getSatelliteSize(sat.cn0, radius);
         
         // Dim satellites with poor signal or invalid tracking
-        if (!sat.valid || sat.cn0 < 25.0) {
+        if (!sat.valid || (m_colorMode == ColorMode::System && sat.cn0 < 25.0)) {
             color = color.lighter(150);
         }
         
@@ -540,6 +617,13 @@ void SkyPlotWidget::drawSatellites(QPainter &painter, const QRect &plotArea)
         painter.setBrush(satBrush); // Set the pen and brush
         painter.drawEllipse(pos, satSize/2, satSize/2);
         
+        // Ring the satellites that their ephemeris flags as unusable
+        if (sat.unhealthy) {
+            painter.setPen(QPen(QColor(200, 0, 0), 2));
+            painter.setBrush(Qt::NoBrush);
+            painter.drawEllipse(pos, satSize/2 + 4, satSize/2 + 4);
+        }
+        
         // Draw PRN number
         QFont font = painter.font();
         font.setPointSize(7);
@@ -575,28 +659,54 @@ void SkyPlotWidget::drawLegend(QPainter &painter, const QRect &legendArea)
     int y = legendArea.y() + 15;
     int x = legendArea.x() + 8;
     
-    // GNSS Systems
-    painter.drawText(x, y, "GNSS Systems:");
-    y += 20;
-    
     QFont normalFont = painter.font();
     normalFont.setPointSize(8);
     normalFont.setBold(false);
-    painter.setFont(normalFont);
     
-    std::map<std::string, QString> systemNames = {
-        {"G", "GPS"}, {"U", "Unknown"}, {"E", "Galileo"}, {"R", "GLONASS"}, {"C", "BeiDou"}
-    };
-    
-    for (const auto &sys : systemNames) {
-        QColor color = getSystemColor(sys.first);
-        painter.setBrush(QBrush(color));
-        painter.setPen(QPen(color.darker(150), 1));
-        painter.drawEllipse(x + 2, y - 6, 8, 8);
+    if (m_colorMode == ColorMode::Cn0Deviation) {
+        // C/N0 relative to the one expected at the same elevation
+        painter.drawText(x, y, "C/N0 vs Expected:");
+        y += 20;
+        painter.setFont(normalFont);
         
+        const std::pair<double, const char *> steps[] = {
+            {0.0, "0 dB or better"}, {-3.0, "-3 dB"}, {-6.0, "-6 dB"}, {-9.0, "-9 dB or worse"}
+        };
+        for (const auto &step : steps) {
+            QColor color = getDeviationColor(step.first);
+            painter.setBrush(QBrush(color));
+            painter.setPen(QPen(color.darker(150), 1));
+            painter.drawEllipse(x + 2, y - 6, 8, 8);
+            painter.setPen(Qt::black);
+            painter.drawText(x + 18, y, step.second);
+            y += 14;
+        }
+        painter.setBrush(QColor(160, 160, 160));
+        painter.setPen(QPen(QColor(160, 160, 160).darker(150), 1));
+        painter.drawEllipse(x + 2, y - 6, 8, 8);
         painter.setPen(Qt::black);
-        painter.drawText(x + 18, y, sys.second);
+        painter.drawText(x + 18, y, "Not learned yet");
         y += 14;
+    } else {
+        // GNSS Systems
+        painter.drawText(x, y, "GNSS Systems:");
+        y += 20;
+        painter.setFont(normalFont);
+        
+        std::map<std::string, QString> systemNames = {
+            {"G", "GPS"}, {"U", "Unknown"}, {"E", "Galileo"}, {"R", "GLONASS"}, {"C", "BeiDou"}
+        };
+        
+        for (const auto &sys : systemNames) {
+            QColor color = getSystemColor(sys.first);
+            painter.setBrush(QBrush(color));
+            painter.setPen(QPen(color.darker(150), 1));
+            painter.drawEllipse(x + 2, y - 6, 8, 8);
+            
+            painter.setPen(Qt::black);
+            painter.drawText(x + 18, y, sys.second);
+            y += 14;
+        }
     }
     
     // Position Sources
@@ -628,6 +738,14 @@ void SkyPlotWidget::drawLegend(QPainter &painter, const QRect &legendArea)
     painter.drawText(x + 18, y, "Unknown Position");
     y += 14;
     
+    // Unhealthy satellites (red ring)
+    painter.setPen(QPen(QColor(200, 0, 0), 2));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawEllipse(x + 2, y - 7, 10, 10);
+    painter.setPen(Qt::black);
+    painter.drawText(x + 18, y, "Unhealthy");
+    y += 14;
+    
     // Statistics
     y += 10;
     painter.setFont(titleFont);
@@ -691,6 +809,13 @@ QColor SkyPlotWidget::getSystemColor(const std::string &system) const
     return QColor(128, 128, 128);                      // Unknown - Gray
 }
 
+QColor SkyPlotWidget::getDeviationColor(double deviation) const
+{
+    // Green at the expected C/N0 or above, through yellow to red 9 dB below it
+    double t = std::max(0.0, std::min(1.0, -deviation / 9.0));
+    return QColor::fromHsv(static_cast<int>(120.0 * (1.0 - t)), 220, 210);
+}
+
 QPointF SkyPlotWidget::polarToCartesian(double elevation, double azimuth, const QRect &plotArea) const
 {
     QPointF center = plotArea.center();
@@ -773,103 +898,39 @@ void SkyPlotWidget::mouseMoveEvent(QMouseEvent *event)
     }
 }
 
-void SkyPlotWidget::resizeEvent(QResizeEvent *event)
+void SkyPlotWidget::contextMenuEvent(QContextMenuEvent *event)
 {
-    QWidget::resizeEvent(event);
-    update();
-}
-
-// Improved satellite position computation
-double SkyPlotWidget::computeSatelliteElevation(int prn, const std::string& system, 
-                                              double receiver_lat, double receiver_lon, double gps_time) const
-{
-    // Enhanced orbital mechanics simulation
-    double time_factor = gps_time / 3600.0; // Convert to hours for smoother motion
-    
-    if (system == "G") { // GPS
-        int orbital_plane = (prn - 1) % 6;
-        double plane_offset = orbital_plane * M_PI / 3.0;
-        double orbital_period = 12.0; // ~12 hour orbit
-        double elevation = 25.0 + 50.0 * (0.5 + 0.4 * sin(2 * M_PI * time_factor / orbital_period + plane_offset));
-        
-        // Add some randomness based on PRN
-        elevation += 10.0 * sin(prn * 0.7 + time_factor * 0.1);
-        
-        return std::max(5.0, std::min(85.0, elevation));
-    }
-    else if (system == "E") { // Galileo
-        int orbital_plane = (prn - 1) % 3;
-        double plane_offset = orbital_plane * 2 * M_PI / 3.0;
-        double orbital_period = 14.1; // ~14.1 hour orbit
-        double elevation = 30.0 + 45.0 * (0.5 + 0.35 * sin(2 * M_PI * time_factor / orbital_period + plane_offset));
-        
-        elevation += 8.0 * sin(prn * 0.9 + time_factor * 0.12);
-        
-        return std::max(10.0, std::min(80.0, elevation));
-    }
-    else if (system == "R") { // GLONASS
-        int orbital_plane = (prn - 1) % 3;
-        double plane_offset = orbital_plane * 2 * M_PI / 3.0;
-        double orbital_period = 11.3; // ~11.3 hour orbit
-        double elevation = 35.0 + 40.0 * (0.5 + 0.3 * sin(2 * M_PI * time_factor / orbital_period + plane_offset));
-        
-        elevation += 12.0 * sin(prn * 1.1 + time_factor * 0.08);
-        
-        return std::max(15.0, std::min(75.0, elevation));
-    }
-    else if (system == "C") { // BeiDou
-        int orbital_plane = (prn - 1) % 3;
-        double plane_offset = orbital_plane * 2 * M_PI / 3.0;
-        double orbital_period = 12.9; // ~12.9 hour orbit
-        double elevation = 28.0 + 47.0 * (0.5 + 0.38 * sin(2 * M_PI * time_factor / orbital_period + plane_offset));
-        
-        elevation += 9.0 * sin(prn * 0.8 + time_factor * 0.11);
-        
-        return std::max(8.0, std::min(82.0, elevation));
+    QMenu menu(this);
+    QActionGroup group(&menu);
+    QAction *bySystem = menu.addAction("Colour by System");
+    QAction *byDeviation = menu.addAction("Colour by C/N0 vs Expected");
+    for (QAction *action : {bySystem, byDeviation}) {
+        action->setCheckable(true);
+        group.addAction(action);
+    }
+    bySystem->setChecked(m_colorMode == ColorMode::System);
+    byDeviation->setChecked(m_colorMode == ColorMode::Cn0Deviation);
+    menu.addSeparator();
+    QAction *forget = menu.addAction("Forget Expected C/N0");
+    forget->setEnabled(m_cn0Model != nullptr);
+
+    QAction *chosen = menu.exec(event->globalPos());
+    if (chosen == bySystem) {
+        setColorMode(ColorMode::System);
+    } else if (chosen == byDeviation) {
+        setColorMode(ColorMode::Cn0Deviation);
+    } else if (chosen == forget) {
+        // After moving the antenna the learned curves no longer apply
+        emit forgetExpectedCn0();
+        for (auto &pair : m_satellites) {
+            pair.second->hasCn0Deviation = false;
+        }
+        update();
     }
-    
-    // Fallback for unknown systems
-    return 30.0 + fmod(prn * 7.0, 50.0);
 }
 
-double SkyPlotWidget::computeSatelliteAzimuth(int prn, const std::string& system, 
-                                            double receiver_lat, double receiver_lon, double gps_time) const
+void SkyPlotWidget::resizeEvent(QResizeEvent *event)
 {
-    double time_factor = gps_time / 3600.0;
-    double azimuth = 0.0;
-    
-    if (system == "G") { // GPS
-        int orbital_plane = (prn - 1) % 6;
-        double base_azimuth = orbital_plane * 60.0;
-        azimuth = base_azimuth + 45.0 * sin(2 * M_PI * time_factor / 12.0 + prn * 0.3);
-        azimuth += receiver_lon * 0.15; // Longitude effect
-    }
-    else if (system == "E") { // Galileo
-        int orbital_plane = (prn - 1) % 3;
-        double base_azimuth = orbital_plane * 120.0;
-        azimuth = base_azimuth + 50.0 * sin(2 * M_PI * time_factor / 14.1 + prn * 0.4);
-        azimuth += receiver_lon * 0.18;
-    }
-    else if (system == "R") { // GLONASS
-        int orbital_plane = (prn - 1) % 3;
-        double base_azimuth = orbital_plane * 120.0 + 60.0; // Offset from Galileo
-        azimuth = base_azimuth + 40.0 * sin(2 * M_PI * time_factor / 11.3 + prn * 0.35);
-        azimuth += receiver_lon * 0.12;
-    }
-    else if (system == "C") { // BeiDou
-        int orbital_plane = (prn - 1) % 3;
-        double base_azimuth = orbital_plane * 120.0 + 30.0; // Different offset
-        azimuth = base_azimuth + 48.0 * sin(2 * M_PI * time_factor / 12.9 + prn * 0.42);
-        azimuth += receiver_lon * 0.16;
-    }
-    else {
-        // Fallback
-        azimuth = fmod(prn * 23.0 + time_factor * 15.0, 360.0);
-    }
-    
-    // Normalize to 0-360 range
-    while (azimuth < 0) azimuth += 360.0;
-    while (azimuth >= 360.0) azimuth -= 360.0;
-    
-    return azimuth;
+    QWidget::resizeEvent(event);
+    update();
 }
@@ -33,20 +33,25 @@
 #ifndef GNSS_SDR_MONITOR_SKYPLOT_WIDGET_H_
 #define GNSS_SDR_MONITOR_SKYPLOT_WIDGET_H_
 
+#include "cn0_elevation_model.h"
+#include "ephemeris_store.h"
+#include "geodesy.h"
 #include "gnss_synchro.pb.h"
-#include "monitor_pvt.pb.h"
+#include "monitor_clock.h"
+#include "pvt_snapshot.h"
+#include "satellite_health.h"
 #include <QWidget>
 #include <QPainter>
-#include <QTimer>
 #include <QDateTime>
 #include <map>
 #include <memory>
+#include <vector>
 
 enum class PositionSource
 {
     NONE,           // No position data available
     REAL,           // Real satellite position from GNSS-SDR
-    COMPUTED,       // Computed using receiver position and time
+    COMPUTED,       // Computed from the broadcast ephemeris and the receiver position
     FALLBACK        // Fallback pattern-based position
 };
 
@@ -66,6 +71,10 @@ struct SatelliteInfo
     // Signal quality
     double cn0;              // dB-Hz
     bool valid;              // tracking validity
+    bool hasCn0Deviation;    // expected C/N0 known at this elevation
+    double cn0Deviation;     // dB, measured - expected
+    double expectedCn0;      // dB-Hz
+    bool unhealthy;          // flagged unusable by its ephemeris
     
     // Tracking state
     bool seenInThisUpdate;   // updated in current cycle
@@ -86,6 +95,12 @@ class SkyPlotWidget : public QWidget
     Q_OBJECT
 
 public:
+    enum class ColorMode
+    {
+        System,        // Colour of the constellation
+        Cn0Deviation   // Green to red by C/N0 below the expected one at that elevation
+    };
+
     explicit SkyPlotWidget(QWidget *parent = nullptr);
     ~SkyPlotWidget() override = default;
 
@@ -93,31 +108,44 @@ public:
     void setMaxMissedUpdates(int maxUpdates) { m_maxMissedUpdates = maxUpdates; }
     void setUpdateRate(int milliseconds) { m_updateTimer.setInterval(milliseconds); }
     void setShowDebugInfo(bool show) { m_showDebugInfo = show; update(); }
+    void setEphemerisStore(EphemerisStore *store) { m_ephemerisStore = store; }
+    void setCn0Model(const Cn0ElevationModel *model) { m_cn0Model = model; }
+    void setSatelliteHealth(const SatelliteHealth *health) { m_satelliteHealth = health; }
+    void setColorMode(ColorMode mode) { m_colorMode = mode; update(); }
+    ColorMode colorMode() const { return m_colorMode; }
+    void setClock(MonitorClock *clock);
 
 public slots:
     void updateSatellites(const gnss_sdr::Observables &observables);
-    void updateReceiverPosition(const gnss_sdr::MonitorPvt &monitor_pvt);
+    void updateReceiverPosition(const PvtSnapshot &pvt);
     void clear();
     void clearStale(); // Remove satellites not seen recently
 
+signals:
+    // Asked from the context menu, e.g. after moving the antenna.
+    void forgetExpectedCn0();
+
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
 
 private:
     // Core functionality
-    void processSatellite(const gnss_sdr::GnssSynchro &obs);
+    void processSatellite(const gnss_sdr::GnssSynchro &obs, int index);
     void cleanupStaleSatellites();
     void scheduleUpdate();
     
     // Position computation
     bool extractRealPosition(const gnss_sdr::GnssSynchro &obs, double &elevation, double &azimuth);
-    void computeApproximatePosition(const gnss_sdr::GnssSynchro &obs, double &elevation, double &azimuth);
+    void computeEphemerisPositions(const gnss_sdr::Observables &observables);
+    bool ephemerisPosition(int index, double &elevation, double &azimuth) const;
     void computeFallbackPosition(const gnss_sdr::GnssSynchro &obs, double &elevation, double &azimuth);
     
     // Drawing functions
+    void drawStaticLayer(QPainter &painter);
     void drawBackground(QPainter &painter);
     void drawGrid(QPainter &painter, const QRect &plotArea);
     void drawSatellites(QPainter &painter, const QRect &plotArea);
@@ -126,16 +154,11 @@ private:
     
     // Utility functions
     QColor getSystemColor(const std::string &system) const;
+    QColor getDeviationColor(double deviation) const;
     QPointF polarToCartesian(double elevation, double azimuth, const QRect &plotArea) const;
     SatelliteInfo* findSatelliteAt(const QPointF &point);
     int getSatelliteSize(double cn0, int plotRadius) const;
     
-    // Orbital mechanics (improved versions)
-    double computeSatelliteElevation(int prn, const std::string& system, 
-                                   double receiverLat, double receiverLon, double gpsTime) const;
-    double computeSatelliteAzimuth(int prn, const std::string& system, 
-                                 double receiverLat, double receiverLon, double gpsTime) const;
-    
     // Data management
     std::map<int, std::unique_ptr<SatelliteInfo>> m_satellites;  // key: channel_id    
 
@@ -143,9 +166,15 @@ private:
     QRect m_plotArea;
     QRect m_legendArea;
     QRect m_debugArea;
+
+    // Background and grid, redrawn only when the geometry changes
+    QImage m_staticLayer;
+    QRect m_staticLayerArea;
+    qreal m_staticLayerDpr;
     
     // Update management
-    QTimer m_updateTimer;
+    MonitorClock *m_clock;
+    ClockTimer m_updateTimer;
     bool m_needsUpdate;
     int m_maxMissedUpdates;
     
@@ -153,9 +182,22 @@ private:
     double m_receiverLat;
     double m_receiverLon;
     double m_receiverHeight;
+    geodesy::LocalFrame m_receiverFrame;
     double m_currentGpsTime;
+    quint32 m_currentGpsWeek;
     bool m_hasReceiverPosition;
     QDateTime m_lastReceiverUpdate;
+    EphemerisStore *m_ephemerisStore;
+    const Cn0ElevationModel *m_cn0Model;
+    const SatelliteHealth *m_satelliteHealth;
+
+    // Look angles from the ephemeris of one Observables message, converted in a single batch.
+    struct EphemerisBatch
+    {
+        std::vector<int> slot;  // Per observable: position in the arrays below, or -1.
+        std::vector<double> x, y, z;
+        std::vector<double> azimuth, elevation;
+    } m_ephemerisBatch;
     
     // Statistics
     int m_totalSatellites;
@@ -167,6 +209,7 @@ private:
     SatelliteInfo* m_hoveredSatellite;
     SatelliteInfo* m_selectedSatellite;
     bool m_showDebugInfo;
+    ColorMode m_colorMode;
     
     // Visual configuration
     static constexpr int MIN_WIDGET_SIZE = 300;
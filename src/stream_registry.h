@@ -0,0 +1,258 @@
+/*!
+ * \file stream_registry.h
+ * \brief Compile-time registry of the UDP streams published by GNSS-SDR:
+ * one socket per stream, shared ingest buffer and recorder.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_STREAM_REGISTRY_H_
+#define GNSS_SDR_MONITOR_STREAM_REGISTRY_H_
+
+#include "alert_capture.h"
+#include "session_recorder.h"
+#include <QByteArray>
+#include <QDebug>
+#include <QSettings>
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QUdpSocket>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+/*
+ A stream is declared once as a struct with:
+
+   using Message = <protobuf message type>;
+   static constexpr quint16 id;            // Stream id used in recordings, never reused.
+   static constexpr quint16 defaultPort;
+   static const char *settingsKey();       // Port key in the "Preferences_Dialog" group.
+   static const char *label();             // Label shown in the preferences dialog.
+
+ Its consumers are the handler's overload of handle(Stream, const Message &),
+ which is selected at compile time, so the hot path has no virtual call and no
+ QVariant marshalling.
+ */
+
+/*!
+ Runtime description of a stream, used by the preferences dialog.
+ */
+struct StreamDescriptor
+{
+    quint16 id;
+    quint16 defaultPort;
+    const char *settingsKey;
+    const char *label;
+};
+
+template <typename Stream>
+struct StreamEndpoint
+{
+    QUdpSocket *socket = nullptr;
+    quint16 port = 0;
+    typename Stream::Message message;  // Reused for every datagram.
+};
+
+/*!
+ Owns one UDP socket per stream and forwards every decoded message to \a Handler.
+
+ All streams are drained on the thread that owns the registry through a single
+ receive buffer, and every datagram is handed to the shared SessionRecorder,
+ when one is recording, and to the AlertCapture, when enabled, before it is
+ parsed.
+ */
+template <typename Handler, typename... Streams>
+class StreamRegistry
+{
+public:
+    StreamRegistry(Handler *handler, QObject *parent) : m_handler(handler)
+    {
+        forEachEndpoint([this, parent](auto &endpoint) {
+            using Stream = typename std::decay<decltype(endpoint)>::type::StreamType;
+            endpoint.socket = new QUdpSocket(parent);
+            QObject::connect(endpoint.socket, &QUdpSocket::readyRead, endpoint.socket,
+                [this, &endpoint]() { drain<Stream>(endpoint); });
+        });
+    }
+
+    StreamRegistry(const StreamRegistry &) = delete;
+    StreamRegistry &operator=(const StreamRegistry &) = delete;
+
+    /*!
+     (Re)binds every socket to the port stored in the settings, or to the stream's default port.
+     */
+    void bind()
+    {
+        QSettings settings;
+        settings.beginGroup("Preferences_Dialog");
+        forEachEndpoint([&settings](auto &endpoint) {
+            using Stream = typename std::decay<decltype(endpoint)>::type::StreamType;
+            bool ok = false;
+            const uint value = settings.value(Stream::settingsKey(), Stream::defaultPort).toUInt(&ok);
+            const quint16 port = ok && value <= 65535 ? static_cast<quint16>(value) : Stream::defaultPort;
+            if (port == endpoint.port && endpoint.socket->state() == QAbstractSocket::BoundState)
+            {
+                return;
+            }
+            endpoint.socket->close();
+            endpoint.port = port;
+            if (!endpoint.socket->bind(QHostAddress::Any, port))
+            {
+                qDebug() << "Cannot bind" << Stream::settingsKey() << port << endpoint.socket->errorString();
+            }
+        });
+        settings.endGroup();
+    }
+
+    /*!
+     Closes every socket, e.g. while a recording is being replayed. bind() opens them again.
+     */
+    void close()
+    {
+        forEachEndpoint([](auto &endpoint) {
+            endpoint.socket->close();
+            endpoint.port = 0;
+        });
+    }
+
+    void setRecorder(SessionRecorder *recorder) { m_recorder = recorder; }
+    void setAlertCapture(AlertCapture *capture) { m_capture = capture; }
+
+    /*!
+     Decodes \a size bytes of \a data as a message of the stream with id \a stream_id and hands it
+     to the handler, exactly as if it had been received. Returns false for unknown streams.
+     */
+    bool dispatch(quint16 stream_id, const char *data, int size)
+    {
+        bool delivered[] = {false, deliverIf<Streams>(stream_id, data, size)...};
+        return std::find(std::begin(delivered), std::end(delivered), true) != std::end(delivered);
+    }
+
+private:
+    template <typename Stream>
+    struct Endpoint : StreamEndpoint<Stream>
+    {
+        using StreamType = Stream;
+    };
+
+    template <typename F>
+    void forEachEndpoint(F f)
+    {
+        int expand[] = {0, (f(std::get<Endpoint<Streams>>(m_endpoints)), 0)...};
+        (void)expand;
+    }
+
+    template <typename Stream>
+    void drain(Endpoint<Stream> &endpoint)
+    {
+        while (endpoint.socket->hasPendingDatagrams())
+        {
+            qint64 size = endpoint.socket->pendingDatagramSize();
+            if (size < 0)
+            {
+                break;
+            }
+            if (m_buffer.size() < size)
+            {
+                m_buffer.resize(static_cast<int>(size));
+            }
+
+            qint64 bytes = endpoint.socket->readDatagram(m_buffer.data(), size);
+            if (bytes < 0)
+            {
+                break;
+            }
+
+            const bool recording = m_recorder && m_recorder->isRecording();
+            const bool capturing = m_capture && m_capture->isEnabled();
+            if (recording || capturing)
+            {
+                qint64 now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                                    .count();
+                if (recording)
+                {
+                    m_recorder->record(Stream::id, now_us, m_buffer.constData(), bytes);
+                }
+                if (capturing)
+                {
+                    m_capture->push(Stream::id, now_us, m_buffer.constData(), bytes);
+                }
+            }
+
+            deliver(endpoint, m_buffer.constData(), static_cast<int>(bytes));
+        }
+    }
+
+    template <typename Stream>
+    bool deliverIf(quint16 stream_id, const char *data, int size)
+    {
+        if (Stream::id != stream_id)
+        {
+            return false;
+        }
+        deliver(std::get<Endpoint<Stream>>(m_endpoints), data, size);
+        return true;
+    }
+
+    template <typename Stream>
+    void deliver(Endpoint<Stream> &endpoint, const char *data, int size)
+    {
+        if (!endpoint.message.ParseFromArray(data, size))
+        {
+            qDebug() << "Malformed datagram on" << Stream::settingsKey();
+            return;
+        }
+        m_handler->handle(Stream(), endpoint.message);
+    }
+
+    Handler *m_handler;
+    SessionRecorder *m_recorder = nullptr;
+    AlertCapture *m_capture = nullptr;
+    QByteArray m_buffer;
+    std::tuple<Endpoint<Streams>...> m_endpoints;
+};
+
+/*!
+ Ordered list of the streams the monitor listens to.
+ */
+template <typename... Streams>
+struct StreamList
+{
+    template <typename Handler>
+    using Registry = StreamRegistry<Handler, Streams...>;
+
+    static std::vector<StreamDescriptor> descriptors()
+    {
+        return {StreamDescriptor{Streams::id, Streams::defaultPort, Streams::settingsKey(), Streams::label()}...};
+    }
+};
+
+#endif  // GNSS_SDR_MONITOR_STREAM_REGISTRY_H_
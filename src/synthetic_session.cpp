@@ -0,0 +1,214 @@
+/*!
+ * \file synthetic_session.cpp
+ * \brief Implementation of a generator of synthetic recordings used to
+ * exercise the views without a receiver.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "synthetic_session.h"
+#include "geodesy.h"
+#include "gnss_synchro.pb.h"
+#include "gnss_time.h"
+#include "gps_ephemeris.pb.h"
+#include "monitor_pvt.pb.h"
+#include "monitor_streams.h"
+#include "session_recorder.h"
+#include <cmath>
+#include <string>
+
+namespace
+{
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEG = PI / 180.0;
+
+// Fixed start of the session, so that every run produces the same file.
+constexpr quint32 START_WEEK = 2400;
+constexpr double START_TOW = 345600.0;
+
+// Receiver at CTTC, Castelldefels.
+constexpr double RX_LAT = 41.2750;
+constexpr double RX_LON = 1.9870;
+constexpr double RX_HEIGHT = 80.0;
+
+const char *const SYSTEMS[] = {"G", "E", "C", "R"};
+const char *const SIGNALS[] = {"1C", "1B", "B1", "1G"};
+const int PRN_COUNT[] = {32, 36, 37, 24};
+
+void fillEphemeris(gnss_sdr::GpsEphemeris &eph, int prn)
+{
+    // Six planes of slots, roughly like the real constellation.
+    const int plane = (prn - 1) % 6;
+    const int slot = (prn - 1) / 6;
+    eph.Clear();
+    eph.set_prn(prn);
+    eph.set_sqrta(5153.6);
+    eph.set_ecc(0.01);
+    eph.set_i_0(55.0 * DEG);
+    eph.set_omega_0(plane * PI / 3.0);
+    eph.set_omega(0.5);
+    eph.set_m_0(slot * 2.0 * PI / 6.0 + plane * 0.25);
+    eph.set_omegadot(-8.0e-9);
+    eph.set_toe(static_cast<int>(START_TOW));
+    eph.set_toc(static_cast<int>(START_TOW));
+    eph.set_wn(static_cast<int>(START_WEEK));
+    eph.set_tow(static_cast<int>(START_TOW));
+    eph.set_af0(1.0e-5 * (prn % 7));
+    eph.set_iodc(prn);
+    eph.set_iode_sf2(prn);
+    eph.set_iode_sf3(prn);
+}
+
+void fillObservable(gnss_sdr::GnssSynchro &obs, int channel, double tow)
+{
+    const int system = channel % 4;
+    const int prn = (channel / 4) % PRN_COUNT[system] + 1;
+    const double phase = 0.37 * channel;
+    const double azimuth = std::fmod(channel * 47.0 + tow / 120.0, 360.0);
+    const double elevation = 10.0 + 35.0 * (1.0 + std::sin(phase + tow / 900.0));
+
+    obs.set_system(SYSTEMS[system]);
+    obs.set_signal(SIGNALS[system]);
+    obs.set_prn(prn);
+    obs.set_channel_id(channel);
+    obs.set_fs(4000000);
+    obs.set_acq_delay_samples(100.0 + channel);
+    obs.set_acq_doppler_hz(3000.0 * std::sin(phase));
+    obs.set_acq_samplestamp_samples(1000);
+    obs.set_acq_doppler_step(250);
+    obs.set_flag_valid_acquisition(true);
+    obs.set_prompt_i(1000.0 * std::cos(phase + tow * 3.0));
+    obs.set_prompt_q(60.0 * std::sin(phase + tow * 7.0));
+    obs.set_cn0_db_hz(38.0 + 8.0 * std::sin(phase + tow / 60.0) + 0.5 * std::sin(tow * 11.0 + channel));
+    obs.set_carrier_doppler_hz(3000.0 * std::sin(phase) + 0.8 * (tow - START_TOW));
+    obs.set_carrier_phase_rads(std::fmod(tow * 100.0 + phase, 2.0 * PI));
+    obs.set_code_phase_samples(std::fmod(tow * 1000.0 + channel, 4000.0));
+    obs.set_tracking_sample_counter(static_cast<quint64>((tow - START_TOW) * 4e6));
+    obs.set_flag_valid_symbol_output(true);
+    obs.set_correlation_length_ms(1);
+    obs.set_flag_valid_word(true);
+    obs.set_tow_at_current_symbol_ms(static_cast<quint32>(tow * 1000.0));
+    obs.set_pseudorange_m(2.2e7 + 1.0e6 * std::sin(phase) + 500.0 * (tow - START_TOW));
+    obs.set_rx_time(tow);
+    obs.set_flag_valid_pseudorange(true);
+    obs.set_interp_tow_ms(tow * 1000.0);
+    obs.set_satellite_azimuth_deg(azimuth);
+    obs.set_satellite_elevation_deg(elevation);
+    obs.set_flag_valid_satellite_position(true);
+}
+
+void fillPvt(gnss_sdr::MonitorPvt &pvt, double tow, int channels)
+{
+    const double t = tow - START_TOW;
+    const double lat = RX_LAT + 1.0e-6 * std::sin(t / 30.0);
+    const double lon = RX_LON + 1.0e-6 * std::cos(t / 30.0);
+    const double height = RX_HEIGHT + 2.0 * std::sin(t / 45.0);
+    double x, y, z;
+    geodesy::geodeticToEcef(&lat, &lon, &height, 1, &x, &y, &z);
+
+    pvt.Clear();
+    pvt.set_tow_at_current_symbol_ms(static_cast<quint32>(tow * 1000.0));
+    pvt.set_week(START_WEEK);
+    pvt.set_rx_time(tow);
+    pvt.set_user_clk_offset(1.0e-4);
+    pvt.set_pos_x(x);
+    pvt.set_pos_y(y);
+    pvt.set_pos_z(z);
+    pvt.set_latitude(lat);
+    pvt.set_longitude(lon);
+    pvt.set_height(height);
+    pvt.set_valid_sats(static_cast<quint32>(channels));
+    pvt.set_solution_status(1);
+    pvt.set_gdop(1.8 + 0.2 * std::sin(t / 50.0));
+    pvt.set_pdop(1.5 + 0.2 * std::sin(t / 50.0));
+    pvt.set_hdop(0.9 + 0.1 * std::sin(t / 40.0));
+    pvt.set_vdop(1.2 + 0.1 * std::cos(t / 40.0));
+}
+}  // namespace
+
+/*!
+ Writes the synthetic session to \a path. Returns false and sets \a error if the file cannot be written.
+ */
+bool SyntheticSession::write(const QString &path, int channels, int seconds, QString *error)
+{
+    SessionRecorder recorder;
+    if (!recorder.open(path))
+    {
+        if (error)
+        {
+            *error = "cannot open " + path;
+        }
+        return false;
+    }
+
+    const double start_gps = GnssTime::gpsSeconds(START_WEEK, START_TOW);
+    const qint64 start_us = static_cast<qint64>(GnssTime::fromGps(start_gps, TimeSystem::UTC) * 1e6);
+
+    std::string buffer;
+    auto write = [&recorder, &buffer](quint16 stream_id, qint64 timestamp_us, const google::protobuf::Message &message) {
+        message.SerializeToString(&buffer);
+        recorder.record(stream_id, timestamp_us, buffer.data(), static_cast<qint64>(buffer.size()));
+    };
+
+    gnss_sdr::GpsEphemeris ephemeris;
+    for (int prn = 1; prn <= 32; prn++)
+    {
+        fillEphemeris(ephemeris, prn);
+        write(GpsEphemerisStream::id, start_us, ephemeris);
+    }
+
+    gnss_sdr::Observables observables;
+    for (int c = 0; c < channels; c++)
+    {
+        observables.add_observable();
+    }
+
+    gnss_sdr::MonitorPvt pvt;
+    const int epochs = seconds * 1000 / EPOCH_MS;
+    for (int e = 0; e < epochs; e++)
+    {
+        const qint64 elapsed_ms = static_cast<qint64>(e) * EPOCH_MS;
+        const qint64 timestamp_us = start_us + elapsed_ms * 1000;
+        const double tow = START_TOW + elapsed_ms / 1000.0;
+
+        for (int c = 0; c < channels; c++)
+        {
+            fillObservable(*observables.mutable_observable(c), c, tow);
+        }
+        write(GnssSynchroStream::id, timestamp_us, observables);
+
+        if (elapsed_ms % PVT_MS == 0)
+        {
+            fillPvt(pvt, tow, channels);
+            write(MonitorPvtStream::id, timestamp_us, pvt);
+        }
+    }
+
+    recorder.close();
+    return true;
+}
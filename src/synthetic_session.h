@@ -0,0 +1,54 @@
+/*!
+ * \file synthetic_session.h
+ * \brief Interface of a generator of synthetic recordings used to exercise
+ * the views without a receiver.
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_MONITOR_SYNTHETIC_SESSION_H_
+#define GNSS_SDR_MONITOR_SYNTHETIC_SESSION_H_
+
+#include <QString>
+
+/*!
+ Writes a deterministic recording with \a channels tracking channels over
+ \a seconds of receiver time: observables at 10 Hz, PVT at 1 Hz and the GPS
+ ephemerides at the start. The same arguments always produce the same file,
+ so the recordings can stand in for a bundled test session.
+ */
+class SyntheticSession
+{
+public:
+    static constexpr int EPOCH_MS = 100;
+    static constexpr int PVT_MS = 1000;
+
+    static bool write(const QString &path, int channels, int seconds, QString *error = nullptr);
+};
+
+#endif  // GNSS_SDR_MONITOR_SYNTHETIC_SESSION_H_
@@ -0,0 +1,309 @@
+/*!
+ * \file geodesy_test.cpp
+ * \brief Accuracy tests and benchmarks of the geodesy transforms
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "geodesy.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Bounds on the errors. The polynomial arctangent is measured at about 9e-7 degrees and the
+// geodetic round trip at about 1e-8 m, so these catch any drift of the kernels.
+constexpr double ECEF_TOLERANCE_M = 2e-6;  // The reference positions are rounded to 1e-6 m.
+constexpr double HORIZONTAL_TOLERANCE_M = 2e-6;
+constexpr double HEIGHT_TOLERANCE_M = 2e-6;
+constexpr double ANGLE_TOLERANCE_DEG = 1.5e-6;  // Azimuth and elevation.
+constexpr double ROUND_TRIP_TOLERANCE_M = 1e-7;
+constexpr double TWIN_TOLERANCE_RAD = 4e-15;  // Scalar and SSE2 arctangent, a few ulps of pi.
+
+int failures = 0;
+
+void check(const char *what, double error, double tolerance)
+{
+    const bool ok = error <= tolerance;
+    std::printf("%-44s %10.3e  (tolerance %.1e) %s\n", what, error, tolerance, ok ? "ok" : "FAIL");
+    failures += ok ? 0 : 1;
+}
+
+// Geodetic positions and their ECEF coordinates, computed with 64-bit mantissas.
+struct GeodeticReference
+{
+    double latitude, longitude, height;
+    double x, y, z;
+};
+
+const GeodeticReference GEODETIC[] = {
+    {40.4168, -3.7038, 650, 4853167.141146, -314163.462464, 4113751.707986},
+    {0, 0, 0, 6378137.000000, 0.000000, 0.000000},
+    {90, 0, 0, 0.000000, 0.000000, 6356752.314245},
+    {-33.8688, 151.2093, 10000, -4653328.034749, 2557205.238389, -3539945.318405},
+    {12.5, -75.25, 20200000, 6606692.855931, -25093977.249626, 5743535.308567},
+    {31.5, 35.5, -430, 4431121.217524, 3160688.047471, 3313062.343178},
+    {60, 179.999, 3000, -3198604.586437, 55.826182, 5503075.210150},
+    {-89.9, 120, -400, -5584.347020, 9672.372765, -6356342.567719},
+    {45, -120, 1000000, -2612348.830018, -4524720.900684, 5194455.190052},
+};
+
+// Satellites at 20200 km seen from 40.4168 N, 3.7038 W, 650 m, computed with 64-bit mantissas.
+struct LookReference
+{
+    double x, y, z;
+    double azimuth, elevation;
+};
+
+const GeodeticReference OBSERVER = GEODETIC[0];
+const LookReference LOOK[] = {
+    {16832505.280843, 2968024.833930, 20336886.788710, 40.515288542417, 72.238628940221},
+    {20204910.500312, -1306592.951103, 17203931.803424, 170.217550717376, 89.977582023970},
+    {20051205.209555, -16824958.895997, 4607941.736607, 236.777027440845, 34.393562078967},
+    {21631259.788647, 12488813.661886, -9076503.683007, 145.756752020951, 8.237404142682},
+    {-1579631.376365, -8958534.706476, 24952830.946994, 335.308050293419, 22.687509835025},
+    {11510984.897869, 19937610.688268, 13270373.735384, 80.343044291437, 25.528691135947},
+    {26522624.205587, -1716907.580499, 0.000000, 180.000000000000, 38.855954881383},
+    {20016845.439618, -1399714.186758, 17414815.586294, 339.022023269126, 89.178115628085},
+    {26120318.685778, -1690864.855945, -4607941.736607, 180.000000000000, 27.326610651303},
+};
+
+double azimuthError(double a, double b)
+{
+    const double d = std::abs(a - b);
+    return std::min(d, 360.0 - d);
+}
+
+void testGeodetic()
+{
+    double ecef = 0.0, horizontal = 0.0, height = 0.0;
+    for (const GeodeticReference &r : GEODETIC)
+    {
+        double x, y, z;
+        geodesy::geodeticToEcef(&r.latitude, &r.longitude, &r.height, 1, &x, &y, &z);
+        ecef = std::max(ecef, std::max(std::abs(x - r.x), std::max(std::abs(y - r.y), std::abs(z - r.z))));
+
+        double latitude, longitude, h;
+        geodesy::ecefToGeodetic(&r.x, &r.y, &r.z, 1, &latitude, &longitude, &h);
+        // On the ground, so that the longitudes near the poles are not held to a tighter bound.
+        const double north = (latitude - r.latitude) * geodesy::DEG * geodesy::WGS84_A;
+        const double east = std::remainder(longitude - r.longitude, 360.0) * geodesy::DEG * geodesy::WGS84_A *
+                            std::cos(r.latitude * geodesy::DEG);
+        horizontal = std::max(horizontal, std::sqrt(north * north + east * east));
+        height = std::max(height, std::abs(h - r.height));
+    }
+    check("geodetic to ECEF [m]", ecef, ECEF_TOLERANCE_M);
+    check("ECEF to geodetic, horizontal [m]", horizontal, HORIZONTAL_TOLERANCE_M);
+    check("ECEF to geodetic, height [m]", height, HEIGHT_TOLERANCE_M);
+}
+
+void testLookAngles()
+{
+    const geodesy::LocalFrame frame = geodesy::LocalFrame::at(OBSERVER.latitude, OBSERVER.longitude, OBSERVER.height);
+    const size_t n = sizeof(LOOK) / sizeof(LOOK[0]);
+    std::vector<double> x(n), y(n), z(n), azimuth(n), elevation(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        x[i] = LOOK[i].x;
+        y[i] = LOOK[i].y;
+        z[i] = LOOK[i].z;
+    }
+
+    // An odd count, so that both the SSE2 pairs and the scalar tail are checked.
+    geodesy::lookAngles(frame, x.data(), y.data(), z.data(), n, azimuth.data(), elevation.data());
+    double az = 0.0, el = 0.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        az = std::max(az, azimuthError(azimuth[i], LOOK[i].azimuth));
+        el = std::max(el, std::abs(elevation[i] - LOOK[i].elevation));
+    }
+    check("azimuth against the references [deg]", az, ANGLE_TOLERANCE_DEG);
+    check("elevation against the references [deg]", el, ANGLE_TOLERANCE_DEG);
+}
+
+/*!
+ Compares the polynomial azimuth and elevation with std::atan2 on random directions, and the scalar
+ arctangent with its SSE2 twin on the same inputs plus the axes, the diagonals and the signed zeros.
+ */
+void testArctangent(std::mt19937 &random)
+{
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    const size_t n = 100001;
+    std::vector<double> east(n), north(n), up(n), azimuth(n), elevation(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        const double scale = std::pow(10.0, 8.0 * uniform(random));
+        east[i] = scale * uniform(random);
+        north[i] = scale * uniform(random);
+        up[i] = scale * uniform(random);
+    }
+    geodesy::enuToAzEl(east.data(), north.data(), up.data(), n, azimuth.data(), elevation.data());
+
+    double az = 0.0, el = 0.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        double reference = std::atan2(east[i], north[i]) / geodesy::DEG;
+        reference = reference < 0.0 ? reference + 360.0 : reference;
+        az = std::max(az, azimuthError(azimuth[i], reference));
+        el = std::max(el, std::abs(elevation[i] - std::atan2(up[i], std::hypot(east[i], north[i])) / geodesy::DEG));
+    }
+    check("azimuth against std::atan2 [deg]", az, ANGLE_TOLERANCE_DEG);
+    check("elevation against std::atan2 [deg]", el, ANGLE_TOLERANCE_DEG);
+
+#ifdef GNSS_SDR_MONITOR_GEODESY_SSE2
+    std::vector<double> ys = {0.0, -0.0, 1.0, -1.0, 0.0, 1.0, -1.0, geodesy::detail::ATAN_TAN_PI_8, 1e-300, 1e300};
+    std::vector<double> xs = {0.0, 0.0, 0.0, 0.0, -1.0, 1.0, -1.0, 1.0, 1.0, -1e-300};
+    ys.insert(ys.end(), east.begin(), east.end());
+    xs.insert(xs.end(), north.begin(), north.end());
+    ys.resize(ys.size() & ~size_t(1));
+    xs.resize(ys.size());
+
+    double twin = 0.0;
+    for (size_t i = 0; i < ys.size(); i += 2)
+    {
+        double simd[2];
+        _mm_storeu_pd(simd, geodesy::detail::atan2(_mm_loadu_pd(&ys[i]), _mm_loadu_pd(&xs[i])));
+        for (int k = 0; k < 2; k++)
+        {
+            twin = std::max(twin, std::abs(simd[k] - geodesy::detail::atan2(ys[i + k], xs[i + k])));
+        }
+    }
+    check("SSE2 arctangent against the scalar one [rad]", twin, TWIN_TOLERANCE_RAD);
+#else
+    std::printf("SSE2 arctangent not built, nothing to compare\n");
+#endif
+}
+
+void testRoundTrip(std::mt19937 &random)
+{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const size_t n = 100001;
+    std::vector<double> latitude(n), longitude(n), height(n), x(n), y(n), z(n), x2(n), y2(n), z2(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        latitude[i] = -90.0 + 180.0 * uniform(random);
+        longitude[i] = -180.0 + 360.0 * uniform(random);
+        height[i] = -500.0 + (i % 3 == 0 ? 2.5e7 : 1e4) * uniform(random);
+    }
+    geodesy::geodeticToEcef(latitude.data(), longitude.data(), height.data(), n, x.data(), y.data(), z.data());
+    geodesy::ecefToGeodetic(x.data(), y.data(), z.data(), n, latitude.data(), longitude.data(), height.data());
+    geodesy::geodeticToEcef(latitude.data(), longitude.data(), height.data(), n, x2.data(), y2.data(), z2.data());
+
+    double error = 0.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        error = std::max(error, std::sqrt((x2[i] - x[i]) * (x2[i] - x[i]) + (y2[i] - y[i]) * (y2[i] - y[i]) +
+                                          (z2[i] - z[i]) * (z2[i] - z[i])));
+    }
+    check("ECEF to geodetic and back [m]", error, ROUND_TRIP_TOLERANCE_M);
+}
+
+/*!
+ Prints the time per point of the batch transforms and of the libm equivalent of lookAngles().
+ */
+void benchmark(std::mt19937 &random)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int REPEATS = 20;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const size_t n = 4096;
+    std::vector<double> x(n), y(n), z(n), a(n), b(n), c(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        const double azimuth = 2.0 * geodesy::PI * uniform(random);
+        const double polar = geodesy::PI * (uniform(random) - 0.5);
+        x[i] = 2.66e7 * std::cos(polar) * std::cos(azimuth);
+        y[i] = 2.66e7 * std::cos(polar) * std::sin(azimuth);
+        z[i] = 2.66e7 * std::sin(polar);
+    }
+    const geodesy::LocalFrame frame = geodesy::LocalFrame::at(OBSERVER.latitude, OBSERVER.longitude, OBSERVER.height);
+
+    auto report = [n](const char *what, Clock::time_point start, double sink) {
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (REPEATS * n);
+        std::printf("%-44s %8.2f ns/point  (%g)\n", what, ns, sink);
+    };
+
+    Clock::time_point start = Clock::now();
+    double sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        geodesy::lookAngles(frame, x.data(), y.data(), z.data(), n, a.data(), b.data());
+        sink += a[r] + b[r];
+    }
+    report("lookAngles", start, sink);
+
+    geodesy::ecefToEnu(frame, x.data(), y.data(), z.data(), n, a.data(), b.data(), c.data());
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            sink += std::atan2(a[i], b[i]) + std::atan2(c[i], std::sqrt(a[i] * a[i] + b[i] * b[i]));
+        }
+    }
+    report("std::atan2 azimuth and elevation", start, sink);
+
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        geodesy::ecefToGeodetic(x.data(), y.data(), z.data(), n, a.data(), b.data(), c.data());
+        sink += a[r] + c[r];
+    }
+    report("ecefToGeodetic", start, sink);
+
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        geodesy::geodeticToEcef(a.data(), b.data(), c.data(), n, x.data(), y.data(), z.data());
+        sink += x[r] + z[r];
+    }
+    report("geodeticToEcef", start, sink);
+}
+}  // namespace
+
+/*!
+ Checks the transforms of geodesy.h against reference values and std::atan2, then prints their cost.
+ Returns the number of checks that failed.
+ */
+int main()
+{
+    std::mt19937 random(1);
+    testGeodetic();
+    testLookAngles();
+    testArctangent(random);
+    testRoundTrip(random);
+    benchmark(random);
+    return failures;
+}
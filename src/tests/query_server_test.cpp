@@ -0,0 +1,296 @@
+/*!
+ * \file query_server_test.cpp
+ * \brief Tests of the query API served over a local socket
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "query_server.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <cstdio>
+#include <iterator>
+
+namespace
+{
+constexpr quint16 FIRST_PORT = 18090;  // The API takes a fixed port, the test tries the next ones when taken.
+constexpr int PORT_ATTEMPTS = 100;
+constexpr int TIMEOUT_MS = 5000;
+constexpr int SAMPLES = 1000;  // One per second, from t = 0 to t = 999.
+
+int failures = 0;
+
+void check(const char *what, bool ok)
+{
+    std::printf("%-52s %s\n", what, ok ? "ok" : "FAIL");
+    failures += ok ? 0 : 1;
+}
+
+struct Reply
+{
+    int status = 0;
+    QByteArray contentType;
+    QByteArray body;
+};
+
+/*!
+ Fixed data of two channels and a PVT history, shaped like the snapshots the monitor takes: each
+ field of each series holds SAMPLES samples, with values that tell the field and the time apart.
+ */
+std::shared_ptr<const SeriesSnapshot> fixedSnapshot(const SeriesRequest &request)
+{
+    auto snapshot = std::make_shared<SeriesSnapshot>();
+    const SeriesSnapshot::Channel channels[] = {{3, "G12", "1C", SAMPLES}, {7, "E05", "1B", SAMPLES}};
+    snapshot->channels.assign(std::begin(channels), std::end(channels));
+
+    auto add = [&](const QString &field, int offset, const SeriesSnapshot::Channel *channel) {
+        SeriesSnapshot::Series series;
+        series.field = field;
+        if (channel)
+        {
+            series.channelId = channel->channelId;
+            series.satellite = channel->satellite;
+            series.signal = channel->signal;
+        }
+        for (int i = 0; i < SAMPLES; i++)
+        {
+            series.time.push_back(i);
+            series.values.push_back(offset + i);
+        }
+        snapshot->series.push_back(series);
+    };
+
+    if (request.kind == SeriesRequest::Kind::Channel)
+    {
+        for (const SeriesSnapshot::Channel &channel : snapshot->channels)
+        {
+            if (channel.satellite == request.satellite || channel.channelId == request.channelId)
+            {
+                for (const QString &field : request.fields)
+                {
+                    add(field, 10000 * (SeriesRequest::channelFields().indexOf(field) + 1), &channel);
+                }
+            }
+        }
+    }
+    else if (request.kind == SeriesRequest::Kind::Pvt)
+    {
+        for (const QString &field : request.fields)
+        {
+            add(field, 10000 * (SeriesRequest::pvtFields().indexOf(field) + 1), nullptr);
+        }
+    }
+    return snapshot;
+}
+
+/*!
+ Sends \a method \a target to the server on \a port and waits, running the event loop, until it closes the connection.
+ */
+Reply fetch(quint16 port, const QByteArray &method, const QByteArray &target)
+{
+    QTcpSocket socket;
+    QEventLoop loop;
+    QObject::connect(&socket, &QTcpSocket::connected, [&] {
+        socket.write(method + " " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    });
+    QObject::connect(&socket, &QTcpSocket::disconnected, &loop, &QEventLoop::quit);
+    QTimer::singleShot(TIMEOUT_MS, &loop, &QEventLoop::quit);
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    loop.exec();
+
+    Reply reply;
+    const QByteArray message = socket.readAll();
+    const int end = message.indexOf("\r\n\r\n");
+    if (end < 0)
+    {
+        return reply;
+    }
+
+    const QList<QByteArray> lines = message.left(end).split('\n');
+    const QList<QByteArray> status = lines.first().trimmed().split(' ');
+    reply.status = status.size() > 1 ? status.at(1).toInt() : 0;
+    for (const QByteArray &line : lines)
+    {
+        if (line.startsWith("Content-Type: "))
+        {
+            reply.contentType = line.mid(14).trimmed();
+        }
+    }
+    reply.body = message.mid(end + 4);
+    return reply;
+}
+
+QJsonObject json(const Reply &reply)
+{
+    return QJsonDocument::fromJson(reply.body).object();
+}
+
+void testChannels(quint16 port)
+{
+    const Reply reply = fetch(port, "GET", "/api/channels");
+    const QJsonArray channels = json(reply).value("channels").toArray();
+    check("channels: 200 and JSON", reply.status == 200 && reply.contentType == "application/json");
+    check("channels: every tracked channel", channels.size() == 2);
+    const QJsonObject first = channels.at(0).toObject();
+    check("channels: id, satellite, signal and samples", first.value("channel").toInt() == 3 &&
+        first.value("sat").toString() == "G12" && first.value("signal").toString() == "1C" &&
+        first.value("samples").toInt() == SAMPLES);
+}
+
+void testSeries(quint16 port)
+{
+    Reply reply = fetch(port, "GET", "/api/series?sat=g12&field=cn0,doppler&last=100&points=1000");
+    QJsonArray series = json(reply).value("series").toArray();
+    check("series: 200 and JSON", reply.status == 200 && reply.contentType == "application/json");
+    check("series: one per field", series.size() == 2);
+
+    const QJsonObject cn0 = series.at(0).toObject();
+    const QJsonArray t = cn0.value("t").toArray();
+    const QJsonArray v = cn0.value("v").toArray();
+    check("series: field and channel", cn0.value("field").toString() == "cn0" &&
+        cn0.value("channel").toInt() == 3 && cn0.value("sat").toString() == "G12" &&
+        cn0.value("signal").toString() == "1C");
+    check("series: last= keeps the newest seconds", t.size() == 101 && t.first().toDouble() == SAMPLES - 101 &&
+        t.last().toDouble() == SAMPLES - 1);
+    check("series: values of the field", v.size() == 101 && v.first().toDouble() == 10000 + SAMPLES - 101 &&
+        series.at(1).toObject().value("v").toArray().first().toDouble() == 20000 + SAMPLES - 101);
+
+    reply = fetch(port, "GET", "/api/series?channel=7&from=100&to=899&points=50");
+    series = json(reply).value("series").toArray();
+    const QJsonArray downsampled = series.at(0).toObject().value("t").toArray();
+    check("series: channel= and default field", reply.status == 200 && series.size() == 1 &&
+        series.at(0).toObject().value("sat").toString() == "E05" &&
+        series.at(0).toObject().value("field").toString() == "cn0");
+    check("series: points= bounds the samples", downsampled.size() > 0 && downsampled.size() <= 50 &&
+        downsampled.first().toDouble() >= 100 && downsampled.last().toDouble() <= 899);
+}
+
+void testBinary(quint16 port)
+{
+    const Reply reply = fetch(port, "GET", "/api/series?sat=G12&field=prompt_i&from=10&to=19&format=binary");
+    check("binary: 200 and octet stream", reply.status == 200 && reply.contentType == "application/octet-stream");
+
+    QDataStream stream(reply.body);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    quint32 series = 0;
+    quint32 samples = 0;
+    stream >> series >> samples;
+    check("binary: series and sample counts", series == 1 && samples == 10);
+    check("binary: size of the body", reply.body.size() == static_cast<int>(8 + 2 * samples * sizeof(double)));
+
+    bool ok = samples == 10;
+    for (quint32 i = 0; ok && i < samples; i++)
+    {
+        double t = 0.0;
+        stream >> t;
+        ok = t == 10 + i;
+    }
+    for (quint32 i = 0; ok && i < samples; i++)
+    {
+        double v = 0.0;
+        stream >> v;
+        ok = v == 40000 + 10 + i;
+    }
+    check("binary: times, then values", ok && stream.status() == QDataStream::Ok && stream.atEnd());
+}
+
+void testPvt(quint16 port)
+{
+    Reply reply = fetch(port, "GET", "/api/pvt?fields=height,gdop&last=9");
+    const QJsonArray series = json(reply).value("series").toArray();
+    check("pvt: 200 and JSON", reply.status == 200 && reply.contentType == "application/json");
+    check("pvt: one series per field, without a channel", series.size() == 2 &&
+        series.at(0).toObject().value("field").toString() == "height" &&
+        series.at(1).toObject().value("field").toString() == "gdop" &&
+        !series.at(0).toObject().contains("channel"));
+    check("pvt: last= keeps the newest seconds", series.at(1).toObject().value("t").toArray().size() == 10);
+
+    reply = fetch(port, "GET", "/api/pvt");
+    check("pvt: default fields", json(reply).value("series").toArray().size() == 3);
+}
+
+void testErrors(quint16 port)
+{
+    const struct
+    {
+        const char *what;
+        QByteArray method;
+        QByteArray target;
+        int status;
+    } cases[] = {
+        {"errors: series without sat nor channel", "GET", "/api/series?field=cn0", 400},
+        {"errors: unknown field", "GET", "/api/series?sat=G12&field=snr", 400},
+        {"errors: invalid channel", "GET", "/api/series?channel=-1", 400},
+        {"errors: points out of range", "GET", "/api/series?sat=G12&points=1", 400},
+        {"errors: non-finite bound", "GET", "/api/pvt?from=nan", 400},
+        {"errors: unknown format", "GET", "/api/pvt?format=csv", 400},
+        {"errors: unknown path", "GET", "/api/satellites", 404},
+        {"errors: satellite not tracked", "GET", "/api/series?sat=R01", 404},
+        {"errors: POST", "POST", "/api/channels", 405},
+        {"errors: DELETE", "DELETE", "/api/series?sat=G12", 405},
+    };
+
+    for (const auto &c : cases)
+    {
+        const Reply reply = fetch(port, c.method, c.target);
+        check(c.what, reply.status == c.status && reply.contentType == "application/json" &&
+            !json(reply).value("error").toString().isEmpty());
+    }
+}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QueryServer server;
+    server.setSnapshotProvider(fixedSnapshot);
+    quint16 port = FIRST_PORT;
+    while (!server.listen(port) && port < FIRST_PORT + PORT_ATTEMPTS)
+    {
+        port++;
+    }
+    check("listens on localhost", server.isListening());
+    if (!server.isListening())
+    {
+        return failures;
+    }
+
+    testChannels(port);
+    testSeries(port);
+    testBinary(port);
+    testPvt(port);
+    testErrors(port);
+    return failures;
+}
@@ -0,0 +1,56 @@
+/*!
+ * \file replay_benchmark_test.cpp
+ * \brief Runs the replay benchmark as a test
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "replay_benchmark.h"
+#include <QApplication>
+#include <QCommandLineParser>
+
+/*!
+ Takes the options of --benchmark, see ReplayBenchmark::addOptions(), and exits with the status of
+ ReplayBenchmark::run(). Never touches the settings nor the saved session of the monitor.
+ */
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    app.setOrganizationName("gnss-sdr");
+    app.setOrganizationDomain("gnss-sdr.org");
+    app.setApplicationName("gnss-sdr-monitor");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays synthetic sessions through all the views and checks their budgets.");
+    parser.addHelpOption();
+    ReplayBenchmark::addOptions(parser);
+    parser.process(app);
+
+    ReplayBenchmark benchmark(ReplayBenchmark::options(parser));
+    return benchmark.run();
+}
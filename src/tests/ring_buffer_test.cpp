@@ -0,0 +1,294 @@
+/*!
+ * \file ring_buffer_test.cpp
+ * \brief Tests and micro-benchmarks of the ring buffer and its reductions
+ *
+ * \author Andrew Smilie (smilima), 2026.
+ *
+ * -----------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2019  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *      Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * -----------------------------------------------------------------------
+ */
+
+
+#include "ring_buffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Same layout as QPointF, which the altitude and DOP widgets keep.
+struct Point
+{
+    double x;
+    double y;
+};
+
+// The SSE2 sum adds in two lanes, so the mean differs from a sequential sum by a few ulps of the values.
+constexpr double MEAN_TOLERANCE = 1e-12;
+
+int failures = 0;
+
+void check(const char *what, bool ok)
+{
+    std::printf("%-52s %s\n", what, ok ? "ok" : "FAIL");
+    failures += ok ? 0 : 1;
+}
+
+/*!
+ Compares the contents, segments and reductions of buffers of several capacities with a plain
+ history of everything pushed, over every window and across the wrap of the storage.
+ */
+void testAgainstHistory(std::mt19937 &random)
+{
+    std::uniform_real_distribution<double> uniform(-1e3, 1e3);
+    bool contents = true, spans = true, range = true, range_xy = true, mean = true, copy = true;
+
+    for (size_t capacity : {1, 2, 3, 5, 8, 13, 64, 100})
+    {
+        RingBuffer<double> values(capacity);
+        RingBuffer<Point> points(capacity);
+        std::vector<double> history;
+        std::vector<Point> point_history;
+
+        for (size_t pushed = 0; pushed < 3 * capacity + 7; pushed++)
+        {
+            const double value = uniform(random);
+            values.push_back(value);
+            points.push_back({uniform(random), uniform(random)});
+            history.push_back(value);
+            point_history.push_back(points.back());
+
+            const size_t size = std::min(history.size(), capacity);
+            const size_t oldest = history.size() - size;
+            contents = contents && values.size() == size && points.size() == size;
+
+            std::vector<double> copied;
+            values.copyTo(copied);
+            copy = copy && copied == std::vector<double>(history.begin() + oldest, history.end());
+
+            for (size_t first = 0; first <= size; first++)
+            {
+                const size_t count = size - first;
+                RingBuffer<double>::Segments s = values.segments(first, count);
+                spans = spans && s.first.size + s.second.size == count;
+
+                RingRange expected;
+                double expected_sum = 0.0;
+                RingRange expected_x, expected_y;
+                for (size_t i = 0; i < count; i++)
+                {
+                    const double v = history[oldest + first + i];
+                    contents = contents && values[first + i] == v;
+                    expected.min = std::min(expected.min, v);
+                    expected.max = std::max(expected.max, v);
+                    expected_sum += v;
+
+                    const Point &p = point_history[oldest + first + i];
+                    expected_x.min = std::min(expected_x.min, p.x);
+                    expected_x.max = std::max(expected_x.max, p.x);
+                    expected_y.min = std::min(expected_y.min, p.y);
+                    expected_y.max = std::max(expected_y.max, p.y);
+                }
+
+                const RingRange r = ringMinMax(values, first, count);
+                range = range && r.min == expected.min && r.max == expected.max;
+                const double expected_mean = count > 0 ? expected_sum / count : 0.0;
+                mean = mean && std::abs(ringMean(values, first, count) - expected_mean) <= MEAN_TOLERANCE;
+                const std::pair<RingRange, RingRange> xy = ringMinMaxXY(points, first, count);
+                range_xy = range_xy && xy.first.min == expected_x.min && xy.first.max == expected_x.max &&
+                           xy.second.min == expected_y.min && xy.second.max == expected_y.max;
+            }
+        }
+    }
+
+    check("contents and indexing", contents);
+    check("segments cover the requested range", spans);
+    check("copyTo", copy);
+    check("ringMinMax against a scalar scan", range);
+    check("ringMinMaxXY against a scalar scan", range_xy);
+    check("ringMean against a scalar sum", mean);
+}
+
+void testCapacityAndGeneration()
+{
+    RingBuffer<double> buffer(5);
+    for (int i = 0; i < 12; i++)
+    {
+        buffer.push_back(i);
+    }
+    const uint64_t generation = buffer.generation();
+    buffer.setCapacity(3);
+    check("setCapacity keeps the newest elements", buffer.size() == 3 && buffer.front() == 9.0 && buffer.back() == 11.0);
+    check("every change bumps the generation", buffer.generation() != generation);
+
+    RingRange empty = ringMinMax(buffer, 3, 1);
+    check("an empty range is not valid", !empty.valid());
+    check("the mean of an empty range is 0", ringMean(buffer, 3, 1) == 0.0 && ringMean(buffer, 1, 0) == 0.0);
+
+    RingBuffer<double> none(0);
+    none.push_back(1.0);
+    check("a buffer without capacity stays empty", none.empty());
+}
+
+/*!
+ Prints the time per element of the reductions next to the scalar loops they replace, and of
+ copyTo() next to a copy element by element.
+ */
+void benchmark(std::mt19937 &random)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int REPEATS = 200;
+    constexpr size_t CAPACITY = 10000;
+    std::uniform_real_distribution<double> uniform(-1e3, 1e3);
+
+    std::vector<double> input(3 * CAPACITY);
+    for (double &value : input)
+    {
+        value = uniform(random);
+    }
+
+    RingBuffer<double> values(CAPACITY);
+    RingBuffer<Point> points(CAPACITY);
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < REPEATS; r++)
+    {
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            values.push_back(input[i]);
+            points.push_back({static_cast<double>(i), input[i]});
+        }
+    }
+    const double push_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (REPEATS * input.size());
+    std::printf("%-52s %8.3f ns/element\n", "push_back, a double and a point", push_ns);
+
+    auto report = [](const char *what, Clock::time_point start, double sink) {
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (REPEATS * CAPACITY);
+        std::printf("%-52s %8.3f ns/element  (%g)\n", what, ns, sink);
+    };
+
+    start = Clock::now();
+    double sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        const RingRange range = ringMinMax(values, 0, values.size());
+        sink += range.max - range.min;
+    }
+    report("ringMinMax", start, sink);
+
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        RingRange range;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            range.min = std::min(range.min, values[i]);
+            range.max = std::max(range.max, values[i]);
+        }
+        sink += range.max - range.min;
+    }
+    report("scalar min and max through operator[]", start, sink);
+
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        sink += ringMean(values, 0, values.size());
+    }
+    report("ringMean", start, sink);
+
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            sum += values[i];
+        }
+        sink += sum / values.size();
+    }
+    report("scalar mean through operator[]", start, sink);
+
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        const std::pair<RingRange, RingRange> range = ringMinMaxXY(points, 0, points.size());
+        sink += range.second.max - range.first.min;
+    }
+    report("ringMinMaxXY", start, sink);
+
+    start = Clock::now();
+    sink = 0.0;
+    for (int r = 0; r < REPEATS; r++)
+    {
+        RingRange x, y;
+        points.forEach([&x, &y](const Point &p) {
+            x.min = std::min(x.min, p.x);
+            x.max = std::max(x.max, p.x);
+            y.min = std::min(y.min, p.y);
+            y.max = std::max(y.max, p.y);
+        });
+        sink += y.max - x.min;
+    }
+    report("scalar x and y ranges through forEach", start, sink);
+
+    std::vector<Point> copied;
+    start = Clock::now();
+    for (int r = 0; r < REPEATS; r++)
+    {
+        copied.clear();
+        points.copyTo(copied);
+    }
+    report("copyTo", start, copied.back().y);
+
+    start = Clock::now();
+    for (int r = 0; r < REPEATS; r++)
+    {
+        copied.clear();
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            copied.push_back(points[i]);
+        }
+    }
+    report("copy element by element", start, copied.back().y);
+}
+}  // namespace
+
+/*!
+ Checks RingBuffer and its reductions against plain scans, then prints their cost.
+ Returns the number of checks that failed.
+ */
+int main()
+{
+    std::mt19937 random(1);
+    testAgainstHistory(random);
+    testCapacityAndGeneration();
+    benchmark(random);
+    return failures;
+}